@@ -0,0 +1,593 @@
+#include "AssetDatabase.h"
+#include "ContentHash.h"
+#include "MeshImporter.h"
+#include "SceneAssetImporter.h"
+#include "TextureImporter.h"
+#include "../Core/EditorLog.h"
+#include "../Core/EditorStats.h"
+#include "../Core/MemoryTracker.h"
+#include "../Core/Profiler.h"
+#include "../Document/SceneFile.h"
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSaveFile>
+#include <QtCore/QSet>
+#include <QtCore/QThread>
+
+namespace Orca
+{
+	namespace
+	{
+		const char* const kScanRoots[] = { "Assets", "Scenes", "Scripts" };
+
+		constexpr quint32 kDatabaseMagic = 0x4244414F; // "OADB"
+		constexpr quint32 kDatabaseVersion = 1;
+
+		QDataStream& operator<<(QDataStream& stream, const AssetRecord& record)
+		{
+			return stream << record.path << record.size << record.modifiedMs << record.metaSize << record.metaModifiedMs
+				<< record.contentHash << record.settingsHash << record.importer << record.importerVersion
+				<< record.artifactKey << record.error;
+		}
+
+		QDataStream& operator>>(QDataStream& stream, AssetRecord& record)
+		{
+			return stream >> record.path >> record.size >> record.modifiedMs >> record.metaSize >> record.metaModifiedMs
+				>> record.contentHash >> record.settingsHash >> record.importer >> record.importerVersion
+				>> record.artifactKey >> record.error;
+		}
+
+		QString ExtensionOf(const QString& path)
+		{
+			int dot = path.lastIndexOf('.');
+			int slash = path.lastIndexOf('/');
+			return dot > slash ? path.mid(dot + 1).toLower() : QString();
+		}
+	}
+
+	AssetDatabase::AssetDatabase(const QString& projectRoot)
+		: m_projectRoot(QDir(projectRoot).absolutePath())
+	{
+		m_pool.setMaxThreadCount(QThread::idealThreadCount());
+		m_pool.setObjectName("AssetImport");
+
+		RegisterImporter(std::make_shared<SceneAssetImporter>());
+		RegisterImporter(std::make_shared<TextureImporter>());
+		RegisterImporter(std::make_shared<MeshImporter>());
+	}
+
+	AssetDatabase::~AssetDatabase()
+	{
+		m_pool.waitForDone();
+		DetachFromEditorStats();
+	}
+
+	void AssetDatabase::AttachToEditorStats(QThreadPool& refreshQueue)
+	{
+		m_attachedToStats = true;
+		EditorStats::Get().RegisterMemoryReporter("Assets", [this]() -> uint64_t { return MemoryBytes(); });
+		EditorStats::Get().RegisterReclaimer("assets", [this, &refreshQueue](EditorStats::ReclaimDone done)
+		{
+			// Queued behind any pending refresh and reported from the queue once it runs.
+			refreshQueue.start([this, done]() { done(CollectGarbage()); });
+		});
+	}
+
+	void AssetDatabase::DetachFromEditorStats()
+	{
+		if (!m_attachedToStats) return;
+		m_attachedToStats = false;
+		EditorStats::Get().UnregisterMemoryReporter("Assets");
+		EditorStats::Get().UnregisterReclaimer("assets");
+	}
+
+	void AssetDatabase::RegisterImporter(std::shared_ptr<AssetImporter> importer)
+	{
+		for (const QString& extension : importer->Extensions())
+		{
+			m_importersByExtension.insert(extension, importer.get());
+		}
+		m_importers.push_back(std::move(importer));
+	}
+
+	const AssetImporter* AssetDatabase::ImporterFor(const QString& path) const
+	{
+		return m_importersByExtension.value(ExtensionOf(path), nullptr);
+	}
+
+	QString AssetDatabase::LibraryPath() const
+	{
+		return m_projectRoot + "/Library";
+	}
+
+	QString AssetDatabase::ArtifactPath(quint64 artifactKey) const
+	{
+		QString hex = QString("%1").arg(artifactKey, 16, 16, QChar('0'));
+		return LibraryPath() + "/Artifacts/" + hex.left(2) + "/" + hex;
+	}
+
+	bool AssetDatabase::Load(QString* error)
+	{
+		QFile file(LibraryPath() + "/AssetDatabase.bin");
+		if (!file.exists()) return true;
+		if (!file.open(QIODevice::ReadOnly))
+		{
+			if (error) *error = file.errorString();
+			return false;
+		}
+
+		QDataStream stream(&file);
+		quint32 magic = 0, version = 0, count = 0;
+		stream >> magic >> version >> count;
+		if (magic != kDatabaseMagic || version != kDatabaseVersion)
+		{
+			ORCA_LOG_INFO("Assets", "Asset database format changed; all assets will be checked again");
+			return true;
+		}
+
+		QHash<QString, AssetRecord> records;
+		records.reserve(static_cast<qsizetype>(count));
+		for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+		{
+			AssetRecord record;
+			stream >> record;
+			records.insert(record.path, record);
+		}
+
+		if (stream.status() != QDataStream::Ok)
+		{
+			if (error) *error = "Asset database is truncated";
+			return false;
+		}
+
+		QMutexLocker locker(&m_mutex);
+		m_records = std::move(records);
+		return true;
+	}
+
+	bool AssetDatabase::Save(QString* error) const
+	{
+		if (!QDir().mkpath(LibraryPath()))
+		{
+			if (error) *error = QString("Couldn't create %1").arg(LibraryPath());
+			return false;
+		}
+
+		QSaveFile file(LibraryPath() + "/AssetDatabase.bin");
+		if (!file.open(QIODevice::WriteOnly))
+		{
+			if (error) *error = file.errorString();
+			return false;
+		}
+
+		QDataStream stream(&file);
+		{
+			QMutexLocker locker(&m_mutex);
+			stream << kDatabaseMagic << kDatabaseVersion << static_cast<quint32>(m_records.size());
+			for (const AssetRecord& record : m_records) stream << record;
+		}
+
+		if (stream.status() != QDataStream::Ok || !file.commit())
+		{
+			if (error) *error = file.errorString();
+			return false;
+		}
+		return true;
+	}
+
+	bool AssetDatabase::IsUpToDate(const Candidate& candidate, const AssetRecord& record) const
+	{
+		if (candidate.size != record.size || candidate.modifiedMs != record.modifiedMs
+			|| candidate.metaSize != record.metaSize || candidate.metaModifiedMs != record.metaModifiedMs)
+		{
+			return false;
+		}
+
+		const AssetImporter* importer = ImporterFor(candidate.path);
+		if (!importer) return record.importer.isEmpty();
+		return record.importer == importer->Name() && record.importerVersion == importer->Version();
+	}
+
+	AssetDatabase::ImportResult AssetDatabase::ProcessAsset(const Candidate& candidate, const std::atomic<bool>* cancel) const
+	{
+		ImportResult result;
+		AssetRecord& record = result.record;
+		record.path = candidate.path;
+		record.size = candidate.size;
+		record.modifiedMs = candidate.modifiedMs;
+		record.metaSize = candidate.metaSize;
+		record.metaModifiedMs = candidate.metaModifiedMs;
+
+		if (cancel && cancel->load(std::memory_order_relaxed))
+		{
+			result.skipped = true;
+			return result;
+		}
+
+		const QString sourcePath = m_projectRoot + "/" + candidate.path;
+		MappedFile source;
+		QString error;
+		if (!source.Open(sourcePath, &error))
+		{
+			record.error = error;
+			return result;
+		}
+
+		record.contentHash = ContentHash(source.Data(), source.Size());
+		result.hashed = true;
+
+		QJsonObject settings;
+		if (candidate.metaSize >= 0)
+		{
+			QFile meta(sourcePath + ".meta");
+			if (meta.open(QIODevice::ReadOnly))
+			{
+				QByteArray bytes = meta.readAll();
+				record.settingsHash = ContentHash(bytes.constData(), static_cast<size_t>(bytes.size()));
+				settings = QJsonDocument::fromJson(bytes).object().value("Settings").toObject();
+			}
+		}
+
+		const AssetImporter* importer = ImporterFor(candidate.path);
+		if (!importer)
+		{
+			return result;
+		}
+
+		record.importer = importer->Name();
+		record.importerVersion = importer->Version();
+
+		QByteArray importerName = record.importer.toUtf8();
+		quint64 key = CombineHash(record.contentHash, record.settingsHash);
+		key = CombineHash(key, ContentHash(importerName.constData(), static_cast<size_t>(importerName.size())));
+		key = CombineHash(key, record.importerVersion);
+		record.artifactKey = key ? key : 1;
+
+		const QString artifactPath = ArtifactPath(record.artifactKey);
+		if (QFileInfo::exists(artifactPath))
+		{
+			result.cacheHit = true;
+			return result;
+		}
+
+		AssetImportContext context;
+		context.sourcePath = sourcePath;
+		context.assetPath = candidate.path;
+		context.data = source.Data();
+		context.size = source.Size();
+		context.settings = settings;
+
+		QByteArray artifact;
+		if (!importer->Import(context, artifact, error))
+		{
+			record.error = error.isEmpty() ? QString("Import failed") : error;
+			record.artifactKey = 0;
+			return result;
+		}
+
+		// Identical sources may race for the same key; QSaveFile makes the last rename win harmlessly.
+		QDir().mkpath(QFileInfo(artifactPath).path());
+		QSaveFile output(artifactPath);
+		if (!output.open(QIODevice::WriteOnly) || output.write(artifact) != artifact.size() || !output.commit())
+		{
+			record.error = QString("Couldn't write artifact: %1").arg(output.errorString());
+			record.artifactKey = 0;
+			return result;
+		}
+
+		result.imported = true;
+		return result;
+	}
+
+	void AssetDatabase::ScanTree(const QString& absoluteDirectory, QVector<Candidate>& files) const
+	{
+		// .meta files are picked up by the same walk, so each file costs one directory entry.
+		QHash<QString, QPair<qint64, qint64>> metas;
+		const qsizetype prefixLength = m_projectRoot.size() + 1;
+		const qsizetype firstFile = files.size();
+
+		QDirIterator it(absoluteDirectory, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+		while (it.hasNext())
+		{
+			it.next();
+			const QFileInfo info = it.fileInfo();
+			const QString path = info.filePath().mid(prefixLength);
+			const qint64 modifiedMs = info.lastModified().toMSecsSinceEpoch();
+
+			if (path.endsWith(".meta"))
+			{
+				metas.insert(path.chopped(5), { info.size(), modifiedMs });
+			}
+			else
+			{
+				files.append({ path, info.size(), modifiedMs, -1, 0 });
+			}
+		}
+
+		for (qsizetype i = firstFile; i < files.size(); ++i)
+		{
+			Candidate& candidate = files[i];
+			auto meta = metas.constFind(candidate.path);
+			if (meta != metas.constEnd())
+			{
+				candidate.metaSize = meta->first;
+				candidate.metaModifiedMs = meta->second;
+			}
+		}
+	}
+
+	bool AssetDatabase::IsTracked(const QString& assetPath)
+	{
+		for (const char* rootName : kScanRoots)
+		{
+			const qsizetype length = static_cast<qsizetype>(qstrlen(rootName));
+			if (assetPath.startsWith(QLatin1String(rootName))
+				&& (assetPath.size() == length || assetPath.at(length) == '/'))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	AssetRefreshStats AssetDatabase::Refresh(const ProgressCallback& progress, const std::atomic<bool>* cancel)
+	{
+		ORCA_PROFILE_ZONE("AssetDatabase::Refresh");
+		MemoryTagScope memoryTag(MemoryTag::Assets);
+
+		QElapsedTimer timer;
+		timer.start();
+
+		QVector<Candidate> files;
+		for (const char* rootName : kScanRoots)
+		{
+			ScanTree(m_projectRoot + "/" + rootName, files);
+		}
+
+		QStringList removed;
+		{
+			QSet<QString> seen;
+			seen.reserve(files.size());
+			for (const Candidate& candidate : files) seen.insert(candidate.path);
+
+			QMutexLocker locker(&m_mutex);
+			for (auto it = m_records.constBegin(); it != m_records.constEnd(); ++it)
+			{
+				if (!seen.contains(it.key())) removed.append(it.key());
+			}
+		}
+
+		AssetRefreshStats stats = Update(files, removed, timer.nsecsElapsed() / 1e6, progress, cancel);
+		ORCA_LOG_INFO("Assets", "Refreshed {} assets in {} ms: {} unchanged, {} imported, {} from cache, {} removed, {} failed",
+			stats.scanned, static_cast<int>(stats.scanMs + stats.importMs), stats.unchanged, stats.imported, stats.cacheHits, stats.removed, stats.failed);
+		return stats;
+	}
+
+	AssetRefreshStats AssetDatabase::RefreshPaths(const QStringList& paths, const ProgressCallback& progress, const std::atomic<bool>* cancel)
+	{
+		ORCA_PROFILE_ZONE("AssetDatabase::RefreshPaths");
+		MemoryTagScope memoryTag(MemoryTag::Assets);
+
+		QElapsedTimer timer;
+		timer.start();
+
+		QVector<Candidate> files;
+		QSet<QString> queued;
+		QStringList removed;
+
+		for (const QString& changedPath : paths)
+		{
+			if (changedPath.isEmpty() || changedPath == ".")
+			{
+				return Refresh(progress, cancel);
+			}
+
+			// A .meta edit reimports the asset it describes.
+			const QString assetPath = changedPath.endsWith(".meta") ? changedPath.chopped(5) : changedPath;
+			if (!IsTracked(assetPath) || queued.contains(assetPath)) continue;
+			queued.insert(assetPath);
+
+			const QFileInfo info(m_projectRoot + "/" + assetPath);
+			if (info.isFile())
+			{
+				Candidate candidate{ assetPath, info.size(), info.lastModified().toMSecsSinceEpoch(), -1, 0 };
+				const QFileInfo meta(info.filePath() + ".meta");
+				if (meta.isFile())
+				{
+					candidate.metaSize = meta.size();
+					candidate.metaModifiedMs = meta.lastModified().toMSecsSinceEpoch();
+				}
+				files.append(candidate);
+				continue;
+			}
+
+			// A directory stands for everything under it, e.g. after a folder was moved in or out.
+			QSet<QString> present;
+			if (info.isDir())
+			{
+				const qsizetype before = files.size();
+				ScanTree(info.filePath(), files);
+				for (qsizetype i = before; i < files.size(); ++i) present.insert(files[i].path);
+			}
+
+			const QString prefix = assetPath + "/";
+			QMutexLocker locker(&m_mutex);
+			for (auto it = m_records.constBegin(); it != m_records.constEnd(); ++it)
+			{
+				if ((it.key() == assetPath || it.key().startsWith(prefix)) && !present.contains(it.key()))
+				{
+					removed.append(it.key());
+				}
+			}
+		}
+
+		AssetRefreshStats stats = Update(files, removed, timer.nsecsElapsed() / 1e6, progress, cancel);
+		if (stats.imported || stats.cacheHits || stats.removed || stats.failed)
+		{
+			ORCA_LOG_INFO("Assets", "Reloaded {} changed paths in {} ms: {} imported, {} from cache, {} removed, {} failed",
+				paths.size(), static_cast<int>(stats.scanMs + stats.importMs), stats.imported, stats.cacheHits, stats.removed, stats.failed);
+		}
+		return stats;
+	}
+
+	AssetRefreshStats AssetDatabase::Update(const QVector<Candidate>& files, const QStringList& removed, double scanMs,
+		const ProgressCallback& progress, const std::atomic<bool>* cancel)
+	{
+		AssetRefreshStats stats;
+		QElapsedTimer timer;
+		timer.start();
+
+		// Without the artifact cache nothing can be trusted, e.g. after Library/ was deleted.
+		const bool libraryIntact = QFileInfo::exists(LibraryPath() + "/Artifacts");
+
+		QVector<Candidate> changed;
+		{
+			QMutexLocker locker(&m_mutex);
+			for (const Candidate& candidate : files)
+			{
+				auto record = m_records.constFind(candidate.path);
+				if (libraryIntact && record != m_records.constEnd() && IsUpToDate(candidate, *record))
+				{
+					++stats.unchanged;
+				}
+				else
+				{
+					changed.append(candidate);
+				}
+			}
+		}
+
+		stats.scanned = static_cast<int>(files.size());
+		stats.scanMs = scanMs + timer.nsecsElapsed() / 1e6;
+		timer.restart();
+
+		std::vector<ImportResult> results(static_cast<size_t>(changed.size()));
+		std::atomic<int> completed{ 0 };
+		for (qsizetype i = 0; i < changed.size(); ++i)
+		{
+			m_pool.start([this, &changed, &results, &completed, cancel, i]()
+			{
+				MemoryTagScope memoryTag(MemoryTag::Assets);
+				results[static_cast<size_t>(i)] = ProcessAsset(changed[i], cancel);
+				completed.fetch_add(1, std::memory_order_relaxed);
+			});
+		}
+
+		const int total = static_cast<int>(changed.size());
+		while (!m_pool.waitForDone(50))
+		{
+			if (progress) progress(completed.load(std::memory_order_relaxed), total);
+		}
+		if (progress) progress(total, total);
+
+		{
+			QMutexLocker locker(&m_mutex);
+			for (const QString& path : removed) m_records.remove(path);
+
+			for (ImportResult& result : results)
+			{
+				if (result.skipped)
+				{
+					stats.cancelled = true;
+					continue;
+				}
+
+				if (result.hashed) ++stats.hashed;
+				if (result.imported) ++stats.imported;
+				if (result.cacheHit) ++stats.cacheHits;
+				if (!result.record.error.isEmpty())
+				{
+					++stats.failed;
+					ORCA_LOG_WARNING("Assets", "Failed to import {}: {}", result.record.path, result.record.error);
+				}
+				m_records.insert(result.record.path, std::move(result.record));
+			}
+		}
+		stats.removed = static_cast<int>(removed.size());
+		stats.importMs = timer.nsecsElapsed() / 1e6;
+
+		if (changed.isEmpty() && removed.isEmpty()) return stats;
+
+		QString saveError;
+		if (!Save(&saveError))
+		{
+			ORCA_LOG_WARNING("Assets", "Couldn't save the asset database: {}", saveError);
+		}
+		return stats;
+	}
+
+	bool AssetDatabase::Find(const QString& assetPath, AssetRecord& out) const
+	{
+		QMutexLocker locker(&m_mutex);
+		auto record = m_records.constFind(assetPath);
+		if (record == m_records.constEnd()) return false;
+		out = *record;
+		return true;
+	}
+
+	int AssetDatabase::AssetCount() const
+	{
+		QMutexLocker locker(&m_mutex);
+		return static_cast<int>(m_records.size());
+	}
+
+	QByteArray AssetDatabase::LoadArtifact(const QString& assetPath) const
+	{
+		AssetRecord record;
+		if (!Find(assetPath, record) || record.artifactKey == 0) return {};
+
+		QFile file(ArtifactPath(record.artifactKey));
+		if (!file.open(QIODevice::ReadOnly)) return {};
+		return file.readAll();
+	}
+
+	uint64_t AssetDatabase::CollectGarbage()
+	{
+		QSet<quint64> referenced;
+		{
+			QMutexLocker locker(&m_mutex);
+			for (const AssetRecord& record : m_records)
+			{
+				if (record.artifactKey) referenced.insert(record.artifactKey);
+			}
+		}
+
+		uint64_t freed = 0;
+		int deleted = 0;
+		QDirIterator it(LibraryPath() + "/Artifacts", QDir::Files, QDirIterator::Subdirectories);
+		while (it.hasNext())
+		{
+			it.next();
+			bool ok = false;
+			quint64 key = it.fileName().toULongLong(&ok, 16);
+			if (ok && referenced.contains(key)) continue;
+
+			qint64 size = it.fileInfo().size();
+			if (QFile::remove(it.filePath()))
+			{
+				freed += static_cast<uint64_t>(size);
+				++deleted;
+			}
+		}
+
+		ORCA_LOG_INFO("Assets", "Removed {} unreferenced artifacts", deleted);
+		return freed;
+	}
+
+	size_t AssetDatabase::MemoryBytes() const
+	{
+		QMutexLocker locker(&m_mutex);
+		size_t bytes = static_cast<size_t>(m_records.capacity()) * (sizeof(QString) + sizeof(AssetRecord));
+		for (const AssetRecord& record : m_records)
+		{
+			bytes += static_cast<size_t>(record.path.capacity() + record.importer.capacity() + record.error.capacity()) * sizeof(QChar);
+		}
+		return bytes;
+	}
+}
\ No newline at end of file
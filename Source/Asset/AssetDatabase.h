@@ -0,0 +1,163 @@
+#pragma once
+
+#ifndef ASSET_DATABASE_H
+#define ASSET_DATABASE_H
+
+#include "AssetImporter.h"
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Orca
+{
+	struct AssetRecord
+	{
+		QString path;                // project-relative, '/' separated ("Assets/Textures/Grass.png")
+		qint64 size = 0;
+		qint64 modifiedMs = 0;
+		qint64 metaSize = -1;        // -1 when the asset has no .meta file
+		qint64 metaModifiedMs = 0;
+
+		quint64 contentHash = 0;
+		quint64 settingsHash = 0;
+		QString importer;            // empty when no importer handles the extension
+		quint32 importerVersion = 0;
+		quint64 artifactKey = 0;     // 0 when there is no artifact
+		QString error;               // last import failure, empty on success
+	};
+
+	struct AssetRefreshStats
+	{
+		int scanned = 0;
+		int unchanged = 0;
+		int hashed = 0;
+		int imported = 0;
+		int cacheHits = 0;
+		int removed = 0;
+		int failed = 0;
+		bool cancelled = false;
+		double scanMs = 0.0;
+		double importMs = 0.0;
+	};
+
+	/**
+	 * @brief Tracks every source file under the project's Assets/, Scenes/ and Scripts/ folders.
+	 *
+	 * A file whose size and modification time (and those of its .meta) match the database is
+	 * skipped without being read. Anything else is hashed on a worker pool; the artifact key is
+	 * derived from the content hash, the .meta settings and the importer version, and artifacts
+	 * live content-addressed under Library/Artifacts, so reverting a file or switching back to a
+	 * branch finds its artifact again instead of reimporting.
+	 *
+	 * Refresh() may run on any single thread; Find() and the other const accessors are safe to
+	 * call concurrently with it.
+	 */
+	class AssetDatabase
+	{
+	public:
+		using ProgressCallback = std::function<void(int done, int total)>;
+
+		explicit AssetDatabase(const QString& projectRoot);
+		~AssetDatabase();
+
+		AssetDatabase(const AssetDatabase&) = delete;
+		AssetDatabase& operator=(const AssetDatabase&) = delete;
+
+		void RegisterImporter(std::shared_ptr<AssetImporter> importer);
+
+		/**
+		 * @brief Reads Library/AssetDatabase.bin. A missing or outdated file just means
+		 *        everything is treated as new on the next Refresh().
+		 */
+		bool Load(QString* error = nullptr);
+		bool Save(QString* error = nullptr) const;
+
+		/**
+		 * @brief Brings the database in line with the disk and saves it.
+		 * @param progress Called on the refreshing thread as imports complete.
+		 * @param cancel Checked between imports; finished work is kept.
+		 */
+		AssetRefreshStats Refresh(const ProgressCallback& progress = {}, const std::atomic<bool>* cancel = nullptr);
+
+		/**
+		 * @brief Like Refresh(), but only looks at the given project-relative paths, as reported by
+		 *        ProjectWatcher. A directory covers everything under it; "." means the whole project.
+		 */
+		AssetRefreshStats RefreshPaths(const QStringList& paths, const ProgressCallback& progress = {},
+			const std::atomic<bool>* cancel = nullptr);
+
+		bool Find(const QString& assetPath, AssetRecord& out) const;
+		int AssetCount() const;
+
+		QString ProjectRoot() const { return m_projectRoot; }
+		QString LibraryPath() const;
+		QString ArtifactPath(quint64 artifactKey) const;
+
+		/** @brief The imported artifact for an asset, empty if it has none. */
+		QByteArray LoadArtifact(const QString& assetPath) const;
+
+		/**
+		 * @brief Deletes artifacts no record points at. Returns the bytes freed. Must not run
+		 *        alongside a refresh, which writes an artifact before its record points at it.
+		 */
+		uint64_t CollectGarbage();
+
+		size_t MemoryBytes() const;
+
+		/**
+		 * @brief Reports this database in "mem" and makes "gc assets" collect its garbage on
+		 *        @p refreshQueue, the single-threaded pool its refreshes run on, so the two never
+		 *        overlap. Only the project's own database should do this; it is undone on destruction.
+		 */
+		void AttachToEditorStats(QThreadPool& refreshQueue);
+		void DetachFromEditorStats();
+
+	private:
+		struct Candidate
+		{
+			QString path;
+			qint64 size;
+			qint64 modifiedMs;
+			qint64 metaSize;
+			qint64 metaModifiedMs;
+		};
+
+		struct ImportResult
+		{
+			AssetRecord record;
+			bool hashed = false;
+			bool imported = false;
+			bool cacheHit = false;
+			bool skipped = false;
+		};
+
+		static bool IsTracked(const QString& assetPath);
+
+		const AssetImporter* ImporterFor(const QString& path) const;
+		void ScanTree(const QString& absoluteDirectory, QVector<Candidate>& files) const;
+		AssetRefreshStats Update(const QVector<Candidate>& files, const QStringList& removed, double scanMs,
+			const ProgressCallback& progress, const std::atomic<bool>* cancel);
+		bool IsUpToDate(const Candidate& candidate, const AssetRecord& record) const;
+		ImportResult ProcessAsset(const Candidate& candidate, const std::atomic<bool>* cancel) const;
+
+		QString m_projectRoot;
+
+		mutable QMutex m_mutex;
+		QHash<QString, AssetRecord> m_records;
+
+		std::vector<std::shared_ptr<AssetImporter>> m_importers;
+		QHash<QString, const AssetImporter*> m_importersByExtension;
+
+		QThreadPool m_pool;
+		bool m_attachedToStats = false;
+	};
+}
+
+#endif
\ No newline at end of file
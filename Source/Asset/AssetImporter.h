@@ -0,0 +1,46 @@
+#pragma once
+
+#ifndef ASSET_IMPORTER_H
+#define ASSET_IMPORTER_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <cstddef>
+#include <cstdint>
+
+namespace Orca
+{
+	struct AssetImportContext
+	{
+		QString sourcePath;     // absolute
+		QString assetPath;      // project-relative, '/' separated
+		const char* data = nullptr;
+		size_t size = 0;
+		QJsonObject settings;   // "Settings" object of the asset's .meta file; empty when there is none
+	};
+
+	/**
+	 * @brief Turns a source asset into the engine-ready artifact cached in Library/.
+	 *
+	 * Import() runs on the asset database's worker threads, several at once, so it must not
+	 * touch the GUI or shared editor state. Bump Version() whenever the artifact layout or
+	 * processing changes; that invalidates every artifact the importer produced.
+	 */
+	class AssetImporter
+	{
+	public:
+		virtual ~AssetImporter() = default;
+
+		virtual QString Name() const = 0;
+		virtual uint32_t Version() const = 0;
+
+		/** @brief Lower-case extensions without the dot. */
+		virtual QStringList Extensions() const = 0;
+
+		virtual bool Import(const AssetImportContext& context, QByteArray& artifact, QString& error) const = 0;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Orca
+{
+	/**
+	 * @brief 64-bit XXH64 of a byte range. Used to key assets and Library artifacts by content;
+	 *        fast enough (several GB/s) that hashing is bounded by disk reads.
+	 */
+	uint64_t ContentHash(const void* data, size_t size, uint64_t seed = 0);
+
+	/** @brief Mixes another value into a running key (order-dependent). */
+	inline uint64_t CombineHash(uint64_t hash, uint64_t value)
+	{
+		return ContentHash(&value, sizeof(value), hash);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "MeshArtifact.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr size_t kAlignment = 16;
+
+		size_t AlignUp(size_t value)
+		{
+			return (value + kAlignment - 1) & ~(kAlignment - 1);
+		}
+	}
+
+	void ComputeNormals(MeshData& mesh)
+	{
+		for (MeshVertex& vertex : mesh.vertices)
+		{
+			vertex.normal[0] = vertex.normal[1] = vertex.normal[2] = 0.0f;
+		}
+
+		for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+		{
+			MeshVertex* corners[3] = { &mesh.vertices[mesh.indices[i]], &mesh.vertices[mesh.indices[i + 1]], &mesh.vertices[mesh.indices[i + 2]] };
+			float e1[3], e2[3];
+			for (int k = 0; k < 3; ++k)
+			{
+				e1[k] = corners[1]->position[k] - corners[0]->position[k];
+				e2[k] = corners[2]->position[k] - corners[0]->position[k];
+			}
+			// Unnormalized cross product: longer for larger triangles, which is the weighting we want.
+			const float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+			for (MeshVertex* corner : corners)
+			{
+				for (int k = 0; k < 3; ++k) corner->normal[k] += n[k];
+			}
+		}
+
+		for (MeshVertex& vertex : mesh.vertices)
+		{
+			const float length = std::sqrt(vertex.normal[0] * vertex.normal[0] + vertex.normal[1] * vertex.normal[1] + vertex.normal[2] * vertex.normal[2]);
+			if (length > 0.0f)
+			{
+				for (float& component : vertex.normal) component /= length;
+			}
+			else
+			{
+				vertex.normal[1] = 1.0f;
+			}
+		}
+		mesh.hasNormals = true;
+	}
+
+	bool WriteMeshArtifact(const MeshData& mesh, const std::vector<std::vector<uint32_t>>& lodIndices,
+		const std::vector<float>& lodErrors, const std::function<bool(const char* data, size_t size)>& sink)
+	{
+		if (mesh.vertices.empty() || lodIndices.empty()) return false;
+
+		MeshArtifactHeader header;
+		header.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+		header.lodCount = static_cast<uint32_t>(lodIndices.size());
+		header.indexSize = mesh.vertices.size() <= 0x10000 ? 2 : 4;
+
+		std::vector<MeshLod> lods(lodIndices.size());
+		uint32_t firstIndex = 0;
+		for (size_t lod = 0; lod < lodIndices.size(); ++lod)
+		{
+			lods[lod].firstIndex = firstIndex;
+			lods[lod].indexCount = static_cast<uint32_t>(lodIndices[lod].size());
+			lods[lod].error = lod < lodErrors.size() ? lodErrors[lod] : 0.0f;
+			firstIndex += lods[lod].indexCount;
+		}
+		header.indexCount = firstIndex;
+
+		for (int k = 0; k < 3; ++k)
+		{
+			header.boundsMin[k] = mesh.vertices[0].position[k];
+			header.boundsMax[k] = mesh.vertices[0].position[k];
+		}
+		for (const MeshVertex& vertex : mesh.vertices)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				header.boundsMin[k] = std::min(header.boundsMin[k], vertex.position[k]);
+				header.boundsMax[k] = std::max(header.boundsMax[k], vertex.position[k]);
+			}
+		}
+
+		const size_t vertexOffset = AlignUp(sizeof(MeshArtifactHeader) + lods.size() * sizeof(MeshLod));
+		const size_t vertexBytes = mesh.vertices.size() * sizeof(MeshVertex);
+		const size_t indexOffset = AlignUp(vertexOffset + vertexBytes);
+		header.vertexOffset = static_cast<uint32_t>(vertexOffset);
+		header.indexOffset = static_cast<uint32_t>(indexOffset);
+		if (indexOffset > UINT32_MAX) return false;
+
+		static const char kPadding[kAlignment] = {};
+		const size_t tableEnd = sizeof(MeshArtifactHeader) + lods.size() * sizeof(MeshLod);
+		if (!sink(reinterpret_cast<const char*>(&header), sizeof(header))) return false;
+		if (!sink(reinterpret_cast<const char*>(lods.data()), lods.size() * sizeof(MeshLod))) return false;
+		if (!sink(kPadding, vertexOffset - tableEnd)) return false;
+		if (!sink(reinterpret_cast<const char*>(mesh.vertices.data()), vertexBytes)) return false;
+		if (!sink(kPadding, indexOffset - vertexOffset - vertexBytes)) return false;
+
+		for (const std::vector<uint32_t>& indices : lodIndices)
+		{
+			if (header.indexSize == 2)
+			{
+				std::vector<uint16_t> narrow(indices.begin(), indices.end());
+				if (!sink(reinterpret_cast<const char*>(narrow.data()), narrow.size() * sizeof(uint16_t))) return false;
+			}
+			else if (!sink(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(uint32_t)))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool MeshArtifactView::Open(const char* data, size_t size, std::string* error)
+	{
+		auto fail = [error](const char* reason)
+		{
+			if (error) *error = reason;
+			return false;
+		};
+
+		m_data = nullptr;
+		m_lods.clear();
+
+		if (size < sizeof(MeshArtifactHeader)) return fail("File is too small to be a mesh artifact");
+		std::memcpy(&m_header, data, sizeof(m_header));
+		if (m_header.magic != MeshArtifactHeader::kMagic) return fail("Not a mesh artifact");
+		if (m_header.version != MeshArtifactHeader::kVersion) return fail("Unsupported mesh artifact version");
+		if (m_header.indexSize != 2 && m_header.indexSize != 4) return fail("Invalid index size");
+		if (m_header.lodCount == 0 || m_header.lodCount > 32) return fail("Invalid LOD count");
+
+		const uint64_t tableEnd = sizeof(MeshArtifactHeader) + static_cast<uint64_t>(m_header.lodCount) * sizeof(MeshLod);
+		const uint64_t vertexEnd = m_header.vertexOffset + static_cast<uint64_t>(m_header.vertexCount) * sizeof(MeshVertex);
+		const uint64_t indexEnd = m_header.indexOffset + static_cast<uint64_t>(m_header.indexCount) * m_header.indexSize;
+		if (tableEnd > size || m_header.vertexOffset < tableEnd || m_header.vertexOffset % 4 != 0 || vertexEnd > size
+			|| m_header.indexOffset < vertexEnd || indexEnd > size)
+		{
+			return fail("Mesh data is out of bounds");
+		}
+
+		m_lods.resize(m_header.lodCount);
+		std::memcpy(m_lods.data(), data + sizeof(MeshArtifactHeader), m_lods.size() * sizeof(MeshLod));
+		for (const MeshLod& lod : m_lods)
+		{
+			if (static_cast<uint64_t>(lod.firstIndex) + lod.indexCount > m_header.indexCount || lod.indexCount % 3 != 0)
+			{
+				return fail("LOD range is out of bounds");
+			}
+		}
+
+		// Indices are checked once here so renderers can trust them.
+		for (uint32_t i = 0; i < m_header.indexCount; ++i)
+		{
+			uint32_t index;
+			if (m_header.indexSize == 2)
+			{
+				uint16_t narrow;
+				std::memcpy(&narrow, data + m_header.indexOffset + i * 2, 2);
+				index = narrow;
+			}
+			else
+			{
+				std::memcpy(&index, data + m_header.indexOffset + static_cast<size_t>(i) * 4, 4);
+			}
+			if (index >= m_header.vertexCount) return fail("Index refers past the last vertex");
+		}
+
+		m_data = data;
+		return true;
+	}
+}
\ No newline at end of file
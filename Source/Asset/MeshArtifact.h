@@ -0,0 +1,99 @@
+#pragma once
+
+#ifndef MESH_ARTIFACT_H
+#define MESH_ARTIFACT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Orca
+{
+	struct MeshVertex
+	{
+		float position[3];
+		float normal[3];
+		float uv[2];
+	};
+
+	/** @brief Indexed triangle list, as produced by the mesh parsers. */
+	struct MeshData
+	{
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		bool hasNormals = false;
+		bool hasUVs = false;
+	};
+
+	/** @brief One level of detail: a range of the shared index buffer. */
+	struct MeshLod
+	{
+		uint32_t firstIndex = 0;
+		uint32_t indexCount = 0;
+		float error = 0.0f;        // deviation from LOD 0, relative to the mesh's bounding box diagonal
+		uint32_t reserved = 0;
+	};
+
+	/**
+	 * @brief Mesh artifact layout, version 1. All values little-endian.
+	 *
+	 *   MeshArtifactHeader
+	 *   MeshLod[lodCount]          LOD 0 first
+	 *   MeshVertex[vertexCount]    shared by every LOD
+	 *   indices                    uint16 when every vertex fits, uint32 otherwise
+	 *
+	 * Sections start 16-byte aligned; the file is meant to be mapped and uploaded as-is.
+	 */
+	struct MeshArtifactHeader
+	{
+		static constexpr uint32_t kMagic = 0x48534D4F;   // "OMSH"
+		static constexpr uint32_t kVersion = 1;
+
+		uint32_t magic = kMagic;
+		uint32_t version = kVersion;
+		uint32_t vertexCount = 0;
+		uint32_t indexCount = 0;    // all LODs
+		uint32_t lodCount = 0;
+		uint32_t indexSize = 4;
+		uint32_t vertexOffset = 0;
+		uint32_t indexOffset = 0;
+		float boundsMin[3] = {};
+		float boundsMax[3] = {};
+	};
+
+	static_assert(sizeof(MeshArtifactHeader) == 56, "MeshArtifactHeader is part of the file format");
+	static_assert(sizeof(MeshLod) == 16, "MeshLod is part of the file format");
+	static_assert(sizeof(MeshVertex) == 32, "MeshVertex is part of the file format");
+
+	/** @brief Fills in area-weighted smooth normals for meshes that came without them. */
+	void ComputeNormals(MeshData& mesh);
+
+	/**
+	 * @brief Writes the mesh with the given LODs. Each LOD is a triangle list over mesh.vertices;
+	 *        the first one is normally mesh.indices itself.
+	 */
+	bool WriteMeshArtifact(const MeshData& mesh, const std::vector<std::vector<uint32_t>>& lodIndices,
+		const std::vector<float>& lodErrors, const std::function<bool(const char* data, size_t size)>& sink);
+
+	/** @brief Checked, zero-copy view of a mesh artifact in memory. */
+	class MeshArtifactView
+	{
+	public:
+		bool Open(const char* data, size_t size, std::string* error = nullptr);
+
+		const MeshArtifactHeader& Header() const { return m_header; }
+		uint32_t LodCount() const { return m_header.lodCount; }
+		const MeshLod& Lod(uint32_t lod) const { return m_lods[lod]; }
+		const MeshVertex* Vertices() const { return reinterpret_cast<const MeshVertex*>(m_data + m_header.vertexOffset); }
+		const char* Indices() const { return m_data + m_header.indexOffset; }
+
+	private:
+		const char* m_data = nullptr;
+		MeshArtifactHeader m_header;
+		std::vector<MeshLod> m_lods;
+	};
+}
+
+#endif
\ No newline at end of file
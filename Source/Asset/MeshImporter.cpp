@@ -0,0 +1,580 @@
+#include "MeshImporter.h"
+#include "MeshArtifact.h"
+#include "MeshSimplifier.h"
+#include "ObjParser.h"
+#include "ParallelFor.h"
+#include "../Core/EditorLog.h"
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QUrl>
+#include <QtGui/QMatrix4x4>
+#include <QtGui/QQuaternion>
+#include <QtGui/QVector3D>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace Orca
+{
+	namespace
+	{
+		// Importers already run side by side on the database's pool; this only splits one large file.
+		constexpr unsigned kMaxImportThreads = 4;
+
+		constexpr uint32_t kGlbMagic = 0x46546C67;      // "glTF"
+		constexpr uint32_t kGlbJsonChunk = 0x4E4F534A;  // "JSON"
+		constexpr uint32_t kGlbBinChunk = 0x004E4942;   // "BIN\0"
+		constexpr int kMaxNodeDepth = 128;
+
+		constexpr int kComponentUnsignedByte = 5121;
+		constexpr int kComponentUnsignedShort = 5123;
+		constexpr int kComponentUnsignedInt = 5125;
+		constexpr int kComponentFloat = 5126;
+		constexpr int kModeTriangles = 4;
+
+		struct GltfFile
+		{
+			QJsonObject root;
+			std::vector<QByteArray> buffers;
+		};
+
+		struct PrimitiveInstance
+		{
+			QJsonObject primitive;
+			QMatrix4x4 world;
+		};
+
+		uint32_t ReadU32(const char* p)
+		{
+			uint32_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		bool LoadGltf(const AssetImportContext& context, GltfFile& file, QString& error)
+		{
+			QByteArray json;
+			QByteArray binChunk;
+			if (context.size >= 12 && ReadU32(context.data) == kGlbMagic)
+			{
+				const size_t length = std::min<size_t>(ReadU32(context.data + 8), context.size);
+				size_t offset = 12;
+				while (offset + 8 <= length)
+				{
+					const uint32_t chunkLength = ReadU32(context.data + offset);
+					const uint32_t chunkType = ReadU32(context.data + offset + 4);
+					offset += 8;
+					if (chunkLength > length - offset)
+					{
+						error = "GLB chunk is out of bounds";
+						return false;
+					}
+					if (chunkType == kGlbJsonChunk && json.isEmpty()) json = QByteArray(context.data + offset, static_cast<qsizetype>(chunkLength));
+					else if (chunkType == kGlbBinChunk && binChunk.isEmpty()) binChunk = QByteArray(context.data + offset, static_cast<qsizetype>(chunkLength));
+					offset += (chunkLength + 3u) & ~3u;
+				}
+			}
+			else
+			{
+				json = QByteArray::fromRawData(context.data, static_cast<qsizetype>(context.size));
+			}
+
+			QJsonParseError parseError;
+			const QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+			if (!document.isObject())
+			{
+				error = json.isEmpty() ? QString("GLB file has no JSON chunk") : QString("Invalid glTF JSON: %1").arg(parseError.errorString());
+				return false;
+			}
+			file.root = document.object();
+			if (!file.root.value("asset").toObject().value("version").toString().startsWith("2."))
+			{
+				error = "Only glTF 2.0 is supported";
+				return false;
+			}
+
+			const QDir directory = QFileInfo(context.sourcePath).dir();
+			const QJsonArray buffers = file.root.value("buffers").toArray();
+			for (qsizetype i = 0; i < buffers.size(); ++i)
+			{
+				const QJsonObject buffer = buffers[i].toObject();
+				const QString uri = buffer.value("uri").toString();
+				QByteArray bytes;
+				if (uri.isEmpty())
+				{
+					if (i != 0 || binChunk.isNull())
+					{
+						error = QString("Buffer %1 has no data").arg(i);
+						return false;
+					}
+					bytes = binChunk;
+				}
+				else if (uri.startsWith("data:"))
+				{
+					const qsizetype comma = uri.indexOf(',');
+					if (comma < 0 || !uri.left(comma).endsWith(";base64"))
+					{
+						error = QString("Buffer %1 has an unsupported data URI").arg(i);
+						return false;
+					}
+					bytes = QByteArray::fromBase64(uri.mid(comma + 1).toLatin1());
+				}
+				else
+				{
+					QFile external(directory.filePath(QUrl::fromPercentEncoding(uri.toUtf8())));
+					if (!external.open(QIODevice::ReadOnly))
+					{
+						error = QString("Could not open buffer %1").arg(uri);
+						return false;
+					}
+					bytes = external.readAll();
+				}
+
+				if (bytes.size() < buffer.value("byteLength").toInteger())
+				{
+					error = QString("Buffer %1 is shorter than its byteLength").arg(i);
+					return false;
+				}
+				file.buffers.push_back(std::move(bytes));
+			}
+			return true;
+		}
+
+		/** @brief Bounds-checked location of an accessor's elements. */
+		struct AccessorView
+		{
+			const char* data = nullptr;
+			size_t count = 0;
+			size_t stride = 0;
+			int components = 0;
+			int componentType = 0;
+			bool normalized = false;
+		};
+
+		int ComponentCount(const QString& type)
+		{
+			if (type == "SCALAR") return 1;
+			if (type == "VEC2") return 2;
+			if (type == "VEC3") return 3;
+			if (type == "VEC4") return 4;
+			return 0;
+		}
+
+		size_t ComponentSize(int componentType)
+		{
+			switch (componentType)
+			{
+			case kComponentUnsignedByte: return 1;
+			case kComponentUnsignedShort: return 2;
+			case kComponentUnsignedInt:
+			case kComponentFloat: return 4;
+			default: return 0;
+			}
+		}
+
+		bool OpenAccessor(const GltfFile& file, int index, AccessorView& view, QString& error)
+		{
+			const QJsonArray accessors = file.root.value("accessors").toArray();
+			if (index < 0 || index >= accessors.size())
+			{
+				error = QString("Accessor %1 does not exist").arg(index);
+				return false;
+			}
+			const QJsonObject accessor = accessors[index].toObject();
+			if (accessor.contains("sparse") || !accessor.contains("bufferView"))
+			{
+				error = QString("Accessor %1 is sparse or has no buffer view, which is not supported").arg(index);
+				return false;
+			}
+
+			view.count = static_cast<size_t>(accessor.value("count").toInteger());
+			view.components = ComponentCount(accessor.value("type").toString());
+			view.componentType = accessor.value("componentType").toInt();
+			view.normalized = accessor.value("normalized").toBool();
+			const size_t elementSize = ComponentSize(view.componentType) * static_cast<size_t>(view.components);
+			if (elementSize == 0 || view.count > UINT32_MAX)
+			{
+				error = QString("Accessor %1 has an unsupported type or count").arg(index);
+				return false;
+			}
+
+			const QJsonArray bufferViews = file.root.value("bufferViews").toArray();
+			const int viewIndex = accessor.value("bufferView").toInt(-1);
+			if (viewIndex < 0 || viewIndex >= bufferViews.size())
+			{
+				error = QString("Accessor %1 refers to a missing buffer view").arg(index);
+				return false;
+			}
+			const QJsonObject bufferView = bufferViews[viewIndex].toObject();
+			const int bufferIndex = bufferView.value("buffer").toInt(-1);
+			if (bufferIndex < 0 || static_cast<size_t>(bufferIndex) >= file.buffers.size())
+			{
+				error = QString("Buffer view %1 refers to a missing buffer").arg(viewIndex);
+				return false;
+			}
+
+			const QByteArray& buffer = file.buffers[static_cast<size_t>(bufferIndex)];
+			const int64_t viewOffset = bufferView.value("byteOffset").toInteger();
+			const int64_t viewLength = bufferView.value("byteLength").toInteger();
+			const int64_t accessorOffset = accessor.value("byteOffset").toInteger();
+			view.stride = static_cast<size_t>(bufferView.value("byteStride").toInteger(static_cast<qint64>(elementSize)));
+			const int64_t needed = view.count == 0 ? 0 : accessorOffset + static_cast<int64_t>((view.count - 1) * view.stride + elementSize);
+			if (viewOffset < 0 || viewLength < 0 || accessorOffset < 0 || view.stride < elementSize
+				|| viewOffset + viewLength > buffer.size() || needed > viewLength)
+			{
+				error = QString("Accessor %1 is out of bounds").arg(index);
+				return false;
+			}
+			view.data = buffer.constData() + viewOffset + accessorOffset;
+			return true;
+		}
+
+		float ReadComponent(const AccessorView& view, const char* p)
+		{
+			switch (view.componentType)
+			{
+			case kComponentFloat:
+			{
+				float value;
+				std::memcpy(&value, p, sizeof(value));
+				return value;
+			}
+			case kComponentUnsignedByte: return view.normalized ? static_cast<uint8_t>(*p) / 255.0f : static_cast<uint8_t>(*p);
+			case kComponentUnsignedShort:
+			{
+				uint16_t value;
+				std::memcpy(&value, p, sizeof(value));
+				return view.normalized ? value / 65535.0f : value;
+			}
+			default: return 0.0f;
+			}
+		}
+
+		uint32_t ReadIndex(const AccessorView& view, const char* p)
+		{
+			switch (view.componentType)
+			{
+			case kComponentUnsignedByte: return static_cast<uint8_t>(*p);
+			case kComponentUnsignedShort:
+			{
+				uint16_t value;
+				std::memcpy(&value, p, sizeof(value));
+				return value;
+			}
+			default: return ReadU32(p);
+			}
+		}
+
+		bool DecodePrimitive(const GltfFile& file, const PrimitiveInstance& instance, MeshData& mesh, QString& error)
+		{
+			const QJsonObject attributes = instance.primitive.value("attributes").toObject();
+			AccessorView positions;
+			if (!OpenAccessor(file, attributes.value("POSITION").toInt(-1), positions, error)) return false;
+			if (positions.components != 3 || positions.componentType != kComponentFloat)
+			{
+				error = "POSITION must be a float VEC3";
+				return false;
+			}
+
+			AccessorView normals;
+			AccessorView uvs;
+			mesh.hasNormals = attributes.contains("NORMAL");
+			mesh.hasUVs = attributes.contains("TEXCOORD_0");
+			if (mesh.hasNormals && (!OpenAccessor(file, attributes.value("NORMAL").toInt(-1), normals, error) || normals.count != positions.count)) return false;
+			if (mesh.hasUVs && (!OpenAccessor(file, attributes.value("TEXCOORD_0").toInt(-1), uvs, error) || uvs.count != positions.count)) return false;
+
+			const size_t componentSize = ComponentSize(kComponentFloat);
+			const QMatrix3x3 normalMatrix = instance.world.normalMatrix();
+			mesh.vertices.resize(positions.count);
+			for (size_t v = 0; v < positions.count; ++v)
+			{
+				MeshVertex& vertex = mesh.vertices[v];
+				const char* p = positions.data + v * positions.stride;
+				const QVector3D position = instance.world.map(QVector3D(ReadComponent(positions, p), ReadComponent(positions, p + componentSize), ReadComponent(positions, p + 2 * componentSize)));
+				vertex.position[0] = position.x();
+				vertex.position[1] = position.y();
+				vertex.position[2] = position.z();
+
+				vertex.normal[0] = vertex.normal[1] = vertex.normal[2] = 0.0f;
+				if (mesh.hasNormals)
+				{
+					const size_t size = ComponentSize(normals.componentType);
+					const char* n = normals.data + v * normals.stride;
+					const float local[3] = { ReadComponent(normals, n), ReadComponent(normals, n + size), ReadComponent(normals, n + 2 * size) };
+					QVector3D normal;
+					for (int row = 0; row < 3; ++row)
+					{
+						normal[row] = normalMatrix(row, 0) * local[0] + normalMatrix(row, 1) * local[1] + normalMatrix(row, 2) * local[2];
+					}
+					normal.normalize();
+					vertex.normal[0] = normal.x();
+					vertex.normal[1] = normal.y();
+					vertex.normal[2] = normal.z();
+				}
+
+				vertex.uv[0] = vertex.uv[1] = 0.0f;
+				if (mesh.hasUVs)
+				{
+					const char* t = uvs.data + v * uvs.stride;
+					vertex.uv[0] = ReadComponent(uvs, t);
+					vertex.uv[1] = ReadComponent(uvs, t + ComponentSize(uvs.componentType));
+				}
+			}
+
+			if (instance.primitive.contains("indices"))
+			{
+				AccessorView indices;
+				if (!OpenAccessor(file, instance.primitive.value("indices").toInt(-1), indices, error)) return false;
+				if (indices.components != 1 || indices.componentType == kComponentFloat)
+				{
+					error = "Indices must be unsigned integer scalars";
+					return false;
+				}
+				mesh.indices.resize(indices.count - indices.count % 3);
+				for (size_t i = 0; i < mesh.indices.size(); ++i)
+				{
+					mesh.indices[i] = ReadIndex(indices, indices.data + i * indices.stride);
+					if (mesh.indices[i] >= positions.count)
+					{
+						error = "Index refers past the last vertex";
+						return false;
+					}
+				}
+			}
+			else
+			{
+				mesh.indices.resize(positions.count - positions.count % 3);
+				for (size_t i = 0; i < mesh.indices.size(); ++i) mesh.indices[i] = static_cast<uint32_t>(i);
+			}
+
+			// A mirroring transform turns the triangles inside out.
+			if (instance.world.determinant() < 0.0)
+			{
+				for (size_t i = 0; i < mesh.indices.size(); i += 3) std::swap(mesh.indices[i + 1], mesh.indices[i + 2]);
+			}
+
+			if (!mesh.hasNormals) ComputeNormals(mesh);
+			return true;
+		}
+
+		QMatrix4x4 NodeTransform(const QJsonObject& node)
+		{
+			QMatrix4x4 transform;
+			const QJsonArray matrix = node.value("matrix").toArray();
+			if (matrix.size() == 16)
+			{
+				// glTF stores column-major; QMatrix4x4 reads row-major.
+				float values[16];
+				for (int i = 0; i < 16; ++i) values[i] = static_cast<float>(matrix[i].toDouble());
+				return QMatrix4x4(values).transposed();
+			}
+
+			const QJsonArray translation = node.value("translation").toArray();
+			const QJsonArray rotation = node.value("rotation").toArray();
+			const QJsonArray scale = node.value("scale").toArray();
+			if (translation.size() == 3) transform.translate(translation[0].toDouble(), translation[1].toDouble(), translation[2].toDouble());
+			if (rotation.size() == 4) transform.rotate(QQuaternion(rotation[3].toDouble(), rotation[0].toDouble(), rotation[1].toDouble(), rotation[2].toDouble()).normalized());
+			if (scale.size() == 3) transform.scale(scale[0].toDouble(), scale[1].toDouble(), scale[2].toDouble());
+			return transform;
+		}
+
+		bool CollectPrimitives(const GltfFile& file, int nodeIndex, const QMatrix4x4& parent, int depth,
+			std::vector<PrimitiveInstance>& instances, size_t& skipped, QString& error)
+		{
+			const QJsonArray nodes = file.root.value("nodes").toArray();
+			if (nodeIndex < 0 || nodeIndex >= nodes.size() || depth > kMaxNodeDepth)
+			{
+				error = depth > kMaxNodeDepth ? QString("Node hierarchy is too deep or cyclic") : QString("Node %1 does not exist").arg(nodeIndex);
+				return false;
+			}
+
+			const QJsonObject node = nodes[nodeIndex].toObject();
+			const QMatrix4x4 world = parent * NodeTransform(node);
+			if (node.contains("mesh"))
+			{
+				const QJsonArray meshes = file.root.value("meshes").toArray();
+				const int meshIndex = node.value("mesh").toInt(-1);
+				if (meshIndex < 0 || meshIndex >= meshes.size())
+				{
+					error = QString("Node %1 refers to a missing mesh").arg(nodeIndex);
+					return false;
+				}
+				for (const QJsonValue primitive : meshes[meshIndex].toObject().value("primitives").toArray())
+				{
+					if (primitive.toObject().value("mode").toInt(kModeTriangles) != kModeTriangles)
+					{
+						++skipped;
+						continue;
+					}
+					instances.push_back({ primitive.toObject(), world });
+				}
+			}
+
+			for (const QJsonValue child : node.value("children").toArray())
+			{
+				if (!CollectPrimitives(file, child.toInt(-1), world, depth + 1, instances, skipped, error)) return false;
+			}
+			return true;
+		}
+
+		bool ParseGltf(const AssetImportContext& context, MeshData& mesh, QString& error)
+		{
+			GltfFile file;
+			if (!LoadGltf(context, file, error)) return false;
+
+			// The default scene, or every root node when the file names none.
+			QJsonArray roots;
+			const QJsonArray scenes = file.root.value("scenes").toArray();
+			const int scene = file.root.value("scene").toInt(0);
+			if (scene >= 0 && scene < scenes.size())
+			{
+				roots = scenes[scene].toObject().value("nodes").toArray();
+			}
+			else
+			{
+				const QJsonArray nodes = file.root.value("nodes").toArray();
+				std::vector<bool> isChild(static_cast<size_t>(nodes.size()), false);
+				for (const QJsonValue node : nodes)
+				{
+					for (const QJsonValue child : node.toObject().value("children").toArray())
+					{
+						const int index = child.toInt(-1);
+						if (index >= 0 && index < nodes.size()) isChild[static_cast<size_t>(index)] = true;
+					}
+				}
+				for (qsizetype i = 0; i < nodes.size(); ++i)
+				{
+					if (!isChild[static_cast<size_t>(i)]) roots.append(static_cast<int>(i));
+				}
+			}
+
+			std::vector<PrimitiveInstance> instances;
+			size_t skipped = 0;
+			for (const QJsonValue root : roots)
+			{
+				if (!CollectPrimitives(file, root.toInt(-1), QMatrix4x4(), 0, instances, skipped, error)) return false;
+			}
+			if (instances.empty())
+			{
+				error = skipped ? QString("glTF file has only point or line primitives") : QString("glTF file has no meshes");
+				return false;
+			}
+			if (skipped) ORCA_LOG_WARNING("Assets", "{}: skipped {} non-triangle primitives", context.assetPath, skipped);
+
+			std::vector<MeshData> parts(instances.size());
+			std::vector<QString> errors(instances.size());
+			ParallelFor(instances.size(), [&](size_t i) { DecodePrimitive(file, instances[i], parts[i], errors[i]); }, kMaxImportThreads);
+
+			size_t vertexCount = 0;
+			size_t indexCount = 0;
+			for (size_t i = 0; i < parts.size(); ++i)
+			{
+				if (!errors[i].isEmpty())
+				{
+					error = errors[i];
+					return false;
+				}
+				vertexCount += parts[i].vertices.size();
+				indexCount += parts[i].indices.size();
+			}
+			if (vertexCount > UINT32_MAX)
+			{
+				error = "Mesh has too many vertices";
+				return false;
+			}
+
+			mesh = MeshData();
+			mesh.vertices.reserve(vertexCount);
+			mesh.indices.reserve(indexCount);
+			mesh.hasNormals = true;
+			for (const MeshData& part : parts)
+			{
+				const uint32_t base = static_cast<uint32_t>(mesh.vertices.size());
+				mesh.vertices.insert(mesh.vertices.end(), part.vertices.begin(), part.vertices.end());
+				for (uint32_t index : part.indices) mesh.indices.push_back(base + index);
+				mesh.hasUVs = mesh.hasUVs || part.hasUVs;
+			}
+			return true;
+		}
+	}
+
+	bool MeshImporter::Import(const AssetImportContext& context, QByteArray& artifact, QString& error) const
+	{
+		QElapsedTimer timer;
+		timer.start();
+
+		MeshData mesh;
+		const QString format = QFileInfo(context.assetPath).suffix().toLower();
+		if (format == "obj")
+		{
+			std::string parseError;
+			if (!ParseObj(context.data, context.size, mesh, &parseError, kMaxImportThreads))
+			{
+				error = QString("Invalid OBJ file: %1").arg(QString::fromStdString(parseError));
+				return false;
+			}
+		}
+		else if (!ParseGltf(context, mesh, error))
+		{
+			return false;
+		}
+
+		if (mesh.indices.empty())
+		{
+			error = "Mesh has no triangles";
+			return false;
+		}
+		const qint64 parseMs = timer.restart();
+
+		std::vector<float> ratios;
+		if (context.settings.contains("LodRatios"))
+		{
+			for (const QJsonValue ratio : context.settings.value("LodRatios").toArray()) ratios.push_back(static_cast<float>(ratio.toDouble()));
+		}
+		else
+		{
+			ratios = { 0.5f, 0.25f, 0.125f };
+		}
+		const float maxError = static_cast<float>(context.settings.value("LodMaxError").toDouble(0.01));
+
+		// Each LOD is simplified from the one before it, which is far cheaper than starting over
+		// from LOD 0; the recorded error adds up the steps, so it is an upper bound.
+		std::vector<std::vector<uint32_t>> lods;
+		std::vector<float> errors{ 0.0f };
+		lods.push_back(std::move(mesh.indices));
+		const size_t triangleCount = lods.front().size() / 3;
+		for (float ratio : ratios)
+		{
+			if (lods.size() >= 32 || ratio <= 0.0f || ratio >= 1.0f) break;
+
+			float reached = 0.0f;
+			std::vector<uint32_t> next = SimplifyMesh(mesh.vertices, lods.back(), static_cast<size_t>(triangleCount * ratio) * 3, maxError, &reached);
+			if (next.empty() || next.size() * 10 > lods.back().size() * 9) break;
+
+			errors.push_back(errors.back() + reached);
+			lods.push_back(std::move(next));
+		}
+		const qint64 lodMs = timer.elapsed();
+
+		const bool written = WriteMeshArtifact(mesh, lods, errors, [&artifact](const char* data, size_t size)
+		{
+			artifact.append(data, static_cast<qsizetype>(size));
+			return true;
+		});
+		if (!written)
+		{
+			error = "Mesh is too large for the artifact format";
+			return false;
+		}
+
+		QStringList triangles;
+		for (const std::vector<uint32_t>& lod : lods) triangles.append(QString::number(lod.size() / 3));
+		ORCA_LOG_INFO("Assets", "Imported mesh {}: {} vertices, {} triangles per LOD, parsed in {} ms, LODs in {} ms",
+			context.assetPath, mesh.vertices.size(), triangles.join(" / "), parseMs, lodMs);
+		return true;
+	}
+}
\ No newline at end of file
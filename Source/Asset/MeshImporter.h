@@ -0,0 +1,29 @@
+#pragma once
+
+#ifndef MESH_IMPORTER_H
+#define MESH_IMPORTER_H
+
+#include "AssetImporter.h"
+
+namespace Orca
+{
+	/**
+	 * @brief Imports OBJ and glTF 2.0 (.gltf and .glb) geometry as mesh artifacts (see MeshArtifact.h),
+	 *        flattened into one mesh with a chain of simplified LODs.
+	 *
+	 * .meta "Settings": "LodRatios" (default [0.5, 0.25, 0.125], triangle counts relative to LOD 0)
+	 * and "LodMaxError" (default 0.01 of the bounding box diagonal). LOD generation stops early
+	 * once a level no longer gets meaningfully smaller.
+	 */
+	class MeshImporter : public AssetImporter
+	{
+	public:
+		QString Name() const override { return "Mesh"; }
+		uint32_t Version() const override { return 1; }
+		QStringList Extensions() const override { return { "obj", "gltf", "glb" }; }
+
+		bool Import(const AssetImportContext& context, QByteArray& artifact, QString& error) const override;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Orca
+{
+	namespace
+	{
+		/** @brief Sum of squared distances to a set of planes, weighted by triangle area. */
+		struct Quadric
+		{
+			double a2 = 0, b2 = 0, c2 = 0, d2 = 0;
+			double ab = 0, ac = 0, ad = 0, bc = 0, bd = 0, cd = 0;
+			double weight = 0;
+
+			static Quadric FromPlane(double a, double b, double c, double d, double w)
+			{
+				Quadric q;
+				q.a2 = a * a * w; q.b2 = b * b * w; q.c2 = c * c * w; q.d2 = d * d * w;
+				q.ab = a * b * w; q.ac = a * c * w; q.ad = a * d * w;
+				q.bc = b * c * w; q.bd = b * d * w; q.cd = c * d * w;
+				q.weight = w;
+				return q;
+			}
+
+			void Add(const Quadric& o)
+			{
+				a2 += o.a2; b2 += o.b2; c2 += o.c2; d2 += o.d2;
+				ab += o.ab; ac += o.ac; ad += o.ad; bc += o.bc; bd += o.bd; cd += o.cd;
+				weight += o.weight;
+			}
+
+			/** @brief Mean squared distance of p to the planes. */
+			double Error(const double* p) const
+			{
+				const double x = p[0], y = p[1], z = p[2];
+				const double sum = a2 * x * x + b2 * y * y + c2 * z * z + d2
+					+ 2.0 * (ab * x * y + ac * x * z + bc * y * z + ad * x + bd * y + cd * z);
+				return weight > 0.0 ? std::max(0.0, sum / weight) : 0.0;
+			}
+		};
+
+		struct Collapse
+		{
+			uint32_t from;
+			uint32_t to;
+			double error;
+		};
+
+		struct PositionKey
+		{
+			float p[3];
+			bool operator==(const PositionKey& o) const { return std::memcmp(p, o.p, sizeof(p)) == 0; }
+		};
+
+		struct PositionKeyHash
+		{
+			size_t operator()(const PositionKey& key) const
+			{
+				uint32_t bits[3];
+				std::memcpy(bits, key.p, sizeof(bits));
+				return static_cast<size_t>((bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u));
+			}
+		};
+
+		void Cross(const double* a, const double* b, const double* c, double* n)
+		{
+			const double e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+			const double e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+			n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+			n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+			n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+		}
+	}
+
+	std::vector<uint32_t> SimplifyMesh(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices,
+		size_t targetIndexCount, float maxError, float* resultError)
+	{
+		std::vector<uint32_t> result = indices;
+		if (resultError) *resultError = 0.0f;
+		if (vertices.empty() || result.size() <= targetIndexCount) return result;
+
+		const size_t vertexCount = vertices.size();
+
+		// Work in units of the bounding box diagonal, so errors are comparable between meshes.
+		double lo[3] = { HUGE_VAL, HUGE_VAL, HUGE_VAL };
+		double hi[3] = { -HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+		for (const MeshVertex& vertex : vertices)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				lo[k] = std::min<double>(lo[k], vertex.position[k]);
+				hi[k] = std::max<double>(hi[k], vertex.position[k]);
+			}
+		}
+		const double diagonal = std::sqrt((hi[0] - lo[0]) * (hi[0] - lo[0]) + (hi[1] - lo[1]) * (hi[1] - lo[1]) + (hi[2] - lo[2]) * (hi[2] - lo[2]));
+		const double scale = diagonal > 0.0 ? 1.0 / diagonal : 1.0;
+
+		std::vector<double> positions(vertexCount * 3);
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			for (int k = 0; k < 3; ++k) positions[v * 3 + k] = (vertices[v].position[k] - lo[k]) * scale;
+		}
+
+		// Vertices that share a position (attribute seams) are treated as one point.
+		std::vector<uint32_t> canonical(vertexCount);
+		std::vector<uint32_t> wedges(vertexCount, 0);
+		{
+			std::unordered_map<PositionKey, uint32_t, PositionKeyHash> firstAt;
+			firstAt.reserve(vertexCount);
+			for (size_t v = 0; v < vertexCount; ++v)
+			{
+				PositionKey key;
+				std::memcpy(key.p, vertices[v].position, sizeof(key.p));
+				canonical[v] = firstAt.emplace(key, static_cast<uint32_t>(v)).first->second;
+				++wedges[canonical[v]];
+			}
+		}
+
+		std::vector<uint8_t> locked(vertexCount, 0);
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			if (wedges[canonical[v]] > 1) locked[canonical[v]] = 1;
+		}
+
+		// An edge with no opposite half-edge is on an open border.
+		{
+			std::unordered_set<uint64_t> halfEdges;
+			halfEdges.reserve(result.size());
+			auto edgeKey = [](uint32_t a, uint32_t b) { return static_cast<uint64_t>(a) << 32 | b; };
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				for (int e = 0; e < 3; ++e)
+				{
+					halfEdges.insert(edgeKey(canonical[result[i + e]], canonical[result[i + (e + 1) % 3]]));
+				}
+			}
+			for (uint64_t edge : halfEdges)
+			{
+				const uint32_t a = static_cast<uint32_t>(edge >> 32);
+				const uint32_t b = static_cast<uint32_t>(edge);
+				if (!halfEdges.count(edgeKey(b, a))) locked[a] = locked[b] = 1;
+			}
+		}
+
+		std::vector<Quadric> quadrics(vertexCount);
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			const double* p0 = &positions[result[i] * 3ull];
+			double n[3];
+			Cross(p0, &positions[result[i + 1] * 3ull], &positions[result[i + 2] * 3ull], n);
+			const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			if (length <= 0.0) continue;
+
+			for (double& component : n) component /= length;
+			const double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+			const Quadric plane = Quadric::FromPlane(n[0], n[1], n[2], d, length * 0.5);
+			for (int c = 0; c < 3; ++c) quadrics[canonical[result[i + c]]].Add(plane);
+		}
+
+		const double maxErrorSquared = static_cast<double>(maxError) * maxError;
+		double reached = 0.0;
+
+		std::vector<uint32_t> triangleStart(vertexCount + 1);
+		std::vector<uint32_t> trianglesOf;
+		std::vector<Collapse> collapses;
+		std::vector<uint32_t> remap(vertexCount);
+		std::vector<uint8_t> touched(vertexCount);
+
+		while (result.size() > targetIndexCount)
+		{
+			const size_t triangleCount = result.size() / 3;
+
+			// Triangles around each vertex, as a counting sort.
+			std::fill(triangleStart.begin(), triangleStart.end(), 0);
+			for (uint32_t index : result) ++triangleStart[index + 1];
+			for (size_t v = 0; v < vertexCount; ++v) triangleStart[v + 1] += triangleStart[v];
+			trianglesOf.resize(result.size());
+			{
+				std::vector<uint32_t> cursor(triangleStart.begin(), triangleStart.end() - 1);
+				for (size_t i = 0; i < result.size(); ++i) trianglesOf[cursor[result[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+
+			// Only single-wedge vertices collapse, so a vertex and its canonical point are the same.
+			// Each edge is considered once, from its half-edge with a < b (border edges have both
+			// ends locked, so losing their other half costs nothing), in the cheaper direction.
+			collapses.clear();
+			for (size_t i = 0; i < result.size(); i += 3)
+			{
+				for (int e = 0; e < 3; ++e)
+				{
+					const uint32_t a = result[i + e];
+					const uint32_t b = result[i + (e + 1) % 3];
+					if (a > b || (locked[a] && locked[b])) continue;
+					if (wedges[canonical[a]] > 1 || wedges[canonical[b]] > 1) continue;
+
+					Quadric combined = quadrics[a];
+					combined.Add(quadrics[b]);
+					const double toB = locked[a] ? HUGE_VAL : combined.Error(&positions[b * 3ull]);
+					const double toA = locked[b] ? HUGE_VAL : combined.Error(&positions[a * 3ull]);
+					const Collapse collapse = toB <= toA ? Collapse{ a, b, toB } : Collapse{ b, a, toA };
+					if (collapse.error <= maxErrorSquared) collapses.push_back(collapse);
+				}
+			}
+			if (collapses.empty()) break;
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.error < y.error; });
+
+			for (size_t v = 0; v < vertexCount; ++v) remap[v] = static_cast<uint32_t>(v);
+			std::fill(touched.begin(), touched.end(), 0);
+
+			const size_t trianglesToRemove = (result.size() - targetIndexCount + 2) / 3;
+			size_t removed = 0;
+			size_t applied = 0;
+			for (const Collapse& collapse : collapses)
+			{
+				if (removed >= trianglesToRemove) break;
+				if (touched[collapse.from] || touched[collapse.to]) continue;
+
+				// Reject collapses that flip or squash a surviving triangle around `from`.
+				bool valid = true;
+				size_t shared = 0;
+				for (uint32_t k = triangleStart[collapse.from]; k < triangleStart[collapse.from + 1] && valid; ++k)
+				{
+					const uint32_t* triangle = &result[trianglesOf[k] * 3ull];
+					if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+					{
+						++shared;
+						continue;
+					}
+
+					const double* before[3];
+					const double* after[3];
+					for (int c = 0; c < 3; ++c)
+					{
+						before[c] = &positions[triangle[c] * 3ull];
+						after[c] = triangle[c] == collapse.from ? &positions[collapse.to * 3ull] : before[c];
+					}
+					double n0[3], n1[3];
+					Cross(before[0], before[1], before[2], n0);
+					Cross(after[0], after[1], after[2], n1);
+					const double dot = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+					const double lengths = std::sqrt((n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2]) * (n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2]));
+					valid = lengths > 0.0 && dot >= 0.25 * lengths;
+				}
+				if (!valid || shared == 0) continue;
+
+				// Everything around `from` is frozen for this pass, which keeps the checks above valid.
+				for (uint32_t k = triangleStart[collapse.from]; k < triangleStart[collapse.from + 1]; ++k)
+				{
+					const uint32_t* triangle = &result[trianglesOf[k] * 3ull];
+					for (int c = 0; c < 3; ++c) touched[triangle[c]] = 1;
+				}
+
+				remap[collapse.from] = collapse.to;
+				quadrics[collapse.to].Add(quadrics[collapse.from]);
+				removed += shared;
+				reached = std::max(reached, collapse.error);
+				++applied;
+			}
+			if (applied == 0) break;
+
+			size_t write = 0;
+			for (size_t t = 0; t < triangleCount; ++t)
+			{
+				const uint32_t a = remap[result[t * 3]];
+				const uint32_t b = remap[result[t * 3 + 1]];
+				const uint32_t c = remap[result[t * 3 + 2]];
+				if (a == b || b == c || a == c) continue;
+				result[write++] = a;
+				result[write++] = b;
+				result[write++] = c;
+			}
+			result.resize(write);
+		}
+
+		if (resultError) *resultError = static_cast<float>(std::sqrt(reached));
+		return result;
+	}
+}
\ No newline at end of file
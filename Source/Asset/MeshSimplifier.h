@@ -0,0 +1,28 @@
+#pragma once
+
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include "MeshArtifact.h"
+#include <vector>
+
+namespace Orca
+{
+	/**
+	 * @brief Reduces a triangle list by quadric-error edge collapse (Garland & Heckbert).
+	 *
+	 * Vertices are collapsed onto their neighbours rather than moved, so every LOD can share
+	 * the original vertex buffer. Vertices on open borders and on attribute seams (several
+	 * vertices at one position) stay where they are, which keeps outlines and UV layouts intact
+	 * at the cost of simplifying those regions less.
+	 *
+	 * @param targetIndexCount Stops once the result has this many indices or fewer.
+	 * @param maxError Largest allowed deviation, relative to the bounding box diagonal.
+	 * @param resultError Receives the deviation actually reached, on the same scale.
+	 * @return The simplified triangle list; the input unchanged when nothing could be collapsed.
+	 */
+	std::vector<uint32_t> SimplifyMesh(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices,
+		size_t targetIndexCount, float maxError, float* resultError = nullptr);
+}
+
+#endif
\ No newline at end of file
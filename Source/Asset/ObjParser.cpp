@@ -0,0 +1,281 @@
+#include "ObjParser.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr size_t kMinRangeBytes = 1 << 20;
+
+		// Position, texture coordinate and normal references of one face corner; -1 when absent.
+		// A set bit in `relative` means the index counts from the start of its range and still
+		// needs the vertices of the preceding ranges added.
+		struct Corner
+		{
+			int32_t index[3] = { -1, -1, -1 };
+			uint8_t relative = 0;
+		};
+
+		struct RangeResult
+		{
+			std::vector<float> positions;   // 3 per vertex
+			std::vector<float> uvs;         // 2 per coordinate
+			std::vector<float> normals;     // 3 per normal
+			std::vector<Corner> corners;    // already triangulated, 3 per triangle
+			size_t lines = 0;
+			size_t errorLine = 0;           // 1-based within the range, 0 when there was no error
+			const char* error = nullptr;
+		};
+
+		bool IsSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
+
+		const char* SkipSpaces(const char* p, const char* end)
+		{
+			while (p < end && IsSpace(*p)) ++p;
+			return p;
+		}
+
+		bool ReadFloats(const char*& p, const char* end, float* out, int required, int count)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				p = SkipSpaces(p, end);
+				auto result = std::from_chars(p, end, out[i]);
+				if (result.ec != std::errc())
+				{
+					if (i < required) return false;
+					out[i] = 0.0f;
+					continue;
+				}
+				p = result.ptr;
+			}
+			return true;
+		}
+
+		bool ReadIndex(const char*& p, const char* end, size_t localCount, int32_t& index, bool& relative)
+		{
+			long long value = 0;
+			auto result = std::from_chars(p, end, value);
+			if (result.ec != std::errc() || value == 0) return false;
+			p = result.ptr;
+
+			// A relative index may reach back into earlier ranges, so it can be negative for now.
+			relative = value < 0;
+			index = static_cast<int32_t>(relative ? static_cast<long long>(localCount) + value : value - 1);
+			return true;
+		}
+
+		bool ParseFace(const char* p, const char* end, RangeResult& range)
+		{
+			const size_t counts[3] = { range.positions.size() / 3, range.uvs.size() / 2, range.normals.size() / 3 };
+
+			Corner first;
+			Corner previous;
+			int cornerCount = 0;
+			for (;;)
+			{
+				p = SkipSpaces(p, end);
+				if (p == end) break;
+
+				Corner corner;
+				for (int slot = 0; slot < 3; ++slot)
+				{
+					if (slot > 0)
+					{
+						if (p == end || *p != '/') break;
+						++p;
+						if (slot == 1 && p < end && *p == '/') continue;   // "v//vn"
+					}
+
+					bool relative = false;
+					if (!ReadIndex(p, end, counts[slot], corner.index[slot], relative)) return false;
+					if (relative) corner.relative |= static_cast<uint8_t>(1 << slot);
+				}
+				if (p < end && !IsSpace(*p)) return false;
+
+				if (cornerCount == 0) first = corner;
+				else if (cornerCount >= 2)
+				{
+					range.corners.push_back(first);
+					range.corners.push_back(previous);
+					range.corners.push_back(corner);
+				}
+				previous = corner;
+				++cornerCount;
+			}
+			return cornerCount >= 3;
+		}
+
+		void ParseRange(const char* begin, const char* end, RangeResult& range)
+		{
+			const char* line = begin;
+			while (line < end)
+			{
+				const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+				if (!lineEnd) lineEnd = end;
+				++range.lines;
+
+				const char* p = SkipSpaces(line, lineEnd);
+				if (lineEnd - p >= 2 && p[0] == 'v' && IsSpace(p[1]))
+				{
+					float position[3];
+					p += 2;
+					if (!ReadFloats(p, lineEnd, position, 3, 3)) range.error = "Invalid vertex position";
+					range.positions.insert(range.positions.end(), position, position + 3);
+				}
+				else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 't' && IsSpace(p[2]))
+				{
+					float uv[2];
+					p += 3;
+					if (!ReadFloats(p, lineEnd, uv, 1, 2)) range.error = "Invalid texture coordinate";
+					range.uvs.insert(range.uvs.end(), uv, uv + 2);
+				}
+				else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 'n' && IsSpace(p[2]))
+				{
+					float normal[3];
+					p += 3;
+					if (!ReadFloats(p, lineEnd, normal, 3, 3)) range.error = "Invalid normal";
+					range.normals.insert(range.normals.end(), normal, normal + 3);
+				}
+				else if (lineEnd - p >= 2 && p[0] == 'f' && IsSpace(p[1]))
+				{
+					if (!ParseFace(p + 2, lineEnd, range)) range.error = "Invalid face";
+				}
+
+				if (range.error)
+				{
+					range.errorLine = range.lines;
+					return;
+				}
+				line = lineEnd + 1;
+			}
+		}
+	}
+
+	bool ParseObj(const char* data, size_t size, MeshData& mesh, std::string* error, unsigned maxThreads)
+	{
+		mesh = MeshData();
+
+		// Split on line boundaries into ranges of at least kMinRangeBytes.
+		std::vector<const char*> bounds{ data };
+		const size_t rangeCount = std::max<size_t>(1, std::min<size_t>(size / kMinRangeBytes, maxThreads ? maxThreads : std::thread::hardware_concurrency() * 4));
+		for (size_t i = 1; i < rangeCount; ++i)
+		{
+			const char* split = data + size * i / rangeCount;
+			if (split <= bounds.back()) continue;
+			const char* newline = static_cast<const char*>(std::memchr(split, '\n', static_cast<size_t>(data + size - split)));
+			if (!newline) break;
+			bounds.push_back(newline + 1);
+		}
+		bounds.push_back(data + size);
+
+		std::vector<RangeResult> ranges(bounds.size() - 1);
+		ParallelFor(ranges.size(), [&](size_t i) { ParseRange(bounds[i], bounds[i + 1], ranges[i]); }, maxThreads);
+
+		size_t lineBase = 0;
+		size_t totals[3] = {};
+		size_t cornerCount = 0;
+		for (const RangeResult& range : ranges)
+		{
+			if (range.error)
+			{
+				if (error) *error = std::to_string(lineBase + range.errorLine) + ": " + range.error;
+				return false;
+			}
+			lineBase += range.lines;
+			totals[0] += range.positions.size() / 3;
+			totals[1] += range.uvs.size() / 2;
+			totals[2] += range.normals.size() / 3;
+			cornerCount += range.corners.size();
+		}
+
+		std::vector<float> positions, uvs, normals;
+		positions.reserve(totals[0] * 3);
+		uvs.reserve(totals[1] * 2);
+		normals.reserve(totals[2] * 3);
+		for (const RangeResult& range : ranges)
+		{
+			positions.insert(positions.end(), range.positions.begin(), range.positions.end());
+			uvs.insert(uvs.end(), range.uvs.begin(), range.uvs.end());
+			normals.insert(normals.end(), range.normals.begin(), range.normals.end());
+		}
+
+		// Corners become vertices, one per distinct (position, uv, normal). Vertices with the same
+		// position are chained, and chains are short, so this beats hashing whole corners.
+		struct VertexKey
+		{
+			int32_t t;
+			int32_t n;
+			uint32_t next;
+		};
+		constexpr uint32_t kNone = UINT32_MAX;
+		std::vector<uint32_t> firstAtPosition(totals[0], kNone);
+		std::vector<VertexKey> keys;
+		std::vector<uint32_t> positionOf;
+		keys.reserve(totals[0]);
+		positionOf.reserve(totals[0]);
+		mesh.indices.reserve(cornerCount);
+		mesh.hasUVs = totals[1] > 0;
+		mesh.hasNormals = totals[2] > 0;
+
+		size_t base[3] = {};
+		for (const RangeResult& range : ranges)
+		{
+			for (const Corner& corner : range.corners)
+			{
+				int32_t resolved[3];
+				for (int slot = 0; slot < 3; ++slot)
+				{
+					const bool relative = (corner.relative & (1 << slot)) != 0;
+					resolved[slot] = relative ? corner.index[slot] + static_cast<int32_t>(base[slot]) : corner.index[slot];
+					if (resolved[slot] >= static_cast<int64_t>(totals[slot]) || (relative && resolved[slot] < 0))
+					{
+						if (error) *error = "Face refers to a vertex that does not exist";
+						return false;
+					}
+				}
+				if (resolved[0] < 0)
+				{
+					if (error) *error = "Face corner has no position";
+					return false;
+				}
+				if (resolved[2] < 0) mesh.hasNormals = false;
+
+				uint32_t vertex = firstAtPosition[resolved[0]];
+				while (vertex != kNone && (keys[vertex].t != resolved[1] || keys[vertex].n != resolved[2])) vertex = keys[vertex].next;
+				if (vertex == kNone)
+				{
+					vertex = static_cast<uint32_t>(keys.size());
+					keys.push_back({ resolved[1], resolved[2], firstAtPosition[resolved[0]] });
+					positionOf.push_back(static_cast<uint32_t>(resolved[0]));
+					firstAtPosition[resolved[0]] = vertex;
+				}
+				mesh.indices.push_back(vertex);
+			}
+
+			base[0] += range.positions.size() / 3;
+			base[1] += range.uvs.size() / 2;
+			base[2] += range.normals.size() / 3;
+		}
+
+		mesh.vertices.resize(keys.size());
+		for (size_t v = 0; v < keys.size(); ++v)
+		{
+			MeshVertex& vertex = mesh.vertices[v];
+			std::copy_n(&positions[positionOf[v] * 3ull], 3, vertex.position);
+			if (keys[v].t >= 0) std::copy_n(&uvs[keys[v].t * 2ull], 2, vertex.uv);
+			else vertex.uv[0] = vertex.uv[1] = 0.0f;
+			if (keys[v].n >= 0) std::copy_n(&normals[keys[v].n * 3ull], 3, vertex.normal);
+			else vertex.normal[0] = vertex.normal[1] = vertex.normal[2] = 0.0f;
+		}
+
+		if (!mesh.hasNormals) ComputeNormals(mesh);
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#ifndef OBJ_PARSER_H
+#define OBJ_PARSER_H
+
+#include "MeshArtifact.h"
+#include <string>
+
+namespace Orca
+{
+	/**
+	 * @brief Parses Wavefront OBJ geometry (v, vt, vn and f; polygons are fan-triangulated) into
+	 *        one indexed mesh. Groups, objects and materials are ignored.
+	 *
+	 * The file is split into line-aligned ranges that are parsed on separate threads; relative
+	 * (negative) face indices are resolved once every range's vertex counts are known.
+	 * @param maxThreads 0 uses every core.
+	 */
+	bool ParseObj(const char* data, size_t size, MeshData& mesh, std::string* error = nullptr, unsigned maxThreads = 0);
+}
+
+#endif
\ No newline at end of file
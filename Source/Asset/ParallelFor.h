@@ -0,0 +1,51 @@
+#pragma once
+
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include "../Core/MemoryTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace Orca
+{
+	/**
+	 * @brief Calls body(i) for every i in [0, count), spread over up to maxThreads threads
+	 *        (hardware concurrency when 0). The calling thread takes part; returns when all are done.
+	 *
+	 * For splitting a single import across cores. Importers already run several at once on the
+	 * asset database's pool, so keep maxThreads modest there. Starts threads on every call, so
+	 * per-frame work goes to WorkerPool instead.
+	 */
+	template <typename Body>
+	void ParallelFor(size_t count, Body&& body, unsigned maxThreads = 0)
+	{
+		if (maxThreads == 0) maxThreads = std::max(1u, std::thread::hardware_concurrency());
+		const size_t threadCount = std::min<size_t>(maxThreads, count);
+		if (threadCount <= 1)
+		{
+			for (size_t i = 0; i < count; ++i) body(i);
+			return;
+		}
+
+		// Workers charge their allocations to whatever the caller is tagged as.
+		const MemoryTag tag = MemoryTracker::CurrentTag();
+		std::atomic<size_t> next{ 0 };
+		auto worker = [&]()
+		{
+			MemoryTagScope memoryTag(tag);
+			for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) body(i);
+		};
+
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount - 1);
+		for (size_t t = 1; t < threadCount; ++t) threads.emplace_back(worker);
+		worker();
+		for (std::thread& thread : threads) thread.join();
+	}
+}
+
+#endif
\ No newline at end of file
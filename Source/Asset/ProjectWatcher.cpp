@@ -0,0 +1,237 @@
+#include "ProjectWatcher.h"
+#include "../Core/EditorLog.h"
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QSocketNotifier>
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include <sys/inotify.h>
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace Orca
+{
+	namespace
+	{
+		const char* const kIgnoredRoots[] = { "Library", "Temp", "Build" };
+
+#ifdef Q_OS_LINUX
+		// Directories only: a file event arrives on its parent's watch, named.
+		constexpr uint32_t kInotifyMask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+#endif
+	}
+
+	ProjectWatcher::ProjectWatcher(const QString& projectRoot, QObject* parent)
+		: QObject(parent), m_projectRoot(QDir(projectRoot).absolutePath())
+	{
+		m_debounce.setSingleShot(true);
+		connect(&m_debounce, &QTimer::timeout, this, &ProjectWatcher::Flush);
+
+#ifdef Q_OS_LINUX
+		m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_inotifyFd >= 0)
+		{
+			m_notifier = new QSocketNotifier(m_inotifyFd, QSocketNotifier::Read, this);
+			connect(m_notifier, &QSocketNotifier::activated, this, &ProjectWatcher::readNativeEvents);
+		}
+#endif
+
+		if (m_inotifyFd < 0)
+		{
+			m_fallback = new QFileSystemWatcher(this);
+			connect(m_fallback, &QFileSystemWatcher::directoryChanged, this, &ProjectWatcher::onDirectoryChanged);
+		}
+
+		QElapsedTimer timer;
+		timer.start();
+		WatchTree(m_projectRoot);
+		ORCA_LOG_INFO("Assets", "Watching {} directories under {} in {} ms", WatchedDirectoryCount(), m_projectRoot, timer.elapsed());
+	}
+
+	ProjectWatcher::~ProjectWatcher()
+	{
+#ifdef Q_OS_LINUX
+		if (m_inotifyFd >= 0)
+		{
+			delete m_notifier;
+			::close(m_inotifyFd);
+		}
+#endif
+	}
+
+	int ProjectWatcher::WatchedDirectoryCount() const
+	{
+		return static_cast<int>(m_watchedDirectories.size());
+	}
+
+	bool ProjectWatcher::IsIgnored(const QString& absolutePath) const
+	{
+		if (absolutePath.size() <= m_projectRoot.size()) return false;
+
+		const QString relative = absolutePath.mid(m_projectRoot.size() + 1);
+		if (relative.endsWith('~')) return true;
+
+		const QString first = relative.section('/', 0, 0);
+		for (const char* root : kIgnoredRoots)
+		{
+			if (first == QLatin1String(root)) return true;
+		}
+
+		// Hidden directories (.git, .vs) and editor swap files.
+		return relative.startsWith('.') || relative.contains(QLatin1String("/."));
+	}
+
+	void ProjectWatcher::WatchTree(const QString& absoluteDirectory)
+	{
+		QStringList stack{ absoluteDirectory };
+		while (!stack.isEmpty())
+		{
+			const QString directory = stack.takeLast();
+			if (IsIgnored(directory)) continue;
+
+			WatchDirectory(directory);
+			const QStringList children = QDir(directory).entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+			for (const QString& child : children) stack.append(directory + "/" + child);
+		}
+	}
+
+	void ProjectWatcher::WatchDirectory(const QString& absoluteDirectory)
+	{
+		if (m_watchedDirectories.contains(absoluteDirectory)) return;
+
+#ifdef Q_OS_LINUX
+		if (m_inotifyFd >= 0)
+		{
+			int watch = inotify_add_watch(m_inotifyFd, QFile::encodeName(absoluteDirectory).constData(), kInotifyMask);
+			if (watch < 0)
+			{
+				if (errno == ENOSPC && !m_warnedWatchLimit)
+				{
+					m_warnedWatchLimit = true;
+					ORCA_LOG_WARNING("Assets", "Ran out of inotify watches at {} directories; raise fs.inotify.max_user_watches to see all changes",
+						WatchedDirectoryCount());
+				}
+				return;
+			}
+
+			m_watchPaths.insert(watch, absoluteDirectory);
+			m_watchedDirectories.insert(absoluteDirectory);
+			return;
+		}
+#endif
+
+		if (m_fallback->addPath(absoluteDirectory)) m_watchedDirectories.insert(absoluteDirectory);
+	}
+
+	void ProjectWatcher::Enqueue(const QString& absolutePath)
+	{
+		QString relative = absolutePath.size() > m_projectRoot.size() ? absolutePath.mid(m_projectRoot.size() + 1) : QString(".");
+
+		if (m_pending.isEmpty()) m_batchAge.start();
+		m_pending.insert(relative);
+
+		// A steady trickle would keep pushing the quiet period out; cap how long a batch waits.
+		if (m_batchAge.elapsed() >= m_maxDelayMs)
+		{
+			Flush();
+		}
+		else
+		{
+			m_debounce.start(m_debounceMs);
+		}
+	}
+
+	void ProjectWatcher::Flush()
+	{
+		m_debounce.stop();
+		if (m_pending.isEmpty()) return;
+
+		QStringList paths;
+		if (m_pending.contains("."))
+		{
+			paths.append(".");
+		}
+		else
+		{
+			// Entries inside a directory that is itself in the batch are already covered by it.
+			paths.reserve(m_pending.size());
+			for (const QString& path : m_pending)
+			{
+				bool covered = false;
+				for (qsizetype slash = path.lastIndexOf('/'); slash > 0 && !covered; slash = path.lastIndexOf('/', slash - 1))
+				{
+					covered = m_pending.contains(path.left(slash));
+				}
+				if (!covered) paths.append(path);
+			}
+			std::sort(paths.begin(), paths.end());
+		}
+
+		m_pending.clear();
+		emit filesChanged(paths);
+	}
+
+	void ProjectWatcher::readNativeEvents()
+	{
+#ifdef Q_OS_LINUX
+		alignas(inotify_event) char buffer[64 * 1024];
+		for (;;)
+		{
+			const ssize_t length = ::read(m_inotifyFd, buffer, sizeof(buffer));
+			if (length <= 0) break;
+
+			for (const char* cursor = buffer; cursor < buffer + length;)
+			{
+				const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+				cursor += sizeof(inotify_event) + event->len;
+
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					ORCA_LOG_WARNING("Assets", "File change queue overflowed; rechecking the whole project");
+					Enqueue(m_projectRoot);
+					continue;
+				}
+
+				if (event->mask & IN_IGNORED)
+				{
+					m_watchedDirectories.remove(m_watchPaths.take(event->wd));
+					continue;
+				}
+
+				auto directory = m_watchPaths.constFind(event->wd);
+				if (directory == m_watchPaths.constEnd()) continue;
+
+				const QString path = event->len ? *directory + "/" + QFile::decodeName(event->name) : *directory;
+				if (IsIgnored(path)) continue;
+
+				// Files created before the new watch was in place are covered by queueing the directory.
+				if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) WatchTree(path);
+				Enqueue(path);
+			}
+		}
+#endif
+	}
+
+	void ProjectWatcher::onDirectoryChanged(const QString& path)
+	{
+		if (!QFileInfo(path).isDir())
+		{
+			m_watchedDirectories.remove(path);
+		}
+		else
+		{
+			const QStringList children = QDir(path).entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+			for (const QString& child : children)
+			{
+				const QString childPath = path + "/" + child;
+				if (!m_watchedDirectories.contains(childPath)) WatchTree(childPath);
+			}
+		}
+
+		Enqueue(path);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#ifndef PROJECT_WATCHER_H
+#define PROJECT_WATCHER_H
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
+
+class QFileSystemWatcher;
+class QSocketNotifier;
+
+namespace Orca
+{
+	/**
+	 * @brief Watches a project directory and reports changes in debounced batches.
+	 *
+	 * Events are collected until the tree has been quiet for the debounce interval (or the
+	 * batch has been held back for the maximum delay), then delivered once with every path
+	 * listed a single time. A git checkout touching thousands of files becomes one
+	 * filesChanged() instead of thousands of reloads.
+	 *
+	 * On Linux this reads inotify directly, which names the changed file; elsewhere it falls
+	 * back to QFileSystemWatcher and reports the directory that changed. Library/, Temp/ and
+	 * hidden directories are never watched.
+	 */
+	class ProjectWatcher : public QObject
+	{
+		Q_OBJECT
+	public:
+		explicit ProjectWatcher(const QString& projectRoot, QObject* parent = nullptr);
+		~ProjectWatcher() override;
+
+		/** @brief Quiet period after the last event before a batch goes out. */
+		void SetDebounceInterval(int milliseconds) { m_debounceMs = milliseconds; }
+
+		/** @brief Longest a continuous stream of events may hold a batch back. */
+		void SetMaxBatchDelay(int milliseconds) { m_maxDelayMs = milliseconds; }
+
+		QString ProjectRoot() const { return m_projectRoot; }
+		int WatchedDirectoryCount() const;
+		bool IsNative() const { return m_inotifyFd >= 0; }
+
+		/** @brief Delivers whatever is pending right away. */
+		void Flush();
+
+	signals:
+		/**
+		 * @brief Project-relative, '/' separated paths that changed, were created or were removed.
+		 *        A directory means anything under it may have changed; "." means the whole project
+		 *        (the kernel dropped events).
+		 */
+		void filesChanged(const QStringList& paths);
+
+	private slots:
+		void readNativeEvents();
+		void onDirectoryChanged(const QString& path);
+
+	private:
+		bool IsIgnored(const QString& absolutePath) const;
+		void WatchTree(const QString& absoluteDirectory);
+		void WatchDirectory(const QString& absoluteDirectory);
+		void Enqueue(const QString& absolutePath);
+
+		QString m_projectRoot;
+		int m_debounceMs = 150;
+		int m_maxDelayMs = 1000;
+
+		QSet<QString> m_pending;
+		QTimer m_debounce;
+		QElapsedTimer m_batchAge;
+
+		int m_inotifyFd = -1;
+		QSocketNotifier* m_notifier = nullptr;
+		QHash<int, QString> m_watchPaths;
+		QSet<QString> m_watchedDirectories;
+		bool m_warnedWatchLimit = false;
+
+		QFileSystemWatcher* m_fallback = nullptr;
+	};
+}
+
+#endif
\ No newline at end of file
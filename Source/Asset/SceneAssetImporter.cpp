@@ -0,0 +1,23 @@
+#include "SceneAssetImporter.h"
+#include "../Document/OrcaBinaryScene.h"
+#include "../Document/OrcaSceneParser.h"
+
+namespace Orca
+{
+	bool SceneAssetImporter::Import(const AssetImportContext& context, QByteArray& artifact, QString& error) const
+	{
+		SceneDocument document;
+		std::string parseError;
+		if (!ParseOrcaScene(context.data, context.size, document, &parseError))
+		{
+			error = QString::fromStdString(parseError);
+			return false;
+		}
+
+		return WriteOrcaBinaryScene(document, [&artifact](const char* data, size_t size)
+		{
+			artifact.append(data, static_cast<qsizetype>(size));
+			return true;
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#ifndef SCENE_ASSET_IMPORTER_H
+#define SCENE_ASSET_IMPORTER_H
+
+#include "AssetImporter.h"
+
+namespace Orca
+{
+	/**
+	 * @brief Imports .orca scenes as .orcab, so opening a scene maps the binary artifact
+	 *        instead of parsing text.
+	 */
+	class SceneAssetImporter : public AssetImporter
+	{
+	public:
+		QString Name() const override { return "Scene"; }
+		uint32_t Version() const override { return 1; }
+		QStringList Extensions() const override { return { "orca" }; }
+
+		bool Import(const AssetImportContext& context, QByteArray& artifact, QString& error) const override;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,445 @@
+#include "TextureArtifact.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ORCA_TEXTURE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr uint32_t kMaxMipCount = 32;
+		constexpr size_t kDataAlignment = 16;
+
+		size_t AlignUp(size_t value)
+		{
+			return (value + kDataAlignment - 1) & ~(kDataAlignment - 1);
+		}
+
+		uint32_t BlockBytes(TextureFormat format)
+		{
+			return format == TextureFormat::BC1 ? 8 : 16;
+		}
+
+		uint16_t To565(int r, int g, int b)
+		{
+			return static_cast<uint16_t>(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+		}
+
+		void From565(uint16_t color, int rgb[3])
+		{
+			const int r = (color >> 11) & 31;
+			const int g = (color >> 5) & 63;
+			const int b = color & 31;
+			rgb[0] = (r << 3) | (r >> 2);
+			rgb[1] = (g << 2) | (g >> 4);
+			rgb[2] = (b << 3) | (b >> 2);
+		}
+
+		void Store16(uint8_t* out, uint16_t value)
+		{
+			out[0] = static_cast<uint8_t>(value);
+			out[1] = static_cast<uint8_t>(value >> 8);
+		}
+
+		void ColorPalette(uint16_t c0, uint16_t c1, bool fourColor, int palette[4][3])
+		{
+			From565(c0, palette[0]);
+			From565(c1, palette[1]);
+			for (int i = 0; i < 3; ++i)
+			{
+				if (fourColor)
+				{
+					palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+					palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+				}
+				else
+				{
+					palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+					palette[3][i] = 0;
+				}
+			}
+		}
+
+		void AlphaPalette(int a0, int a1, int palette[8])
+		{
+			palette[0] = a0;
+			palette[1] = a1;
+			if (a0 > a1)
+			{
+				for (int i = 1; i < 7; ++i) palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+			}
+			else
+			{
+				for (int i = 1; i < 5; ++i) palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+		}
+
+		// Bounding-box endpoints inset by 1/16 of the range, then the nearest palette entry per
+		// pixel. Not the best quality available, but fast and deterministic.
+		void EncodeColor(const uint8_t* block, uint8_t* out)
+		{
+			int lo[3] = { 255, 255, 255 };
+			int hi[3] = { 0, 0, 0 };
+			for (int p = 0; p < 16; ++p)
+			{
+				for (int i = 0; i < 3; ++i)
+				{
+					lo[i] = std::min<int>(lo[i], block[p * 4 + i]);
+					hi[i] = std::max<int>(hi[i], block[p * 4 + i]);
+				}
+			}
+			for (int i = 0; i < 3; ++i)
+			{
+				const int inset = (hi[i] - lo[i]) >> 4;
+				lo[i] += inset;
+				hi[i] -= inset;
+			}
+
+			uint16_t c0 = To565(hi[0], hi[1], hi[2]);
+			uint16_t c1 = To565(lo[0], lo[1], lo[2]);
+			if (c0 < c1) std::swap(c0, c1);
+
+			Store16(out, c0);
+			Store16(out + 2, c1);
+
+			uint32_t indices = 0;
+			if (c0 != c1)
+			{
+				int palette[4][3];
+				ColorPalette(c0, c1, true, palette);
+				for (int p = 0; p < 16; ++p)
+				{
+					int best = 0;
+					int bestDistance = INT32_MAX;
+					for (int c = 0; c < 4; ++c)
+					{
+						const int dr = block[p * 4] - palette[c][0];
+						const int dg = block[p * 4 + 1] - palette[c][1];
+						const int db = block[p * 4 + 2] - palette[c][2];
+						const int distance = dr * dr + dg * dg + db * db;
+						if (distance < bestDistance)
+						{
+							bestDistance = distance;
+							best = c;
+						}
+					}
+					indices |= static_cast<uint32_t>(best) << (2 * p);
+				}
+			}
+			std::memcpy(out + 4, &indices, 4);
+		}
+
+		void EncodeAlpha(const uint8_t* block, uint8_t* out)
+		{
+			int a0 = 0;
+			int a1 = 255;
+			for (int p = 0; p < 16; ++p)
+			{
+				a0 = std::max<int>(a0, block[p * 4 + 3]);
+				a1 = std::min<int>(a1, block[p * 4 + 3]);
+			}
+			out[0] = static_cast<uint8_t>(a0);
+			out[1] = static_cast<uint8_t>(a1);
+
+			uint64_t indices = 0;
+			if (a0 != a1)
+			{
+				int palette[8];
+				AlphaPalette(a0, a1, palette);
+				for (int p = 0; p < 16; ++p)
+				{
+					int best = 0;
+					int bestDistance = INT32_MAX;
+					for (int c = 0; c < 8; ++c)
+					{
+						const int distance = std::abs(block[p * 4 + 3] - palette[c]);
+						if (distance < bestDistance)
+						{
+							bestDistance = distance;
+							best = c;
+						}
+					}
+					indices |= static_cast<uint64_t>(best) << (3 * p);
+				}
+			}
+			for (int i = 0; i < 6; ++i) out[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+		}
+
+		void DecodeColor(const uint8_t* in, bool forceFourColor, uint8_t* block)
+		{
+			const uint16_t c0 = static_cast<uint16_t>(in[0] | in[1] << 8);
+			const uint16_t c1 = static_cast<uint16_t>(in[2] | in[3] << 8);
+			uint32_t indices;
+			std::memcpy(&indices, in + 4, 4);
+
+			const bool fourColor = forceFourColor || c0 > c1;
+			int palette[4][3];
+			ColorPalette(c0, c1, fourColor, palette);
+			for (int p = 0; p < 16; ++p)
+			{
+				const uint32_t index = (indices >> (2 * p)) & 3;
+				for (int i = 0; i < 3; ++i) block[p * 4 + i] = static_cast<uint8_t>(palette[index][i]);
+				block[p * 4 + 3] = (!fourColor && index == 3) ? 0 : 255;
+			}
+		}
+
+		void DecodeAlpha(const uint8_t* in, uint8_t* block)
+		{
+			int palette[8];
+			AlphaPalette(in[0], in[1], palette);
+			uint64_t indices = 0;
+			for (int i = 0; i < 6; ++i) indices |= static_cast<uint64_t>(in[2 + i]) << (8 * i);
+			for (int p = 0; p < 16; ++p)
+			{
+				block[p * 4 + 3] = static_cast<uint8_t>(palette[(indices >> (3 * p)) & 7]);
+			}
+		}
+
+		/** @brief Copies the 4x4 block at (bx, by), repeating the last row/column past the edges. */
+		void GatherBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t bx, uint32_t by, uint8_t* block)
+		{
+			for (uint32_t y = 0; y < 4; ++y)
+			{
+				const uint32_t sy = std::min(by * 4 + y, height - 1);
+				for (uint32_t x = 0; x < 4; ++x)
+				{
+					const uint32_t sx = std::min(bx * 4 + x, width - 1);
+					std::memcpy(block + (y * 4 + x) * 4, rgba + (static_cast<size_t>(sy) * width + sx) * 4, 4);
+				}
+			}
+		}
+
+		void EncodeLevel(TextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out)
+		{
+			out.resize(TextureLevelSize(format, width, height));
+			if (format == TextureFormat::RGBA8)
+			{
+				std::memcpy(out.data(), rgba, out.size());
+				return;
+			}
+
+			const uint32_t blocksX = (width + 3) / 4;
+			const uint32_t blocksY = (height + 3) / 4;
+			const uint32_t blockBytes = BlockBytes(format);
+			uint8_t block[64];
+			uint8_t* cursor = out.data();
+			for (uint32_t by = 0; by < blocksY; ++by)
+			{
+				for (uint32_t bx = 0; bx < blocksX; ++bx)
+				{
+					GatherBlock(rgba, width, height, bx, by, block);
+					if (format == TextureFormat::BC1) EncodeBC1Block(block, cursor);
+					else EncodeBC3Block(block, cursor);
+					cursor += blockBytes;
+				}
+			}
+		}
+	}
+
+	uint64_t TextureLevelSize(TextureFormat format, uint32_t width, uint32_t height)
+	{
+		if (format == TextureFormat::RGBA8) return static_cast<uint64_t>(width) * height * 4;
+		return static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4) * BlockBytes(format);
+	}
+
+	void EncodeBC1Block(const uint8_t* block, uint8_t* out)
+	{
+		EncodeColor(block, out);
+	}
+
+	void EncodeBC3Block(const uint8_t* block, uint8_t* out)
+	{
+		EncodeAlpha(block, out);
+		EncodeColor(block, out + 8);
+	}
+
+	void DecodeBlocks(TextureFormat format, const uint8_t* data, uint32_t width, uint32_t height, uint8_t* rgba)
+	{
+		const uint32_t blocksX = (width + 3) / 4;
+		const uint32_t blocksY = (height + 3) / 4;
+		uint8_t block[64];
+		for (uint32_t by = 0; by < blocksY; ++by)
+		{
+			for (uint32_t bx = 0; bx < blocksX; ++bx)
+			{
+				if (format == TextureFormat::BC1)
+				{
+					DecodeColor(data, false, block);
+					data += 8;
+				}
+				else
+				{
+					DecodeColor(data + 8, true, block);
+					DecodeAlpha(data, block);
+					data += 16;
+				}
+
+				for (uint32_t y = 0; y < 4 && by * 4 + y < height; ++y)
+				{
+					const uint32_t columns = std::min(4u, width - bx * 4);
+					std::memcpy(rgba + ((static_cast<size_t>(by) * 4 + y) * width + bx * 4) * 4, block + y * 16, columns * 4);
+				}
+			}
+		}
+	}
+
+	void DownsampleRgba8(const uint8_t* source, uint32_t width, uint32_t height, uint8_t* destination)
+	{
+		const uint32_t outWidth = std::max(1u, width / 2);
+		const uint32_t outHeight = std::max(1u, height / 2);
+		const size_t stride = static_cast<size_t>(width) * 4;
+
+		for (uint32_t y = 0; y < outHeight; ++y)
+		{
+			const uint8_t* row0 = source + std::min(2 * y, height - 1) * stride;
+			const uint8_t* row1 = source + std::min(2 * y + 1, height - 1) * stride;
+			uint8_t* out = destination + static_cast<size_t>(y) * outWidth * 4;
+			uint32_t x = 0;
+
+#if ORCA_TEXTURE_SSE2
+			// 8 source pixels from each row -> 4 output pixels, summed in 16 bits.
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i round = _mm_set1_epi16(2);
+			for (; 2 * (x + 4) <= width; x += 4)
+			{
+				const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+				const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8 + 16));
+				const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+				const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8 + 16));
+
+				const __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+				const __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+				const __m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+				const __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+				__m128i first = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+				__m128i second = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+				first = _mm_srli_epi16(_mm_add_epi16(first, round), 2);
+				second = _mm_srli_epi16(_mm_add_epi16(second, round), 2);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), _mm_packus_epi16(first, second));
+			}
+#endif
+
+			for (; x < outWidth; ++x)
+			{
+				const size_t left = static_cast<size_t>(std::min(2 * x, width - 1)) * 4;
+				const size_t right = static_cast<size_t>(std::min(2 * x + 1, width - 1)) * 4;
+				for (int c = 0; c < 4; ++c)
+				{
+					out[x * 4 + c] = static_cast<uint8_t>((row0[left + c] + row0[right + c] + row1[left + c] + row1[right + c] + 2) >> 2);
+				}
+			}
+		}
+	}
+
+	bool WriteTextureArtifact(const uint8_t* rgba, uint32_t width, uint32_t height, const TextureBuildOptions& options,
+		const std::function<bool(const char* data, size_t size)>& sink)
+	{
+		if (width == 0 || height == 0) return false;
+
+		bool opaque = true;
+		const size_t pixelCount = static_cast<size_t>(width) * height;
+		for (size_t i = 0; i < pixelCount && opaque; ++i) opaque = rgba[i * 4 + 3] == 255;
+
+		TextureArtifactHeader header;
+		const TextureFormat format = !options.compress ? TextureFormat::RGBA8 : (opaque ? TextureFormat::BC1 : TextureFormat::BC3);
+		header.format = static_cast<uint32_t>(format);
+		header.width = width;
+		header.height = height;
+		header.srgb = options.srgb ? 1 : 0;
+		header.mipCount = 1;
+		if (options.generateMips)
+		{
+			while ((std::max(width, height) >> header.mipCount) > 0) ++header.mipCount;
+		}
+
+		std::vector<TextureMipEntry> mips(header.mipCount);
+		size_t offset = AlignUp(sizeof(TextureArtifactHeader) + mips.size() * sizeof(TextureMipEntry));
+		for (uint32_t level = 0; level < header.mipCount; ++level)
+		{
+			TextureMipEntry& mip = mips[level];
+			mip.width = std::max(1u, width >> level);
+			mip.height = std::max(1u, height >> level);
+			mip.offset = offset;
+			mip.size = TextureLevelSize(format, mip.width, mip.height);
+			offset = AlignUp(offset + static_cast<size_t>(mip.size));
+		}
+
+		if (!sink(reinterpret_cast<const char*>(&header), sizeof(header))) return false;
+		if (!sink(reinterpret_cast<const char*>(mips.data()), mips.size() * sizeof(TextureMipEntry))) return false;
+
+		static const char kPadding[kDataAlignment] = {};
+		size_t written = sizeof(header) + mips.size() * sizeof(TextureMipEntry);
+
+		// Only the current and next level are held at once.
+		std::vector<uint8_t> current;
+		std::vector<uint8_t> next;
+		std::vector<uint8_t> encoded;
+		const uint8_t* pixels = rgba;
+		for (uint32_t level = 0; level < header.mipCount; ++level)
+		{
+			const TextureMipEntry& mip = mips[level];
+			EncodeLevel(format, pixels, mip.width, mip.height, encoded);
+
+			if (!sink(kPadding, static_cast<size_t>(mip.offset) - written)) return false;
+			if (!sink(reinterpret_cast<const char*>(encoded.data()), encoded.size())) return false;
+			written = static_cast<size_t>(mip.offset + mip.size);
+
+			if (level + 1 < header.mipCount)
+			{
+				next.resize(static_cast<size_t>(mips[level + 1].width) * mips[level + 1].height * 4);
+				DownsampleRgba8(pixels, mip.width, mip.height, next.data());
+				current.swap(next);
+				pixels = current.data();
+			}
+		}
+		return true;
+	}
+
+	bool TextureArtifactView::Open(const char* data, size_t size, std::string* error)
+	{
+		auto fail = [error](const char* reason)
+		{
+			if (error) *error = reason;
+			return false;
+		};
+
+		m_data = nullptr;
+		m_mips.clear();
+
+		if (size < sizeof(TextureArtifactHeader)) return fail("File is too small to be a texture artifact");
+		std::memcpy(&m_header, data, sizeof(m_header));
+		if (m_header.magic != TextureArtifactHeader::kMagic) return fail("Not a texture artifact");
+		if (m_header.version != TextureArtifactHeader::kVersion) return fail("Unsupported texture artifact version");
+		if (m_header.format > static_cast<uint32_t>(TextureFormat::BC3)) return fail("Unknown texture format");
+		if (m_header.width == 0 || m_header.height == 0) return fail("Texture has no pixels");
+		if (m_header.mipCount == 0 || m_header.mipCount > kMaxMipCount) return fail("Invalid mip count");
+
+		const size_t tableEnd = sizeof(TextureArtifactHeader) + m_header.mipCount * sizeof(TextureMipEntry);
+		if (size < tableEnd) return fail("Truncated mip table");
+
+		m_mips.resize(m_header.mipCount);
+		std::memcpy(m_mips.data(), data + sizeof(TextureArtifactHeader), m_mips.size() * sizeof(TextureMipEntry));
+
+		for (uint32_t level = 0; level < m_header.mipCount; ++level)
+		{
+			const TextureMipEntry& mip = m_mips[level];
+			if (mip.width != std::max(1u, m_header.width >> level) || mip.height != std::max(1u, m_header.height >> level))
+			{
+				return fail("Mip dimensions do not match the texture");
+			}
+			if (mip.size != TextureLevelSize(Format(), mip.width, mip.height)) return fail("Mip size does not match its format");
+			if (mip.offset < tableEnd || mip.offset > size || mip.size > size - mip.offset) return fail("Mip data is out of bounds");
+		}
+
+		m_data = data;
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#ifndef TEXTURE_ARTIFACT_H
+#define TEXTURE_ARTIFACT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Orca
+{
+	enum class TextureFormat : uint32_t
+	{
+		RGBA8 = 0,
+		BC1 = 1,    // 4x4 blocks of 8 bytes, opaque
+		BC3 = 2     // 4x4 blocks of 16 bytes, with alpha
+	};
+
+	/**
+	 * @brief Texture artifact layout, version 1. All values little-endian.
+	 *
+	 *   TextureArtifactHeader
+	 *   TextureMipEntry[mipCount]     finest level first
+	 *   mip data                      each level 16-byte aligned
+	 *
+	 * The file is meant to be mapped and uploaded straight from the mapping.
+	 */
+	struct TextureArtifactHeader
+	{
+		static constexpr uint32_t kMagic = 0x5845544F;   // "OTEX"
+		static constexpr uint32_t kVersion = 1;
+
+		uint32_t magic = kMagic;
+		uint32_t version = kVersion;
+		uint32_t format = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t mipCount = 0;
+		uint32_t srgb = 0;
+		uint32_t reserved = 0;
+	};
+
+	struct TextureMipEntry
+	{
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint64_t offset = 0;    // from the start of the artifact
+		uint64_t size = 0;
+	};
+
+	static_assert(sizeof(TextureArtifactHeader) == 32, "TextureArtifactHeader is part of the file format");
+	static_assert(sizeof(TextureMipEntry) == 24, "TextureMipEntry is part of the file format");
+
+	struct TextureBuildOptions
+	{
+		bool generateMips = true;
+		bool compress = true;
+		bool srgb = true;
+	};
+
+	/**
+	 * @brief Builds an artifact from tightly packed, non-premultiplied RGBA8 pixels.
+	 *        BC1 is chosen when every pixel is opaque, BC3 otherwise.
+	 */
+	bool WriteTextureArtifact(const uint8_t* rgba, uint32_t width, uint32_t height, const TextureBuildOptions& options,
+		const std::function<bool(const char* data, size_t size)>& sink);
+
+	/** @brief Halves an RGBA8 image with a 2x2 box filter (SSE2 where available); odd edges are clamped. */
+	void DownsampleRgba8(const uint8_t* source, uint32_t width, uint32_t height, uint8_t* destination);
+
+	/** @brief Encodes one 4x4 block of RGBA8 pixels (row stride 16 bytes). */
+	void EncodeBC1Block(const uint8_t* block, uint8_t* out);
+	void EncodeBC3Block(const uint8_t* block, uint8_t* out);
+
+	/** @brief Decodes a compressed level to RGBA8, for drivers without S3TC support. */
+	void DecodeBlocks(TextureFormat format, const uint8_t* data, uint32_t width, uint32_t height, uint8_t* rgba);
+
+	/** @brief Bytes of one level of the given size and format. */
+	uint64_t TextureLevelSize(TextureFormat format, uint32_t width, uint32_t height);
+
+	/**
+	 * @brief Checked, zero-copy view of an artifact in memory (typically a mapped file).
+	 *        Every offset and size is validated in Open(); afterwards the accessors trust them.
+	 */
+	class TextureArtifactView
+	{
+	public:
+		bool Open(const char* data, size_t size, std::string* error = nullptr);
+
+		const TextureArtifactHeader& Header() const { return m_header; }
+		TextureFormat Format() const { return static_cast<TextureFormat>(m_header.format); }
+		uint32_t MipCount() const { return m_header.mipCount; }
+		const TextureMipEntry& Mip(uint32_t level) const { return m_mips[level]; }
+		const char* MipData(uint32_t level) const { return m_data + m_mips[level].offset; }
+
+	private:
+		const char* m_data = nullptr;
+		TextureArtifactHeader m_header;
+		std::vector<TextureMipEntry> m_mips;
+	};
+}
+
+#endif
\ No newline at end of file
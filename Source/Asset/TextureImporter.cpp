@@ -0,0 +1,44 @@
+#include "TextureImporter.h"
+#include "TextureArtifact.h"
+#include <QtCore/QFileInfo>
+#include <QtGui/QImage>
+#include <cstring>
+#include <vector>
+
+namespace Orca
+{
+	bool TextureImporter::Import(const AssetImportContext& context, QByteArray& artifact, QString& error) const
+	{
+		// TGA has no signature, so the extension is passed as a format hint.
+		const QByteArray format = QFileInfo(context.assetPath).suffix().toLower().toLatin1();
+		QImage image = QImage::fromData(reinterpret_cast<const uchar*>(context.data), static_cast<int>(context.size), format.constData());
+		if (image.isNull())
+		{
+			error = QString("Could not decode %1 image").arg(QString::fromLatin1(format).toUpper());
+			return false;
+		}
+		image.convertTo(QImage::Format_RGBA8888);
+
+		const uint32_t width = static_cast<uint32_t>(image.width());
+		const uint32_t height = static_cast<uint32_t>(image.height());
+		std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+		for (uint32_t y = 0; y < height; ++y)
+		{
+			std::memcpy(pixels.data() + static_cast<size_t>(y) * width * 4, image.constScanLine(static_cast<int>(y)), width * 4);
+		}
+		image = QImage();
+
+		TextureBuildOptions options;
+		options.generateMips = context.settings.value("GenerateMips").toBool(true);
+		options.compress = context.settings.value("Compress").toBool(true);
+		options.srgb = context.settings.value("sRGB").toBool(true);
+
+		const bool written = WriteTextureArtifact(pixels.data(), width, height, options, [&artifact](const char* data, size_t size)
+		{
+			artifact.append(data, static_cast<qsizetype>(size));
+			return true;
+		});
+		if (!written) error = "Texture has no pixels";
+		return written;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#ifndef TEXTURE_IMPORTER_H
+#define TEXTURE_IMPORTER_H
+
+#include "AssetImporter.h"
+
+namespace Orca
+{
+	/**
+	 * @brief Imports PNG, JPEG and TGA images as texture artifacts (see TextureArtifact.h):
+	 *        a full mip chain, BC1/BC3 compressed on the CPU, laid out for mapping.
+	 *
+	 * .meta "Settings": "GenerateMips" (default true), "Compress" (default true) and
+	 * "sRGB" (default true; turn off for normal maps and masks).
+	 */
+	class TextureImporter : public AssetImporter
+	{
+	public:
+		QString Name() const override { return "Texture"; }
+		uint32_t Version() const override { return 1; }
+		QStringList Extensions() const override { return { "png", "jpg", "jpeg", "tga" }; }
+
+		bool Import(const AssetImportContext& context, QByteArray& artifact, QString& error) const override;
+	};
+}
+
+#endif
\ No newline at end of file
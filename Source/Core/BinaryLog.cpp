@@ -0,0 +1,568 @@
+#include "BinaryLog.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr char kMagic[8] = { 'O', 'R', 'C', 'A', 'B', 'L', 'O', 'G' };
+		constexpr uint16_t kVersion = 1;
+		constexpr size_t kHeaderSize = 8 + 2 + 2 + 8;
+
+		constexpr uint8_t kRecordFormat = 1;
+		constexpr uint8_t kRecordEvent = 2;
+
+		void PutVarint(std::vector<uint8_t>& out, uint64_t value)
+		{
+			while (value >= 0x80)
+			{
+				out.push_back(static_cast<uint8_t>(value) | 0x80);
+				value >>= 7;
+			}
+			out.push_back(static_cast<uint8_t>(value));
+		}
+
+		void PutBytes(std::vector<uint8_t>& out, const void* data, size_t size)
+		{
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			out.insert(out.end(), bytes, bytes + size);
+		}
+
+		void PutString(std::vector<uint8_t>& out, std::string_view value)
+		{
+			PutVarint(out, value.size());
+			PutBytes(out, value.data(), value.size());
+		}
+
+		uint64_t ZigZag(int64_t value)
+		{
+			return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+		}
+
+		int64_t UnZigZag(uint64_t value)
+		{
+			return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+		}
+
+		/** Bounds-checked cursor over a decoded buffer. */
+		struct Cursor
+		{
+			const uint8_t* data;
+			size_t size;
+			size_t pos = 0;
+			bool ok = true;
+
+			bool AtEnd() const { return pos >= size; }
+
+			uint8_t Byte()
+			{
+				if (pos >= size) { ok = false; return 0; }
+				return data[pos++];
+			}
+
+			uint64_t Varint()
+			{
+				uint64_t value = 0;
+				for (int shift = 0; shift < 64; shift += 7)
+				{
+					uint8_t b = Byte();
+					value |= static_cast<uint64_t>(b & 0x7f) << shift;
+					if (!(b & 0x80)) return value;
+				}
+				ok = false;
+				return 0;
+			}
+
+			std::string_view String()
+			{
+				uint64_t length = Varint();
+				if (!ok || length > size - pos) { ok = false; return {}; }
+				std::string_view s(reinterpret_cast<const char*>(data + pos), static_cast<size_t>(length));
+				pos += static_cast<size_t>(length);
+				return s;
+			}
+
+			template<typename T>
+			T Raw()
+			{
+				T value{};
+				if (sizeof(T) > size - pos) { ok = false; return value; }
+				std::memcpy(&value, data + pos, sizeof(T));
+				pos += sizeof(T);
+				return value;
+			}
+		};
+
+		uint32_t CurrentThreadIndex()
+		{
+			static std::atomic<uint32_t> s_next{ 0 };
+			thread_local uint32_t index = s_next.fetch_add(1, std::memory_order_relaxed);
+			return index;
+		}
+
+		/** Skips one packed argument; returns false on malformed input. */
+		bool SkipArg(Cursor& cursor)
+		{
+			switch (static_cast<BinaryLogArgType>(cursor.Byte()))
+			{
+			case BinaryLogArgType::Int:
+			case BinaryLogArgType::UInt:
+			case BinaryLogArgType::Pointer: cursor.Varint(); break;
+			case BinaryLogArgType::Double: cursor.Raw<double>(); break;
+			case BinaryLogArgType::False:
+			case BinaryLogArgType::True: break;
+			case BinaryLogArgType::String: cursor.String(); break;
+			default: return false;
+			}
+			return cursor.ok;
+		}
+
+		void AppendArg(std::string& out, Cursor& cursor)
+		{
+			char scratch[64];
+			switch (static_cast<BinaryLogArgType>(cursor.Byte()))
+			{
+			case BinaryLogArgType::Int:
+				std::snprintf(scratch, sizeof(scratch), "%lld", static_cast<long long>(UnZigZag(cursor.Varint())));
+				out += scratch;
+				break;
+			case BinaryLogArgType::UInt:
+				std::snprintf(scratch, sizeof(scratch), "%llu", static_cast<unsigned long long>(cursor.Varint()));
+				out += scratch;
+				break;
+			case BinaryLogArgType::Pointer:
+				std::snprintf(scratch, sizeof(scratch), "0x%llx", static_cast<unsigned long long>(cursor.Varint()));
+				out += scratch;
+				break;
+			case BinaryLogArgType::Double:
+				std::snprintf(scratch, sizeof(scratch), "%g", cursor.Raw<double>());
+				out += scratch;
+				break;
+			case BinaryLogArgType::False: out += "false"; break;
+			case BinaryLogArgType::True: out += "true"; break;
+			case BinaryLogArgType::String: out += cursor.String(); break;
+			default: cursor.ok = false; break;
+			}
+		}
+	}
+
+	// --- Severity helpers ---
+
+	const char* LogSeverityName(LogSeverity severity)
+	{
+		switch (severity)
+		{
+		case LogSeverity::Trace: return "TRACE";
+		case LogSeverity::Debug: return "DEBUG";
+		case LogSeverity::Info: return "INFO";
+		case LogSeverity::Warning: return "WARN";
+		case LogSeverity::Error: return "ERROR";
+		case LogSeverity::Fatal: return "FATAL";
+		default: return "?";
+		}
+	}
+
+	bool ParseLogSeverity(std::string_view name, LogSeverity& outSeverity)
+	{
+		for (int i = 0; i < static_cast<int>(LogSeverity::Count); ++i)
+		{
+			std::string_view candidate = LogSeverityName(static_cast<LogSeverity>(i));
+			if (candidate.size() != name.size()) continue;
+
+			bool equal = true;
+			for (size_t c = 0; c < name.size() && equal; ++c)
+			{
+				equal = std::toupper(static_cast<unsigned char>(name[c])) == candidate[c];
+			}
+			if (equal)
+			{
+				outSeverity = static_cast<LogSeverity>(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// --- BinaryLogArgs ---
+
+	void BinaryLogArgs::AddInt(int64_t value)
+	{
+		m_bytes.push_back(static_cast<uint8_t>(BinaryLogArgType::Int));
+		PutVarint(m_bytes, ZigZag(value));
+		++m_count;
+	}
+
+	void BinaryLogArgs::AddUInt(uint64_t value)
+	{
+		m_bytes.push_back(static_cast<uint8_t>(BinaryLogArgType::UInt));
+		PutVarint(m_bytes, value);
+		++m_count;
+	}
+
+	void BinaryLogArgs::AddDouble(double value)
+	{
+		m_bytes.push_back(static_cast<uint8_t>(BinaryLogArgType::Double));
+		PutBytes(m_bytes, &value, sizeof(value));
+		++m_count;
+	}
+
+	void BinaryLogArgs::AddBool(bool value)
+	{
+		m_bytes.push_back(static_cast<uint8_t>(value ? BinaryLogArgType::True : BinaryLogArgType::False));
+		++m_count;
+	}
+
+	void BinaryLogArgs::AddString(std::string_view value)
+	{
+		m_bytes.push_back(static_cast<uint8_t>(BinaryLogArgType::String));
+		PutString(m_bytes, value);
+		++m_count;
+	}
+
+	void BinaryLogArgs::AddPointer(const void* value)
+	{
+		m_bytes.push_back(static_cast<uint8_t>(BinaryLogArgType::Pointer));
+		PutVarint(m_bytes, reinterpret_cast<uintptr_t>(value));
+		++m_count;
+	}
+
+	// --- BinaryLogFormatTable ---
+
+	BinaryLogFormatTable& BinaryLogFormatTable::Get()
+	{
+		static BinaryLogFormatTable s_table;
+		return s_table;
+	}
+
+	uint32_t BinaryLogFormatTable::Register(LogSeverity severity, std::string_view category, std::string_view format)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		// Call sites cache their id, so this only runs once per site; a linear scan keeps
+		// identical formats from different sites (e.g. the Qt message handler) on one id.
+		for (size_t i = 0; i < m_formats.size(); ++i)
+		{
+			const BinaryLogFormat& existing = m_formats[i];
+			if (existing.severity == severity && existing.category == category && existing.format == format)
+			{
+				return static_cast<uint32_t>(i);
+			}
+		}
+
+		m_formats.push_back({ severity, std::string(category), std::string(format) });
+		return static_cast<uint32_t>(m_formats.size() - 1);
+	}
+
+	BinaryLogFormat BinaryLogFormatTable::Lookup(uint32_t id) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return id < m_formats.size() ? m_formats[id] : BinaryLogFormat{};
+	}
+
+	size_t BinaryLogFormatTable::Size() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_formats.size();
+	}
+
+	// --- BinaryLogWriter ---
+
+	std::string BinaryLogPath(const std::string& basePath, int index)
+	{
+		return index == 0 ? basePath + ".oblog" : basePath + "." + std::to_string(index) + ".oblog";
+	}
+
+	BinaryLogWriter::~BinaryLogWriter()
+	{
+		Close();
+	}
+
+	bool BinaryLogWriter::Open(const BinaryLogWriterSettings& settings)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_file) return true;
+
+		m_settings = settings;
+		m_buffer.reserve(m_settings.bufferBytes);
+		RotateLocked();
+		return m_file != nullptr;
+	}
+
+	void BinaryLogWriter::Close()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_file) return;
+
+		FlushLocked();
+		std::fclose(m_file);
+		m_file = nullptr;
+	}
+
+	bool BinaryLogWriter::IsOpen() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_file != nullptr;
+	}
+
+	void BinaryLogWriter::Write(uint32_t formatId, int64_t steadyNs, const BinaryLogArgs& args)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_file) return;
+
+		if (m_fileBytes + m_buffer.size() >= m_settings.rotateBytes)
+		{
+			RotateLocked();
+			if (!m_file) return;
+		}
+
+		if (formatId >= m_definedFormats.size() || !m_definedFormats[formatId])
+		{
+			DefineFormatLocked(formatId);
+		}
+
+		// Threads read the clock before taking the lock, so an event can arrive older than the
+		// last one. It is stamped with the last time instead: the decoder sums the deltas, and
+		// clamping alone would push every later event forward by the difference.
+		const int64_t eventNs = std::max(steadyNs, m_lastEventNs);
+		const int64_t delta = eventNs - m_lastEventNs;
+		m_lastEventNs = eventNs;
+
+		m_buffer.push_back(kRecordEvent);
+		PutVarint(m_buffer, formatId);
+		PutVarint(m_buffer, static_cast<uint64_t>(delta));
+		PutVarint(m_buffer, CurrentThreadIndex());
+		m_buffer.push_back(args.Count());
+		PutBytes(m_buffer, args.Bytes().data(), args.Bytes().size());
+
+		if (m_buffer.size() >= m_settings.bufferBytes)
+		{
+			FlushLocked();
+		}
+	}
+
+	void BinaryLogWriter::Flush()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		FlushLocked();
+	}
+
+	uint64_t BinaryLogWriter::BytesWritten() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_totalBytes + m_buffer.size();
+	}
+
+	std::string BinaryLogWriter::CurrentPath() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return BinaryLogPath(m_settings.basePath, 0);
+	}
+
+	void BinaryLogWriter::FlushLocked()
+	{
+		if (!m_file || m_buffer.empty()) return;
+
+		std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+		std::fflush(m_file);
+		m_fileBytes += m_buffer.size();
+		m_totalBytes += m_buffer.size();
+		m_buffer.clear();
+	}
+
+	void BinaryLogWriter::RotateLocked()
+	{
+		if (m_file)
+		{
+			FlushLocked();
+			std::fclose(m_file);
+			m_file = nullptr;
+		}
+
+		// Shift OrcaStudio.N.oblog -> OrcaStudio.N+1.oblog, dropping the oldest.
+		std::remove(BinaryLogPath(m_settings.basePath, m_settings.keepFiles - 1).c_str());
+		for (int i = m_settings.keepFiles - 2; i >= 0; --i)
+		{
+			std::rename(BinaryLogPath(m_settings.basePath, i).c_str(), BinaryLogPath(m_settings.basePath, i + 1).c_str());
+		}
+
+		OpenFileLocked();
+	}
+
+	bool BinaryLogWriter::OpenFileLocked()
+	{
+		m_file = std::fopen(BinaryLogPath(m_settings.basePath, 0).c_str(), "wb");
+		if (!m_file) return false;
+
+		// Our own buffer already batches writes.
+		std::setvbuf(m_file, nullptr, _IONBF, 0);
+
+		m_fileBytes = 0;
+		m_definedFormats.assign(m_definedFormats.size(), false);
+		WriteHeaderLocked();
+		return true;
+	}
+
+	void BinaryLogWriter::WriteHeaderLocked()
+	{
+		using namespace std::chrono;
+
+		int64_t steadyNow = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+		int64_t unixNow = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+
+		// Events store steady-clock deltas; the header anchors the first one to wall-clock time.
+		m_lastEventNs = steadyNow;
+
+		uint16_t reserved = 0;
+		PutBytes(m_buffer, kMagic, sizeof(kMagic));
+		PutBytes(m_buffer, &kVersion, sizeof(kVersion));
+		PutBytes(m_buffer, &reserved, sizeof(reserved));
+		PutBytes(m_buffer, &unixNow, sizeof(unixNow));
+	}
+
+	void BinaryLogWriter::DefineFormatLocked(uint32_t formatId)
+	{
+		if (formatId >= m_definedFormats.size())
+		{
+			m_definedFormats.resize(formatId + 1, false);
+		}
+
+		BinaryLogFormat format = BinaryLogFormatTable::Get().Lookup(formatId);
+		m_buffer.push_back(kRecordFormat);
+		PutVarint(m_buffer, formatId);
+		m_buffer.push_back(static_cast<uint8_t>(format.severity));
+		PutString(m_buffer, format.category);
+		PutString(m_buffer, format.format);
+		m_definedFormats[formatId] = true;
+	}
+
+	// --- BinaryLogReader ---
+
+	bool BinaryLogReader::Open(const std::string& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		if (!in)
+		{
+			m_error = "cannot open " + path;
+			return false;
+		}
+
+		m_data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		if (m_data.size() < kHeaderSize || std::memcmp(m_data.data(), kMagic, sizeof(kMagic)) != 0)
+		{
+			m_error = path + " is not an Orca binary log";
+			return false;
+		}
+
+		uint16_t version = 0;
+		std::memcpy(&version, m_data.data() + sizeof(kMagic), sizeof(version));
+		if (version != kVersion)
+		{
+			m_error = path + ": unsupported log version " + std::to_string(version);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool BinaryLogReader::ForEach(const std::function<bool(const BinaryLogEvent&)>& visitor)
+	{
+		if (m_data.size() < kHeaderSize) return false;
+
+		int64_t unixNs = 0;
+		std::memcpy(&unixNs, m_data.data() + 12, sizeof(unixNs));
+
+		Cursor cursor{ m_data.data(), m_data.size(), kHeaderSize };
+		BinaryLogEvent event;
+
+		while (!cursor.AtEnd())
+		{
+			uint8_t kind = cursor.Byte();
+			if (kind == kRecordFormat)
+			{
+				uint64_t id = cursor.Varint();
+				LogSeverity severity = static_cast<LogSeverity>(cursor.Byte());
+				std::string_view category = cursor.String();
+				std::string_view format = cursor.String();
+				if (!cursor.ok || id > 0xffffffu) break;
+
+				if (id >= m_formats.size()) m_formats.resize(static_cast<size_t>(id) + 1);
+				m_formats[static_cast<size_t>(id)] = { severity, std::string(category), std::string(format) };
+			}
+			else if (kind == kRecordEvent)
+			{
+				uint64_t formatId = cursor.Varint();
+				unixNs += static_cast<int64_t>(cursor.Varint());
+				uint64_t thread = cursor.Varint();
+				uint8_t argc = cursor.Byte();
+
+				size_t argsBegin = cursor.pos;
+				for (uint8_t i = 0; i < argc && cursor.ok; ++i)
+				{
+					cursor.ok = SkipArg(cursor);
+				}
+				if (!cursor.ok || formatId >= m_formats.size()) break;
+
+				const BinaryLogFormat& format = m_formats[static_cast<size_t>(formatId)];
+				event.unixNs = unixNs;
+				event.formatId = static_cast<uint32_t>(formatId);
+				event.thread = static_cast<uint32_t>(thread);
+				event.severity = format.severity;
+				event.category = format.category;
+				event.format = format.format;
+				event.message = FormatBinaryLogMessage(format.format, m_data.data() + argsBegin, cursor.pos - argsBegin, argc);
+
+				if (!visitor(event)) return true;
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		// A truncated tail is expected after a crash; everything before it was still delivered.
+		if (!cursor.ok || !cursor.AtEnd())
+		{
+			m_error = "log is truncated or corrupt at offset " + std::to_string(cursor.pos);
+			return false;
+		}
+		return true;
+	}
+
+	std::string FormatBinaryLogMessage(std::string_view format, const uint8_t* args, size_t size, uint8_t count)
+	{
+		std::string out;
+		out.reserve(format.size() + size);
+
+		Cursor cursor{ args, size };
+		uint8_t consumed = 0;
+
+		for (size_t i = 0; i < format.size(); ++i)
+		{
+			char c = format[i];
+			if (c == '{' && i + 1 < format.size() && format[i + 1] == '{') { out += '{'; ++i; continue; }
+			if (c == '}' && i + 1 < format.size() && format[i + 1] == '}') { out += '}'; ++i; continue; }
+
+			if (c == '{' && i + 1 < format.size() && format[i + 1] == '}')
+			{
+				if (consumed < count) { AppendArg(out, cursor); ++consumed; }
+				else { out += "{}"; }
+				++i;
+				continue;
+			}
+			out += c;
+		}
+
+		// Arguments without a placeholder are still worth seeing.
+		for (; consumed < count && cursor.ok; ++consumed)
+		{
+			out += ' ';
+			AppendArg(out, cursor);
+		}
+		return out;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+#pragma once
+
+#ifndef BINARY_LOG_H
+#define BINARY_LOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Binary structured log (.oblog)
+ *
+ * A file is a header followed by a stream of records. Format strings are
+ * written once per file as FormatDef records; every log call afterwards is an
+ * Event record carrying the format id and the packed arguments. Nothing is
+ * formatted at the call site: the text is only produced when a reader
+ * (ConsolePanel, orca_logdecode) renders an event.
+ *
+ *   Header   : "ORCABLOG" u16 version u16 reserved i64 sessionStartUnixNs
+ *   FormatDef: u8 kind=1, varint id, u8 severity, varint len + category, varint len + format
+ *   Event    : u8 kind=2, varint formatId, varint deltaNs, varint thread, u8 argc, args...
+ *   Arg      : u8 type, payload (zigzag varint / varint / f64 / varint len + bytes)
+ *
+ * Placeholders in format strings are "{}", "{{" and "}}" escape braces.
+ */
+
+namespace Orca
+{
+	enum class LogSeverity : uint8_t
+	{
+		Trace,
+		Debug,
+		Info,
+		Warning,
+		Error,
+		Fatal,
+		Count
+	};
+
+	const char* LogSeverityName(LogSeverity severity);
+	bool ParseLogSeverity(std::string_view name, LogSeverity& outSeverity);
+
+	enum class BinaryLogArgType : uint8_t
+	{
+		Int = 1,
+		UInt,
+		Double,
+		False,
+		True,
+		String,
+		Pointer
+	};
+
+	/**
+	 * @brief Packed argument list of a single log event.
+	 */
+	class BinaryLogArgs
+	{
+	public:
+		void AddInt(int64_t value);
+		void AddUInt(uint64_t value);
+		void AddDouble(double value);
+		void AddBool(bool value);
+		void AddString(std::string_view value);
+		void AddPointer(const void* value);
+
+		template<typename T>
+		void Add(const T& value)
+		{
+			if constexpr (std::is_same_v<T, bool>) AddBool(value);
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) AddInt(static_cast<int64_t>(value));
+			else if constexpr (std::is_integral_v<T>) AddUInt(static_cast<uint64_t>(value));
+			else if constexpr (std::is_enum_v<T>) AddInt(static_cast<int64_t>(value));
+			else if constexpr (std::is_floating_point_v<T>) AddDouble(static_cast<double>(value));
+			else if constexpr (std::is_same_v<T, char*> || std::is_same_v<T, const char*>) Add(static_cast<const char*>(value));
+			else if constexpr (std::is_convertible_v<const T&, std::string_view>) AddString(std::string_view(value));
+			else if constexpr (std::is_pointer_v<T>) AddPointer(static_cast<const void*>(value));
+			else static_assert(sizeof(T) == 0, "Unsupported log argument type");
+		}
+
+		/** @brief Every C string goes through here, null included; the template forwards char* too. */
+		void Add(const char* value) { AddString(value ? std::string_view(value) : std::string_view("(null)")); }
+
+		uint8_t Count() const { return m_count; }
+		const std::vector<uint8_t>& Bytes() const { return m_bytes; }
+		void Clear() { m_bytes.clear(); m_count = 0; }
+
+	private:
+		std::vector<uint8_t> m_bytes;
+		uint8_t m_count = 0;
+	};
+
+	struct BinaryLogFormat
+	{
+		LogSeverity severity = LogSeverity::Info;
+		std::string category;
+		std::string format;
+	};
+
+	/**
+	 * @brief Process-wide table of format strings, shared by every writer.
+	 */
+	class BinaryLogFormatTable
+	{
+	public:
+		static BinaryLogFormatTable& Get();
+
+		uint32_t Register(LogSeverity severity, std::string_view category, std::string_view format);
+		BinaryLogFormat Lookup(uint32_t id) const;
+		size_t Size() const;
+
+	private:
+		mutable std::mutex m_mutex;
+		std::vector<BinaryLogFormat> m_formats;
+	};
+
+	struct BinaryLogWriterSettings
+	{
+		std::string basePath;                      // e.g. ".../Logs/OrcaStudio" -> OrcaStudio.oblog, OrcaStudio.1.oblog, ...
+		size_t bufferBytes = 64 * 1024;            // appends are batched into one fwrite per buffer
+		uint64_t rotateBytes = 16ull * 1024 * 1024;
+		int keepFiles = 5;
+	};
+
+	/**
+	 * @brief Appends events to a rotating set of .oblog files through an in-memory buffer.
+	 *
+	 * Thread safe. Each rotated file re-declares the formats it uses so it can be
+	 * decoded on its own.
+	 */
+	class BinaryLogWriter
+	{
+	public:
+		BinaryLogWriter() = default;
+		~BinaryLogWriter();
+
+		BinaryLogWriter(const BinaryLogWriter&) = delete;
+		BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+		bool Open(const BinaryLogWriterSettings& settings);
+		void Close();
+		bool IsOpen() const;
+
+		void Write(uint32_t formatId, int64_t steadyNs, const BinaryLogArgs& args);
+		void Flush();
+
+		uint64_t BytesWritten() const;
+		std::string CurrentPath() const;
+
+	private:
+		bool OpenFileLocked();
+		void RotateLocked();
+		void FlushLocked();
+		void WriteHeaderLocked();
+		void DefineFormatLocked(uint32_t formatId);
+
+	private:
+		mutable std::mutex m_mutex;
+		BinaryLogWriterSettings m_settings;
+		std::FILE* m_file = nullptr;
+		std::vector<uint8_t> m_buffer;
+		std::vector<bool> m_definedFormats;
+		uint64_t m_fileBytes = 0;
+		uint64_t m_totalBytes = 0;
+		int64_t m_lastEventNs = 0;
+	};
+
+	struct BinaryLogEvent
+	{
+		int64_t unixNs = 0;
+		uint32_t formatId = 0;
+		uint32_t thread = 0;
+		LogSeverity severity = LogSeverity::Info;
+		std::string_view category;
+		std::string_view format;
+		std::string message;
+	};
+
+	/**
+	 * @brief Decodes .oblog files. Used by orca_logdecode and anything else that reads logs offline.
+	 */
+	class BinaryLogReader
+	{
+	public:
+		bool Open(const std::string& path);
+		const std::string& Error() const { return m_error; }
+
+		/**
+		 * @brief Walks every event in the file. Return false from the visitor to stop.
+		 */
+		bool ForEach(const std::function<bool(const BinaryLogEvent&)>& visitor);
+
+	private:
+		std::vector<uint8_t> m_data;
+		std::vector<BinaryLogFormat> m_formats;
+		std::string m_error;
+	};
+
+	std::string FormatBinaryLogMessage(std::string_view format, const uint8_t* args, size_t size, uint8_t count);
+	std::string BinaryLogPath(const std::string& basePath, int index);
+}
+
+#endif
\ No newline at end of file
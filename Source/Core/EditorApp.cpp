@@ -2,244 +2,539 @@
 #include "../Panel/SceneViewport.h"
 #include "../Panel/HierarchyPanel.h"
 #include "../Panel/InspectorPanel.h"
+#include "../Panel/ConsolePanel.h"
+#include "../Panel/ConsoleBuiltinCommands.h"
+#include "../Panel/ConsoleRenderCommands.h"
+#include "../Panel/ProfilerPanel.h"
+#include "../Panel/RecentProjectsModel.h"
+#include "../Asset/AssetDatabase.h"
+#include "../Asset/ProjectWatcher.h"
+#include "../Document/EditableScene.h"
+#include "EditorLog.h"
+#include "EditorTheme.h"
+#include "MemoryTracker.h"
+#include "PlaySession.h"
+#include "Profiler.h"
+#include "ProjectLoader.h"
+#include "SceneAutosave.h"
 #include <QtWidgets/QApplication>
+#include <QtWidgets/QMenu>
 #include <QtWidgets/QMenuBar>
 #include <QtWidgets/QToolBar>
 #include <QtWidgets/QDockWidget>
 #include <QtWidgets/QTreeWidget>
 #include <QtWidgets/QHeaderView>
-#include <QtWidgets/QGridLayout>
 #include <QtWidgets/QStatusBar>
-#include <QtWidgets/QVBoxLayout>
-#include <QtWidgets/QHBoxLayout>
-#include <QtWidgets/QComboBox>
 #include <QtWidgets/QLineEdit>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QPushButton>
-#include <QtWidgets/QSlider>
+#include <QtWidgets/QProgressBar>
 #include <QtCore/QDateTime>
+#include <QtGui/QAction>
+#include <QtGui/QCloseEvent>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSettings>
+#include <QtCore/QTimer>
+#include <algorithm>
 
 namespace Orca
 {
+	namespace
+	{
+		// Bump when docks are added, removed or renamed, so stale saved layouts are ignored.
+		constexpr int kLayoutVersion = 2;
+	}
+
 	EditorApp::EditorApp(QWidget* parent) : QMainWindow(parent)
 	{
 		this->setWindowTitle("Orca(R) Studio");
 		this->setMinimumSize(860, 640);
 
-		ApplyDarkTheme();
-
 		SetupMenuBar();
 
-		SceneViewport* viewport = new SceneViewport(this);
-		this->setCentralWidget(viewport);
+		m_assetQueue.setMaxThreadCount(1);
+
+		m_viewport = new SceneViewport(this);
+		m_viewports.push_back(m_viewport);
+		this->setCentralWidget(m_viewport);
+		Editor::RegisterBenchCommand(m_viewport);
+		m_focusedViewport = m_viewport;
+		Editor::RegisterRenderCommands([this]()
+		{
+			std::vector<SceneViewport*> viewports = m_viewports;
+			std::stable_partition(viewports.begin(), viewports.end(), [this](SceneViewport* viewport) { return viewport == m_focusedViewport; });
+			return viewports;
+		},
+		[this](uint32_t entity, bool castsShadows) { SetCastsShadows(entity, castsShadows); });
+
+		// Console commands act on the viewport last clicked into, which keeps its place while the console has focus.
+		QObject::connect(qApp, &QApplication::focusChanged, this, [this](QWidget*, QWidget* now)
+		{
+			if (std::find(m_viewports.begin(), m_viewports.end(), now) != m_viewports.end()) m_focusedViewport = static_cast<SceneViewport*>(now);
+		});
 
 		SetupLeftDocks();
 		SetupRightDock();
+		SetupBottomDock();
+		SetupViewDocks();
         SetupStatusBar();
 
-		QDockWidget* hierarchyDock = this->findChild<QDockWidget*>("HierarchyDock");
 		QDockWidget* projectDock = this->findChild<QDockWidget*>("ProjectDock");
-		if (hierarchyDock && projectDock)
+		if (m_hierarchyDock && projectDock)
 		{
-			this->tabifyDockWidget(hierarchyDock, projectDock);
-			hierarchyDock->raise();
+			this->tabifyDockWidget(m_hierarchyDock, projectDock);
+			m_hierarchyDock->raise();
 		}
+
+		// Replaces the default arrangement above with the one the user left behind, if any.
+		RestoreLayout();
 	}
 
-	void EditorApp::ApplyDarkTheme()
+	EditorApp::~EditorApp()
 	{
-		QString style = R"(QMainWindow { background-color: #1e1e1e; }
-        QMenuBar { background-color: #2d2d2d; color: #ccc; border-bottom: 1px solid #333333; }
-        QMenuBar::item:selected { background-color: #007acc; color: white; }
-        QDockWidget { border: 1px solid #333333; }
-        QDockWidget::title { background: #2d2d2d; padding: 5px; color: #ccc; border-bottom: 1px solid #333333; }
-        QWidget { background-color: #252526; color: #ccc; font-size: 10pt; }
-        QToolBar { background-color: #2d2d2d; border: none; padding: 2px; }
-        QToolButton { color: #ccc; padding: 5px; margin: 2px; }
-        QToolButton:hover { background-color: #3a3a3a; }
-        
-        QTreeWidget { background-color: #252526; border: none; }
-        QTreeWidget::item { padding: 3px 0; }
-        QTreeWidget::item:selected { background-color: #007acc; color: white; }
-
-        QLineEdit, QComboBox, QSlider { 
-            background-color: #333333; 
-            border: 1px solid #444444; 
-            padding: 2px;
-            border-radius: 3px;
-            color: white;
-        }
-        QPushButton { 
-            background-color: #4a4a4a; 
-            border: 1px solid #5a5a5a; 
-            color: white; 
-            padding: 5px; 
-            border-radius: 4px;
-        }
-        QPushButton:hover { background-color: #555555; }
+		for (SceneViewport* viewport : m_viewports) viewport->SetPlaySession(nullptr);
+		m_play.reset();
+		delete m_loader;
+		m_assetQueue.waitForDone();
+	}
+
+	void EditorApp::OpenProject(const QString& projectFile)
+	{
+		m_playAction->setChecked(false);
+
+		// Deleting a loader cancels it and waits for its thread.
+		delete m_loader;
+		m_loader = new ProjectLoader(this);
+		m_autosave.reset();
+		m_scene.reset();
+		m_projectFile = projectFile;
+		++m_hierarchyGeneration;
+
+		this->setWindowTitle(QString("%1 - Orca(R) Studio").arg(QFileInfo(projectFile).completeBaseName()));
+
+		// 64k instances is 4 MB of matrices per frame. Viewports share the instances, so one
+		// upload serves them all.
+		m_loader->SetUploadStep([this](const LoadedScene& scene, size_t first)
+		{
+			return UploadInstances(scene.worldMatrices, first, 65536);
+		});
+
+		QObject::connect(m_loader, &ProjectLoader::stageStarted, this, [this](int stage)
+		{
+			SetStatus(ProjectLoader::StageName(static_cast<ProjectLoadStage>(stage)) + "...", ThemeRole::Text);
+			m_loadProgress->setRange(0, 0);
+			m_loadProgress->show();
+			m_cancelLoad->show();
+		});
+
+		QObject::connect(m_loader, &ProjectLoader::progressChanged, this, [this](int, int done, int total)
+		{
+			m_loadProgress->setRange(0, total);
+			m_loadProgress->setValue(done);
+		});
+
+		QObject::connect(m_loader, &ProjectLoader::assetsReady, this, [this]()
+		{
+			WatchProject(m_loader->TakeAssetDatabase());
+		});
+
+		QObject::connect(m_loader, &ProjectLoader::sceneInstantiated, this, [this]()
+		{
+			std::shared_ptr<const LoadedScene> scene = m_loader->Scene();
+			m_castShadowOverrides.clear();
+			SelectEntity(-1);
+			for (SceneViewport* viewport : m_viewports)
+			{
+				viewport->FrameBounds(QVector3D(scene->boundsCenter[0], scene->boundsCenter[1], scene->boundsCenter[2]), scene->boundsRadius);
+				SetViewportScene(viewport, scene);
+			}
+			FillHierarchy(scene, m_hierarchyGeneration, 0);
+
+			m_scene = std::make_unique<EditableScene>(scene->document);
+			m_autosave = std::make_unique<SceneAutosave>(m_scene.get(), SceneAutosave::AutosavePathFor(m_projectFile));
+			QObject::connect(m_autosave.get(), &SceneAutosave::saved, this, [this](const QString& path, bool ok, const QString& error, qint64 ms)
+			{
+				if (m_loader && m_loader->IsRunning()) return;
+				if (ok) SetStatus(QString("Saved %1 (%2 ms)").arg(QFileInfo(path).fileName()).arg(ms), ThemeRole::Text);
+				else SetStatus(error, ThemeRole::Error);
+			});
+		});
+
+		QObject::connect(m_loader, &ProjectLoader::finished, this, [this](bool ok, const QString& error)
+		{
+			m_loadProgress->hide();
+			m_cancelLoad->hide();
+			if (ok) SetStatus("Ready", ThemeRole::Success);
+			else SetStatus(error, ThemeRole::Error);
+		});
+
+		m_loader->Start(projectFile);
+	}
 
-        QScrollBar:vertical, QScrollBar:horizontal { border: 1px solid #444444; background: #2d2d2d; width: 8px; height: 8px; }
-        QScrollBar::handle:vertical, QScrollBar::handle:horizontal { background: #555555; border-radius: 4px; min-height: 20px; }
-        QScrollBar::add-line, QScrollBar::sub-line { border: none; background: none; })";
+	void EditorApp::SaveProject()
+	{
+		if (!m_autosave) return;
 
-        this->setStyleSheet(style);
+		if (m_projectFile.endsWith(".orcab", Qt::CaseInsensitive))
+		{
+			ORCA_LOG_WARNING("Project", "Binary scenes are not saved from the editor; convert with orca_sceneconvert");
+			return;
+		}
+		m_autosave->SaveNow(m_projectFile);
+	}
+
+	void EditorApp::SetPlaying(bool playing)
+	{
+		if (playing == static_cast<bool>(m_play)) return;
+
+		std::shared_ptr<const LoadedScene> scene = m_loader && !m_loader->IsRunning() ? m_loader->Scene() : nullptr;
+		if (playing)
+		{
+			if (!m_scene || !scene)
+			{
+				ORCA_LOG_WARNING("Play", "Play mode needs a fully loaded project");
+				m_playAction->setChecked(false);
+				return;
+			}
+
+			// The edit scene stays as it is; the session simulates a snapshot of it.
+			m_play = std::make_unique<PlaySession>(m_scene->Snapshot(), scene);
+			for (SceneViewport* viewport : m_viewports) viewport->SetPlaySession(m_play.get());
+			SetStatus("Playing", ThemeRole::Success);
+			return;
+		}
+
+		for (SceneViewport* viewport : m_viewports) viewport->SetPlaySession(nullptr);
+		m_play.reset();
+		if (scene)
+		{
+			UploadInstances(scene->worldMatrices, 0, scene->worldMatrices.size() / 16);
+			for (SceneViewport* viewport : m_viewports) SetViewportScene(viewport, scene);
+		}
+		SetStatus("Ready", ThemeRole::Success);
+	}
+
+	void EditorApp::closeEvent(QCloseEvent* event)
+	{
+		if (!m_projectFile.isEmpty() && (!m_loader || !m_loader->IsRunning()))
+		{
+			RecentProjectsModel::SaveThumbnail(m_projectFile, m_viewport->grabFramebuffer());
+		}
+		SaveLayout();
+		QMainWindow::closeEvent(event);
+	}
+
+	void EditorApp::WatchProject(std::unique_ptr<AssetDatabase> assets)
+	{
+		if (!assets) return;
+
+		delete m_watcher;
+
+		// Refreshes of the old project may still be queued or running. Drop the ones that haven't
+		// started and let the queue delete the database after the one that has, so switching
+		// projects never waits on an import.
+		if (m_assets)
+		{
+			m_assetQueue.clear();
+			m_assets->DetachFromEditorStats();
+			AssetDatabase* previous = m_assets.release();
+			m_assetQueue.start([previous]() { delete previous; });
+		}
+
+		m_assets = std::move(assets);
+		m_assets->AttachToEditorStats(m_assetQueue);
+
+		// Shaders are shared by every viewport, so the central one reloads them for all.
+		m_viewport->SetProjectRoot(m_assets->ProjectRoot());
+
+		m_watcher = new ProjectWatcher(m_assets->ProjectRoot(), this);
+		QObject::connect(m_watcher, &ProjectWatcher::filesChanged, this, [this](const QStringList& paths)
+		{
+			m_viewport->ReloadShaders(paths);
+
+			AssetDatabase* assets = m_assets.get();
+			m_assetQueue.start([assets, paths]() { assets->RefreshPaths(paths); });
+		});
+	}
+
+	void EditorApp::FillHierarchy(std::shared_ptr<const LoadedScene> scene, quint64 generation, size_t first)
+	{
+		if (generation != m_hierarchyGeneration) return;
+
+		if (first == 0)
+		{
+			BuildDock(m_hierarchyDock);
+			m_hierarchyTree->clear();
+			m_hierarchyItems.assign(scene->document->EntityCount(), nullptr);
+			m_hierarchyRoot = new QTreeWidgetItem(m_hierarchyTree, QStringList() << QFileInfo(m_loader->ProjectFile()).completeBaseName());
+			m_hierarchyRoot->setExpanded(true);
+		}
+
+		const size_t end = std::min(first + 2000, scene->hierarchyOrder.size());
+		Editor::AppendHierarchyItems(*scene, first, end, m_hierarchyRoot, m_hierarchyItems);
+
+		if (end < scene->hierarchyOrder.size())
+		{
+			QTimer::singleShot(0, this, [this, scene, generation, end]() { FillHierarchy(scene, generation, end); });
+		}
 	}
 
     void EditorApp::SetupMenuBar()
     {
         QMenuBar* menuBar = new QMenuBar(this);
 
-        menuBar->addMenu(tr("&File"));
+        QMenu* fileMenu = menuBar->addMenu(tr("&File"));
+        QAction* saveAction = fileMenu->addAction(tr("&Save"));
+        saveAction->setShortcut(QKeySequence::Save);
+        connect(saveAction, &QAction::triggered, this, [this]() { SaveProject(); });
+
         menuBar->addMenu(tr("&Edit"));
         menuBar->addMenu(tr("&Project"));
-        menuBar->addMenu(tr("&Window"));
+        QMenu* windowMenu = menuBar->addMenu(tr("&Window"));
+        windowMenu->setObjectName("WindowMenu");
         menuBar->addMenu(tr("&Help"));
         setMenuBar(menuBar);
 
         QToolBar* toolBar = new QToolBar(tr("Controls"), this);
+        toolBar->setObjectName("ControlsToolBar");
         toolBar->setMovable(false);
         toolBar->setFloatable(false);
-        toolBar->setStyleSheet("QToolBar { background-color: #2d2d2d; border-bottom: 1px solid #333333; padding: 0; }");
         addToolBar(Qt::TopToolBarArea, toolBar);
 
+        m_playAction = toolBar->addAction(tr("Play"));
+        m_playAction->setCheckable(true);
+        m_playAction->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_P));
+        m_playAction->setToolTip(tr("Simulate a copy of the scene (Ctrl+P)"));
+        connect(m_playAction, &QAction::toggled, this, [this](bool playing) { SetPlaying(playing); });
+
         toolBar->addSeparator();
     }
 
-    void EditorApp::SetupLeftDocks()
+    QDockWidget* EditorApp::AddLazyDock(const QString& title, const QString& objectName, Qt::DockWidgetArea area, DockBuilder build)
     {
-        QDockWidget* hierarchyDock = new QDockWidget(tr("Hierarchy"), this);
-        hierarchyDock->setObjectName("HierarchyDock");
-        hierarchyDock->setMinimumWidth(200);
-        hierarchyDock->setAllowedAreas(Qt::LeftDockWidgetArea);
+        QDockWidget* dock = new QDockWidget(title, this);
+        dock->setObjectName(objectName);
+        dock->setAllowedAreas(area);
+        m_pendingDocks.emplace(dock, std::move(build));
 
-        QTreeWidget* hierarchyTree = new QTreeWidget();
-        hierarchyTree->setHeaderHidden(true);
-        hierarchyTree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
-        hierarchyTree->setStyleSheet("QTreeWidget { background-color: #252526; }");
+        // Building inside show() would hold back the window's first paint, so it waits a turn of the event loop.
+        QObject::connect(dock, &QDockWidget::visibilityChanged, this, [this, dock](bool visible)
+        {
+            if (visible && m_pendingDocks.count(dock)) QTimer::singleShot(0, this, [this, dock]() { BuildDock(dock); });
+        });
 
-        QTreeWidgetItem* scene = new QTreeWidgetItem(hierarchyTree, QStringList() << "SampleScene");
-        new QTreeWidgetItem(scene, QStringList() << "Main Camera");
-        QTreeWidgetItem* env = new QTreeWidgetItem(scene, QStringList() << "Environment");
-        QTreeWidgetItem* terrain = new QTreeWidgetItem(env, QStringList() << "Terrain");
-        terrain->setFlags(terrain->flags() | Qt::ItemIsUserCheckable);
-        terrain->setCheckState(0, Qt::Checked);
-        new QTreeWidgetItem(terrain, QStringList() << "Building 1");
+        if (QMenu* windowMenu = menuBar()->findChild<QMenu*>("WindowMenu"))
+        {
+            windowMenu->addAction(dock->toggleViewAction());
+        }
+        addDockWidget(area, dock);
+        return dock;
+    }
 
-        hierarchyDock->setWidget(hierarchyTree);
-        addDockWidget(Qt::LeftDockWidgetArea, hierarchyDock);
+    void EditorApp::BuildDock(QDockWidget* dock)
+    {
+        auto pending = m_pendingDocks.find(dock);
+        if (pending == m_pendingDocks.end()) return;
+
+        ORCA_PROFILE_ZONE("EditorApp::BuildDock");
+        MemoryTagScope memoryTag(MemoryTag::UI);
+        DockBuilder build = std::move(pending->second);
+        m_pendingDocks.erase(pending);
+        dock->setWidget(build(dock));
+    }
 
+    void EditorApp::RestoreLayout()
+    {
+        QSettings settings("OrcaStudio", "OrcaStudio");
+        restoreGeometry(settings.value("EditorLayout/Geometry").toByteArray());
+        restoreState(settings.value("EditorLayout/State").toByteArray(), kLayoutVersion);
+    }
 
-        QDockWidget* projectDock = new QDockWidget(tr("Project"), this);
-        projectDock->setObjectName("ProjectDock");
-        projectDock->setMinimumWidth(200);
-        projectDock->setAllowedAreas(Qt::LeftDockWidgetArea);
+    void EditorApp::SaveLayout() const
+    {
+        QSettings settings("OrcaStudio", "OrcaStudio");
+        settings.setValue("EditorLayout/Geometry", saveGeometry());
+        settings.setValue("EditorLayout/State", saveState(kLayoutVersion));
+    }
 
-        QTreeWidget* projectTree = new QTreeWidget();
-        projectTree->setHeaderHidden(true);
-        new QTreeWidgetItem(projectTree, QStringList() << "Assets");
-        new QTreeWidgetItem(projectTree, QStringList() << "Managers");
-        new QTreeWidgetItem(projectTree, QStringList() << "Prefabs");
-        new QTreeWidgetItem(projectTree, QStringList() << "Resources");
+    void EditorApp::SetupLeftDocks()
+    {
+        m_hierarchyDock = AddLazyDock(tr("Hierarchy"), "HierarchyDock", Qt::LeftDockWidgetArea, [this](QDockWidget*) -> QWidget*
+        {
+            QTreeWidget* hierarchyTree = new QTreeWidget();
+            m_hierarchyTree = hierarchyTree;
+            hierarchyTree->setHeaderHidden(true);
+            hierarchyTree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+            QObject::connect(hierarchyTree, &QTreeWidget::currentItemChanged, this, [this](QTreeWidgetItem* item)
+            {
+                const QVariant entity = item ? item->data(0, Qt::UserRole) : QVariant();
+                SelectEntity(entity.isValid() ? entity.toInt() : -1);
+            });
+
+            QTreeWidgetItem* scene = new QTreeWidgetItem(hierarchyTree, QStringList() << "SampleScene");
+            new QTreeWidgetItem(scene, QStringList() << "Main Camera");
+            QTreeWidgetItem* env = new QTreeWidgetItem(scene, QStringList() << "Environment");
+            QTreeWidgetItem* terrain = new QTreeWidgetItem(env, QStringList() << "Terrain");
+            terrain->setFlags(terrain->flags() | Qt::ItemIsUserCheckable);
+            terrain->setCheckState(0, Qt::Checked);
+            new QTreeWidgetItem(terrain, QStringList() << "Building 1");
+            return hierarchyTree;
+        });
+        m_hierarchyDock->setMinimumWidth(200);
 
-        projectDock->setWidget(projectTree);
-        addDockWidget(Qt::LeftDockWidgetArea, projectDock);
+        QDockWidget* projectDock = AddLazyDock(tr("Project"), "ProjectDock", Qt::LeftDockWidgetArea, [](QDockWidget*) -> QWidget*
+        {
+            QTreeWidget* projectTree = new QTreeWidget();
+            projectTree->setHeaderHidden(true);
+            new QTreeWidgetItem(projectTree, QStringList() << "Assets");
+            new QTreeWidgetItem(projectTree, QStringList() << "Managers");
+            new QTreeWidgetItem(projectTree, QStringList() << "Prefabs");
+            new QTreeWidgetItem(projectTree, QStringList() << "Resources");
+            return projectTree;
+        });
+        projectDock->setMinimumWidth(200);
     }
 
     void EditorApp::SetupRightDock()
     {
-        QDockWidget* inspectorDock = new QDockWidget(tr("Inspector"), this);
+        QDockWidget* inspectorDock = AddLazyDock(tr("Inspector"), "InspectorDock", Qt::RightDockWidgetArea, [this](QDockWidget* dock) -> QWidget*
+        {
+            m_inspector = new Editor::InspectorPanel(dock);
+            QObject::connect(m_inspector, &Editor::InspectorPanel::castShadowsChanged, this, [this](int entity, bool castsShadows)
+            {
+                if (entity >= 0) SetCastsShadows(static_cast<uint32_t>(entity), castsShadows);
+            });
+            SelectEntity(m_selectedEntity);
+            return m_inspector->GetWidget();
+        });
         inspectorDock->setMinimumWidth(250);
-        inspectorDock->setAllowedAreas(Qt::RightDockWidgetArea);
+    }
 
-        QWidget* inspectorContent = new QWidget();
-        QVBoxLayout* mainLayout = new QVBoxLayout(inspectorContent);
-        mainLayout->setAlignment(Qt::AlignTop);
-        mainLayout->setContentsMargins(10, 10, 10, 10);
-        mainLayout->setSpacing(15);
+    void EditorApp::SelectEntity(int entity)
+    {
+        m_selectedEntity = entity;
+        if (!m_inspector) return;
 
-        auto createTransformWidget = [=](const QString& label, const QString& value) -> QWidget* 
-        {
-            QWidget* w = new QWidget();
-            QHBoxLayout* hLayout = new QHBoxLayout(w);
-            hLayout->setContentsMargins(0, 0, 0, 0);
-            hLayout->setSpacing(5);
+        m_inspector->SetSelectedEntity(entity);
+        if (entity >= 0) m_inspector->SetCastShadows(m_viewport->Shadows().CastsShadows(static_cast<uint32_t>(entity)));
+    }
 
-            QLabel* l = new QLabel(label);
-            l->setFixedWidth(60);
+    void EditorApp::SetCastsShadows(uint32_t entity, bool castsShadows)
+    {
+        m_castShadowOverrides[entity] = castsShadows;
+        for (SceneViewport* viewport : m_viewports) viewport->SetCastsShadows(entity, castsShadows);
 
-            QLineEdit* x = new QLineEdit(value);
-            x->setStyleSheet("QLineEdit { color: #ff6666; }");
+        // A change from the console shows up in the Inspector's box as well.
+        if (m_inspector && static_cast<int>(entity) == m_selectedEntity) m_inspector->SetCastShadows(castsShadows);
+    }
 
-            QLineEdit* y = new QLineEdit(value);
-            y->setStyleSheet("QLineEdit { color: #66ff66; }");
+    void EditorApp::SetupBottomDock()
+    {
+        QDockWidget* consoleDock = AddLazyDock(tr("Console"), "ConsoleDock", Qt::BottomDockWidgetArea, [](QDockWidget* dock) -> QWidget*
+        {
+            Editor::ConsolePanel* console = new Editor::ConsolePanel(dock);
+            return console->GetWidget();
+        });
+        consoleDock->setMinimumHeight(150);
 
-            QLineEdit* z = new QLineEdit(value);
-            z->setStyleSheet("QLineEdit { color: #6666ff; }");
+        QDockWidget* profilerDock = AddLazyDock(tr("Profiler"), "ProfilerDock", Qt::BottomDockWidgetArea, [](QDockWidget* dock) -> QWidget*
+        {
+            Editor::ProfilerPanel* profiler = new Editor::ProfilerPanel(dock);
+            return profiler->GetWidget();
+        });
+        profilerDock->setMinimumHeight(150);
+        tabifyDockWidget(consoleDock, profilerDock);
+        consoleDock->raise();
+    }
 
-            hLayout->addWidget(l);
-            hLayout->addWidget(x);
-            hLayout->addWidget(y);
-            hLayout->addWidget(z);
-            return w;
+    void EditorApp::SetupViewDocks()
+    {
+        // More views of the scene, sharing the central viewport's GPU resources. They sit behind
+        // the Inspector tab, and a view that isn't showing is never built, ticked or painted.
+        QDockWidget* inspectorDock = this->findChild<QDockWidget*>("InspectorDock");
+        auto addView = [this, inspectorDock](const QString& title, const QString& objectName, ViewportCamera camera)
+        {
+            QDockWidget* dock = AddLazyDock(title, objectName, Qt::RightDockWidgetArea, [this, camera](QDockWidget* parent) -> QWidget*
+            {
+                SceneViewport* viewport = new SceneViewport(parent, camera);
+                AttachViewport(viewport);
+                return viewport;
+            });
+            dock->setMinimumWidth(250);
+            if (inspectorDock) tabifyDockWidget(inspectorDock, dock);
         };
 
-        mainLayout->addWidget(new QLabel("<h4>Static</h4>"));
-        QWidget* tagLayer = new QWidget();
-        QGridLayout* gLayout = new QGridLayout(tagLayer);
-        gLayout->setContentsMargins(0, 0, 0, 0);
-
-        gLayout->addWidget(new QLabel("Tag"), 0, 0);
-        QComboBox* tagCombo = new QComboBox();
-        tagCombo->addItem("Nothing");
-        gLayout->addWidget(tagCombo, 0, 1);
-
-        gLayout->addWidget(new QLabel("Layer"), 1, 0);
-        QComboBox* layerCombo = new QComboBox();
-        layerCombo->addItem("Default");
-        gLayout->addWidget(layerCombo, 1, 1);
-        mainLayout->addWidget(tagLayer);
-
-        mainLayout->addWidget(new QLabel("<h4>Transform</h4>"));
-        mainLayout->addWidget(createTransformWidget("Position", "0.0"));
-        mainLayout->addWidget(createTransformWidget("Rotation", "0.0"));
-        mainLayout->addWidget(createTransformWidget("Scale", "1.0"));
-
-        mainLayout->addWidget(new QLabel("<h4>Terrain</h4>"));
+        addView(tr("Top View"), "TopViewDock", ViewportCamera::Top);
+        addView(tr("Front View"), "FrontViewDock", ViewportCamera::Front);
+        addView(tr("Game View"), "GameViewDock", ViewportCamera::Game);
+        if (inspectorDock) inspectorDock->raise();
+    }
 
-        QLabel* pixelErrorLabel = new QLabel("Pixel Error: 50");
-        QSlider* pixelErrorSlider = new QSlider(Qt::Horizontal);
-        pixelErrorSlider->setRange(1, 500);
-        pixelErrorSlider->setValue(50);
+    void EditorApp::AttachViewport(SceneViewport* viewport)
+    {
+        m_viewports.push_back(viewport);
 
-        QObject::connect(pixelErrorSlider, &QSlider::valueChanged, [=](int value)
+        // Catch up with the open scene; its instances are already uploaded and shared.
+        std::shared_ptr<const LoadedScene> scene = m_loader ? m_loader->Scene() : nullptr;
+        if (scene)
         {
-            pixelErrorLabel->setText(QString("Pixel Error: %1").arg(value));
-        });
+            viewport->FrameBounds(QVector3D(scene->boundsCenter[0], scene->boundsCenter[1], scene->boundsCenter[2]), scene->boundsRadius);
+            SetViewportScene(viewport, scene);
+        }
+        viewport->SetPlaySession(m_play.get());
+    }
 
-        mainLayout->addWidget(pixelErrorLabel);
-        mainLayout->addWidget(pixelErrorSlider);
+    size_t EditorApp::UploadInstances(const std::vector<float>& matrices, size_t first, size_t maxCount)
+    {
+        // The instances are shared, so any viewport with a context can upload them for all.
+        for (SceneViewport* viewport : m_viewports)
+        {
+            if (viewport->isValid()) return viewport->UploadInstances(matrices, first, maxCount);
+        }
+        return 0;
+    }
 
-        QPushButton* addComponent = new QPushButton("Add Component");
-        mainLayout->addWidget(addComponent);
+    void EditorApp::SetViewportScene(SceneViewport* viewport, std::shared_ptr<const LoadedScene> scene)
+    {
+        viewport->SetScene(std::move(scene));
+        for (const auto& [entity, castsShadows] : m_castShadowOverrides) viewport->SetCastsShadows(entity, castsShadows);
+    }
 
-        inspectorDock->setWidget(inspectorContent);
-        addDockWidget(Qt::RightDockWidgetArea, inspectorDock);
+    void EditorApp::SetStatus(const QString& text, ThemeRole role)
+    {
+        m_statusLabel->setText(text);
+        EditorTheme::SetTextRole(m_statusLabel, role);
     }
 
     void EditorApp::SetupStatusBar()
     {
         QStatusBar* statusBar = new QStatusBar(this);
-        statusBar->setStyleSheet("QStatusBar { background-color: #2d2d2d; border-top: 1px solid #333333; color: #ccc; }");
 
-        QLabel* statusReady = new QLabel("<span style='color: #00b000;'>Ready</span>");
+        QLabel* statusReady = new QLabel();
+        statusReady->setTextFormat(Qt::PlainText);
+        m_statusLabel = statusReady;
+        SetStatus("Ready", ThemeRole::Success);
+
+        m_loadProgress = new QProgressBar();
+        m_loadProgress->setFixedWidth(160);
+        m_loadProgress->setTextVisible(false);
+        m_loadProgress->hide();
+
+        m_cancelLoad = new QPushButton(tr("Cancel"));
+        m_cancelLoad->hide();
+        QObject::connect(m_cancelLoad, &QPushButton::clicked, this, [this]()
+        {
+            if (m_loader) m_loader->Cancel();
+        });
         QLabel* statusTime = new QLabel(QDateTime::currentDateTime().toString("hh:mm AP MM/dd/yyyy"));
 
         QLineEdit* commandInput = new QLineEdit();
         commandInput->setPlaceholderText("Search for documentation or tools...");
         commandInput->setFixedWidth(300);
-        commandInput->setStyleSheet("QLineEdit { background-color: #3a3a3a; border: 1px solid #444444; }");
 
         statusBar->addWidget(statusReady);
+        statusBar->addWidget(m_loadProgress);
+        statusBar->addWidget(m_cancelLoad);
         statusBar->addWidget(commandInput);
         statusBar->addPermanentWidget(statusTime);
 
@@ -3,21 +3,147 @@
 #ifndef EDITOR_APP_H
 #define EDITOR_APP_H
 
+#include <QtCore/QThreadPool>
 #include <QtWidgets/QMainWindow>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class QAction;
+class QDockWidget;
+class QLabel;
+class QProgressBar;
+class QPushButton;
+class QTreeWidget;
+class QTreeWidgetItem;
 
 namespace Orca
 {
+	class AssetDatabase;
+	class EditableScene;
+	class PlaySession;
+	class ProjectLoader;
+	class ProjectWatcher;
+	class SceneAutosave;
+	class SceneViewport;
+	struct LoadedScene;
+	enum class ThemeRole;
+
+	namespace Editor { class InspectorPanel; }
+
 	class EditorApp : public QMainWindow
 	{
 	public:
 		explicit EditorApp(QWidget* parent = nullptr);
+		~EditorApp() override;
+
+		/**
+		 * @brief Loads a project (.orca file) in the background and returns immediately.
+		 *        Progress shows in the status bar, and the hierarchy and viewport fill in
+		 *        as each loading stage finishes.
+		 */
+		void OpenProject(const QString& projectFile);
+
+		/** @brief Writes the open scene back to the project file in the background (File > Save). */
+		void SaveProject();
+
+		/**
+		 * @brief Enters play mode on a clone of the open scene, or leaves it and shows the edit
+		 *        scene again. Needs a fully loaded project.
+		 */
+		void SetPlaying(bool playing);
+
+	protected:
+		/** @brief Leaves a scene thumbnail behind for the welcome screen and saves the dock layout. */
+		void closeEvent(QCloseEvent* event) override;
 
 	private:
-		void ApplyDarkTheme();
+		/**
+		 * @brief Takes over the project's asset database and starts watching the project directory.
+		 *        Each batch of changes reimports off the GUI thread and reloads affected shaders.
+		 */
+		void WatchProject(std::unique_ptr<AssetDatabase> assets);
+
+		/** @brief Adds hierarchy items a slice at a time so big scenes don't stall the event loop. */
+		void FillHierarchy(std::shared_ptr<const LoadedScene> scene, quint64 generation, size_t first);
+
+		using DockBuilder = std::function<QWidget*(QDockWidget* dock)>;
+
+		/**
+		 * @brief Adds an empty dock whose contents are built the first time it is shown, so
+		 *        tabbed-away and closed docks cost nothing at start-up.
+		 */
+		QDockWidget* AddLazyDock(const QString& title, const QString& objectName, Qt::DockWidgetArea area, DockBuilder build);
+
+		/** @brief Builds a lazy dock's contents now, if that hasn't happened yet. */
+		void BuildDock(QDockWidget* dock);
+
+		void RestoreLayout();
+		void SaveLayout() const;
+
 		void SetupMenuBar();
 		void SetupLeftDocks();
 		void SetupRightDock();
+		void SetupBottomDock();
+		void SetupViewDocks();
 		void SetupStatusBar();
+
+		/** @brief Adds a viewport to the ones showing the scene and brings it up to date. */
+		void AttachViewport(SceneViewport* viewport);
+
+		/**
+		 * @brief SceneViewport::UploadInstances() through whichever viewport has a GL context.
+		 * @return Number of instances uploaded; 0 while no viewport has been shown yet.
+		 */
+		size_t UploadInstances(const std::vector<float>& matrices, size_t first, size_t maxCount);
+
+		/** @brief SceneViewport::SetScene() plus the Cast Shadows changes made in the Inspector. */
+		void SetViewportScene(SceneViewport* viewport, std::shared_ptr<const LoadedScene> scene);
+
+		/** @brief Shows an entity in the Inspector, or that nothing is selected for -1. */
+		void SelectEntity(int entity);
+
+		/** @brief Applies an Inspector Cast Shadows change to every viewport, and to views built later. */
+		void SetCastsShadows(uint32_t entity, bool castsShadows);
+
+		/** @brief Shows plain text in the status bar, drawn in the given theme role. */
+		void SetStatus(const QString& text, ThemeRole role);
+
+		SceneViewport* m_viewport = nullptr;           // the central, perspective one
+		std::vector<SceneViewport*> m_viewports;       // m_viewport and every view dock built so far
+		SceneViewport* m_focusedViewport = nullptr;    // the last one to have focus; render console commands act on it
+		QDockWidget* m_hierarchyDock = nullptr;
+		QTreeWidget* m_hierarchyTree = nullptr;
+		Editor::InspectorPanel* m_inspector = nullptr; // null until its dock is first shown
+		int m_selectedEntity = -1;
+		std::unordered_map<uint32_t, bool> m_castShadowOverrides;   // of the open scene, by entity
+		std::unordered_map<QDockWidget*, DockBuilder> m_pendingDocks;
+		QLabel* m_statusLabel = nullptr;
+		QProgressBar* m_loadProgress = nullptr;
+		QPushButton* m_cancelLoad = nullptr;
+
+		QString m_projectFile;
+		ProjectLoader* m_loader = nullptr;
+		quint64 m_hierarchyGeneration = 0;
+		QTreeWidgetItem* m_hierarchyRoot = nullptr;
+		std::vector<QTreeWidgetItem*> m_hierarchyItems;
+
+		ProjectWatcher* m_watcher = nullptr;
+		std::unique_ptr<AssetDatabase> m_assets;
+
+		// The autosave reads the scene, so it is declared after it and destroyed first.
+		std::unique_ptr<EditableScene> m_scene;
+		std::unique_ptr<SceneAutosave> m_autosave;
+
+		QAction* m_playAction = nullptr;
+		std::unique_ptr<PlaySession> m_play;
+
+		// One thread, so watcher batches are applied to the database in order; a replaced
+		// database is deleted on it after its last batch. Declared after m_assets so queued
+		// refreshes finish before the database goes away.
+		QThreadPool m_assetQueue;
 	};
 }
 
@@ -0,0 +1,301 @@
+#include "EditorLog.h"
+#include "LogStore.h"
+#include "EditorStats.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QTimer>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace Orca
+{
+	namespace
+	{
+		BinaryLogWriter s_writer;
+		std::atomic<int> s_minimumSeverity{ static_cast<int>(LogSeverity::Debug) };
+		QtMessageHandler s_previousHandler = nullptr;
+
+		constexpr int64_t kRateWindowMs = 1000;
+		std::atomic<uint32_t> s_rateLimit{ 100 };
+
+		// A message logged more often than the limit, keyed by its site and argument hash.
+		struct MessageFlood
+		{
+			const LogSite* site = nullptr;
+			std::vector<uint8_t> args;
+			uint8_t argCount = 0;
+			int64_t windowStartMs = 0;
+			uint32_t windowCount = 0;
+			uint32_t suppressed = 0;
+		};
+
+		// Only sites over the limit come here, so the common path stays lock free.
+		QMutex s_floodingMutex;
+		QHash<size_t, MessageFlood> s_floodingMessages;
+
+		int64_t SteadyNowNs()
+		{
+			using namespace std::chrono;
+			return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+		}
+
+		int64_t UnixNowNs()
+		{
+			using namespace std::chrono;
+			return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+		}
+
+		LogSeverity SeverityFromQt(QtMsgType type)
+		{
+			switch (type)
+			{
+			case QtDebugMsg: return LogSeverity::Debug;
+			case QtInfoMsg: return LogSeverity::Info;
+			case QtWarningMsg: return LogSeverity::Warning;
+			case QtCriticalMsg: return LogSeverity::Error;
+			case QtFatalMsg: return LogSeverity::Fatal;
+			}
+			return LogSeverity::Info;
+		}
+
+		/**
+		 * Qt hands us already formatted text, so every qDebug() from one category
+		 * shares a single "{}" format and the text travels as its argument.
+		 */
+		void QtMessageToLog(QtMsgType type, const QMessageLogContext& context, const QString& message)
+		{
+			static QMutex s_sitesMutex;
+			static QHash<QByteArray, LogSite*> s_sites;
+
+			LogSeverity severity = SeverityFromQt(type);
+			QByteArray category = context.category ? QByteArray(context.category) : QByteArray("qt");
+			QByteArray key = category + '/' + QByteArray::number(static_cast<int>(severity));
+
+			const LogSite* site = nullptr;
+			{
+				QMutexLocker locker(&s_sitesMutex);
+				LogSite*& cached = s_sites[key];
+				if (!cached)
+				{
+					// Sites live for the whole process, like the static ones ORCA_LOG creates.
+					char* persistentCategory = qstrdup(category.constData());
+					cached = new LogSite(severity, persistentCategory, "{}");
+				}
+				site = cached;
+			}
+
+			EditorLog::Write(*site, "{}", message);
+
+			if (s_previousHandler)
+			{
+				s_previousHandler(type, context, message);
+			}
+		}
+	}
+
+	LogSite::LogSite(LogSeverity logSeverity, const char* logCategory, const char* logFormat)
+		: severity(logSeverity), category(logCategory), format(logFormat),
+		  formatId(BinaryLogFormatTable::Get().Register(logSeverity, logCategory, logFormat)),
+		  categoryId(LogStore::Get().RegisterCategory(logCategory))
+	{
+	}
+
+	bool EditorLog::Initialize(const QString& logDirectory)
+	{
+		if (!QDir().mkpath(logDirectory))
+		{
+			return false;
+		}
+
+		BinaryLogWriterSettings settings;
+		settings.basePath = QDir(logDirectory).filePath("OrcaStudio").toStdString();
+		if (!s_writer.Open(settings))
+		{
+			return false;
+		}
+
+		s_previousHandler = qInstallMessageHandler(QtMessageToLog);
+		EditorStats::Get().RegisterMemoryReporter("Logging", [] { return LogStore::Get().MemoryBytes(); });
+
+		// Low-severity events sit in the buffer until it fills; this bounds how stale the file can get.
+		if (QCoreApplication* app = QCoreApplication::instance())
+		{
+			QTimer* flushTimer = new QTimer(app);
+			QObject::connect(flushTimer, &QTimer::timeout, []
+			{
+				EditorLog::ReportSuppressed();
+				EditorLog::Flush();
+			});
+			flushTimer->start(2000);
+		}
+
+		ORCA_LOG_INFO("Log", "Binary log opened at {}", CurrentLogPath());
+		return true;
+	}
+
+	void EditorLog::Shutdown()
+	{
+		if (s_previousHandler)
+		{
+			qInstallMessageHandler(s_previousHandler);
+			s_previousHandler = nullptr;
+		}
+		s_writer.Close();
+	}
+
+	void EditorLog::Flush()
+	{
+		s_writer.Flush();
+	}
+
+	QString EditorLog::CurrentLogPath()
+	{
+		return QString::fromStdString(s_writer.CurrentPath());
+	}
+
+	uint64_t EditorLog::BytesWritten()
+	{
+		return s_writer.BytesWritten();
+	}
+
+	bool EditorLog::IsEnabled(LogSeverity severity)
+	{
+		return static_cast<int>(severity) >= s_minimumSeverity.load(std::memory_order_relaxed);
+	}
+
+	void EditorLog::SetMinimumSeverity(LogSeverity severity)
+	{
+		s_minimumSeverity.store(static_cast<int>(severity), std::memory_order_relaxed);
+	}
+
+	void EditorLog::SetRateLimit(uint32_t eventsPerSecond)
+	{
+		s_rateLimit.store(eventsPerSecond, std::memory_order_relaxed);
+	}
+
+	bool EditorLog::AdmitSite(const LogSite& site)
+	{
+		const uint32_t limit = s_rateLimit.load(std::memory_order_relaxed);
+		if (limit == 0) return true;
+
+		// Once a site floods, every one of its messages is limited on its own until the floods end.
+		LogSite::RateLimit& state = site.rateLimit;
+		if (state.floods.load(std::memory_order_relaxed) > 0) return false;
+
+		const int64_t nowMs = SteadyNowNs() / 1000000;
+
+		int64_t windowStart = state.windowStartMs.load(std::memory_order_relaxed);
+		if (nowMs - windowStart >= kRateWindowMs &&
+			state.windowStartMs.compare_exchange_strong(windowStart, nowMs, std::memory_order_relaxed))
+		{
+			state.windowCount.store(0, std::memory_order_relaxed);
+		}
+
+		// A site under the limit can't be repeating any one message too often.
+		return state.windowCount.fetch_add(1, std::memory_order_relaxed) < limit;
+	}
+
+	bool EditorLog::AdmitMessage(const LogSite& site, size_t key, bool& firstOfFlood)
+	{
+		// Busy sites are limited per message: "{}" passthroughs and sites like
+		// "Failed to import {}: {}" log many different lines that must not drop each other.
+		const uint32_t limit = s_rateLimit.load(std::memory_order_relaxed);
+		LogSite::RateLimit& state = site.rateLimit;
+		const int64_t nowMs = SteadyNowNs() / 1000000;
+
+		QMutexLocker locker(&s_floodingMutex);
+		MessageFlood& flood = s_floodingMessages[key];
+		if (!flood.site)
+		{
+			flood.site = &site;
+			flood.windowStartMs = nowMs;
+			firstOfFlood = true;
+			state.floods.fetch_add(1, std::memory_order_relaxed);
+
+			// The site's own counter let its events through this window without telling messages
+			// apart; charge them all to this one so it doesn't get a second allowance on top.
+			if (nowMs - state.windowStartMs.load(std::memory_order_relaxed) < kRateWindowMs)
+			{
+				flood.windowCount = state.windowCount.load(std::memory_order_relaxed);
+			}
+		}
+		else if (nowMs - flood.windowStartMs >= kRateWindowMs)
+		{
+			flood.windowStartMs = nowMs;
+			flood.windowCount = 0;
+		}
+
+		if (flood.windowCount++ < limit)
+		{
+			return true;
+		}
+		++flood.suppressed;
+		return false;
+	}
+
+	void EditorLog::RememberFlood(size_t key, const BinaryLogArgs& args)
+	{
+		QMutexLocker locker(&s_floodingMutex);
+		auto flood = s_floodingMessages.find(key);
+		if (flood == s_floodingMessages.end() || !flood->args.empty()) return;
+
+		flood->args = args.Bytes();
+		flood->argCount = args.Count();
+	}
+
+	void EditorLog::ReportSuppressed()
+	{
+		struct Dropped
+		{
+			const LogSite* site;
+			std::string message;
+			uint32_t count;
+		};
+		std::vector<Dropped> dropped;
+
+		const int64_t nowMs = SteadyNowNs() / 1000000;
+		{
+			QMutexLocker locker(&s_floodingMutex);
+			for (auto it = s_floodingMessages.begin(); it != s_floodingMessages.end();)
+			{
+				// Keep counting while the flood is ongoing; summarise once per quiet window.
+				MessageFlood& flood = it.value();
+				if (nowMs - flood.windowStartMs < kRateWindowMs)
+				{
+					++it;
+					continue;
+				}
+
+				if (flood.suppressed > 0)
+				{
+					dropped.push_back({ flood.site,
+						FormatBinaryLogMessage(flood.site->format, flood.args.data(), flood.args.size(), flood.argCount),
+						flood.suppressed });
+				}
+				flood.site->rateLimit.floods.fetch_sub(1, std::memory_order_relaxed);
+				it = s_floodingMessages.erase(it);
+			}
+		}
+
+		// Logged outside the lock: the summaries go through Admit themselves.
+		for (const Dropped& entry : dropped)
+		{
+			ORCA_LOG_WARNING("Log", "Suppressed {} repeats of <{}> \"{}\"", entry.count, entry.site->category, entry.message);
+		}
+	}
+
+	void EditorLog::Submit(const LogSite& site, const BinaryLogArgs& args)
+	{
+		s_writer.Write(site.formatId, SteadyNowNs(), args);
+		LogStore::Get().Append(site.formatId, site.severity, site.categoryId, UnixNowNs(), args);
+
+		// Anything that might precede a crash goes to disk immediately.
+		if (site.severity >= LogSeverity::Error)
+		{
+			s_writer.Flush();
+		}
+	}
+}
\ No newline at end of file
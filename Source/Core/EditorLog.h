@@ -0,0 +1,156 @@
+#pragma once
+
+#ifndef EDITOR_LOG_H
+#define EDITOR_LOG_H
+
+#include "BinaryLog.h"
+#include <QtCore/QString>
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <atomic>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace Orca
+{
+	/**
+	 * @brief A log call site. Created once per ORCA_LOG statement, so the format
+	 *        string is registered a single time and later calls only pack arguments.
+	 */
+	struct LogSite
+	{
+		LogSite(LogSeverity logSeverity, const char* logCategory, const char* logFormat);
+
+		LogSeverity severity;
+		const char* category;
+		const char* format;
+		uint32_t formatId;
+		uint16_t categoryId;
+
+		/** Events this site logged in the current window; see EditorLog::SetRateLimit. */
+		struct RateLimit
+		{
+			std::atomic<int64_t> windowStartMs{ 0 };
+			std::atomic<uint32_t> windowCount{ 0 };
+			std::atomic<uint32_t> floods{ 0 };     // its messages being limited one by one
+		};
+		mutable RateLimit rateLimit;
+	};
+
+	template<typename... Args>
+	constexpr const char* LogFormatOf(const char* format, const Args&...) { return format; }
+
+	/**
+	 * @brief Editor-wide structured logger backed by the binary log writer.
+	 */
+	class EditorLog
+	{
+	public:
+		/**
+		 * @brief Opens the rotating log under the given directory and routes qDebug()/qWarning() into it.
+		 */
+		static bool Initialize(const QString& logDirectory);
+		static void Shutdown();
+		static void Flush();
+
+		static QString CurrentLogPath();
+		static uint64_t BytesWritten();
+
+		template<typename... Args>
+		static void Write(const LogSite& site, const char* /*format*/, const Args&... args)
+		{
+			if (!IsEnabled(site.severity)) return;
+
+			// Over the limit, messages are told apart by a hash of the raw arguments, so a
+			// suppressed repeat is never formatted or packed.
+			bool firstOfFlood = false;
+			size_t key = 0;
+			bool admitted = AdmitSite(site);
+			if (!admitted)
+			{
+				key = qHash(&site);
+				((key = HashArg(key, args)), ...);
+				admitted = AdmitMessage(site, key, firstOfFlood);
+				if (!admitted && !firstOfFlood) return;
+			}
+
+			BinaryLogArgs packed;
+			(PackArg(packed, args), ...);
+			if (firstOfFlood) RememberFlood(key, packed);
+			if (admitted) Submit(site, packed);
+		}
+
+		static bool IsEnabled(LogSeverity severity);
+		static void SetMinimumSeverity(LogSeverity severity);
+
+		/**
+		 * @brief Caps how many times one message, a call site with the same arguments, may be
+		 *        logged per second (0 = unlimited). Excess repeats are counted and summarised once
+		 *        the flood ends; other messages from the same site still get through, except in
+		 *        the second the site first went over, whose events all count against the flood.
+		 */
+		static void SetRateLimit(uint32_t eventsPerSecond);
+
+		/**
+		 * @brief Emits the "suppressed N repeats" summary for messages whose flood has ended.
+		 */
+		static void ReportSuppressed();
+
+	private:
+		/** @brief Counts an event against its site; false once the site is over the limit. */
+		static bool AdmitSite(const LogSite& site);
+
+		/**
+		 * @brief Counts an event against its message, keyed by site and argument hash. Sets
+		 *        @p firstOfFlood when the message wasn't being limited yet, so the caller packs
+		 *        its arguments once for RememberFlood().
+		 */
+		static bool AdmitMessage(const LogSite& site, size_t key, bool& firstOfFlood);
+
+		/** @brief Keeps the arguments of a new flood for its "suppressed" summary. */
+		static void RememberFlood(size_t key, const BinaryLogArgs& args);
+
+		// Same dispatch as BinaryLogArgs::Add, without packing.
+		template<typename T>
+		static size_t HashArg(size_t seed, const T& value)
+		{
+			if constexpr (std::is_same_v<T, char*> || std::is_same_v<T, const char*>) return HashArg(seed, static_cast<const char*>(value));
+			else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+			{
+				const std::string_view text(value);
+				return qHashBits(text.data(), text.size(), seed);
+			}
+			else return qHashBits(&value, sizeof(value), seed);
+		}
+
+		static size_t HashArg(size_t seed, const char* value) { return value ? qHashBits(value, std::strlen(value), seed) : seed ^ 1; }
+		static size_t HashArg(size_t seed, const QString& value) { return qHash(value, seed); }
+		static size_t HashArg(size_t seed, const QByteArray& value) { return qHash(value, seed); }
+
+		template<typename T>
+		static void PackArg(BinaryLogArgs& packed, const T& value) { packed.Add(value); }
+
+		static void PackArg(BinaryLogArgs& packed, const QString& value) { packed.AddString(value.toUtf8().toStdString()); }
+		static void PackArg(BinaryLogArgs& packed, const QByteArray& value) { packed.AddString(std::string_view(value.constData(), value.size())); }
+
+		static void Submit(const LogSite& site, const BinaryLogArgs& args);
+	};
+}
+
+/**
+ * Usage: ORCA_LOG(Orca::LogSeverity::Warning, "Renderer", "Shader {} failed to link ({} attempts)", name, attempts);
+ * Arguments are packed as-is; the message text is only built when a reader renders the event.
+ */
+#define ORCA_LOG(severity, category, ...) \
+	do { \
+		static const ::Orca::LogSite orcaLogSite_(severity, category, ::Orca::LogFormatOf(__VA_ARGS__)); \
+		::Orca::EditorLog::Write(orcaLogSite_, __VA_ARGS__); \
+	} while (0)
+
+#define ORCA_LOG_DEBUG(category, ...) ORCA_LOG(::Orca::LogSeverity::Debug, category, __VA_ARGS__)
+#define ORCA_LOG_INFO(category, ...) ORCA_LOG(::Orca::LogSeverity::Info, category, __VA_ARGS__)
+#define ORCA_LOG_WARNING(category, ...) ORCA_LOG(::Orca::LogSeverity::Warning, category, __VA_ARGS__)
+#define ORCA_LOG_ERROR(category, ...) ORCA_LOG(::Orca::LogSeverity::Error, category, __VA_ARGS__)
+
+#endif
\ No newline at end of file
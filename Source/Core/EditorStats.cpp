@@ -0,0 +1,200 @@
+#include "EditorStats.h"
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Orca
+{
+	namespace
+	{
+		// Exponential moving average; ~20 frames to settle.
+		constexpr double kSmoothing = 0.1;
+
+		double Smooth(double previous, double sample)
+		{
+			return previous == 0.0 ? sample : previous + (sample - previous) * kSmoothing;
+		}
+
+		qint64 MonotonicNs()
+		{
+			static QElapsedTimer s_clock;
+			if (!s_clock.isValid()) s_clock.start();
+			return s_clock.nsecsElapsed();
+		}
+
+		template <typename Entries, typename Value>
+		void Replace(Entries& entries, const QString& name, Value value)
+		{
+			for (auto& entry : entries)
+			{
+				if (entry.first == name)
+				{
+					entry.second = std::move(value);
+					return;
+				}
+			}
+			entries.append({ name, std::move(value) });
+		}
+
+		template <typename Entries>
+		void Remove(Entries& entries, const QString& name)
+		{
+			entries.removeIf([&name](const auto& entry) { return entry.first == name; });
+		}
+	}
+
+	EditorStats& EditorStats::Get()
+	{
+		static EditorStats s_stats;
+		return s_stats;
+	}
+
+	void EditorStats::RecordFrame(double cpuMs, uint32_t drawCalls, uint64_t triangles, uint64_t heapAllocations)
+	{
+		QMutexLocker locker(&m_mutex);
+
+		qint64 now = MonotonicNs();
+		if (m_lastFrameNs != 0)
+		{
+			m_frame.frameIntervalMs = Smooth(m_frame.frameIntervalMs, (now - m_lastFrameNs) / 1e6);
+		}
+		m_lastFrameNs = now;
+
+		++m_frame.frameIndex;
+		m_frame.cpuMs = Smooth(m_frame.cpuMs, cpuMs);
+		m_frame.drawCalls = drawCalls;
+		m_frame.triangles = triangles;
+		m_frame.heapAllocations = heapAllocations;
+	}
+
+	void EditorStats::RecordGpuTime(double gpuMs)
+	{
+		QMutexLocker locker(&m_mutex);
+		m_frame.gpuMs = Smooth(m_frame.gpuMs, gpuMs);
+	}
+
+	FrameStats EditorStats::Frame() const
+	{
+		QMutexLocker locker(&m_mutex);
+		return m_frame;
+	}
+
+	void EditorStats::SetSceneCounts(uint32_t entities, uint32_t components)
+	{
+		QMutexLocker locker(&m_mutex);
+		m_entityCount = entities;
+		m_componentCount = components;
+	}
+
+	uint32_t EditorStats::EntityCount() const
+	{
+		QMutexLocker locker(&m_mutex);
+		return m_entityCount;
+	}
+
+	uint32_t EditorStats::ComponentCount() const
+	{
+		QMutexLocker locker(&m_mutex);
+		return m_componentCount;
+	}
+
+	void EditorStats::RegisterMemoryReporter(const QString& subsystem, MemoryReporter reporter)
+	{
+		QMutexLocker locker(&m_mutex);
+		Replace(m_memoryReporters, subsystem, std::move(reporter));
+	}
+
+	void EditorStats::UnregisterMemoryReporter(const QString& subsystem)
+	{
+		QMutexLocker locker(&m_mutex);
+		Remove(m_memoryReporters, subsystem);
+	}
+
+	QVector<QPair<QString, uint64_t>> EditorStats::MemoryReport() const
+	{
+		QVector<QPair<QString, MemoryReporter>> reporters;
+		{
+			QMutexLocker locker(&m_mutex);
+			reporters = m_memoryReporters;
+		}
+
+		// Reporters may take their own locks, so they run outside ours.
+		QVector<QPair<QString, uint64_t>> report;
+		for (const auto& reporter : reporters)
+		{
+			report.append({ reporter.first, reporter.second() });
+		}
+		return report;
+	}
+
+	void EditorStats::RegisterReclaimer(const QString& name, Reclaimer reclaimer)
+	{
+		QMutexLocker locker(&m_mutex);
+		Replace(m_reclaimers, name, std::move(reclaimer));
+	}
+
+	void EditorStats::UnregisterReclaimer(const QString& name)
+	{
+		QMutexLocker locker(&m_mutex);
+		Remove(m_reclaimers, name);
+	}
+
+	QStringList EditorStats::ReclaimerNames() const
+	{
+		QMutexLocker locker(&m_mutex);
+		QStringList names;
+		for (const auto& reclaimer : m_reclaimers) names.append(reclaimer.first);
+		return names;
+	}
+
+	bool EditorStats::Reclaim(const QString& name, ReclaimDone done)
+	{
+		Reclaimer reclaimer;
+		{
+			QMutexLocker locker(&m_mutex);
+			for (const auto& entry : m_reclaimers)
+			{
+				if (entry.first == name) reclaimer = entry.second;
+			}
+		}
+
+		if (!reclaimer) return false;
+		reclaimer(std::move(done));
+		return true;
+	}
+
+	uint64_t EditorStats::ProcessResidentBytes()
+	{
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS counters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		{
+			return counters.WorkingSetSize;
+		}
+		return 0;
+#elif defined(__APPLE__)
+		mach_task_basic_info info;
+		mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+		if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+		{
+			return info.resident_size;
+		}
+		return 0;
+#else
+		QFile statm("/proc/self/statm");
+		if (!statm.open(QIODevice::ReadOnly)) return 0;
+
+		QList<QByteArray> fields = statm.readAll().split(' ');
+		if (fields.size() < 2) return 0;
+		return fields[1].toULongLong() * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+	}
+}
\ No newline at end of file
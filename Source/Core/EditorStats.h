@@ -0,0 +1,88 @@
+#pragma once
+
+#ifndef EDITOR_STATS_H
+#define EDITOR_STATS_H
+
+#include <QtCore/QMutex>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+#include <cstdint>
+#include <functional>
+
+namespace Orca
+{
+	struct FrameStats
+	{
+		uint64_t frameIndex = 0;
+		double cpuMs = 0.0;           // smoothed time spent in paintGL
+		double gpuMs = 0.0;           // smoothed GPU time from timer queries
+		double frameIntervalMs = 0.0; // smoothed time between presented frames
+		uint32_t drawCalls = 0;
+		uint64_t triangles = 0;
+		uint64_t heapAllocations = 0; // made during the last paintGL, not smoothed
+	};
+
+	/**
+	 * @brief Editor-wide counters read by the console's "stats" and "mem" commands.
+	 *
+	 * Writers are the systems that own the numbers (viewport, scene loader, ...);
+	 * everything is cheap enough to update every frame.
+	 */
+	class EditorStats
+	{
+	public:
+		static EditorStats& Get();
+
+		void RecordFrame(double cpuMs, uint32_t drawCalls, uint64_t triangles, uint64_t heapAllocations = 0);
+		void RecordGpuTime(double gpuMs);
+		FrameStats Frame() const;
+
+		void SetSceneCounts(uint32_t entities, uint32_t components);
+		uint32_t EntityCount() const;
+		uint32_t ComponentCount() const;
+
+		using MemoryReporter = std::function<uint64_t()>;
+
+		/**
+		 * @brief Adds a named contributor to the "mem" report, replacing one with the same name.
+		 *        Reporters are polled on demand.
+		 */
+		void RegisterMemoryReporter(const QString& subsystem, MemoryReporter reporter);
+		void UnregisterMemoryReporter(const QString& subsystem);
+		QVector<QPair<QString, uint64_t>> MemoryReport() const;
+
+		static uint64_t ProcessResidentBytes();
+
+		/** @brief Told the bytes a reclaimer freed; may be called on the thread that did the work. */
+		using ReclaimDone = std::function<void(uint64_t freedBytes)>;
+		using Reclaimer = std::function<void(ReclaimDone done)>;
+
+		/**
+		 * @brief Adds a cache that "gc <name>" can trim, replacing one with the same name.
+		 *        The reclaimer calls done with the bytes it freed, right away or once work it
+		 *        queued elsewhere has finished, so a busy cache never blocks the caller.
+		 */
+		void RegisterReclaimer(const QString& name, Reclaimer reclaimer);
+		void UnregisterReclaimer(const QString& name);
+		QStringList ReclaimerNames() const;
+
+		/** @brief Starts trimming the named cache; false if there is none. */
+		bool Reclaim(const QString& name, ReclaimDone done);
+
+	private:
+		EditorStats() = default;
+
+	private:
+		mutable QMutex m_mutex;
+		FrameStats m_frame;
+		qint64 m_lastFrameNs = 0;
+		uint32_t m_entityCount = 0;
+		uint32_t m_componentCount = 0;
+		QVector<QPair<QString, MemoryReporter>> m_memoryReporters;
+		QVector<QPair<QString, Reclaimer>> m_reclaimers;
+	};
+}
+
+#endif
\ No newline at end of file
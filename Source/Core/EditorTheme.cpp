@@ -0,0 +1,257 @@
+#include "EditorTheme.h"
+#include <QtGui/QPainter>
+#include <QtWidgets/QAbstractButton>
+#include <QtWidgets/QAbstractItemView>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QMenuBar>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QStatusBar>
+#include <QtWidgets/QStyleFactory>
+#include <QtWidgets/QStyleOption>
+#include <QtWidgets/QToolBar>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr QRgb kColors[static_cast<int>(ThemeRole::Count)] = {
+			0x1e1e1e,   // Window
+			0x252526,   // Panel
+			0x2d2d2d,   // Chrome
+			0x333333,   // Input
+			0x4a4a4a,   // Button
+			0x555555,   // ButtonHover
+			0x444444,   // Border
+			0xcccccc,   // Text
+			0xffffff,   // BrightText
+			0x808080,   // MutedText
+			0x007acc,   // Accent
+			0x008cd9,   // AccentHover
+			0x88c0d0,   // Header
+			0xff6666,   // AxisX
+			0x66ff66,   // AxisY
+			0x6666ff,   // AxisZ
+			0x00b000,   // Success
+			0xe0c050,   // Warning
+			0xd04040,   // Error
+		};
+
+		constexpr qreal kRadius = 3.0;
+
+		QRectF Inset(const QRect& rect)
+		{
+			return QRectF(rect).adjusted(0.5, 0.5, -0.5, -0.5);
+		}
+	}
+
+	void EditorTheme::Apply(QApplication& app)
+	{
+		// The application takes ownership of the style.
+		app.setStyle(new EditorStyle());
+		app.setPalette(Palette());
+
+		QFont font = app.font();
+		font.setPointSizeF(10.0);
+		app.setFont(font);
+	}
+
+	QColor EditorTheme::Color(ThemeRole role)
+	{
+		return QColor(kColors[static_cast<int>(role)]);
+	}
+
+	QPalette EditorTheme::Palette()
+	{
+		QPalette palette;
+		palette.setColor(QPalette::Window, Color(ThemeRole::Panel));
+		palette.setColor(QPalette::WindowText, Color(ThemeRole::Text));
+		palette.setColor(QPalette::Base, Color(ThemeRole::Input));
+		palette.setColor(QPalette::AlternateBase, Color(ThemeRole::Chrome));
+		palette.setColor(QPalette::ToolTipBase, Color(ThemeRole::Chrome));
+		palette.setColor(QPalette::ToolTipText, Color(ThemeRole::Text));
+		palette.setColor(QPalette::PlaceholderText, Color(ThemeRole::MutedText));
+		palette.setColor(QPalette::Text, Color(ThemeRole::Text));
+		palette.setColor(QPalette::Button, Color(ThemeRole::Button));
+		palette.setColor(QPalette::ButtonText, Color(ThemeRole::Text));
+		palette.setColor(QPalette::BrightText, Color(ThemeRole::BrightText));
+		palette.setColor(QPalette::Highlight, Color(ThemeRole::Accent));
+		palette.setColor(QPalette::HighlightedText, Color(ThemeRole::BrightText));
+		palette.setColor(QPalette::Link, Color(ThemeRole::Accent));
+		palette.setColor(QPalette::LinkVisited, Color(ThemeRole::AccentHover));
+
+		// Fusion shades frames and bevels from these.
+		palette.setColor(QPalette::Light, Color(ThemeRole::ButtonHover));
+		palette.setColor(QPalette::Midlight, Color(ThemeRole::Button));
+		palette.setColor(QPalette::Mid, Color(ThemeRole::Border));
+		palette.setColor(QPalette::Dark, Color(ThemeRole::Chrome));
+		palette.setColor(QPalette::Shadow, Color(ThemeRole::Window));
+
+		for (QPalette::ColorRole role : { QPalette::WindowText, QPalette::Text, QPalette::ButtonText })
+		{
+			palette.setColor(QPalette::Disabled, role, Color(ThemeRole::MutedText));
+		}
+		palette.setColor(QPalette::Disabled, QPalette::Highlight, Color(ThemeRole::Border));
+		return palette;
+	}
+
+	void EditorTheme::SetTextRole(QWidget* widget, ThemeRole role)
+	{
+		QPalette palette = widget->palette();
+		palette.setColor(QPalette::WindowText, Color(role));
+		palette.setColor(QPalette::Text, Color(role));
+		palette.setColor(QPalette::ButtonText, Color(role));
+		widget->setPalette(palette);
+	}
+
+	void EditorTheme::SetBackgroundRole(QWidget* widget, ThemeRole role)
+	{
+		QPalette palette = widget->palette();
+		palette.setColor(QPalette::Window, Color(role));
+		widget->setPalette(palette);
+		widget->setAutoFillBackground(true);
+	}
+
+	void EditorTheme::SetPrimary(QPushButton* button)
+	{
+		button->setProperty(kPrimaryProperty, true);
+		SetTextRole(button, ThemeRole::BrightText);
+
+		QFont font = button->font();
+		font.setBold(true);
+		button->setFont(font);
+	}
+
+	EditorStyle::EditorStyle() : QProxyStyle(QStyleFactory::create("Fusion"))
+	{
+	}
+
+	void EditorStyle::polish(QWidget* widget)
+	{
+		QProxyStyle::polish(widget);
+
+		if (qobject_cast<QAbstractButton*>(widget) || qobject_cast<QComboBox*>(widget))
+		{
+			widget->setAttribute(Qt::WA_Hover);
+		}
+		else if (qobject_cast<QMenuBar*>(widget) || qobject_cast<QToolBar*>(widget) || qobject_cast<QStatusBar*>(widget))
+		{
+			EditorTheme::SetBackgroundRole(widget, ThemeRole::Chrome);
+		}
+		else if (qobject_cast<QAbstractItemView*>(widget))
+		{
+			// Lists and trees sit flush with the panel rather than looking like inputs.
+			QPalette palette = widget->palette();
+			palette.setColor(QPalette::Base, EditorTheme::Color(ThemeRole::Panel));
+			widget->setPalette(palette);
+		}
+	}
+
+	void EditorStyle::unpolish(QWidget* widget)
+	{
+		if (qobject_cast<QAbstractButton*>(widget) || qobject_cast<QComboBox*>(widget))
+		{
+			widget->setAttribute(Qt::WA_Hover, false);
+		}
+		QProxyStyle::unpolish(widget);
+	}
+
+	void EditorStyle::polish(QPalette& palette)
+	{
+		palette = EditorTheme::Palette();
+	}
+
+	int EditorStyle::pixelMetric(PixelMetric metric, const QStyleOption* option, const QWidget* widget) const
+	{
+		switch (metric)
+		{
+		case PM_ScrollBarExtent: return 10;
+		case PM_ScrollBarSliderMin: return 20;
+		default: return QProxyStyle::pixelMetric(metric, option, widget);
+		}
+	}
+
+	void EditorStyle::drawPrimitive(PrimitiveElement element, const QStyleOption* option, QPainter* painter, const QWidget* widget) const
+	{
+		switch (element)
+		{
+		case PE_PanelButtonCommand:
+		{
+			const bool primary = widget && widget->property(EditorTheme::kPrimaryProperty).toBool();
+			QColor fill = EditorTheme::Color(primary ? ThemeRole::Accent : ThemeRole::Button);
+			if (!(option->state & State_Enabled)) fill = fill.darker(140);
+			else if (option->state & (State_Sunken | State_On)) fill = fill.darker(120);
+			else if (option->state & State_MouseOver) fill = EditorTheme::Color(primary ? ThemeRole::AccentHover : ThemeRole::ButtonHover);
+
+			painter->save();
+			painter->setRenderHint(QPainter::Antialiasing);
+			painter->setPen(primary ? QPen(Qt::NoPen) : QPen(EditorTheme::Color(ThemeRole::ButtonHover)));
+			painter->setBrush(fill);
+			painter->drawRoundedRect(Inset(option->rect), kRadius + 1.0, kRadius + 1.0);
+			painter->restore();
+			return;
+		}
+		case PE_PanelLineEdit:
+		{
+			const QStyleOptionFrame* frame = qstyleoption_cast<const QStyleOptionFrame*>(option);
+			painter->save();
+			painter->setRenderHint(QPainter::Antialiasing);
+			painter->setPen(Qt::NoPen);
+			painter->setBrush(option->palette.brush(QPalette::Base));
+			painter->drawRoundedRect(Inset(option->rect), kRadius, kRadius);
+			painter->restore();
+			if (frame && frame->lineWidth > 0) drawPrimitive(PE_FrameLineEdit, option, painter, widget);
+			return;
+		}
+		case PE_FrameLineEdit:
+		{
+			const bool focused = (option->state & State_HasFocus) && (option->state & State_Enabled);
+			painter->save();
+			painter->setRenderHint(QPainter::Antialiasing);
+			painter->setPen(EditorTheme::Color(focused ? ThemeRole::Accent : ThemeRole::Border));
+			painter->setBrush(Qt::NoBrush);
+			painter->drawRoundedRect(Inset(option->rect), kRadius, kRadius);
+			painter->restore();
+			return;
+		}
+		case PE_FrameGroupBox:
+		{
+			painter->save();
+			painter->setRenderHint(QPainter::Antialiasing);
+			painter->setPen(EditorTheme::Color(ThemeRole::Border));
+			painter->setBrush(Qt::NoBrush);
+			painter->drawRoundedRect(Inset(option->rect), kRadius + 1.0, kRadius + 1.0);
+			painter->restore();
+			return;
+		}
+		default:
+			QProxyStyle::drawPrimitive(element, option, painter, widget);
+		}
+	}
+
+	void EditorStyle::drawComplexControl(ComplexControl control, const QStyleOptionComplex* option, QPainter* painter, const QWidget* widget) const
+	{
+		// Group box titles are the component headers: bold and highlighted, without changing
+		// the palette the box hands down to its children.
+		if (control == CC_GroupBox)
+		{
+			if (const QStyleOptionGroupBox* group = qstyleoption_cast<const QStyleOptionGroupBox*>(option))
+			{
+				QStyleOptionGroupBox header(*group);
+				header.textColor = EditorTheme::Color(ThemeRole::Header);
+				header.palette.setColor(QPalette::WindowText, header.textColor);
+
+				QFont font = painter->font();
+				font.setBold(true);
+				header.fontMetrics = QFontMetrics(font);
+
+				painter->save();
+				painter->setFont(font);
+				QProxyStyle::drawComplexControl(control, &header, painter, widget);
+				painter->restore();
+				return;
+			}
+		}
+		QProxyStyle::drawComplexControl(control, option, painter, widget);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#ifndef EDITOR_THEME_H
+#define EDITOR_THEME_H
+
+#include <QtGui/QColor>
+#include <QtGui/QPalette>
+#include <QtWidgets/QProxyStyle>
+
+class QApplication;
+class QPushButton;
+
+namespace Orca
+{
+	/** @brief What a color is for; widgets ask for roles, never for literal colors. */
+	enum class ThemeRole
+	{
+		Window,         // main window and dialog background
+		Panel,          // dock and panel contents
+		Chrome,         // menu bar, tool bar, status bar, side bars
+		Input,          // line edits and combo boxes
+		Button,
+		ButtonHover,
+		Border,
+		Text,
+		BrightText,
+		MutedText,
+		Accent,
+		AccentHover,
+		Header,         // component titles in the inspector
+		AxisX,
+		AxisY,
+		AxisZ,
+		Success,
+		Warning,
+		Error,
+		Count
+	};
+
+	/**
+	 * @brief The editor's dark theme: one QPalette plus an EditorStyle, installed on the
+	 *        application once before any window is created.
+	 *
+	 * Replaces per-widget style sheets, which Qt parses and matches again for every widget it
+	 * polishes. Widgets that need something other than the defaults pick a role through the
+	 * helpers below, which only touch the widget's palette or a property.
+	 */
+	class EditorTheme
+	{
+	public:
+		static void Apply(QApplication& app);
+
+		static QColor Color(ThemeRole role);
+		static QPalette Palette();
+
+		/** @brief Draws the widget's text (or its editable text) in the given role. */
+		static void SetTextRole(QWidget* widget, ThemeRole role);
+
+		/** @brief Fills the widget's background with the given role. */
+		static void SetBackgroundRole(QWidget* widget, ThemeRole role);
+
+		/** @brief Draws the button in the accent color, for the main action of a page. */
+		static void SetPrimary(QPushButton* button);
+
+		static constexpr const char* kPrimaryProperty = "orcaPrimary";
+	};
+
+	/**
+	 * @brief Fusion with the editor's shapes: flat rounded buttons and inputs, accent focus
+	 *        frames, highlighted group box titles and thin scroll bars. Colors come from the
+	 *        palette and EditorTheme roles.
+	 */
+	class EditorStyle : public QProxyStyle
+	{
+	public:
+		EditorStyle();
+
+		using QProxyStyle::polish;
+		using QProxyStyle::unpolish;
+		void polish(QWidget* widget) override;
+		void unpolish(QWidget* widget) override;
+		void polish(QPalette& palette) override;
+
+		int pixelMetric(PixelMetric metric, const QStyleOption* option = nullptr, const QWidget* widget = nullptr) const override;
+		void drawPrimitive(PrimitiveElement element, const QStyleOption* option, QPainter* painter, const QWidget* widget = nullptr) const override;
+		void drawComplexControl(ComplexControl control, const QStyleOptionComplex* option, QPainter* painter, const QWidget* widget = nullptr) const override;
+	};
+}
+
+#endif
\ No newline at end of file
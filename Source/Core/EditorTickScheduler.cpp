@@ -0,0 +1,159 @@
+#include "EditorTickScheduler.h"
+#include "EditorLog.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include <QtGui/QGuiApplication>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QWidget>
+#include <algorithm>
+
+namespace Orca
+{
+	EditorTickScheduler& EditorTickScheduler::Get()
+	{
+		static EditorTickScheduler s_scheduler;
+		return s_scheduler;
+	}
+
+	EditorTickScheduler::EditorTickScheduler()
+	{
+		m_clock.start();
+		m_timer.setTimerType(Qt::PreciseTimer);
+		connect(&m_timer, &QTimer::timeout, this, [this]() { Tick(); });
+
+		// Focus changes take effect right away rather than on the next (possibly slow) tick.
+		connect(qApp, &QGuiApplication::applicationStateChanged, this, [this]() { Retarget(); });
+	}
+
+	void EditorTickScheduler::Register(QWidget* widget, const QString& name, UpdateFunction update, double budgetMs)
+	{
+		Unregister(widget);
+
+		Client client;
+		client.widget = widget;
+		client.update = std::move(update);
+		client.zoneName = Profiler::Intern("Update " + name.toUtf8());
+		client.stats.name = name;
+		client.stats.budgetMs = budgetMs;
+		m_clients.append(std::move(client));
+		Retarget();
+	}
+
+	void EditorTickScheduler::Unregister(QWidget* widget)
+	{
+		m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(), [widget](const Client& client)
+		{
+			return client.widget == widget;
+		}), m_clients.end());
+	}
+
+	void EditorTickScheduler::SetBudget(QWidget* widget, double budgetMs)
+	{
+		for (Client& client : m_clients)
+		{
+			if (client.widget == widget) client.stats.budgetMs = budgetMs;
+		}
+	}
+
+	QVector<TickClientStats> EditorTickScheduler::Stats() const
+	{
+		QVector<TickClientStats> stats;
+		for (const Client& client : m_clients)
+		{
+			if (client.widget) stats.append(client.stats);
+		}
+		return stats;
+	}
+
+	void EditorTickScheduler::Tick()
+	{
+		// One profiler frame per tick, so the views it repaints share a frame rather than each starting one.
+		ORCA_PROFILE_FRAME();
+		ORCA_PROFILE_ZONE("EditorTickScheduler::Tick");
+		MemoryTagScope memoryTag(MemoryTag::UI);
+
+		// Widgets deleted since the last tick leave a null pointer behind.
+		m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(), [](const Client& client) { return !client.widget; }), m_clients.end());
+
+		for (qsizetype i = 0; i < m_clients.size(); ++i)
+		{
+			if (!IsVisibleToUser(m_clients[i].widget))
+			{
+				++m_clients[i].stats.skipped;
+				m_clients[i].lastUpdateNs = -1;
+				continue;
+			}
+
+			const qint64 now = m_clock.nsecsElapsed();
+			const qint64 last = m_clients[i].lastUpdateNs;
+			const float deltaTime = last < 0 ? 1.0f / m_hz : std::min(kMaxDeltaSeconds, static_cast<float>((now - last) / 1e9));
+
+			// The update may register or unregister clients, so nothing in the list is held across it.
+			const QPointer<QWidget> widget = m_clients[i].widget;
+			const UpdateFunction update = m_clients[i].update;
+			{
+				ORCA_PROFILE_ZONE(m_clients[i].zoneName);
+				update(deltaTime);
+			}
+			const double ms = (m_clock.nsecsElapsed() - now) / 1e6;
+
+			if (i >= m_clients.size() || m_clients[i].widget != widget) continue;
+			Client& client = m_clients[i];
+			TickClientStats& stats = client.stats;
+			client.lastUpdateNs = now;
+			++stats.updates;
+			stats.lastMs = ms;
+			stats.worstMs = std::max(stats.worstMs, ms);
+			if (ms > stats.budgetMs)
+			{
+				++stats.overruns;
+
+				// A slow panel overruns on every tick; one line per interval says as much.
+				if (client.lastOverrunReportNs < 0 || now - client.lastOverrunReportNs >= kOverrunReportIntervalNs)
+				{
+					ORCA_LOG_WARNING("Editor", "{} update took {} ms, over its {} ms budget ({} overruns since the last report)",
+						stats.name, ms, stats.budgetMs, stats.overruns - client.reportedOverruns);
+					client.lastOverrunReportNs = now;
+					client.reportedOverruns = stats.overruns;
+				}
+			}
+		}
+
+		Retarget();
+	}
+
+	void EditorTickScheduler::Retarget()
+	{
+		if (m_clients.isEmpty())
+		{
+			m_timer.stop();
+			return;
+		}
+
+		const int hz = TargetHz();
+		if (hz != m_hz)
+		{
+			m_hz = hz;
+			m_timer.setInterval(1000 / hz);
+		}
+		if (!m_timer.isActive()) m_timer.start();
+	}
+
+	int EditorTickScheduler::TargetHz() const
+	{
+		const QWidgetList windows = QApplication::topLevelWidgets();
+		const bool anyShown = std::any_of(windows.begin(), windows.end(), [](const QWidget* window)
+		{
+			return window->isVisible() && !window->isMinimized();
+		});
+		if (!anyShown) return kMinimizedHz;
+		return QGuiApplication::applicationState() == Qt::ApplicationActive ? kActiveHz : kInactiveHz;
+	}
+
+	bool EditorTickScheduler::IsVisibleToUser(const QWidget* widget)
+	{
+		// Docks that are closed or behind another tab hide their contents, so isVisible() covers
+		// them; visibleRegion() catches widgets scrolled or squeezed out of view.
+		return widget && widget->isVisible() && !widget->window()->isMinimized() && !widget->visibleRegion().isEmpty();
+	}
+}
\ No newline at end of file
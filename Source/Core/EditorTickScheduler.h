@@ -0,0 +1,96 @@
+#pragma once
+
+#ifndef EDITOR_TICK_SCHEDULER_H
+#define EDITOR_TICK_SCHEDULER_H
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+#include <functional>
+
+class QWidget;
+
+namespace Orca
+{
+	struct TickClientStats
+	{
+		QString name;
+		double budgetMs = 0.0;
+		uint64_t updates = 0;
+		uint64_t skipped = 0;       // ticks spent hidden, tabbed away or minimized
+		uint64_t overruns = 0;
+		double lastMs = 0.0;
+		double worstMs = 0.0;
+	};
+
+	/**
+	 * @brief The editor's update loop: calls each registered widget's update with the real time
+	 *        since its previous update, but only while the widget can actually be seen.
+	 *
+	 * Widgets that are hidden, in a tabbed-away dock or in a minimized window are skipped. Each
+	 * client has a time budget; overruns are counted, and logged at most once per
+	 * kOverrunReportIntervalNs. The loop runs at kActiveHz while the editor has focus, drops to
+	 * kInactiveHz when another application is active and to kMinimizedHz when every editor
+	 * window is minimized. GUI thread only.
+	 */
+	class EditorTickScheduler : public QObject
+	{
+	public:
+		static constexpr int kActiveHz = 60;
+		static constexpr int kInactiveHz = 4;
+		static constexpr int kMinimizedHz = 1;
+
+		/** @brief Longest delta handed to an update, so a widget shown again after a while doesn't jump. */
+		static constexpr float kMaxDeltaSeconds = 0.25f;
+
+		static constexpr double kDefaultBudgetMs = 2.0;
+
+		/** @brief A client that keeps overrunning is logged at most this often. */
+		static constexpr qint64 kOverrunReportIntervalNs = 5000000000;
+
+		static EditorTickScheduler& Get();
+
+		using UpdateFunction = std::function<void(float deltaTime)>;
+
+		/**
+		 * @brief Ticks @p update for as long as @p widget exists; visibility is judged on the widget.
+		 *        Registering the same widget again replaces its entry.
+		 */
+		void Register(QWidget* widget, const QString& name, UpdateFunction update, double budgetMs = kDefaultBudgetMs);
+		void Unregister(QWidget* widget);
+		void SetBudget(QWidget* widget, double budgetMs);
+
+		int CurrentHz() const { return m_hz; }
+		QVector<TickClientStats> Stats() const;
+
+	private:
+		EditorTickScheduler();
+
+		void Tick();
+		void Retarget();
+		int TargetHz() const;
+		static bool IsVisibleToUser(const QWidget* widget);
+
+		struct Client
+		{
+			QPointer<QWidget> widget;
+			UpdateFunction update;
+			const char* zoneName = nullptr;     // "Update <name>" in the profiler
+			TickClientStats stats;
+			qint64 lastUpdateNs = -1;
+			qint64 lastOverrunReportNs = -1;
+			uint64_t reportedOverruns = 0;      // stats.overruns when last logged
+		};
+
+	private:
+		QTimer m_timer;
+		QElapsedTimer m_clock;
+		QVector<Client> m_clients;
+		int m_hz = 0;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr size_t kBlockAlignment = alignof(std::max_align_t);
+
+		size_t AlignUp(size_t value, size_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
+	FixedPool::FixedPool(size_t blockBytes, size_t blocksPerChunk, MemoryTag tag)
+		: m_blockBytes(AlignUp(std::max(blockBytes, sizeof(FreeBlock)), kBlockAlignment)),
+		  m_blocksPerChunk(std::max<size_t>(blocksPerChunk, 1)),
+		  m_tag(tag)
+	{
+	}
+
+	FixedPool::~FixedPool() = default;
+
+	void* FixedPool::Allocate()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_free)
+		{
+			MemoryTagScope tag(m_tag);
+			m_chunks.emplace_back(new unsigned char[m_blockBytes * m_blocksPerChunk]);
+
+			unsigned char* chunk = m_chunks.back().get();
+			for (size_t i = m_blocksPerChunk; i-- > 0;)
+			{
+				FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * m_blockBytes);
+				block->next = m_free;
+				m_free = block;
+			}
+			m_freeCount += m_blocksPerChunk;
+		}
+
+		FreeBlock* block = m_free;
+		m_free = block->next;
+		--m_freeCount;
+		return block;
+	}
+
+	void FixedPool::Free(void* block)
+	{
+		if (!block) return;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		FreeBlock* freed = static_cast<FreeBlock*>(block);
+		freed->next = m_free;
+		m_free = freed;
+		++m_freeCount;
+	}
+
+	size_t FixedPool::CapacityBlocks() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_chunks.size() * m_blocksPerChunk;
+	}
+
+	size_t FixedPool::FreeBlocks() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_freeCount;
+	}
+
+	FixedPool& FrameArena::PagePool()
+	{
+		static FixedPool s_pages(kPageBytes, 8, MemoryTag::Renderer);
+		return s_pages;
+	}
+
+	FrameArena::~FrameArena()
+	{
+		Reset();
+		for (void* page : m_pages) PagePool().Free(page);
+	}
+
+	void* FrameArena::Allocate(size_t bytes, size_t alignment)
+	{
+		assert(alignment <= kBlockAlignment && (alignment & (alignment - 1)) == 0);
+		bytes = std::max<size_t>(bytes, 1);
+
+		if (bytes > kPageBytes)
+		{
+			m_oversized.push_back(::operator new(bytes));
+			++m_oversizedTotal;
+			return m_oversized.back();
+		}
+
+		size_t offset = AlignUp(m_offset, alignment);
+		if (m_pages.empty() || offset + bytes > kPageBytes)
+		{
+			if (!m_pages.empty()) ++m_page;
+			if (m_page >= m_pages.size()) m_pages.push_back(PagePool().Allocate());
+			offset = 0;
+		}
+
+		void* pointer = static_cast<unsigned char*>(m_pages[m_page]) + offset;
+		m_offset = offset + bytes;
+		m_used += bytes;
+		m_peak = std::max(m_peak, m_used);
+		return pointer;
+	}
+
+	void FrameArena::Reset()
+	{
+		for (void* block : m_oversized) ::operator delete(block);
+		m_oversized.clear();
+
+		m_page = 0;
+		m_offset = 0;
+		m_used = 0;
+	}
+}
\ No newline at end of file
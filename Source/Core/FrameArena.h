@@ -0,0 +1,125 @@
+#pragma once
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "MemoryTracker.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Orca
+{
+	/**
+	 * @brief Hands out fixed-size blocks from chunks it never frees until destroyed, so blocks
+	 *        that are released and requested again cost no heap traffic. Thread-safe.
+	 */
+	class FixedPool
+	{
+	public:
+		FixedPool(size_t blockBytes, size_t blocksPerChunk, MemoryTag tag);
+		~FixedPool();
+
+		FixedPool(const FixedPool&) = delete;
+		FixedPool& operator=(const FixedPool&) = delete;
+
+		void* Allocate();
+		void Free(void* block);
+
+		size_t BlockBytes() const { return m_blockBytes; }
+		size_t CapacityBlocks() const;
+		size_t FreeBlocks() const;
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+	private:
+		const size_t m_blockBytes;
+		const size_t m_blocksPerChunk;
+		const MemoryTag m_tag;
+
+		mutable std::mutex m_mutex;
+		std::vector<std::unique_ptr<unsigned char[]>> m_chunks;
+		FreeBlock* m_free = nullptr;
+		size_t m_freeCount = 0;
+	};
+
+	/**
+	 * @brief Linear allocator for work that lives for one frame (draw lists, culling results,
+	 *        event buffers). Allocation is a pointer bump; Reset() releases everything at once
+	 *        and keeps the pages, so once a frame has reached its usual size later frames
+	 *        allocate nothing from the heap.
+	 *
+	 * Pages come from a pool shared by every arena. Requests larger than a page go to the heap
+	 * and are counted in OversizedAllocations(). Not thread-safe: one arena per thread.
+	 */
+	class FrameArena
+	{
+	public:
+		static constexpr size_t kPageBytes = 64 * 1024;
+
+		static FixedPool& PagePool();
+
+		FrameArena() = default;
+		~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+		void Reset();
+
+		size_t UsedBytes() const { return m_used; }
+		size_t PeakBytes() const { return m_peak; }
+		size_t CapacityBytes() const { return m_pages.size() * kPageBytes; }
+		uint64_t OversizedAllocations() const { return m_oversizedTotal; }
+
+	private:
+		std::vector<void*> m_pages;
+		size_t m_page = 0;
+		size_t m_offset = 0;
+		size_t m_used = 0;
+		size_t m_peak = 0;
+
+		std::vector<void*> m_oversized;
+		uint64_t m_oversizedTotal = 0;
+	};
+
+	/**
+	 * @brief Standard allocator over a FrameArena. Deallocation is a no-op; memory comes back
+	 *        when the arena is reset, so containers must not outlive the frame.
+	 */
+	template <typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		explicit ArenaAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.Arena()) {}
+
+		T* allocate(size_t count) { return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T))); }
+		void deallocate(T*, size_t) noexcept {}
+
+		FrameArena* Arena() const noexcept { return m_arena; }
+
+		template <typename U>
+		bool operator==(const ArenaAllocator<U>& other) const noexcept { return m_arena == other.Arena(); }
+		template <typename U>
+		bool operator!=(const ArenaAllocator<U>& other) const noexcept { return m_arena != other.Arena(); }
+
+	private:
+		FrameArena* m_arena;
+	};
+
+	template <typename T>
+	using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
+
+#endif
\ No newline at end of file
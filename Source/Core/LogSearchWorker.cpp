@@ -0,0 +1,278 @@
+#include "LogSearchWorker.h"
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMetaObject>
+#include <algorithm>
+#include <cctype>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Orca
+{
+	namespace
+	{
+		// Upper bounds for one slice of work before yielding back to the event loop.
+		constexpr uint64_t kIndexSliceLines = 16384;
+		constexpr uint64_t kScanSliceLines = 65536;
+		constexpr qint64 kScanSliceMs = 8;
+
+		int LowestSetBit(uint64_t bits)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward64(&index, bits);
+			return static_cast<int>(index);
+#else
+			return __builtin_ctzll(bits);
+#endif
+		}
+	}
+
+	LogSearchWorker::LogSearchWorker(LogStore& store)
+		: m_store(store)
+	{
+		m_thread.setObjectName("LogIndexer");
+		moveToThread(&m_thread);
+	}
+
+	LogSearchWorker::~LogSearchWorker()
+	{
+		m_store.SetAppendListener(nullptr);
+		m_thread.quit();
+		m_thread.wait();
+	}
+
+	void LogSearchWorker::Start()
+	{
+		m_thread.start(QThread::LowPriority);
+
+		m_store.SetAppendListener([this]()
+		{
+			QMetaObject::invokeMethod(this, "indexPending", Qt::QueuedConnection);
+		});
+
+		QMetaObject::invokeMethod(this, "indexPending", Qt::QueuedConnection);
+		QMetaObject::invokeMethod(this, "restartScan", Qt::QueuedConnection);
+	}
+
+	quint64 LogSearchWorker::SetQuery(const LogQuery& query)
+	{
+		quint64 generation;
+		{
+			QMutexLocker locker(&m_queryMutex);
+			m_pendingQuery = query;
+			generation = ++m_generation;
+		}
+
+		QMetaObject::invokeMethod(this, "restartScan", Qt::QueuedConnection);
+		return generation;
+	}
+
+	void LogSearchWorker::indexPending()
+	{
+		// Acknowledge first so appends racing with this pass schedule another one.
+		m_store.AcknowledgeAppends();
+
+		uint64_t firstRetained = m_store.FirstRetained();
+		if (firstRetained != m_lastFirstRetained)
+		{
+			m_lastFirstRetained = firstRetained;
+			emit linesEvicted(firstRetained);
+		}
+
+		uint64_t begin = std::max(m_store.Indexed(), firstRetained);
+		uint64_t end = std::min(m_store.Appended(), begin + kIndexSliceLines);
+		if (begin >= end) return;
+
+		uint64_t sequence = begin;
+		while (sequence < end)
+		{
+			std::shared_ptr<LogChunk> chunk = m_store.ChunkFor(sequence);
+			if (!chunk)
+			{
+				// Evicted before we got to it.
+				sequence = std::max(sequence + 1, m_store.FirstRetained());
+				continue;
+			}
+
+			uint64_t chunkEnd = std::min(end, chunk->firstSequence + LogChunk::kLines);
+			for (; sequence < chunkEnd; ++sequence)
+			{
+				size_t line = static_cast<size_t>(sequence - chunk->firstSequence);
+				LogRecord& record = chunk->records[line];
+				FormatRecord(record);
+				chunk->severityBits[static_cast<size_t>(record.severity)][line / 64] |= 1ull << (line % 64);
+			}
+		}
+		m_store.PublishIndexed(end);
+
+		if (m_scanning)
+		{
+			// The running scan walks in ascending order, so it simply covers the new lines too.
+			m_scanEnd = end;
+		}
+		else
+		{
+			QVector<quint64> matches;
+			ScanRange(std::max(begin, m_query.fromSequence), end, matches);
+			if (!matches.isEmpty())
+			{
+				emit matchesFound(m_activeGeneration, matches, false);
+			}
+		}
+
+		if (end < m_store.Appended())
+		{
+			QMetaObject::invokeMethod(this, "indexPending", Qt::QueuedConnection);
+		}
+	}
+
+	void LogSearchWorker::restartScan()
+	{
+		quint64 generation = m_generation.load();
+		if (generation == m_activeGeneration && m_scanning) return;
+
+		{
+			QMutexLocker locker(&m_queryMutex);
+			m_query = m_pendingQuery;
+		}
+		m_activeGeneration = generation;
+
+		if (m_query.regex)
+		{
+			m_regex.setPattern(m_query.text);
+			m_regex.setPatternOptions(m_query.caseSensitive ? QRegularExpression::NoPatternOption : QRegularExpression::CaseInsensitiveOption);
+			m_regex.optimize();
+		}
+		else
+		{
+			m_matcher.setPattern(m_query.text);
+			m_matcher.setCaseSensitivity(m_query.caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
+		}
+
+		m_scanCursor = std::max(m_query.fromSequence, m_store.FirstRetained());
+		m_scanEnd = m_store.Indexed();
+		m_scanning = true;
+
+		emit matchesFound(m_activeGeneration, QVector<quint64>(), true);
+		continueScan();
+	}
+
+	void LogSearchWorker::continueScan()
+	{
+		if (!m_scanning || m_activeGeneration != m_generation.load())
+		{
+			// A newer query is queued behind us; it restarts from scratch.
+			return;
+		}
+
+		QElapsedTimer timer;
+		timer.start();
+
+		QVector<quint64> matches;
+		while (m_scanCursor < m_scanEnd && timer.elapsed() < kScanSliceMs)
+		{
+			uint64_t sliceEnd = std::min(m_scanEnd, m_scanCursor + kScanSliceLines);
+			ScanRange(std::max(m_scanCursor, m_store.FirstRetained()), sliceEnd, matches);
+			m_scanCursor = sliceEnd;
+		}
+
+		if (!matches.isEmpty())
+		{
+			emit matchesFound(m_activeGeneration, matches, false);
+		}
+
+		if (m_scanCursor < m_scanEnd)
+		{
+			QMetaObject::invokeMethod(this, "continueScan", Qt::QueuedConnection);
+		}
+		else
+		{
+			m_scanning = false;
+			emit scanFinished(m_activeGeneration);
+		}
+	}
+
+	bool LogSearchWorker::Matches(const LogRecord& record) const
+	{
+		if (record.categoryId < m_query.hiddenCategories.size() && m_query.hiddenCategories.test(record.categoryId)) return false;
+		if (m_query.text.isEmpty()) return true;
+
+		if (m_query.regex)
+		{
+			return m_regex.isValid() && m_regex.match(record.text).hasMatch();
+		}
+		return m_matcher.indexIn(record.text) >= 0;
+	}
+
+	void LogSearchWorker::ScanRange(uint64_t begin, uint64_t end, QVector<quint64>& out) const
+	{
+		uint64_t sequence = begin;
+		while (sequence < end)
+		{
+			std::shared_ptr<LogChunk> chunk = m_store.ChunkFor(sequence);
+			if (!chunk) return;
+
+			const uint64_t first = chunk->firstSequence;
+			const uint64_t chunkEnd = std::min(end, first + LogChunk::kLines);
+
+			// Severity filtering works a word (64 lines) at a time off the index bitmaps.
+			for (size_t word = static_cast<size_t>((sequence - first) / 64); first + word * 64 < chunkEnd; ++word)
+			{
+				uint64_t bits = 0;
+				for (size_t severity = 0; severity < static_cast<size_t>(LogSeverity::Count); ++severity)
+				{
+					if (m_query.severityMask & (1u << severity)) bits |= chunk->severityBits[severity][word];
+				}
+
+				while (bits)
+				{
+					int bit = LowestSetBit(bits);
+					bits &= bits - 1;
+
+					uint64_t candidate = first + word * 64 + static_cast<uint64_t>(bit);
+					if (candidate < sequence || candidate >= chunkEnd) continue;
+
+					if (Matches(chunk->records[static_cast<size_t>(candidate - first)]))
+					{
+						out.push_back(candidate);
+					}
+				}
+			}
+			sequence = chunkEnd;
+		}
+	}
+
+	void LogSearchWorker::FormatRecord(LogRecord& record)
+	{
+		if (record.formatId >= m_formats.size())
+		{
+			m_formats.resize(record.formatId + 1);
+		}
+
+		FormatInfo& info = m_formats[record.formatId];
+		if (!info.loaded)
+		{
+			info.format = BinaryLogFormatTable::Get().Lookup(record.formatId);
+			info.hash = qHash(QByteArray::fromStdString(info.format.category + '\n' + info.format.format));
+			info.loaded = true;
+
+			// A format with no literal text of its own ("{}", "> {}") says nothing about the
+			// message, so those lines are told apart by their formatted text instead.
+			info.passthrough = true;
+			std::string literal = info.format.format;
+			for (size_t at = literal.find("{}"); at != std::string::npos; at = literal.find("{}"))
+			{
+				literal.erase(at, 2);
+			}
+			for (char c : literal)
+			{
+				if (std::isalnum(static_cast<unsigned char>(c))) { info.passthrough = false; break; }
+			}
+		}
+
+		record.text = QString::fromStdString(FormatBinaryLogMessage(info.format.format, record.args, record.argsSize, record.argCount));
+		record.templateHash = info.passthrough ? qHash(record.text, info.hash) : info.hash;
+	}
+}
\ No newline at end of file
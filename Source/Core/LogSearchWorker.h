@@ -0,0 +1,99 @@
+#pragma once
+
+#ifndef LOG_SEARCH_WORKER_H
+#define LOG_SEARCH_WORKER_H
+
+#include "LogStore.h"
+#include <QtCore/QObject>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringMatcher>
+#include <QtCore/QVector>
+#include <QtCore/QThread>
+#include <QtCore/QMutex>
+#include <bitset>
+
+namespace Orca
+{
+	/**
+	 * @brief What the console currently wants to see.
+	 */
+	struct LogQuery
+	{
+		QString text;
+		bool regex = false;
+		bool caseSensitive = false;
+		uint32_t severityMask = ~0u;            // bit per LogSeverity
+		std::bitset<1024> hiddenCategories;     // by LogStore category id
+		uint64_t fromSequence = 0;              // lines before this were cleared from view
+	};
+
+	/**
+	 * @brief Formats and indexes new log lines and matches them against the active query.
+	 *
+	 * Lives on its own thread. Full rescans run in short slices that re-queue
+	 * themselves, so a newer query or freshly appended lines are picked up
+	 * between slices instead of after the whole scan.
+	 */
+	class LogSearchWorker : public QObject
+	{
+		Q_OBJECT
+	public:
+		explicit LogSearchWorker(LogStore& store);
+		~LogSearchWorker() override;
+
+		/**
+		 * @brief Starts the worker thread. Thread safe.
+		 */
+		void Start();
+
+		/**
+		 * @brief Replaces the active query. Any scan for an older query is abandoned. Thread safe.
+		 * @return The generation tag results for this query will carry.
+		 */
+		quint64 SetQuery(const LogQuery& query);
+
+	signals:
+		/** Matches are streamed in ascending sequence order. reset=true starts a new result set. */
+		void matchesFound(quint64 generation, const QVector<quint64>& sequences, bool reset);
+		void scanFinished(quint64 generation);
+		void linesEvicted(quint64 firstRetained);
+
+	private slots:
+		void indexPending();
+		void restartScan();
+		void continueScan();
+
+	private:
+		bool Matches(const LogRecord& record) const;
+		void ScanRange(uint64_t begin, uint64_t end, QVector<quint64>& out) const;
+		void FormatRecord(LogRecord& record);
+
+	private:
+		LogStore& m_store;
+		QThread m_thread;
+
+		QMutex m_queryMutex;
+		LogQuery m_pendingQuery;
+		std::atomic<quint64> m_generation{ 0 };
+
+		// Worker-thread state
+		LogQuery m_query;
+		quint64 m_activeGeneration = 0;
+		QRegularExpression m_regex;
+		QStringMatcher m_matcher;
+		uint64_t m_scanCursor = 0;
+		uint64_t m_scanEnd = 0;
+		bool m_scanning = false;
+		uint64_t m_lastFirstRetained = 0;
+		struct FormatInfo
+		{
+			BinaryLogFormat format;
+			uint64_t hash = 0;
+			bool passthrough = false;   // "{}"-style formats whose text is the whole message
+			bool loaded = false;
+		};
+		std::vector<FormatInfo> m_formats;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "LogStore.h"
+#include "MemoryTracker.h"
+#include <cstring>
+
+namespace Orca
+{
+	const uint8_t* LogChunk::StoreArgs(const uint8_t* data, size_t size)
+	{
+		if (size == 0) return nullptr;
+
+		if (size > kArenaPage)
+		{
+			// Oversized argument blocks get a page of their own.
+			argPages.push_front(std::make_unique<uint8_t[]>(size));
+			std::memcpy(argPages.front().get(), data, size);
+			return argPages.front().get();
+		}
+
+		if (argPageUsed + size > kArenaPage)
+		{
+			argPages.push_back(std::make_unique<uint8_t[]>(kArenaPage));
+			argPageUsed = 0;
+		}
+
+		uint8_t* dst = argPages.back().get() + argPageUsed;
+		std::memcpy(dst, data, size);
+		argPageUsed += size;
+		return dst;
+	}
+
+	LogStore& LogStore::Get()
+	{
+		static LogStore s_store;
+		return s_store;
+	}
+
+	void LogStore::Append(uint32_t formatId, LogSeverity severity, uint16_t categoryId, int64_t unixNs, const BinaryLogArgs& args)
+	{
+		MemoryTagScope memoryTag(MemoryTag::Logging);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			uint64_t sequence = m_appended.load(std::memory_order_relaxed);
+			if (m_chunks.empty() || sequence - m_chunks.back()->firstSequence >= LogChunk::kLines)
+			{
+				auto chunk = std::make_shared<LogChunk>();
+				chunk->firstSequence = sequence;
+				m_chunks.push_back(std::move(chunk));
+
+				while (m_chunks.size() > 1 && sequence - m_chunks.front()->firstSequence > m_retainedLines)
+				{
+					m_chunks.pop_front();
+					m_firstRetained.store(m_chunks.front()->firstSequence, std::memory_order_release);
+				}
+			}
+
+			LogChunk& chunk = *m_chunks.back();
+			LogRecord& record = chunk.records[static_cast<size_t>(sequence - chunk.firstSequence)];
+			record.unixNs = unixNs;
+			record.formatId = formatId;
+			record.categoryId = categoryId;
+			record.severity = severity;
+			record.argCount = args.Count();
+			record.args = chunk.StoreArgs(args.Bytes().data(), args.Bytes().size());
+			record.argsSize = static_cast<uint32_t>(args.Bytes().size());
+
+			m_appended.store(sequence + 1, std::memory_order_release);
+		}
+
+		// Coalesce wake-ups: one pending notification covers any number of appends.
+		if (!m_notifyPending.exchange(true, std::memory_order_acq_rel))
+		{
+			// Held through the call so SetAppendListener can't return while it runs.
+			std::lock_guard<std::recursive_mutex> lock(m_listenerMutex);
+			if (m_listener) m_listener();
+			else m_notifyPending.store(false, std::memory_order_release);
+		}
+	}
+
+	uint16_t LogStore::RegisterCategory(const char* name)
+	{
+		std::lock_guard<std::mutex> lock(m_categoryMutex);
+
+		auto it = m_categoryIds.find(name);
+		if (it != m_categoryIds.end()) return it->second;
+
+		uint16_t id = static_cast<uint16_t>(m_categoryNames.size());
+		m_categoryIds.emplace(name, id);
+		m_categoryNames.push_back(QString::fromUtf8(name));
+		return id;
+	}
+
+	QString LogStore::CategoryName(uint16_t id) const
+	{
+		std::lock_guard<std::mutex> lock(m_categoryMutex);
+		return id < m_categoryNames.size() ? m_categoryNames[id] : QString();
+	}
+
+	QStringList LogStore::CategoryNames() const
+	{
+		std::lock_guard<std::mutex> lock(m_categoryMutex);
+		QStringList names;
+		for (const QString& name : m_categoryNames) names << name;
+		return names;
+	}
+
+	std::shared_ptr<LogChunk> LogStore::ChunkFor(uint64_t sequence) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_chunks.empty() || sequence < m_chunks.front()->firstSequence) return nullptr;
+
+		size_t index = static_cast<size_t>((sequence - m_chunks.front()->firstSequence) / LogChunk::kLines);
+		return index < m_chunks.size() ? m_chunks[index] : nullptr;
+	}
+
+	const LogRecord* LogStore::Record(const std::shared_ptr<LogChunk>& chunk, uint64_t sequence) const
+	{
+		if (!chunk || sequence < chunk->firstSequence || sequence - chunk->firstSequence >= LogChunk::kLines) return nullptr;
+		return &chunk->records[static_cast<size_t>(sequence - chunk->firstSequence)];
+	}
+
+	QString LogStore::Text(uint64_t sequence) const
+	{
+		if (sequence >= Indexed()) return QString();
+
+		std::shared_ptr<LogChunk> chunk = ChunkFor(sequence);
+		const LogRecord* record = Record(chunk, sequence);
+		return record ? record->text : QString();
+	}
+
+	void LogStore::SetAppendListener(std::function<void()> listener)
+	{
+		std::lock_guard<std::recursive_mutex> lock(m_listenerMutex);
+		m_listener = std::move(listener);
+	}
+
+	void LogStore::AcknowledgeAppends()
+	{
+		m_notifyPending.store(false, std::memory_order_release);
+	}
+
+	void LogStore::PublishIndexed(uint64_t end)
+	{
+		m_indexed.store(end, std::memory_order_release);
+	}
+
+	void LogStore::SetRetainedLines(uint64_t lines)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_retainedLines = lines < LogChunk::kLines ? LogChunk::kLines : lines;
+	}
+
+	size_t LogStore::MemoryBytes() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		size_t bytes = 0;
+		for (const auto& chunk : m_chunks)
+		{
+			bytes += sizeof(LogChunk) + chunk->argPages.size() * LogChunk::kArenaPage;
+		}
+		return bytes;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+
+#ifndef LOG_STORE_H
+#define LOG_STORE_H
+
+#include "BinaryLog.h"
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Orca
+{
+	/**
+	 * @brief One retained log line. Producers fill everything except text and
+	 *        templateHash; the indexer computes both later on its own thread.
+	 */
+	struct LogRecord
+	{
+		int64_t unixNs = 0;
+		uint32_t formatId = 0;
+		uint16_t categoryId = 0;
+		LogSeverity severity = LogSeverity::Info;
+		uint8_t argCount = 0;
+		const uint8_t* args = nullptr;
+		uint32_t argsSize = 0;
+
+		QString text;
+		uint64_t templateHash = 0;   // equal for repeats of the same message, used to collapse them
+	};
+
+	/**
+	 * @brief Fixed block of records plus the per-severity bitmaps built when it is indexed.
+	 */
+	struct LogChunk
+	{
+		static constexpr int kLines = 4096;
+		static constexpr int kWords = kLines / 64;
+		static constexpr int kArenaPage = 64 * 1024;
+
+		uint64_t firstSequence = 0;
+		std::array<LogRecord, kLines> records;
+		std::array<std::array<uint64_t, kWords>, static_cast<size_t>(LogSeverity::Count)> severityBits{};
+
+		// Packed arguments live in pages that never move, so records can point into them.
+		std::deque<std::unique_ptr<uint8_t[]>> argPages;
+		size_t argPageUsed = kArenaPage;
+
+		const uint8_t* StoreArgs(const uint8_t* data, size_t size);
+	};
+
+	/**
+	 * @brief Bounded, append-only store of every log line the editor produced this session.
+	 *
+	 * Lines are addressed by a monotonically increasing sequence number. Appends are
+	 * cheap (no formatting) and safe from any thread; old chunks are dropped once
+	 * the retention limit is hit. Readers hold chunks through shared_ptr, so a chunk
+	 * that is evicted mid-search stays valid until the search lets go of it.
+	 */
+	class LogStore
+	{
+	public:
+		static LogStore& Get();
+
+		void Append(uint32_t formatId, LogSeverity severity, uint16_t categoryId, int64_t unixNs, const BinaryLogArgs& args);
+
+		uint16_t RegisterCategory(const char* name);
+		QString CategoryName(uint16_t id) const;
+		QStringList CategoryNames() const;
+
+		uint64_t FirstRetained() const { return m_firstRetained.load(std::memory_order_acquire); }
+		uint64_t Appended() const { return m_appended.load(std::memory_order_acquire); }
+		uint64_t Indexed() const { return m_indexed.load(std::memory_order_acquire); }
+
+		std::shared_ptr<LogChunk> ChunkFor(uint64_t sequence) const;
+
+		/**
+		 * @brief Returns the formatted text of an indexed line, or an empty string if it was evicted.
+		 */
+		QString Text(uint64_t sequence) const;
+		const LogRecord* Record(const std::shared_ptr<LogChunk>& chunk, uint64_t sequence) const;
+
+		/**
+		 * @brief Called (at most once until AcknowledgeAppends) when new lines arrive. Once this
+		 *        returns, the previous listener is no longer running and won't be called again.
+		 */
+		void SetAppendListener(std::function<void()> listener);
+		void AcknowledgeAppends();
+
+		/** Indexer side: marks [Indexed(), end) as formatted and searchable. */
+		void PublishIndexed(uint64_t end);
+
+		void SetRetainedLines(uint64_t lines);
+		size_t MemoryBytes() const;
+
+	private:
+		LogStore() = default;
+
+	private:
+		mutable std::mutex m_mutex;
+		std::deque<std::shared_ptr<LogChunk>> m_chunks;
+		uint64_t m_retainedLines = 1024 * 1024;
+
+		std::atomic<uint64_t> m_firstRetained{ 0 };
+		std::atomic<uint64_t> m_appended{ 0 };
+		std::atomic<uint64_t> m_indexed{ 0 };
+
+		std::atomic<bool> m_notifyPending{ false };
+		std::recursive_mutex m_listenerMutex;       // recursive: the listener may itself log
+		std::function<void()> m_listener;
+
+		mutable std::mutex m_categoryMutex;
+		std::unordered_map<std::string, uint16_t> m_categoryIds;
+		std::vector<QString> m_categoryNames;
+	};
+}
+
+#endif
\ No newline at end of file
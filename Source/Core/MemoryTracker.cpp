@@ -0,0 +1,128 @@
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr int kTagCount = static_cast<int>(MemoryTag::Count);
+
+		const char* const kTagNames[kTagCount] = { "General", "Renderer", "Scene", "Assets", "UI", "Logging" };
+		const char* const kCounterNames[kTagCount] = { "Heap General", "Heap Renderer", "Heap Scene", "Heap Assets", "Heap UI", "Heap Logging" };
+
+		// Constant-initialized, so they are usable from operator new before any constructor runs.
+		std::atomic<uint64_t> s_liveBytes[kTagCount];
+		std::atomic<uint64_t> s_peakBytes[kTagCount];
+		std::atomic<uint64_t> s_allocations[kTagCount];
+
+		thread_local MemoryTag t_tag = MemoryTag::General;
+		thread_local uint64_t t_allocations = 0;
+
+#if ORCA_MEMORY_TRACKING
+		// Keeps the block behind it aligned like a plain malloc result.
+		struct alignas(alignof(std::max_align_t)) AllocationHeader
+		{
+			size_t size;
+			MemoryTag tag;
+		};
+
+		void* TrackedAllocate(size_t size)
+		{
+			void* block = std::malloc(sizeof(AllocationHeader) + size);
+			if (!block) return nullptr;
+
+			AllocationHeader* header = static_cast<AllocationHeader*>(block);
+			header->size = size;
+			header->tag = t_tag;
+
+			const int tag = static_cast<int>(header->tag);
+			const uint64_t live = s_liveBytes[tag].fetch_add(size, std::memory_order_relaxed) + size;
+			uint64_t peak = s_peakBytes[tag].load(std::memory_order_relaxed);
+			while (live > peak && !s_peakBytes[tag].compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+			s_allocations[tag].fetch_add(1, std::memory_order_relaxed);
+			++t_allocations;
+
+			return header + 1;
+		}
+
+		void TrackedFree(void* pointer)
+		{
+			if (!pointer) return;
+
+			AllocationHeader* header = static_cast<AllocationHeader*>(pointer) - 1;
+			s_liveBytes[static_cast<int>(header->tag)].fetch_sub(header->size, std::memory_order_relaxed);
+			std::free(header);
+		}
+
+		void* AllocateOrThrow(size_t size)
+		{
+			for (;;)
+			{
+				if (void* pointer = TrackedAllocate(size ? size : 1)) return pointer;
+
+				std::new_handler handler = std::get_new_handler();
+				if (!handler) throw std::bad_alloc();
+				handler();
+			}
+		}
+#endif
+	}
+
+	const char* MemoryTracker::TagName(MemoryTag tag)
+	{
+		return kTagNames[static_cast<int>(tag)];
+	}
+
+	MemoryTag MemoryTracker::CurrentTag()
+	{
+		return t_tag;
+	}
+
+	MemoryTag MemoryTracker::Exchange(MemoryTag tag)
+	{
+		const MemoryTag previous = t_tag;
+		t_tag = tag;
+		return previous;
+	}
+
+	MemoryTagStats MemoryTracker::Stats(MemoryTag tag)
+	{
+		const int index = static_cast<int>(tag);
+		MemoryTagStats stats;
+		stats.liveBytes = s_liveBytes[index].load(std::memory_order_relaxed);
+		stats.peakBytes = s_peakBytes[index].load(std::memory_order_relaxed);
+		stats.allocations = s_allocations[index].load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	uint64_t MemoryTracker::ThreadAllocations()
+	{
+		return t_allocations;
+	}
+
+	void MemoryTracker::PublishCounters()
+	{
+		for (int tag = 0; tag < kTagCount; ++tag)
+		{
+			ORCA_PROFILE_COUNTER(kCounterNames[tag], s_liveBytes[tag].load(std::memory_order_relaxed));
+		}
+	}
+}
+
+#if ORCA_MEMORY_TRACKING
+// Over-aligned types go through the align_val_t overloads, which keep their default pairing.
+void* operator new(std::size_t size) { return Orca::AllocateOrThrow(size); }
+void* operator new[](std::size_t size) { return Orca::AllocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Orca::TrackedAllocate(size ? size : 1); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Orca::TrackedAllocate(size ? size : 1); }
+
+void operator delete(void* pointer) noexcept { Orca::TrackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { Orca::TrackedFree(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { Orca::TrackedFree(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { Orca::TrackedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { Orca::TrackedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { Orca::TrackedFree(pointer); }
+#endif
\ No newline at end of file
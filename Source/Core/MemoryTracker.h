@@ -0,0 +1,93 @@
+#pragma once
+
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Heap tracking switch. With ORCA_MEMORY_TRACKING=0 the global operator new/delete are left
+ * alone and every counter reads zero; tag scopes still compile and cost nothing.
+ *
+ * Off by default on Windows: a replaced operator new only covers the executable, and Qt's DLLs
+ * delete objects the editor created (a QLabel handed to a layout, say) with their own runtime's
+ * operator delete, which can't free a tracked block. Only turn it on there with a static Qt.
+ */
+#ifndef ORCA_MEMORY_TRACKING
+#if defined(_WIN32)
+#define ORCA_MEMORY_TRACKING 0
+#else
+#define ORCA_MEMORY_TRACKING 1
+#endif
+#endif
+
+namespace Orca
+{
+	enum class MemoryTag : uint8_t
+	{
+		General,
+		Renderer,
+		Scene,
+		Assets,
+		UI,
+		Logging,
+		Count
+	};
+
+	struct MemoryTagStats
+	{
+		uint64_t liveBytes = 0;
+		uint64_t peakBytes = 0;
+		uint64_t allocations = 0;   // since start-up, on every thread
+	};
+
+	/**
+	 * @brief Per-subsystem heap accounting.
+	 *
+	 * The editor replaces the global operator new/delete; each allocation is charged to the
+	 * calling thread's current tag (see MemoryTagScope) and remembers it, so a block freed under
+	 * another tag is still credited back to the right one. Qt containers allocate with malloc and
+	 * are not seen, and on Windows Qt's DLLs use their own runtime, so subsystems that keep their
+	 * data in Qt types still report it through EditorStats memory reporters.
+	 */
+	class MemoryTracker
+	{
+	public:
+		static const char* TagName(MemoryTag tag);
+
+		static MemoryTag CurrentTag();
+		static MemoryTagStats Stats(MemoryTag tag);
+
+		/**
+		 * @brief operator new calls made by the calling thread so far; diff two reads to count a
+		 *        span. Other threads and direct malloc calls, Qt containers' included, aren't counted.
+		 */
+		static uint64_t ThreadAllocations();
+
+		/** @brief Reports live bytes per tag as profiler counters. */
+		static void PublishCounters();
+
+	private:
+		friend class MemoryTagScope;
+		static MemoryTag Exchange(MemoryTag tag);
+	};
+
+	/**
+	 * @brief Charges heap allocations made on this thread to @p tag until the scope ends.
+	 */
+	class MemoryTagScope
+	{
+	public:
+		explicit MemoryTagScope(MemoryTag tag) : m_previous(MemoryTracker::Exchange(tag)) {}
+		~MemoryTagScope() { MemoryTracker::Exchange(m_previous); }
+
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+	private:
+		MemoryTag m_previous;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "PlaySession.h"
+#include "EditorLog.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include "ProjectLoader.h"
+#include <QtCore/QThread>
+#include <algorithm>
+#include <chrono>
+
+namespace Orca
+{
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+	}
+
+	PlaySession::PlaySession(SceneSnapshot snapshot, std::shared_ptr<const LoadedScene> scene)
+		: m_snapshot(std::move(snapshot)), m_scene(std::move(scene))
+	{
+		m_thread = QThread::create([this]() { Run(); });
+		m_thread->setObjectName("Play Simulation");
+		m_thread->start(QThread::LowPriority);
+	}
+
+	PlaySession::~PlaySession()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_wakeMutex);
+			m_stop = true;
+		}
+		m_wake.notify_all();
+		m_thread->wait();
+		delete m_thread;
+	}
+
+	const PlayFrame& PlaySession::Latest()
+	{
+		m_frames.Acquire();
+		return m_frames.Front();
+	}
+
+	void PlaySession::Run()
+	{
+		MemoryTagScope memoryTag(MemoryTag::Scene);
+		Clone();
+		Publish(0.0);
+
+		const Clock::duration stepDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / kStepsPerSecond));
+		const float stepSeconds = 1.0f / kStepsPerSecond;
+		Clock::time_point next = Clock::now() + stepDuration;
+
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		while (!m_wake.wait_until(lock, next, [this]() { return m_stop.load(); }))
+		{
+			lock.unlock();
+
+			const Clock::time_point now = Clock::now();
+			double stepMs = 0.0;
+			for (int steps = 0; next <= now && steps < kMaxCatchUpSteps; ++steps)
+			{
+				const Clock::time_point start = Clock::now();
+				Step(stepSeconds);
+				stepMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+				next += stepDuration;
+			}
+
+			// Still behind: let simulated time slip rather than owe the steps.
+			if (next <= now)
+			{
+				const auto behind = (now - next) / stepDuration + 1;
+				m_droppedSteps += static_cast<uint64_t>(behind);
+				next += behind * stepDuration;
+			}
+
+			// Once per wake-up, however many steps ran; only the last state is shown.
+			UpdateWorldMatrices();
+			Publish(stepMs);
+
+			lock.lock();
+		}
+	}
+
+	void PlaySession::Clone()
+	{
+		ORCA_PROFILE_ZONE("PlaySession::Clone");
+		const SceneDocument& document = *m_snapshot.base;
+		const size_t count = m_snapshot.EntityCount();
+
+		m_transforms.resize(count);
+		for (size_t chunk = 0; chunk < m_snapshot.ChunkCount(); ++chunk)
+		{
+			const TransformData* transforms = m_snapshot.Transforms(chunk);
+			std::copy(transforms, transforms + m_snapshot.ChunkSize(chunk), m_transforms.begin() + m_snapshot.ChunkBegin(chunk));
+		}
+		m_worldMatrices.assign(count * 16, 0.0f);
+		m_placed.resize(count);
+
+		const std::vector<PropertyRecord>& sceneProperties = document.SceneProperties();
+		const PropertyRecord* gravity = FindProperty(document, sceneProperties.data(), sceneProperties.size(), "Scene.Environment.Gravity");
+		if (gravity && gravity->type == PropertyType::NumberArray && gravity->count >= 3)
+		{
+			for (uint32_t axis = 0; axis < 3; ++axis) m_gravity[axis] = document.PropertyNumber(*gravity, axis);
+		}
+
+		size_t scripts = 0;
+		const std::vector<ComponentRecord>& components = document.Components();
+		const std::vector<PropertyRecord>& properties = document.Properties();
+		for (uint32_t entity = 0; entity < count; ++entity)
+		{
+			const EntityRecord& record = document.Entities()[entity];
+			for (uint32_t c = record.firstComponent; c < record.firstComponent + record.componentCount; ++c)
+			{
+				const ComponentRecord& component = components[c];
+				const std::string_view type = document.Strings().View(component.typeId);
+				if (type == "ScriptComponent") ++scripts;
+				if (type != "RigidbodyComponent") continue;
+
+				Body body;
+				body.entity = entity;
+				const PropertyRecord* first = properties.data() + component.firstProperty;
+				if (const PropertyRecord* useGravity = FindProperty(document, first, component.propertyCount, "Properties.UseGravity"))
+				{
+					body.gravity = useGravity->type != PropertyType::Bool || useGravity->value != 0;
+				}
+				if (const PropertyRecord* drag = FindProperty(document, first, component.propertyCount, "Properties.Drag"))
+				{
+					body.drag = std::max(0.0f, document.PropertyNumber(*drag));
+				}
+				m_bodies.push_back(body);
+			}
+		}
+
+		ORCA_LOG_INFO("Play", "Playing {} entities, {} rigidbodies at {} Hz", count, m_bodies.size(), kStepsPerSecond);
+		if (scripts > 0)
+		{
+			ORCA_LOG_WARNING("Play", "{} script components are not run: the editor has no script runtime", scripts);
+		}
+
+		UpdateWorldMatrices();
+	}
+
+	void PlaySession::Step(float deltaSeconds)
+	{
+		ORCA_PROFILE_ZONE("PlaySession::Step");
+
+		for (Body& body : m_bodies)
+		{
+			TransformData& transform = m_transforms[body.entity];
+			const float damping = 1.0f / (1.0f + body.drag * deltaSeconds);
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				if (body.gravity) body.velocity[axis] += m_gravity[axis] * deltaSeconds;
+				body.velocity[axis] *= damping;
+				transform.position[axis] += body.velocity[axis] * deltaSeconds;
+			}
+		}
+		++m_step;
+	}
+
+	void PlaySession::UpdateWorldMatrices()
+	{
+		// Nothing moves without bodies, so the matrices from the clone stay valid.
+		if (m_bodies.empty() && m_step > 0) return;
+
+		ORCA_PROFILE_ZONE("PlaySession::UpdateWorldMatrices");
+		const std::vector<EntityRecord>& entities = m_snapshot.base->Entities();
+		const size_t count = m_transforms.size();
+
+		// Same rules as ProjectLoader::Instantiate: a parent not placed yet (a cycle) is ignored.
+		std::fill(m_placed.begin(), m_placed.end(), 0);
+		for (uint32_t entity : m_scene->hierarchyOrder)
+		{
+			const uint32_t parent = entities[entity].parent;
+			const float* parentWorld = parent < count && m_placed[parent] ? m_worldMatrices.data() + static_cast<size_t>(parent) * 16 : nullptr;
+			m_placed[entity] = 1;
+			ComposeWorldMatrix(m_transforms[entity], parentWorld, m_worldMatrices.data() + static_cast<size_t>(entity) * 16);
+		}
+	}
+
+	void PlaySession::Publish(double stepMs)
+	{
+		// Assignment reuses each slot's capacity, so steady-state publishing doesn't allocate.
+		PlayFrame& frame = m_frames.Back();
+		frame.step = m_step;
+		frame.simulatedSeconds = static_cast<double>(m_step) / kStepsPerSecond;
+		frame.stepMs = stepMs;
+		frame.droppedSteps = m_droppedSteps;
+		frame.transforms = m_transforms;
+		frame.worldMatrices = m_worldMatrices;
+		m_frames.Publish();
+
+		ORCA_PROFILE_COUNTER("Play step ms", stepMs);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+
+#ifndef PLAY_SESSION_H
+#define PLAY_SESSION_H
+
+#include "TripleBuffer.h"
+#include "../Document/EditableScene.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class QThread;
+
+namespace Orca
+{
+	struct LoadedScene;
+
+	/**
+	 * @brief Scene state after one simulation step, as the editor shows it. Empty until the
+	 *        simulation thread has cloned the scene.
+	 */
+	struct PlayFrame
+	{
+		uint64_t step = 0;                          // 0 for the cloned starting state
+		double simulatedSeconds = 0.0;
+		double stepMs = 0.0;                        // wall time the step took on the simulation thread
+		uint64_t droppedSteps = 0;                  // steps skipped because the simulation fell behind
+		std::vector<TransformData> transforms;      // per entity, as in the edit scene
+		std::vector<float> worldMatrices;           // 16 floats per entity, column-major
+	};
+
+	/**
+	 * @brief Play mode: a copy of the edit scene stepped at a fixed rate on its own thread.
+	 *
+	 * The edit scene is never touched; the session clones a snapshot of it. Every step is
+	 * published through a triple buffer, so GUI readers pick up the newest complete frame
+	 * without locks and the simulation never waits for them. The thread runs below the GUI's
+	 * priority, and when a step takes longer than its slot the simulation drops steps (slowing
+	 * simulated time) instead of piling up work.
+	 *
+	 * Entities with a RigidbodyComponent fall under Scene.Environment.Gravity unless their
+	 * Properties.UseGravity is false, slowed by Properties.Drag; children follow their parents.
+	 * ScriptComponents are not run, as the editor has no script runtime.
+	 */
+	class PlaySession
+	{
+	public:
+		static constexpr int kStepsPerSecond = 60;
+
+		/** @brief Steps run back to back after a late wake-up before the rest are dropped. */
+		static constexpr int kMaxCatchUpSteps = 4;
+
+		/**
+		 * @brief Starts simulating a clone of @p snapshot. @p scene supplies the hierarchy order
+		 *        and must come from the same document.
+		 */
+		PlaySession(SceneSnapshot snapshot, std::shared_ptr<const LoadedScene> scene);
+
+		/** @brief Stops the simulation and waits for its thread. */
+		~PlaySession();
+
+		PlaySession(const PlaySession&) = delete;
+		PlaySession& operator=(const PlaySession&) = delete;
+
+		/**
+		 * @brief The newest published frame; stays unchanged until the next call. GUI thread only,
+		 *        so everything reading it during one editor tick sees the same step.
+		 */
+		const PlayFrame& Latest();
+
+	private:
+		struct Body
+		{
+			uint32_t entity = 0;
+			float velocity[3] = { 0.0f, 0.0f, 0.0f };
+			float drag = 0.0f;
+			bool gravity = true;
+		};
+
+		void Run();
+		void Clone();
+		void Step(float deltaSeconds);
+		void UpdateWorldMatrices();
+		void Publish(double stepMs);
+
+	private:
+		SceneSnapshot m_snapshot;
+		std::shared_ptr<const LoadedScene> m_scene;
+
+		QThread* m_thread = nullptr;
+		std::mutex m_wakeMutex;
+		std::condition_variable m_wake;
+		std::atomic<bool> m_stop{ false };
+
+		// Simulation thread only.
+		std::vector<TransformData> m_transforms;
+		std::vector<float> m_worldMatrices;
+		std::vector<Body> m_bodies;
+		std::vector<uint8_t> m_placed;
+		float m_gravity[3] = { 0.0f, -9.81f, 0.0f };
+		uint64_t m_step = 0;
+		uint64_t m_droppedSteps = 0;
+
+		TripleBuffer<PlayFrame> m_frames;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,360 @@
+#include "Profiler.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMap>
+#include <QtCore/QThread>
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+
+namespace Orca
+{
+	namespace
+	{
+		// Capacities are powers of two so ring positions are a mask away.
+		static_assert((Profiler::kZonesPerThread & (Profiler::kZonesPerThread - 1)) == 0, "zone ring must be a power of two");
+		static_assert((Profiler::kCountersPerThread & (Profiler::kCountersPerThread - 1)) == 0, "counter ring must be a power of two");
+
+		// Frames get their own lane in saved captures.
+		constexpr quint32 kFrameLane = 0;
+
+		QByteArray JsonEscaped(const QByteArray& text)
+		{
+			QByteArray out;
+			out.reserve(text.size());
+			for (char c : text)
+			{
+				if (c == '"' || c == '\\') out += '\\';
+				out += c;
+			}
+			return out;
+		}
+
+		QByteArray Microseconds(qint64 ns)
+		{
+			return QByteArray::number(ns / 1000.0, 'f', 3);
+		}
+
+		/**
+		 * Copies the live part of a ring written by another thread. Entries the writer lapped
+		 * while they were being read may be torn and are dropped.
+		 */
+		template <typename T, typename Keep>
+		void CopyRing(const T* ring, size_t capacity, const std::atomic<uint64_t>& head, std::vector<T>& out, Keep keep)
+		{
+			const uint64_t end = head.load(std::memory_order_acquire);
+			const uint64_t begin = end > capacity ? end - capacity : 0;
+
+			std::vector<T> copy;
+			copy.reserve(static_cast<size_t>(end - begin));
+			for (uint64_t i = begin; i < end; ++i) copy.push_back(ring[i & (capacity - 1)]);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			const uint64_t after = head.load(std::memory_order_relaxed);
+			// The writer may be midway through entry `after`, whose slot is that of `after - capacity`.
+			const uint64_t firstIntact = after + 1 > capacity ? after + 1 - capacity : 0;
+			const size_t torn = static_cast<size_t>(std::min<uint64_t>(firstIntact > begin ? firstIntact - begin : 0, copy.size()));
+
+			for (size_t i = torn; i < copy.size(); ++i)
+			{
+				if (keep(copy[i])) out.push_back(copy[i]);
+			}
+		}
+
+		// Zones are recorded when they end, so children come before their parents.
+		void AssignDepths(std::vector<ProfileZone>& zones)
+		{
+			std::sort(zones.begin(), zones.end(), [](const ProfileZone& a, const ProfileZone& b)
+			{
+				return a.beginNs != b.beginNs ? a.beginNs < b.beginNs : a.endNs > b.endNs;
+			});
+
+			std::vector<qint64> open;
+			for (ProfileZone& zone : zones)
+			{
+				while (!open.empty() && open.back() <= zone.beginNs) open.pop_back();
+				zone.depth = static_cast<int>(open.size());
+				open.push_back(zone.endNs);
+			}
+		}
+	}
+
+	struct Profiler::ThreadBuffer
+	{
+		quint32 id = 0;
+		QString name;
+		bool inUse = true;
+
+		std::unique_ptr<ProfileZone[]> zones{ new ProfileZone[kZonesPerThread] };
+		std::atomic<uint64_t> zoneHead{ 0 };
+
+		std::unique_ptr<ProfileCounterSample[]> counters{ new ProfileCounterSample[kCountersPerThread] };
+		std::atomic<uint64_t> counterHead{ 0 };
+	};
+
+	// Hands the thread's buffer back when the thread exits, so pooled threads that come and
+	// go reuse a handful of buffers instead of allocating a new one each time.
+	struct Profiler::LocalSlot
+	{
+		ThreadBuffer* buffer = nullptr;
+
+		~LocalSlot()
+		{
+			if (buffer) Profiler::Get().Release(buffer);
+		}
+	};
+
+	Profiler& Profiler::Get()
+	{
+		static Profiler s_profiler;
+		return s_profiler;
+	}
+
+	const char* Profiler::Intern(const QByteArray& name)
+	{
+		static QMutex s_mutex;
+		static std::unordered_set<std::string> s_names;
+
+		QMutexLocker locker(&s_mutex);
+		return s_names.emplace(name.constData(), static_cast<size_t>(name.size())).first->c_str();
+	}
+
+	Profiler::ThreadBuffer& Profiler::LocalBuffer()
+	{
+		thread_local LocalSlot slot;
+		if (slot.buffer) return *slot.buffer;
+
+		QMutexLocker locker(&m_mutex);
+		auto retired = std::find_if(m_threads.begin(), m_threads.end(), [](const std::unique_ptr<ThreadBuffer>& buffer) { return !buffer->inUse; });
+		if (retired != m_threads.end())
+		{
+			slot.buffer = retired->get();
+			slot.buffer->zoneHead.store(0, std::memory_order_relaxed);
+			slot.buffer->counterHead.store(0, std::memory_order_relaxed);
+			slot.buffer->inUse = true;
+		}
+		else
+		{
+			m_threads.push_back(std::make_unique<ThreadBuffer>());
+			slot.buffer = m_threads.back().get();
+		}
+
+		slot.buffer->id = m_nextThreadId++;
+		const QThread* thread = QThread::currentThread();
+		if (!thread->objectName().isEmpty()) slot.buffer->name = thread->objectName();
+		else if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) slot.buffer->name = "Main";
+		else slot.buffer->name = QString("Thread %1").arg(slot.buffer->id);
+		return *slot.buffer;
+	}
+
+	void Profiler::Release(ThreadBuffer* buffer)
+	{
+		QMutexLocker locker(&m_mutex);
+		buffer->inUse = false;
+	}
+
+	void Profiler::SetThreadName(const QString& name)
+	{
+		ThreadBuffer& buffer = LocalBuffer();
+		QMutexLocker locker(&m_mutex);
+		buffer.name = name;
+	}
+
+	void Profiler::RecordZone(const char* name, qint64 beginNs, qint64 endNs)
+	{
+		ThreadBuffer& buffer = LocalBuffer();
+		const uint64_t head = buffer.zoneHead.load(std::memory_order_relaxed);
+		buffer.zones[head & (kZonesPerThread - 1)] = { name, beginNs, endNs, 0 };
+		buffer.zoneHead.store(head + 1, std::memory_order_release);
+	}
+
+	void Profiler::RecordCounter(const char* name, double value)
+	{
+		ThreadBuffer& buffer = LocalBuffer();
+		const uint64_t head = buffer.counterHead.load(std::memory_order_relaxed);
+		buffer.counters[head & (kCountersPerThread - 1)] = { name, NowNs(), value };
+		buffer.counterHead.store(head + 1, std::memory_order_release);
+	}
+
+	uint64_t Profiler::MarkFrame()
+	{
+		const qint64 now = NowNs();
+
+		QMutexLocker locker(&m_mutex);
+		if (m_frameCount > 0) m_frames[(m_frameCount - 1) % kMaxFrames].endNs = now;
+
+		ProfileFrame& frame = m_frames[m_frameCount % kMaxFrames];
+		frame = ProfileFrame();
+		frame.index = m_frameCount;
+		frame.beginNs = now;
+		return m_frameCount++;
+	}
+
+	uint64_t Profiler::CurrentFrame() const
+	{
+		QMutexLocker locker(&m_mutex);
+		return m_frameCount > 0 ? m_frameCount - 1 : 0;
+	}
+
+	void Profiler::RecordGpuTime(uint64_t frame, double gpuMs)
+	{
+		QMutexLocker locker(&m_mutex);
+		if (frame >= m_frameCount || m_frameCount - frame > kMaxFrames) return;
+
+		ProfileFrame& entry = m_frames[frame % kMaxFrames];
+		entry.gpuMs = std::max(entry.gpuMs, 0.0) + gpuMs;
+	}
+
+	ProfileCapture Profiler::Capture(qint64 sinceNs) const
+	{
+		ProfileCapture capture;
+		capture.beginNs = sinceNs;
+		capture.endNs = NowNs();
+
+		QMutexLocker locker(&m_mutex);
+		for (const std::unique_ptr<ThreadBuffer>& buffer : m_threads)
+		{
+			ProfileThread thread;
+			thread.id = buffer->id;
+			thread.name = buffer->name;
+			CopyRing(buffer->zones.get(), kZonesPerThread, buffer->zoneHead, thread.zones,
+				[sinceNs](const ProfileZone& zone) { return zone.beginNs >= sinceNs; });
+			CopyRing(buffer->counters.get(), kCountersPerThread, buffer->counterHead, capture.counters,
+				[sinceNs](const ProfileCounterSample& sample) { return sample.timeNs >= sinceNs; });
+
+			if (thread.zones.empty()) continue;
+			AssignDepths(thread.zones);
+			capture.threads.push_back(std::move(thread));
+		}
+
+		// The newest frame is still open.
+		const uint64_t first = m_frameCount > kMaxFrames ? m_frameCount - kMaxFrames : 0;
+		for (uint64_t i = first; i + 1 < m_frameCount; ++i)
+		{
+			const ProfileFrame& frame = m_frames[i % kMaxFrames];
+			if (frame.beginNs >= sinceNs) capture.frames.push_back(frame);
+		}
+		locker.unlock();
+
+		std::sort(capture.counters.begin(), capture.counters.end(), [](const ProfileCounterSample& a, const ProfileCounterSample& b) { return a.timeNs < b.timeNs; });
+		return capture;
+	}
+
+	bool ProfileCapture::Save(const QString& path, QString* error) const
+	{
+		QFile file(path);
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+			if (error) *error = file.errorString();
+			return false;
+		}
+
+		QByteArray json;
+		json.reserve(64 * 1024);
+		json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + QByteArray::number(kFrameLane) + ",\"args\":{\"name\":\"Frames\"}}";
+
+		for (const ProfileFrame& frame : frames)
+		{
+			json += ",\n{\"name\":\"Frame " + QByteArray::number(frame.index) + "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":" + QByteArray::number(kFrameLane)
+				+ ",\"ts\":" + Microseconds(frame.beginNs - beginNs) + ",\"dur\":" + Microseconds(frame.endNs - frame.beginNs)
+				+ ",\"args\":{\"index\":" + QByteArray::number(frame.index) + ",\"gpuMs\":" + QByteArray::number(frame.gpuMs, 'f', 4) + "}}";
+		}
+
+		for (const ProfileThread& thread : threads)
+		{
+			const QByteArray tid = QByteArray::number(thread.id);
+			json += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":\"" + JsonEscaped(thread.name.toUtf8()) + "\"}}";
+			for (const ProfileZone& zone : thread.zones)
+			{
+				json += ",\n{\"name\":\"" + JsonEscaped(zone.name) + "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid
+					+ ",\"ts\":" + Microseconds(zone.beginNs - beginNs) + ",\"dur\":" + Microseconds(zone.endNs - zone.beginNs) + "}";
+			}
+		}
+
+		for (const ProfileCounterSample& sample : counters)
+		{
+			json += ",\n{\"name\":\"" + JsonEscaped(sample.name) + "\",\"ph\":\"C\",\"pid\":1,\"ts\":" + Microseconds(sample.timeNs - beginNs)
+				+ ",\"args\":{\"value\":" + QByteArray::number(sample.value, 'g', 10) + "}}";
+		}
+		json += "\n]}\n";
+
+		if (file.write(json) != json.size())
+		{
+			if (error) *error = file.errorString();
+			return false;
+		}
+		return true;
+	}
+
+	bool ProfileCapture::Load(const QString& path, ProfileCapture& capture, QString* error)
+	{
+		QFile file(path);
+		if (!file.open(QIODevice::ReadOnly))
+		{
+			if (error) *error = file.errorString();
+			return false;
+		}
+
+		QJsonParseError parseError;
+		const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+		if (!document.isObject())
+		{
+			if (error) *error = parseError.error != QJsonParseError::NoError ? parseError.errorString() : QString("not a trace file");
+			return false;
+		}
+
+		ProfileCapture loaded;
+		QMap<quint32, ProfileThread> threads;
+		const QJsonArray events = document.object().value("traceEvents").toArray();
+		for (const QJsonValue& value : events)
+		{
+			const QJsonObject event = value.toObject();
+			const QString phase = event.value("ph").toString();
+			const quint32 tid = static_cast<quint32>(event.value("tid").toInt());
+			const QJsonObject args = event.value("args").toObject();
+			const qint64 beginNs = static_cast<qint64>(event.value("ts").toDouble() * 1000.0);
+			const qint64 endNs = beginNs + static_cast<qint64>(event.value("dur").toDouble() * 1000.0);
+			loaded.endNs = std::max(loaded.endNs, endNs);
+
+			if (phase == "M")
+			{
+				if (event.value("name").toString() == "thread_name" && tid != kFrameLane) threads[tid].name = args.value("name").toString();
+			}
+			else if (phase == "X" && event.value("cat").toString() == "frame")
+			{
+				ProfileFrame frame;
+				frame.index = static_cast<uint64_t>(args.value("index").toDouble());
+				frame.beginNs = beginNs;
+				frame.endNs = endNs;
+				frame.gpuMs = args.value("gpuMs").toDouble(-1.0);
+				loaded.frames.push_back(frame);
+			}
+			else if (phase == "X")
+			{
+				threads[tid].zones.push_back({ Profiler::Intern(event.value("name").toString().toUtf8()), beginNs, endNs, 0 });
+			}
+			else if (phase == "C")
+			{
+				loaded.counters.push_back({ Profiler::Intern(event.value("name").toString().toUtf8()), beginNs, args.value("value").toDouble() });
+			}
+		}
+
+		for (auto it = threads.begin(); it != threads.end(); ++it)
+		{
+			if (it->zones.empty()) continue;
+			it->id = it.key();
+			if (it->name.isEmpty()) it->name = QString("Thread %1").arg(it.key());
+			AssignDepths(it->zones);
+			loaded.threads.push_back(std::move(*it));
+		}
+
+		std::sort(loaded.frames.begin(), loaded.frames.end(), [](const ProfileFrame& a, const ProfileFrame& b) { return a.index < b.index; });
+		std::sort(loaded.counters.begin(), loaded.counters.end(), [](const ProfileCounterSample& a, const ProfileCounterSample& b) { return a.timeNs < b.timeNs; });
+		capture = std::move(loaded);
+		return true;
+	}
+}
\ No newline at end of file
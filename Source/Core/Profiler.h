@@ -0,0 +1,171 @@
+#pragma once
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Instrumentation switch. Builds with ORCA_PROFILER=0 compile every ORCA_PROFILE_* macro to
+ * nothing; the Profiler class itself stays so saved captures can still be opened.
+ */
+#ifndef ORCA_PROFILER
+#define ORCA_PROFILER 1
+#endif
+
+namespace Orca
+{
+	struct ProfileZone
+	{
+		const char* name = nullptr;
+		qint64 beginNs = 0;
+		qint64 endNs = 0;
+		int depth = 0;              // nesting level within its thread, 0 = outermost
+	};
+
+	struct ProfileCounterSample
+	{
+		const char* name = nullptr;
+		qint64 timeNs = 0;
+		double value = 0.0;
+	};
+
+	struct ProfileFrame
+	{
+		uint64_t index = 0;
+		qint64 beginNs = 0;
+		qint64 endNs = 0;
+		double gpuMs = -1.0;        // negative until the timer query resolves
+
+		double CpuMs() const { return (endNs - beginNs) / 1e6; }
+	};
+
+	struct ProfileThread
+	{
+		quint32 id = 0;
+		QString name;
+		std::vector<ProfileZone> zones;     // sorted by begin time, depths assigned
+	};
+
+	/**
+	 * @brief A window of recorded frames, zones and counters, taken live from the Profiler or
+	 *        loaded from disk. Names point at interned strings and stay valid for the process.
+	 */
+	struct ProfileCapture
+	{
+		qint64 beginNs = 0;
+		qint64 endNs = 0;
+		std::vector<ProfileFrame> frames;
+		std::vector<ProfileThread> threads;
+		std::vector<ProfileCounterSample> counters;
+
+		/** @brief Writes a Chrome trace, so captures also open in chrome://tracing and ui.perfetto.dev. */
+		bool Save(const QString& path, QString* error = nullptr) const;
+		static bool Load(const QString& path, ProfileCapture& capture, QString* error = nullptr);
+	};
+
+	/**
+	 * @brief Always-on, low-overhead instrumentation behind the ORCA_PROFILE_* macros.
+	 *
+	 * Each thread writes zones and counter samples into its own fixed-size ring without locking;
+	 * the oldest entries are overwritten, so a capture holds roughly the last kZonesPerThread
+	 * zones of every thread. Frame markers come from the viewport. Capture() copies the rings out
+	 * and is meant for the GUI thread a few times a second at most.
+	 */
+	class Profiler
+	{
+	public:
+		static constexpr size_t kZonesPerThread = size_t(1) << 14;
+		static constexpr size_t kCountersPerThread = size_t(1) << 12;
+		static constexpr size_t kMaxFrames = 1024;
+
+		static Profiler& Get();
+
+		static qint64 NowNs()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		/** @brief Returns a copy of @p name that lives as long as the process, for zones with runtime names. */
+		static const char* Intern(const QByteArray& name);
+
+		/** @brief Names the calling thread's lane in the timeline. */
+		void SetThreadName(const QString& name);
+
+		void RecordZone(const char* name, qint64 beginNs, qint64 endNs);
+		void RecordCounter(const char* name, double value);
+
+		/**
+		 * @brief Starts a new frame (ending the previous one) and returns its index. The editor
+		 *        tick calls it once per tick, however many viewports paint in between.
+		 */
+		uint64_t MarkFrame();
+
+		/** @brief Index of the frame in progress. */
+		uint64_t CurrentFrame() const;
+
+		/** @brief Adds a view's GPU time to a frame, so views painted in one tick add up. */
+		void RecordGpuTime(uint64_t frame, double gpuMs);
+
+		/** @brief Everything still in the rings that started at or after @p sinceNs. */
+		ProfileCapture Capture(qint64 sinceNs) const;
+
+	private:
+		Profiler() = default;
+
+		struct ThreadBuffer;
+		struct LocalSlot;
+		ThreadBuffer& LocalBuffer();
+		void Release(ThreadBuffer* buffer);
+
+	private:
+		mutable QMutex m_mutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+		std::vector<ProfileFrame> m_frames = std::vector<ProfileFrame>(kMaxFrames);
+		uint64_t m_frameCount = 0;
+		quint32 m_nextThreadId = 1;
+	};
+
+	/**
+	 * @brief RAII zone. @p name must be a string literal or come from Profiler::Intern.
+	 */
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(const char* name) : m_name(name), m_beginNs(Profiler::NowNs()) {}
+		~ProfileScope() { Profiler::Get().RecordZone(m_name, m_beginNs, Profiler::NowNs()); }
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		const char* m_name;
+		qint64 m_beginNs;
+	};
+}
+
+#define ORCA_PROFILE_CONCAT_INNER(a, b) a##b
+#define ORCA_PROFILE_CONCAT(a, b) ORCA_PROFILE_CONCAT_INNER(a, b)
+
+#if ORCA_PROFILER
+#define ORCA_PROFILE_ZONE(name) ::Orca::ProfileScope ORCA_PROFILE_CONCAT(orcaProfileZone, __LINE__)(name)
+#define ORCA_PROFILE_COUNTER(name, value) ::Orca::Profiler::Get().RecordCounter(name, static_cast<double>(value))
+#define ORCA_PROFILE_FRAME() ::Orca::Profiler::Get().MarkFrame()
+#define ORCA_PROFILE_CURRENT_FRAME() ::Orca::Profiler::Get().CurrentFrame()
+#define ORCA_PROFILE_GPU(frame, gpuMs) ::Orca::Profiler::Get().RecordGpuTime(frame, gpuMs)
+#else
+#define ORCA_PROFILE_ZONE(name) ((void)0)
+#define ORCA_PROFILE_COUNTER(name, value) ((void)0)
+#define ORCA_PROFILE_FRAME() (uint64_t(0))
+#define ORCA_PROFILE_CURRENT_FRAME() (uint64_t(0))
+#define ORCA_PROFILE_GPU(frame, gpuMs) ((void)0)
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,443 @@
+#include "ProjectLoader.h"
+#include "EditorLog.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include "../Asset/AssetDatabase.h"
+#include "../Document/SceneFile.h"
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QThread>
+#include <QtGui/QMatrix4x4>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr uint32_t kProgressInterval = 65536;
+
+		float NumberOr(const SceneDocument& document, const PropertyRecord* property, float fallback)
+		{
+			return property && (property->type == PropertyType::Number || property->type == PropertyType::NumberArray)
+				? document.PropertyNumber(*property) : fallback;
+		}
+
+		void CollectLights(const SceneDocument& document, LoadedScene& scene)
+		{
+			const std::vector<PropertyRecord>& sceneProperties = document.SceneProperties();
+			const PropertyRecord* ambient = FindProperty(document, sceneProperties.data(), sceneProperties.size(), "Scene.Environment.AmbientLight");
+			if (ambient && ambient->type == PropertyType::NumberArray && ambient->count >= 3)
+			{
+				for (uint32_t c = 0; c < 3; ++c) scene.ambientLight[c] = document.PropertyNumber(*ambient, c);
+			}
+
+			const std::vector<EntityRecord>& entities = document.Entities();
+			const std::vector<ComponentRecord>& components = document.Components();
+			const std::vector<PropertyRecord>& properties = document.Properties();
+			for (uint32_t entity = 0; entity < entities.size(); ++entity)
+			{
+				const EntityRecord& record = entities[entity];
+				for (uint32_t c = record.firstComponent; c < record.firstComponent + record.componentCount; ++c)
+				{
+					const ComponentRecord& component = components[c];
+					if (document.Strings().View(component.typeId) != "LightComponent") continue;
+
+					const PropertyRecord* first = properties.data() + component.firstProperty;
+					auto find = [&](std::string_view name) { return FindProperty(document, first, component.propertyCount, name); };
+
+					SceneLight light;
+					light.entity = entity;
+					const PropertyRecord* type = find("Properties.Type");
+					const std::string_view typeName = type && type->type == PropertyType::String ? document.Strings().View(type->value) : std::string_view("Point");
+					if (typeName == "Directional") light.type = SceneLightType::Directional;
+					else if (typeName == "Spot") light.type = SceneLightType::Spot;
+					else if (typeName != "Point") continue;
+
+					const float intensity = std::max(0.0f, NumberOr(document, find("Properties.Intensity"), 1.0f));
+					const PropertyRecord* color = find("Properties.Color");
+					for (uint32_t channel = 0; channel < 3; ++channel)
+					{
+						const float value = color && color->type == PropertyType::NumberArray && color->count > channel ? document.PropertyNumber(*color, channel) : 1.0f;
+						light.color[channel] = std::max(0.0f, value) * intensity;
+					}
+					light.range = std::max(0.01f, NumberOr(document, find("Properties.Range"), light.range));
+					light.outerAngle = std::clamp(NumberOr(document, find("Properties.SpotAngle"), light.outerAngle), 1.0f, 179.0f);
+					light.innerAngle = std::clamp(NumberOr(document, find("Properties.InnerSpotAngle"), 0.8f * light.outerAngle), 0.0f, light.outerAngle);
+					scene.lights.push_back(light);
+				}
+			}
+		}
+
+		void CollectCamera(const SceneDocument& document, LoadedScene& scene)
+		{
+			const std::vector<EntityRecord>& entities = document.Entities();
+			const std::vector<ComponentRecord>& components = document.Components();
+			const std::vector<PropertyRecord>& properties = document.Properties();
+			for (uint32_t entity = 0; entity < entities.size(); ++entity)
+			{
+				const EntityRecord& record = entities[entity];
+				for (uint32_t c = record.firstComponent; c < record.firstComponent + record.componentCount; ++c)
+				{
+					const ComponentRecord& component = components[c];
+					if (document.Strings().View(component.typeId) != "CameraComponent") continue;
+
+					const PropertyRecord* first = properties.data() + component.firstProperty;
+					auto find = [&](std::string_view name) { return FindProperty(document, first, component.propertyCount, name); };
+
+					SceneCamera& camera = scene.camera;
+					camera.entity = entity;
+					camera.fieldOfView = std::clamp(NumberOr(document, find("Properties.FOV"), camera.fieldOfView), 1.0f, 179.0f);
+					camera.nearPlane = std::max(0.001f, NumberOr(document, find("Properties.NearPlane"), camera.nearPlane));
+					camera.farPlane = std::max(camera.nearPlane * 2.0f, NumberOr(document, find("Properties.FarPlane"), camera.farPlane));
+					return;
+				}
+			}
+		}
+
+		void CollectRenderFlags(const SceneDocument& document, LoadedScene& scene)
+		{
+			const std::vector<EntityRecord>& entities = document.Entities();
+			const std::vector<ComponentRecord>& components = document.Components();
+			const std::vector<PropertyRecord>& properties = document.Properties();
+			scene.renderFlags.assign(entities.size(), 0);
+			for (uint32_t entity = 0; entity < entities.size(); ++entity)
+			{
+				const EntityRecord& record = entities[entity];
+				for (uint32_t c = record.firstComponent; c < record.firstComponent + record.componentCount; ++c)
+				{
+					const ComponentRecord& component = components[c];
+					const std::string_view type = document.Strings().View(component.typeId);
+					if (type == "RigidbodyComponent") scene.renderFlags[entity] |= LoadedScene::kDynamic;
+					if (type != "MeshRenderer" && type != "MeshRendererComponent") continue;
+
+					const PropertyRecord* first = properties.data() + component.firstProperty;
+					const PropertyRecord* castShadows = FindProperty(document, first, component.propertyCount, "Properties.CastShadows");
+					if (!castShadows || castShadows->type != PropertyType::Bool || castShadows->value != 0)
+					{
+						scene.renderFlags[entity] |= LoadedScene::kCastsShadows;
+					}
+
+					// Off unless asked for: only large, solid meshes make good occluders.
+					const PropertyRecord* occluder = FindProperty(document, first, component.propertyCount, "Properties.Occluder");
+					if (occluder && occluder->type == PropertyType::Bool && occluder->value != 0)
+					{
+						scene.renderFlags[entity] |= LoadedScene::kOccluder;
+					}
+				}
+			}
+
+			// Parents come first, so a rigidbody's whole subtree is dynamic after one pass.
+			for (uint32_t entity : scene.hierarchyOrder)
+			{
+				const uint32_t parent = entities[entity].parent;
+				if (parent < entities.size() && (scene.renderFlags[parent] & LoadedScene::kDynamic)) scene.renderFlags[entity] |= LoadedScene::kDynamic;
+			}
+		}
+	}
+
+	const PropertyRecord* FindProperty(const SceneDocument& document, const PropertyRecord* first, size_t count, std::string_view name)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (document.Strings().View(first[i].nameId) == name) return first + i;
+		}
+		return nullptr;
+	}
+
+	void ComposeWorldMatrix(const TransformData& transform, const float* parentWorld, float* world)
+	{
+		QMatrix4x4 local;
+		local.translate(transform.position[0], transform.position[1], transform.position[2]);
+		local.rotate(transform.rotation[1], 0.0f, 1.0f, 0.0f);
+		local.rotate(transform.rotation[0], 1.0f, 0.0f, 0.0f);
+		local.rotate(transform.rotation[2], 0.0f, 0.0f, 1.0f);
+		local.scale(transform.scale[0], transform.scale[1], transform.scale[2]);
+
+		if (parentWorld)
+		{
+			local = QMatrix4x4(parentWorld).transposed() * local;
+		}
+		std::memcpy(world, local.constData(), 16 * sizeof(float));
+	}
+
+	ProjectLoader::ProjectLoader(QObject* parent)
+		: QObject(parent)
+	{
+		m_uploadTimer.setInterval(0);
+		connect(&m_uploadTimer, &QTimer::timeout, this, &ProjectLoader::UploadNextSlice);
+	}
+
+	ProjectLoader::~ProjectLoader()
+	{
+		m_cancel = true;
+		if (m_thread)
+		{
+			m_thread->wait();
+			delete m_thread;
+		}
+	}
+
+	QString ProjectLoader::StageName(ProjectLoadStage stage)
+	{
+		switch (stage)
+		{
+		case ProjectLoadStage::Parse: return "Reading scene";
+		case ProjectLoadStage::Assets: return "Checking assets";
+		case ProjectLoadStage::Instantiate: return "Building scene";
+		case ProjectLoadStage::Upload: return "Uploading to GPU";
+		}
+		return QString();
+	}
+
+	void ProjectLoader::Start(const QString& projectFile)
+	{
+		if (m_running) return;
+
+		m_projectFile = QFileInfo(projectFile).absoluteFilePath();
+		m_projectRoot = QFileInfo(projectFile).absolutePath();
+		m_cancel = false;
+		m_running = true;
+		m_uploaded = 0;
+
+		if (m_thread)
+		{
+			m_thread->wait();
+			delete m_thread;
+		}
+
+		m_thread = QThread::create([this]() { Run(); });
+		m_thread->setObjectName("ProjectLoader");
+		m_thread->start();
+	}
+
+	void ProjectLoader::Cancel()
+	{
+		if (!m_running) return;
+		m_cancel = true;
+
+		// The worker notices on its own; the upload runs here, so stop it directly.
+		if (m_uploadTimer.isActive())
+		{
+			m_uploadTimer.stop();
+			Finish(false, "Cancelled");
+		}
+	}
+
+	std::shared_ptr<const SceneDocument> ProjectLoader::Document() const
+	{
+		QMutexLocker locker(&m_mutex);
+		return m_document;
+	}
+
+	std::shared_ptr<const LoadedScene> ProjectLoader::Scene() const
+	{
+		QMutexLocker locker(&m_mutex);
+		return m_scene;
+	}
+
+	std::unique_ptr<AssetDatabase> ProjectLoader::TakeAssetDatabase()
+	{
+		QMutexLocker locker(&m_mutex);
+		return std::move(m_assets);
+	}
+
+	void ProjectLoader::Run()
+	{
+		ORCA_PROFILE_ZONE("ProjectLoader::Run");
+		MemoryTagScope memoryTag(MemoryTag::Scene);
+		QElapsedTimer timer;
+		timer.start();
+
+		emit stageStarted(static_cast<int>(ProjectLoadStage::Parse));
+		auto document = std::make_shared<SceneDocument>();
+		QString error;
+		if (!LoadSceneFile(m_projectFile, *document, &error))
+		{
+			FinishFromWorker(false, QString("Couldn't read %1: %2").arg(m_projectFile, error));
+			return;
+		}
+		{
+			QMutexLocker locker(&m_mutex);
+			m_document = document;
+		}
+		emit documentParsed();
+		ORCA_LOG_INFO("Project", "Read {} entities in {} ms", static_cast<quint64>(document->EntityCount()), timer.elapsed());
+		if (Cancelled()) return FinishFromWorker(false, "Cancelled");
+
+		emit stageStarted(static_cast<int>(ProjectLoadStage::Assets));
+		auto assets = std::make_unique<AssetDatabase>(m_projectRoot);
+		if (!assets->Load(&error))
+		{
+			ORCA_LOG_WARNING("Project", "Couldn't read the asset database, checking every asset: {}", error);
+		}
+		AssetRefreshStats stats = assets->Refresh([this](int done, int total)
+		{
+			emit progressChanged(static_cast<int>(ProjectLoadStage::Assets), done, total);
+		}, &m_cancel);
+		if (stats.cancelled || Cancelled()) return FinishFromWorker(false, "Cancelled");
+		{
+			QMutexLocker locker(&m_mutex);
+			m_assets = std::move(assets);
+		}
+		emit assetsReady();
+
+		emit stageStarted(static_cast<int>(ProjectLoadStage::Instantiate));
+		std::shared_ptr<LoadedScene> scene = Instantiate(document, m_cancel, [this](int done, int total)
+		{
+			emit progressChanged(static_cast<int>(ProjectLoadStage::Instantiate), done, total);
+		});
+		if (!scene || Cancelled()) return FinishFromWorker(false, "Cancelled");
+		{
+			QMutexLocker locker(&m_mutex);
+			m_scene = scene;
+		}
+		emit sceneInstantiated();
+
+		// GL calls belong to the GUI thread; the upload continues there between frames.
+		QMetaObject::invokeMethod(this, [this]()
+		{
+			if (Cancelled()) return Finish(false, "Cancelled");
+			emit stageStarted(static_cast<int>(ProjectLoadStage::Upload));
+			m_uploadTimer.start();
+		}, Qt::QueuedConnection);
+	}
+
+	void ProjectLoader::UploadNextSlice()
+	{
+		std::shared_ptr<const LoadedScene> scene = Scene();
+		const size_t total = scene ? scene->document->EntityCount() : 0;
+
+		if (m_uploadStep && m_uploaded < total)
+		{
+			ORCA_PROFILE_ZONE("ProjectLoader::Upload");
+			size_t uploaded = m_uploadStep(*scene, m_uploaded);
+			m_uploaded = uploaded ? m_uploaded + uploaded : total;
+			emit progressChanged(static_cast<int>(ProjectLoadStage::Upload), static_cast<int>(m_uploaded), static_cast<int>(total));
+			if (m_uploaded < total) return;
+		}
+
+		m_uploadTimer.stop();
+		Finish(true, QString());
+	}
+
+	void ProjectLoader::FinishFromWorker(bool ok, const QString& error)
+	{
+		QMetaObject::invokeMethod(this, [this, ok, error]() { Finish(ok, error); }, Qt::QueuedConnection);
+	}
+
+	void ProjectLoader::Finish(bool ok, const QString& error)
+	{
+		if (!m_running) return;
+		m_running = false;
+
+		if (!ok && error != "Cancelled")
+		{
+			ORCA_LOG_ERROR("Project", "Failed to open the project: {}", error);
+		}
+		emit finished(ok, error);
+	}
+
+	std::shared_ptr<LoadedScene> ProjectLoader::Instantiate(std::shared_ptr<const SceneDocument> document,
+		const std::atomic<bool>& cancel, const std::function<void(int, int)>& progress)
+	{
+		ORCA_PROFILE_ZONE("ProjectLoader::Instantiate");
+		MemoryTagScope memoryTag(MemoryTag::Scene);
+
+		auto scene = std::make_shared<LoadedScene>();
+		const std::vector<EntityRecord>& entities = document->Entities();
+		const std::vector<TransformData>& transforms = document->Transforms();
+		const uint32_t count = static_cast<uint32_t>(entities.size());
+
+		// Children grouped by parent with a counting sort; slot `count` collects the roots.
+		std::vector<uint32_t> childStart(static_cast<size_t>(count) + 2, 0);
+		for (const EntityRecord& entity : entities)
+		{
+			uint32_t parent = entity.parent < count ? entity.parent : count;
+			++childStart[parent + 1];
+		}
+		for (size_t i = 1; i < childStart.size(); ++i) childStart[i] += childStart[i - 1];
+
+		std::vector<uint32_t> children(count);
+		std::vector<uint32_t> cursor(childStart.begin(), childStart.end() - 1);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			uint32_t parent = entities[i].parent < count ? entities[i].parent : count;
+			children[cursor[parent]++] = i;
+		}
+
+		// Breadth-first from the roots; anything unreached sits in a parent cycle and becomes a root.
+		std::vector<uint8_t> placed(count, 0);
+		scene->hierarchyOrder.reserve(count);
+		auto visitFrom = [&](uint32_t root)
+		{
+			size_t head = scene->hierarchyOrder.size();
+			placed[root] = 1;
+			scene->hierarchyOrder.push_back(root);
+			for (; head < scene->hierarchyOrder.size(); ++head)
+			{
+				uint32_t entity = scene->hierarchyOrder[head];
+				for (uint32_t c = childStart[entity]; c < childStart[entity + 1]; ++c)
+				{
+					uint32_t child = children[c];
+					if (placed[child]) continue;
+					placed[child] = 1;
+					scene->hierarchyOrder.push_back(child);
+				}
+			}
+		};
+		for (uint32_t c = childStart[count]; c < childStart[count + 1]; ++c) visitFrom(children[c]);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (!placed[i]) visitFrom(i);
+		}
+
+		std::fill(placed.begin(), placed.end(), 0);
+		scene->worldMatrices.resize(static_cast<size_t>(count) * 16);
+		float minimum[3] = { INFINITY, INFINITY, INFINITY };
+		float maximum[3] = { -INFINITY, -INFINITY, -INFINITY };
+
+		for (uint32_t n = 0; n < count; ++n)
+		{
+			if (n % kProgressInterval == 0)
+			{
+				if (cancel.load(std::memory_order_relaxed)) return nullptr;
+				if (progress) progress(static_cast<int>(n), static_cast<int>(count));
+			}
+
+			const uint32_t entity = scene->hierarchyOrder[n];
+			const uint32_t parent = entities[entity].parent;
+			const float* parentWorld = parent < count && placed[parent] ? scene->worldMatrices.data() + static_cast<size_t>(parent) * 16 : nullptr;
+			placed[entity] = 1;
+
+			float* world = scene->worldMatrices.data() + static_cast<size_t>(entity) * 16;
+			ComposeWorldMatrix(transforms[entity], parentWorld, world);
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				minimum[axis] = std::min(minimum[axis], world[12 + axis]);
+				maximum[axis] = std::max(maximum[axis], world[12 + axis]);
+			}
+		}
+		if (progress) progress(static_cast<int>(count), static_cast<int>(count));
+
+		if (count > 0)
+		{
+			float extent = 0.0f;
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				scene->boundsCenter[axis] = 0.5f * (minimum[axis] + maximum[axis]);
+				float half = 0.5f * (maximum[axis] - minimum[axis]);
+				extent += half * half;
+			}
+			// Entities are drawn as unit-radius cubes, so pad by one.
+			scene->boundsRadius = std::sqrt(extent) + 1.0f;
+		}
+
+		CollectLights(*document, *scene);
+		CollectCamera(*document, *scene);
+		CollectRenderFlags(*document, *scene);
+		scene->document = std::move(document);
+		return scene;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#pragma once
+
+#ifndef PROJECT_LOADER_H
+#define PROJECT_LOADER_H
+
+#include "../Document/SceneDocument.h"
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QTimer>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class QThread;
+
+namespace Orca
+{
+	class AssetDatabase;
+
+	enum class ProjectLoadStage
+	{
+		Parse,
+		Assets,
+		Instantiate,
+		Upload
+	};
+
+	enum class SceneLightType : uint8_t
+	{
+		Directional,
+		Point,
+		Spot
+	};
+
+	/**
+	 * @brief A LightComponent. Position and direction come from the entity's world matrix, so
+	 *        the light follows its entity; it shines along the entity's +Z axis.
+	 */
+	struct SceneLight
+	{
+		uint32_t entity = 0;
+		SceneLightType type = SceneLightType::Point;
+		float color[3] = { 1.0f, 1.0f, 1.0f };    // premultiplied by Properties.Intensity
+		float range = 10.0f;
+		float outerAngle = 30.0f;                  // full cone angles in degrees, spot lights only
+		float innerAngle = 24.0f;
+	};
+
+	/**
+	 * @brief The scene's first CameraComponent, which the game view looks through. It looks
+	 *        along its entity's +Z axis, like a light; entity is kNone if the scene has no camera.
+	 */
+	struct SceneCamera
+	{
+		static constexpr uint32_t kNone = ~0u;
+
+		uint32_t entity = kNone;
+		float fieldOfView = 60.0f;    // vertical, in degrees
+		float nearPlane = 0.1f;
+		float farPlane = 1000.0f;
+	};
+
+	/**
+	 * @brief What the editor needs to show a scene, derived from the document off the GUI thread.
+	 */
+	struct LoadedScene
+	{
+		static constexpr uint8_t kCastsShadows = 1;   // renderFlags: a MeshRenderer with CastShadows on
+		static constexpr uint8_t kDynamic = 2;        // renderFlags: moved by play mode (a rigidbody or below one)
+		static constexpr uint8_t kOccluder = 4;       // renderFlags: a MeshRenderer with Occluder on, hides what's behind it
+
+		std::shared_ptr<const SceneDocument> document;
+		std::vector<uint32_t> hierarchyOrder;   // every entity once, parents before children
+		std::vector<float> worldMatrices;       // 16 floats per entity, column-major
+		std::vector<uint8_t> renderFlags;       // per entity
+		std::vector<SceneLight> lights;
+		SceneCamera camera;
+		float ambientLight[3] = { 0.1f, 0.1f, 0.1f };
+		float boundsCenter[3] = { 0.0f, 0.0f, 0.0f };
+		float boundsRadius = 0.0f;
+	};
+
+	/**
+	 * @brief Writes the column-major world matrix of @p transform; @p parentWorld is the parent's
+	 *        world matrix, or null for a root.
+	 */
+	void ComposeWorldMatrix(const TransformData& transform, const float* parentWorld, float* world);
+
+	/** @brief The property called @p name among @p count records starting at @p first, or null. */
+	const PropertyRecord* FindProperty(const SceneDocument& document, const PropertyRecord* first, size_t count, std::string_view name);
+
+	/**
+	 * @brief Opens a project in stages without blocking the GUI.
+	 *
+	 * Parsing, the asset database check and scene instantiation run on a worker thread; the
+	 * GPU upload runs on the GUI thread in slices between frames. Each stage's result is
+	 * published as soon as it exists, so panels can fill in while later stages are running.
+	 * All signals are delivered on the thread that owns the loader.
+	 */
+	class ProjectLoader : public QObject
+	{
+		Q_OBJECT
+	public:
+		/**
+		 * @brief Uploads part of the scene starting at instance `first`; returns how many it did.
+		 *        Called on the GUI thread until everything is uploaded.
+		 */
+		using UploadStep = std::function<size_t(const LoadedScene& scene, size_t first)>;
+
+		explicit ProjectLoader(QObject* parent = nullptr);
+		~ProjectLoader() override;
+
+		void SetUploadStep(UploadStep step) { m_uploadStep = std::move(step); }
+
+		/** @brief Starts loading the project file (.orca) and returns immediately. */
+		void Start(const QString& projectFile);
+
+		/** @brief Stops at the next checkpoint; finished(false, "Cancelled") follows. */
+		void Cancel();
+		bool IsRunning() const { return m_running; }
+
+		QString ProjectFile() const { return m_projectFile; }
+		QString ProjectRoot() const { return m_projectRoot; }
+
+		/** @brief Available once documentParsed() has been emitted. */
+		std::shared_ptr<const SceneDocument> Document() const;
+
+		/** @brief Available once sceneInstantiated() has been emitted. */
+		std::shared_ptr<const LoadedScene> Scene() const;
+
+		/** @brief Hands over the checked asset database once assetsReady() has been emitted. */
+		std::unique_ptr<AssetDatabase> TakeAssetDatabase();
+
+		static QString StageName(ProjectLoadStage stage);
+
+		/**
+		 * @brief Orders the hierarchy and computes world matrices, bounds, lights and render flags; the Instantiate stage.
+		 *        Pure function of the document, so it runs on any thread. Returns null if cancelled.
+		 */
+		static std::shared_ptr<LoadedScene> Instantiate(std::shared_ptr<const SceneDocument> document,
+			const std::atomic<bool>& cancel, const std::function<void(int, int)>& progress);
+
+	signals:
+		void stageStarted(int stage);
+		void progressChanged(int stage, int done, int total);
+		void documentParsed();
+		void assetsReady();
+		void sceneInstantiated();
+		void finished(bool ok, const QString& error);
+
+	private:
+		void Run();
+		bool Cancelled() const { return m_cancel.load(std::memory_order_relaxed); }
+		void FinishFromWorker(bool ok, const QString& error);
+		void Finish(bool ok, const QString& error);
+		void UploadNextSlice();
+
+		QString m_projectFile;
+		QString m_projectRoot;
+
+		QThread* m_thread = nullptr;
+		std::atomic<bool> m_cancel{ false };
+		bool m_running = false;
+
+		mutable QMutex m_mutex;
+		std::shared_ptr<const SceneDocument> m_document;
+		std::shared_ptr<const LoadedScene> m_scene;
+		std::unique_ptr<AssetDatabase> m_assets;
+
+		UploadStep m_uploadStep;
+		QTimer m_uploadTimer;
+		size_t m_uploaded = 0;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include "SceneAutosave.h"
+#include "EditorLog.h"
+#include "EditorStats.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include "../Document/OrcaSceneWriter.h"
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <algorithm>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr int kDefaultIntervalMs = 30000;
+
+		template <typename T>
+		bool SameChunk(const std::weak_ptr<const T>& cached, const std::shared_ptr<const T>& current)
+		{
+			// Owner comparison: an expired entry never matches a new chunk at a reused address,
+			// and two null pointers (both still the loaded document's data) do match.
+			return !cached.owner_before(current) && !current.owner_before(cached);
+		}
+	}
+
+	SceneAutosave::SceneAutosave(const EditableScene* scene, const QString& autosavePath, QObject* parent)
+		: QObject(parent), m_scene(scene), m_autosavePath(autosavePath), m_savedRevision(scene->Revision())
+	{
+		m_worker.setMaxThreadCount(1);
+
+		m_timer.setInterval(kDefaultIntervalMs);
+		QObject::connect(&m_timer, &QTimer::timeout, this, [this]() { Tick(); });
+		m_timer.start();
+
+		EditorStats::Get().RegisterMemoryReporter("Autosave", [this]() -> uint64_t { return MemoryBytes(); });
+		EditorStats::Get().RegisterReclaimer("autosave", [this](EditorStats::ReclaimDone done) { done(DropCache()); });
+	}
+
+	SceneAutosave::~SceneAutosave()
+	{
+		EditorStats::Get().UnregisterMemoryReporter("Autosave");
+		EditorStats::Get().UnregisterReclaimer("autosave");
+		m_worker.waitForDone();
+	}
+
+	QString SceneAutosave::AutosavePathFor(const QString& projectFile)
+	{
+		QFileInfo info(projectFile);
+		return info.absolutePath() + "/Library/Autosave/" + info.completeBaseName() + ".orca";
+	}
+
+	void SceneAutosave::SetInterval(int milliseconds)
+	{
+		m_timer.setInterval(milliseconds);
+	}
+
+	void SceneAutosave::SaveNow(const QString& path)
+	{
+		if (m_saving)
+		{
+			m_pendingPath = path;
+			return;
+		}
+		Start(path);
+	}
+
+	void SceneAutosave::Tick()
+	{
+		if (m_saving || m_scene->Revision() == m_savedRevision) return;
+		Start(m_autosavePath);
+	}
+
+	void SceneAutosave::Start(const QString& path)
+	{
+		SceneSnapshot snapshot;
+		{
+			ORCA_PROFILE_ZONE("AutosaveSnapshot");
+			MemoryTagScope memoryTag(MemoryTag::Scene);
+			snapshot = m_scene->Snapshot();
+		}
+
+		m_saving = true;
+		m_worker.start([this, snapshot = std::move(snapshot), path]()
+		{
+			QElapsedTimer timer;
+			timer.start();
+			WriteResult result = Write(snapshot, path);
+			const qint64 elapsed = timer.elapsed();
+			const uint64_t revision = snapshot.revision;
+
+			// The destructor waits for the worker, so the object is still alive when this is queued.
+			QMetaObject::invokeMethod(this, [this, path, revision, result, elapsed]()
+			{
+				Finish(path, revision, result, elapsed);
+			}, Qt::QueuedConnection);
+		});
+	}
+
+	void SceneAutosave::Finish(const QString& path, uint64_t revision, const WriteResult& result, qint64 milliseconds)
+	{
+		m_saving = false;
+
+		if (result.ok)
+		{
+			m_savedRevision = std::max(m_savedRevision, revision);
+			ORCA_LOG_INFO("Project", "Saved {} in {} ms ({} of {} chunks formatted)", path, milliseconds,
+				static_cast<quint64>(result.rewrittenChunks), static_cast<quint64>(result.totalChunks));
+		}
+		else
+		{
+			ORCA_LOG_ERROR("Project", "Could not save {}: {}", path, result.error);
+		}
+		emit saved(path, result.ok, result.error, milliseconds);
+
+		if (!m_pendingPath.isEmpty())
+		{
+			const QString pending = m_pendingPath;
+			m_pendingPath.clear();
+			Start(pending);
+		}
+	}
+
+	SceneAutosave::WriteResult SceneAutosave::Write(const SceneSnapshot& snapshot, const QString& path)
+	{
+		ORCA_PROFILE_ZONE("AutosaveWrite");
+		MemoryTagScope memoryTag(MemoryTag::Scene);
+		QMutexLocker lock(&m_cacheMutex);
+		WriteResult result;
+
+		const size_t chunkCount = snapshot.ChunkCount();
+		result.totalChunks = chunkCount;
+		if (!SameChunk(m_cacheBase, snapshot.base) || m_chunks.size() != chunkCount)
+		{
+			m_cacheBase = snapshot.base;
+			m_chunks.assign(chunkCount, ChunkText());
+			m_hierarchyKeys.clear();
+			m_hierarchyValid = false;
+			m_hierarchyText.clear();
+		}
+
+		OrcaScenePieces pieces;
+		pieces.entityCount = snapshot.EntityCount();
+		pieces.entities.reserve(chunkCount);
+
+		std::vector<std::string_view> names;
+		for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			ChunkText& cached = m_chunks[chunk];
+			// Chunk pointers can't be compared: once no snapshot holds a chunk, the scene edits
+			// it in place, and the pointer stays the same.
+			if (!cached.valid || cached.recordVersion != snapshot.recordVersions[chunk] || cached.transformVersion != snapshot.transformVersions[chunk])
+			{
+				const EntityRecord* records = snapshot.Records(chunk);
+				const uint32_t size = snapshot.ChunkSize(chunk);
+				names.resize(size);
+				for (uint32_t i = 0; i < size; ++i)
+				{
+					names[i] = snapshot.String(records[i].nameId);
+				}
+
+				cached.text.clear();
+				AppendOrcaEntityText(*snapshot.base, records, snapshot.Transforms(chunk), names.data(), size, chunk == 0, cached.text);
+				cached.recordVersion = snapshot.recordVersions[chunk];
+				cached.transformVersion = snapshot.transformVersions[chunk];
+				cached.valid = true;
+				++result.rewrittenChunks;
+			}
+			pieces.entities.push_back(cached.text);
+		}
+
+		// Parents and GUIDs live in the records, so the hierarchy only changes with a record chunk.
+		bool hierarchyValid = m_hierarchyValid && m_hierarchyKeys.size() == chunkCount;
+		for (size_t chunk = 0; hierarchyValid && chunk < chunkCount; ++chunk)
+		{
+			hierarchyValid = m_hierarchyKeys[chunk] == snapshot.recordVersions[chunk];
+		}
+		if (!hierarchyValid)
+		{
+			std::vector<EntityRecord> records;
+			records.reserve(snapshot.EntityCount());
+			m_hierarchyKeys.resize(chunkCount);
+			for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+			{
+				const EntityRecord* first = snapshot.Records(chunk);
+				records.insert(records.end(), first, first + snapshot.ChunkSize(chunk));
+				m_hierarchyKeys[chunk] = snapshot.recordVersions[chunk];
+			}
+			m_hierarchyText.clear();
+			AppendOrcaHierarchyText(records, m_hierarchyText);
+			m_hierarchyValid = true;
+		}
+		pieces.hierarchy = m_hierarchyText;
+
+		QDir().mkpath(QFileInfo(path).absolutePath());
+		QSaveFile file(path);
+		if (!file.open(QIODevice::WriteOnly))
+		{
+			result.error = file.errorString();
+			return result;
+		}
+
+		SceneWriteSink sink = [&file](const char* data, size_t size)
+		{
+			return file.write(data, static_cast<qint64>(size)) == static_cast<qint64>(size);
+		};
+
+		if (!WriteOrcaScene(*snapshot.base, pieces, sink) || !file.commit())
+		{
+			result.error = file.errorString();
+			file.cancelWriting();
+			return result;
+		}
+
+		result.ok = true;
+		return result;
+	}
+
+	uint64_t SceneAutosave::MemoryBytes() const
+	{
+		QMutexLocker lock(&m_cacheMutex);
+		uint64_t bytes = m_hierarchyText.capacity() + m_chunks.capacity() * sizeof(ChunkText);
+		for (const ChunkText& chunk : m_chunks)
+		{
+			bytes += chunk.text.capacity();
+		}
+		return bytes;
+	}
+
+	uint64_t SceneAutosave::DropCache()
+	{
+		const uint64_t bytes = MemoryBytes();
+
+		QMutexLocker lock(&m_cacheMutex);
+		m_cacheBase.reset();
+		std::vector<ChunkText>().swap(m_chunks);
+		m_hierarchyKeys.clear();
+		m_hierarchyValid = false;
+		std::string().swap(m_hierarchyText);
+		return bytes;
+	}
+}
\ No newline at end of file
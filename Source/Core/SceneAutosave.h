@@ -0,0 +1,98 @@
+#pragma once
+
+#ifndef SCENE_AUTOSAVE_H
+#define SCENE_AUTOSAVE_H
+
+#include "../Document/EditableScene.h"
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QThreadPool>
+#include <QtCore/QTimer>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Orca
+{
+	/**
+	 * @brief Saves an EditableScene in the background, periodically and on request.
+	 *
+	 * The GUI thread only takes a snapshot (a pointer per chunk); formatting and writing happen
+	 * on a worker. The text of each chunk is kept between saves and reused while the chunk is
+	 * unchanged, so a save after a small edit reformats a few thousand entities and then
+	 * streams the rest from memory. Files are replaced atomically through QSaveFile.
+	 */
+	class SceneAutosave : public QObject
+	{
+		Q_OBJECT
+	public:
+		/** @param scene Must outlive the autosave; only read on the thread that owns this object. */
+		SceneAutosave(const EditableScene* scene, const QString& autosavePath, QObject* parent = nullptr);
+		~SceneAutosave() override;
+
+		/** @brief Where periodic saves go: <project>/Library/Autosave/<scene>.orca for a project file. */
+		static QString AutosavePathFor(const QString& projectFile);
+
+		void SetInterval(int milliseconds);
+		int Interval() const { return m_timer.interval(); }
+
+		/** @brief Saves the current state to the path now, or right after a save already in progress. */
+		void SaveNow(const QString& path);
+
+		bool IsSaving() const { return m_saving; }
+
+		/** @brief Bytes held by the cached chunk text. */
+		uint64_t MemoryBytes() const;
+
+		/** @brief Drops the cached chunk text; the next save formats everything again. */
+		uint64_t DropCache();
+
+	signals:
+		void saved(const QString& path, bool ok, const QString& error, qint64 milliseconds);
+
+	private:
+		struct ChunkText
+		{
+			uint64_t recordVersion = 0;         // SceneSnapshot versions the text was formatted from
+			uint64_t transformVersion = 0;
+			bool valid = false;
+			std::string text;
+		};
+
+		struct WriteResult
+		{
+			bool ok = false;
+			QString error;
+			size_t rewrittenChunks = 0;
+			size_t totalChunks = 0;
+		};
+
+		void Tick();
+		void Start(const QString& path);
+		void Finish(const QString& path, uint64_t revision, const WriteResult& result, qint64 milliseconds);
+
+		/** @brief Runs on the worker. */
+		WriteResult Write(const SceneSnapshot& snapshot, const QString& path);
+
+		const EditableScene* m_scene = nullptr;
+		QString m_autosavePath;
+		QTimer m_timer;
+		bool m_saving = false;
+		QString m_pendingPath;
+		uint64_t m_savedRevision = 0;
+
+		// Touched by the worker during a save and by DropCache/MemoryBytes from any thread.
+		mutable QMutex m_cacheMutex;
+		std::weak_ptr<const SceneDocument> m_cacheBase;
+		std::vector<ChunkText> m_chunks;
+		std::vector<uint64_t> m_hierarchyKeys;         // record chunk versions
+		bool m_hierarchyValid = false;
+		std::string m_hierarchyText;
+
+		// Declared last so a running save finishes before anything above goes away.
+		QThreadPool m_worker;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "StartupTrace.h"
+#include "EditorLog.h"
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QEvent>
+#include <QtCore/QFile>
+#include <QtWidgets/QWidget>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#include <sys/time.h>
+#include <unistd.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr const char* kWelcomeVisible = "welcome visible";
+		constexpr const char* kWelcomeClosed = "welcome closed";
+
+		/** @brief How long ago the OS created this process; 0 when it can't tell. */
+		qint64 ProcessAgeNs()
+		{
+#if defined(_WIN32)
+			FILETIME creation, exit, kernel, user, now;
+			if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) return 0;
+			GetSystemTimePreciseAsFileTime(&now);
+			auto ticks = [](const FILETIME& time) { return static_cast<qint64>(time.dwHighDateTime) << 32 | time.dwLowDateTime; };
+			return (ticks(now) - ticks(creation)) * 100;
+#elif defined(__APPLE__)
+			int mib[4] = { CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid() };
+			kinfo_proc info;
+			size_t size = sizeof(info);
+			if (sysctl(mib, 4, &info, &size, nullptr, 0) != 0) return 0;
+			timeval now;
+			gettimeofday(&now, nullptr);
+			const timeval& start = info.kp_proc.p_starttime;
+			return (static_cast<qint64>(now.tv_sec - start.tv_sec) * 1000000 + (now.tv_usec - start.tv_usec)) * 1000;
+#else
+			// Field 22 of /proc/self/stat is the start time in clock ticks since boot. The command
+			// name before it may contain spaces, so fields are counted from its closing parenthesis.
+			QFile stat("/proc/self/stat");
+			if (!stat.open(QIODevice::ReadOnly)) return 0;
+			const QByteArray line = stat.readAll();
+			const QList<QByteArray> fields = line.mid(line.lastIndexOf(')') + 2).split(' ');
+			if (fields.size() < 20) return 0;
+
+			timespec now;
+			if (clock_gettime(CLOCK_BOOTTIME, &now) != 0) return 0;
+			const qint64 startNs = fields[19].toLongLong() * 1000000000 / sysconf(_SC_CLK_TCK);
+			return static_cast<qint64>(now.tv_sec) * 1000000000 + now.tv_nsec - startNs;
+#endif
+		}
+
+		struct StartupClock
+		{
+			QElapsedTimer timer;
+			qint64 offsetNs = 0;
+			std::vector<StartupTrace::Phase> phases;
+			bool finished = false;
+
+			StartupClock()
+			{
+				timer.start();
+				offsetNs = std::max<qint64>(0, ProcessAgeNs());
+			}
+
+			qint64 Now() const { return offsetNs + timer.nsecsElapsed(); }
+		};
+
+		StartupClock& Clock()
+		{
+			static StartupClock s_clock;
+			return s_clock;
+		}
+
+		// Started during static initialisation, so the process-age estimate is taken as early as possible.
+		[[maybe_unused]] const bool s_clockStarted = (Clock(), true);
+
+		const StartupTrace::Phase* FindPhase(const char* name)
+		{
+			for (const StartupTrace::Phase& phase : Clock().phases)
+			{
+				if (std::strcmp(phase.name, name) == 0) return &phase;
+			}
+			return nullptr;
+		}
+
+		class PaintWatcher : public QObject
+		{
+		public:
+			PaintWatcher(QWidget* widget, const char* phase) : QObject(widget), m_phase(phase) {}
+
+			bool eventFilter(QObject* watched, QEvent* event) override
+			{
+				if (event->type() == QEvent::Paint)
+				{
+					StartupTrace::Mark(m_phase);
+					watched->removeEventFilter(this);
+					deleteLater();
+				}
+				return false;
+			}
+
+		private:
+			const char* m_phase;
+		};
+	}
+
+	void StartupTrace::Mark(const char* phase)
+	{
+		StartupClock& clock = Clock();
+		if (clock.finished || FindPhase(phase)) return;
+		clock.phases.push_back({ phase, clock.Now() });
+	}
+
+	void StartupTrace::MarkWhenPainted(QWidget* widget, const char* phase)
+	{
+		if (Clock().finished || FindPhase(phase)) return;
+		widget->installEventFilter(new PaintWatcher(widget, phase));
+	}
+
+	void StartupTrace::Finish(const char* phase)
+	{
+		StartupClock& clock = Clock();
+		if (clock.finished) return;
+		Mark(phase);
+		clock.finished = true;
+
+		const qint64 startupMs = StartupNs() / 1000000;
+		if (startupMs > kBudgetMs)
+		{
+			ORCA_LOG_WARNING("Startup", "Editor start-up took {} ms, over the {} ms budget", startupMs, kBudgetMs);
+		}
+		else
+		{
+			ORCA_LOG_INFO("Startup", "Editor start-up took {} ms", startupMs);
+		}
+
+		const QByteArray dump = qgetenv("ORCA_STARTUP_TRACE");
+		if (dump.isEmpty()) return;
+		if (dump == "1")
+		{
+			for (const QString& line : Report()) std::fprintf(stderr, "%s\n", line.toLocal8Bit().constData());
+			return;
+		}
+
+		QString error;
+		if (!WriteChromeTrace(QString::fromLocal8Bit(dump), &error))
+		{
+			ORCA_LOG_WARNING("Startup", "Could not write the start-up trace: {}", error);
+		}
+	}
+
+	std::vector<StartupTrace::Phase> StartupTrace::Phases()
+	{
+		return Clock().phases;
+	}
+
+	bool StartupTrace::IsFinished()
+	{
+		return Clock().finished;
+	}
+
+	qint64 StartupTrace::StartupNs()
+	{
+		const std::vector<Phase>& phases = Clock().phases;
+		if (phases.empty()) return 0;
+
+		qint64 total = phases.back().ns;
+		const Phase* visible = FindPhase(kWelcomeVisible);
+		const Phase* closed = FindPhase(kWelcomeClosed);
+		if (visible && closed) total -= closed->ns - visible->ns;
+		return total;
+	}
+
+	QStringList StartupTrace::Report()
+	{
+		QStringList lines{ QString("%1 %2 ms").arg("process start", -22).arg(0.0, 8, 'f', 1) };
+		qint64 previous = 0;
+		for (const Phase& phase : Clock().phases)
+		{
+			const bool waiting = std::strcmp(phase.name, kWelcomeClosed) == 0;
+			lines.append(QString("%1 %2 ms  (+%3 ms%4)").arg(phase.name, -22).arg(phase.ns / 1e6, 8, 'f', 1)
+				.arg((phase.ns - previous) / 1e6, 0, 'f', 1).arg(waiting ? ", waiting for the user" : ""));
+			previous = phase.ns;
+		}
+		if (Clock().finished)
+		{
+			lines.append(QString("Start-up %1 ms without the welcome screen (budget %2 ms)").arg(StartupNs() / 1e6, 0, 'f', 1).arg(kBudgetMs));
+		}
+		return lines;
+	}
+
+	bool StartupTrace::WriteChromeTrace(const QString& path, QString* error)
+	{
+		QFile file(path);
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+			if (error) *error = file.errorString();
+			return false;
+		}
+
+		// Each phase is drawn as a span from the one before it.
+		QByteArray json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		qint64 previous = 0;
+		const std::vector<Phase>& phases = Clock().phases;
+		for (size_t i = 0; i < phases.size(); ++i)
+		{
+			json += "{\"name\":\"" + QByteArray(phases[i].name) + "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+				+ ",\"ts\":" + QByteArray::number(previous / 1000.0, 'f', 3)
+				+ ",\"dur\":" + QByteArray::number((phases[i].ns - previous) / 1000.0, 'f', 3) + "}";
+			json += i + 1 < phases.size() ? ",\n" : "\n";
+			previous = phases[i].ns;
+		}
+		json += "]}\n";
+
+		if (file.write(json) != json.size())
+		{
+			if (error) *error = file.errorString();
+			return false;
+		}
+		return true;
+	}
+}
\ No newline at end of file
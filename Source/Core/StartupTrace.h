@@ -0,0 +1,56 @@
+#pragma once
+
+#ifndef STARTUP_TRACE_H
+#define STARTUP_TRACE_H
+
+#include <QtCore/QString>
+#include <QtCore/QtGlobal>
+#include <vector>
+
+class QWidget;
+
+namespace Orca
+{
+	/**
+	 * @brief Timeline of the editor's cold start, measured from process creation:
+	 *        process start -> welcome visible -> editor visible -> first viewport frame.
+	 *
+	 * The console's "startup" command prints it. Setting ORCA_STARTUP_TRACE dumps it when the
+	 * first frame is drawn: to stderr for "1", otherwise as a Chrome trace to the given path.
+	 * GUI thread only.
+	 */
+	class StartupTrace
+	{
+	public:
+		/** @brief Editor start-up should be interactive within this, not counting time on the welcome screen. */
+		static constexpr qint64 kBudgetMs = 500;
+
+		struct Phase
+		{
+			const char* name;
+			qint64 ns;      // since process start
+		};
+
+		/** @brief Records a phase the first time it is reached. Name must be a string literal. */
+		static void Mark(const char* phase);
+
+		/** @brief Marks the phase when the widget first paints, which is when the user can see it. */
+		static void MarkWhenPainted(QWidget* widget, const char* phase);
+
+		/** @brief Marks the end of the start-up and logs the summary (and the dump, if asked for). */
+		static void Finish(const char* phase);
+
+		static std::vector<Phase> Phases();
+		static bool IsFinished();
+
+		/** @brief Time the user could not act, i.e. everything except waiting on the welcome screen. */
+		static qint64 StartupNs();
+
+		/** @brief One line per phase with its time since start and since the previous phase. */
+		static QStringList Report();
+
+		static bool WriteChromeTrace(const QString& path, QString* error = nullptr);
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace Orca
+{
+	/**
+	 * @brief Hands whole values from one writer thread to one reader thread without locks.
+	 *
+	 * The writer fills Back() and publishes it; the reader picks up the newest published value
+	 * with Acquire() and reads Front() until it acquires again. Neither side ever waits, and the
+	 * reader never sees a half-written value: the two sides only trade slot indices. Values the
+	 * reader was too slow to pick up are overwritten, so the writer must fill Back() completely
+	 * each time (it holds whatever was published two rounds ago).
+	 */
+	template <typename T>
+	class TripleBuffer
+	{
+	public:
+		/** @brief Writer: the slot to fill next; the reader can't see it until Publish(). */
+		T& Back() { return m_slots[m_back]; }
+
+		/** @brief Writer: makes Back() the newest value and takes the previous spare slot in exchange. */
+		void Publish()
+		{
+			m_back = m_middle.exchange(static_cast<uint8_t>(m_back | kFresh), std::memory_order_acq_rel) & kIndexMask;
+		}
+
+		/** @brief Reader: moves to the newest published value; false if nothing newer arrived. */
+		bool Acquire()
+		{
+			if (!(m_middle.load(std::memory_order_relaxed) & kFresh)) return false;
+			m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & kIndexMask;
+			return true;
+		}
+
+		/** @brief Reader: the value picked up by the last Acquire(); unchanged until the next one. */
+		const T& Front() const { return m_slots[m_front]; }
+
+	private:
+		static constexpr uint8_t kIndexMask = 3;
+		static constexpr uint8_t kFresh = 4;
+
+		T m_slots[3];
+		uint8_t m_back = 0;                    // writer only
+		std::atomic<uint8_t> m_middle{ 1 };    // shared: spare slot index, plus kFresh once published
+		uint8_t m_front = 2;                   // reader only
+	};
+}
+
+#endif
\ No newline at end of file
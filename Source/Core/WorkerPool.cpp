@@ -0,0 +1,102 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+namespace Orca
+{
+	WorkerPool& WorkerPool::Get()
+	{
+		static WorkerPool s_pool;
+		return s_pool;
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_wake.notify_all();
+		for (std::thread& thread : m_threads) thread.join();
+	}
+
+	size_t WorkerPool::WorkerCount()
+	{
+		std::call_once(m_started, [this]() { Start(); });
+		return m_threads.size();
+	}
+
+	void WorkerPool::Start()
+	{
+		// The caller works too, so one thread per core leaves one out.
+		const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+		m_threads.reserve(cores - 1);
+		for (unsigned i = 1; i < cores; ++i) m_threads.emplace_back([this]() { WorkerLoop(); });
+	}
+
+	void WorkerPool::Run(size_t count, Invoke invoke, void* context)
+	{
+		if (WorkerCount() == 0)
+		{
+			for (size_t i = 0; i < count; ++i) invoke(context, i);
+			return;
+		}
+
+		std::lock_guard<std::mutex> call(m_callMutex);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_invoke = invoke;
+			m_context = context;
+			m_count = count;
+			m_tag = MemoryTracker::CurrentTag();    // workers charge allocations to the caller's tag
+			m_next.store(0, std::memory_order_relaxed);
+			m_open = true;
+			++m_generation;
+		}
+		m_wake.notify_all();
+
+		Drain(invoke, context, count);
+
+		// Workers that haven't woken yet stay out; the ones inside must leave before the body,
+		// which lives on the caller's stack, goes away.
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_open = false;
+		m_done.wait(lock, [this]() { return m_active == 0; });
+	}
+
+	void WorkerPool::WorkerLoop()
+	{
+		uint64_t seen = 0;
+		for (;;)
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [&]() { return m_stopping || m_generation != seen; });
+			if (m_stopping) return;
+
+			seen = m_generation;
+			if (!m_open) continue;
+
+			++m_active;
+			const Invoke invoke = m_invoke;
+			void* const context = m_context;
+			const size_t count = m_count;
+			const MemoryTag tag = m_tag;
+			lock.unlock();
+
+			{
+				MemoryTagScope memoryTag(tag);
+				Drain(invoke, context, count);
+			}
+
+			lock.lock();
+			if (--m_active == 0) m_done.notify_all();
+		}
+	}
+
+	void WorkerPool::Drain(Invoke invoke, void* context, size_t count)
+	{
+		for (size_t i = m_next.fetch_add(1, std::memory_order_relaxed); i < count; i = m_next.fetch_add(1, std::memory_order_relaxed))
+		{
+			invoke(context, i);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "MemoryTracker.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Orca
+{
+	/**
+	 * @brief Long-lived worker threads for splitting per-frame work (light binning, occlusion
+	 *        culling) across cores without starting a thread per call.
+	 *
+	 * The threads start with the first ParallelFor and sleep between calls. A call neither
+	 * allocates nor copies the body, so it can run inside a frame that must not touch the heap.
+	 * Import-time work that runs on the asset pools keeps using the ParallelFor in Asset/.
+	 */
+	class WorkerPool
+	{
+	public:
+		static WorkerPool& Get();
+
+		~WorkerPool();
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		/**
+		 * @brief Calls body(i) for every i in [0, count), on the workers and the calling thread,
+		 *        and returns when all are done; on the calling thread alone when !parallel.
+		 *        Calls from several threads take turns. The body must not call ParallelFor itself.
+		 */
+		template <typename Body>
+		void ParallelFor(size_t count, Body&& body, bool parallel = true)
+		{
+			if (!parallel || count <= 1)
+			{
+				for (size_t i = 0; i < count; ++i) body(i);
+				return;
+			}
+
+			using BodyType = std::remove_reference_t<Body>;
+			Run(count, [](void* context, size_t index) { (*static_cast<BodyType*>(context))(index); },
+				const_cast<void*>(static_cast<const void*>(&body)));
+		}
+
+		/** @brief Threads besides the caller's that share a ParallelFor. */
+		size_t WorkerCount();
+
+	private:
+		WorkerPool() = default;
+
+		using Invoke = void (*)(void* context, size_t index);
+
+		void Start();
+		void Run(size_t count, Invoke invoke, void* context);
+		void WorkerLoop();
+		void Drain(Invoke invoke, void* context, size_t count);
+
+	private:
+		std::once_flag m_started;
+		std::vector<std::thread> m_threads;
+
+		std::mutex m_callMutex;             // one ParallelFor at a time
+		std::mutex m_mutex;                 // guards the job below
+		std::condition_variable m_wake;
+		std::condition_variable m_done;
+		uint64_t m_generation = 0;          // bumped for every job
+		bool m_open = false;                // workers may still join the current job
+		int m_active = 0;                   // workers inside the current job
+		bool m_stopping = false;
+
+		Invoke m_invoke = nullptr;
+		void* m_context = nullptr;
+		size_t m_count = 0;
+		MemoryTag m_tag = MemoryTag::General;
+		std::atomic<size_t> m_next{ 0 };
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "EditableScene.h"
+#include <algorithm>
+#include <atomic>
+
+namespace Orca
+{
+	namespace
+	{
+		// Shared by every scene, so a version identifies one chunk's contents process-wide.
+		std::atomic<uint64_t> s_chunkVersion{ 0 };
+	}
+
+	uint32_t SceneSnapshot::ChunkSize(size_t chunk) const
+	{
+		const size_t begin = chunk * kChunkSize;
+		return static_cast<uint32_t>(std::min<size_t>(kChunkSize, EntityCount() - begin));
+	}
+
+	const EntityRecord* SceneSnapshot::Records(size_t chunk) const
+	{
+		return records[chunk] ? records[chunk]->data() : base->Entities().data() + ChunkBegin(chunk);
+	}
+
+	const TransformData* SceneSnapshot::Transforms(size_t chunk) const
+	{
+		return transforms[chunk] ? transforms[chunk]->data() : base->Transforms().data() + ChunkBegin(chunk);
+	}
+
+	std::string_view SceneSnapshot::String(uint32_t id) const
+	{
+		const uint32_t baseCount = static_cast<uint32_t>(base->Strings().Size());
+		if (id < baseCount) return base->Strings().View(id);
+		return addedStrings && id - baseCount < addedStrings->size() ? std::string_view((*addedStrings)[id - baseCount]) : std::string_view();
+	}
+
+	EditableScene::EditableScene(std::shared_ptr<const SceneDocument> base)
+		: m_base(std::move(base))
+	{
+		const size_t chunks = (m_base->EntityCount() + SceneSnapshot::kChunkSize - 1) / SceneSnapshot::kChunkSize;
+		m_records.resize(chunks);
+		m_transforms.resize(chunks);
+		m_recordVersions.resize(chunks, 0);
+		m_transformVersions.resize(chunks, 0);
+	}
+
+	const EntityRecord& EditableScene::Entity(uint32_t entity) const
+	{
+		const auto& chunk = m_records[entity / SceneSnapshot::kChunkSize];
+		return chunk ? (*chunk)[entity % SceneSnapshot::kChunkSize] : m_base->Entities()[entity];
+	}
+
+	const TransformData& EditableScene::Transform(uint32_t entity) const
+	{
+		const auto& chunk = m_transforms[entity / SceneSnapshot::kChunkSize];
+		return chunk ? (*chunk)[entity % SceneSnapshot::kChunkSize] : m_base->Transforms()[entity];
+	}
+
+	std::string_view EditableScene::EntityName(uint32_t entity) const
+	{
+		return String(Entity(entity).nameId);
+	}
+
+	std::string_view EditableScene::String(uint32_t id) const
+	{
+		const uint32_t baseCount = static_cast<uint32_t>(m_base->Strings().Size());
+		if (id < baseCount) return m_base->Strings().View(id);
+		return m_addedStrings && id - baseCount < m_addedStrings->size() ? std::string_view((*m_addedStrings)[id - baseCount]) : std::string_view();
+	}
+
+	template <typename T>
+	T& EditableScene::Writable(std::vector<std::shared_ptr<SceneChunk<T>>>& chunks, std::vector<uint64_t>& versions, const std::vector<T>& baseTable, uint32_t entity)
+	{
+		const uint32_t index = entity / SceneSnapshot::kChunkSize;
+		versions[index] = s_chunkVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+		std::shared_ptr<SceneChunk<T>>& chunk = chunks[index];
+
+		if (!chunk)
+		{
+			const size_t begin = static_cast<size_t>(index) * SceneSnapshot::kChunkSize;
+			const size_t end = std::min(begin + SceneSnapshot::kChunkSize, baseTable.size());
+			chunk = std::make_shared<SceneChunk<T>>(baseTable.begin() + static_cast<std::ptrdiff_t>(begin), baseTable.begin() + static_cast<std::ptrdiff_t>(end));
+		}
+		else if (chunk.use_count() > 1)
+		{
+			// A snapshot is reading this version. Snapshots only ever drop references from other
+			// threads, so a stale count can only cause an unnecessary copy, never a shared write.
+			chunk = std::make_shared<SceneChunk<T>>(*chunk);
+		}
+
+		return (*chunk)[entity % SceneSnapshot::kChunkSize];
+	}
+
+	uint32_t EditableScene::AddString(std::string_view text)
+	{
+		if (!m_addedStrings)
+		{
+			m_addedStrings = std::make_shared<std::vector<std::string>>();
+		}
+		else if (m_addedStrings.use_count() > 1)
+		{
+			m_addedStrings = std::make_shared<std::vector<std::string>>(*m_addedStrings);
+		}
+
+		m_addedStrings->emplace_back(text);
+		return static_cast<uint32_t>(m_base->Strings().Size() + m_addedStrings->size() - 1);
+	}
+
+	void EditableScene::SetTransform(uint32_t entity, const TransformData& transform)
+	{
+		Writable(m_transforms, m_transformVersions, m_base->Transforms(), entity) = transform;
+		++m_revision;
+	}
+
+	void EditableScene::SetName(uint32_t entity, std::string_view name)
+	{
+		if (EntityName(entity) == name) return;
+
+		const uint32_t nameId = AddString(name);
+		Writable(m_records, m_recordVersions, m_base->Entities(), entity).nameId = nameId;
+		++m_revision;
+	}
+
+	SceneSnapshot EditableScene::Snapshot() const
+	{
+		SceneSnapshot snapshot;
+		snapshot.base = m_base;
+		snapshot.records.assign(m_records.begin(), m_records.end());
+		snapshot.transforms.assign(m_transforms.begin(), m_transforms.end());
+		snapshot.addedStrings = m_addedStrings;
+		snapshot.revision = m_revision;
+		snapshot.recordVersions = m_recordVersions;
+		snapshot.transformVersions = m_transformVersions;
+		return snapshot;
+	}
+
+	size_t EditableScene::MemoryBytes() const
+	{
+		size_t bytes = (m_records.capacity() + m_transforms.capacity()) * (sizeof(void*) * 2 + sizeof(uint64_t));
+		for (const auto& chunk : m_records)
+		{
+			if (chunk) bytes += chunk->capacity() * sizeof(EntityRecord);
+		}
+		for (const auto& chunk : m_transforms)
+		{
+			if (chunk) bytes += chunk->capacity() * sizeof(TransformData);
+		}
+		if (m_addedStrings)
+		{
+			for (const std::string& text : *m_addedStrings) bytes += sizeof(std::string) + text.capacity();
+		}
+		return bytes;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#ifndef EDITABLE_SCENE_H
+#define EDITABLE_SCENE_H
+
+#include "SceneDocument.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Orca
+{
+	/** @brief Entities [chunk * kChunkSize, +kChunkSize) of an edited table. */
+	template <typename T>
+	using SceneChunk = std::vector<T>;
+
+	/**
+	 * @brief Frozen view of an EditableScene. Taking one copies a pointer per chunk, so it is
+	 *        cheap enough to do on the GUI thread; the snapshot can then be read on any thread
+	 *        while editing continues.
+	 */
+	struct SceneSnapshot
+	{
+		static constexpr uint32_t kChunkSize = 4096;
+
+		std::shared_ptr<const SceneDocument> base;
+		std::vector<std::shared_ptr<const SceneChunk<EntityRecord>>> records;       // null: unchanged from base
+		std::vector<std::shared_ptr<const SceneChunk<TransformData>>> transforms;   // null: unchanged from base
+		std::shared_ptr<const std::vector<std::string>> addedStrings;               // ids from base->Strings().Size()
+		uint64_t revision = 0;
+
+		// Per chunk: 0 while unchanged from base, otherwise a value no other write, chunk or
+		// scene has had. Unlike the chunk pointers, these change when a chunk is edited in place.
+		std::vector<uint64_t> recordVersions;
+		std::vector<uint64_t> transformVersions;
+
+		size_t EntityCount() const { return base ? base->EntityCount() : 0; }
+		size_t ChunkCount() const { return records.size(); }
+		uint32_t ChunkBegin(size_t chunk) const { return static_cast<uint32_t>(chunk * kChunkSize); }
+		uint32_t ChunkSize(size_t chunk) const;
+
+		const EntityRecord* Records(size_t chunk) const;
+		const TransformData* Transforms(size_t chunk) const;
+		std::string_view String(uint32_t id) const;
+	};
+
+	/**
+	 * @brief The open scene as the editor changes it, layered over the loaded document.
+	 *
+	 * Entity records and transforms are split into chunks that stay shared with the loaded
+	 * document until first edited, and are copied again only when a snapshot still holds the
+	 * current version. Components and scene settings are read from the loaded document.
+	 * Not thread safe: edit and snapshot from one thread, read snapshots anywhere.
+	 */
+	class EditableScene
+	{
+	public:
+		explicit EditableScene(std::shared_ptr<const SceneDocument> base);
+
+		const SceneDocument& Base() const { return *m_base; }
+		size_t EntityCount() const { return m_base->EntityCount(); }
+
+		const EntityRecord& Entity(uint32_t entity) const;
+		const TransformData& Transform(uint32_t entity) const;
+		std::string_view EntityName(uint32_t entity) const;
+
+		void SetTransform(uint32_t entity, const TransformData& transform);
+		void SetName(uint32_t entity, std::string_view name);
+
+		/** @brief Increments on every edit; equal revisions mean equal contents. */
+		uint64_t Revision() const { return m_revision; }
+
+		SceneSnapshot Snapshot() const;
+
+		/** @brief Bytes held by edited chunks and added strings. */
+		size_t MemoryBytes() const;
+
+	private:
+		template <typename T>
+		T& Writable(std::vector<std::shared_ptr<SceneChunk<T>>>& chunks, std::vector<uint64_t>& versions, const std::vector<T>& baseTable, uint32_t entity);
+
+		std::string_view String(uint32_t id) const;
+		uint32_t AddString(std::string_view text);
+
+		std::shared_ptr<const SceneDocument> m_base;
+		std::vector<std::shared_ptr<SceneChunk<EntityRecord>>> m_records;
+		std::vector<std::shared_ptr<SceneChunk<TransformData>>> m_transforms;
+		std::vector<uint64_t> m_recordVersions;         // see SceneSnapshot::recordVersions
+		std::vector<uint64_t> m_transformVersions;
+		std::shared_ptr<std::vector<std::string>> m_addedStrings;
+		uint64_t m_revision = 0;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,267 @@
+#include "OrcaBinaryScene.h"
+#include <cstring>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr char kMagic[8] = { 'O', 'R', 'C', 'A', 'S', 'C', 'N', 'B' };
+		constexpr uint64_t kSectionAlignment = 16;
+
+		uint64_t AlignUp(uint64_t value)
+		{
+			return (value + kSectionAlignment - 1) & ~(kSectionAlignment - 1);
+		}
+
+		bool SetError(std::string* error, const char* message)
+		{
+			if (error) *error = message;
+			return false;
+		}
+
+		struct SectionSource
+		{
+			OrcaBinarySectionId id;
+			uint32_t elementSize;
+			const void* data;
+			uint64_t count;
+		};
+	}
+
+	bool IsOrcaBinaryScene(const char* data, size_t size)
+	{
+		return size >= sizeof(kMagic) && std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+	}
+
+	template <typename T>
+	bool OrcaBinarySceneView::Bind(const OrcaBinarySection& section, const T*& table, size_t& count, std::string* error)
+	{
+		if (section.elementSize != sizeof(T))
+		{
+			return SetError(error, "Section record size doesn't match this version of the editor");
+		}
+		if (section.offset > m_size || section.count > (m_size - section.offset) / sizeof(T))
+		{
+			return SetError(error, "Section extends past the end of the file (truncated?)");
+		}
+
+		const char* begin = m_data + section.offset;
+		if (reinterpret_cast<uintptr_t>(begin) % alignof(T) != 0)
+		{
+			return SetError(error, "Section is misaligned");
+		}
+
+		table = reinterpret_cast<const T*>(begin);
+		count = static_cast<size_t>(section.count);
+		return true;
+	}
+
+	bool OrcaBinarySceneView::Open(const char* data, size_t size, std::string* error)
+	{
+		*this = OrcaBinarySceneView();
+		m_data = data;
+		m_size = size;
+
+		OrcaBinarySceneHeader header;
+		if (size < sizeof(header) || !IsOrcaBinaryScene(data, size))
+		{
+			return SetError(error, "Not an .orcab scene");
+		}
+		std::memcpy(&header, data, sizeof(header));
+
+		if (header.version != kOrcaBinarySceneVersion)
+		{
+			return SetError(error, "Unsupported .orcab version");
+		}
+		if (header.headerSize < sizeof(header) || header.headerSize > size || header.fileSize != size)
+		{
+			return SetError(error, "Corrupt header or truncated file");
+		}
+		if (header.sectionCount > (size - header.headerSize) / sizeof(OrcaBinarySection))
+		{
+			return SetError(error, "Section table extends past the end of the file");
+		}
+
+		for (uint32_t i = 0; i < header.sectionCount; ++i)
+		{
+			OrcaBinarySection section;
+			std::memcpy(&section, data + header.headerSize + i * sizeof(section), sizeof(section));
+
+			bool bound = true;
+			switch (section.id)
+			{
+			case OrcaBinarySectionId::Entities: bound = Bind(section, m_entities, m_entityCount, error); break;
+			case OrcaBinarySectionId::Transforms: bound = Bind(section, m_transforms, m_transformCount, error); break;
+			case OrcaBinarySectionId::Components: bound = Bind(section, m_components, m_componentCount, error); break;
+			case OrcaBinarySectionId::Properties: bound = Bind(section, m_properties, m_propertyCount, error); break;
+			case OrcaBinarySectionId::SceneProperties: bound = Bind(section, m_sceneProperties, m_scenePropertyCount, error); break;
+			case OrcaBinarySectionId::PropertyData: bound = Bind(section, m_propertyData, m_propertyDataCount, error); break;
+			case OrcaBinarySectionId::StringBytes: bound = Bind(section, m_stringBytes, m_stringByteCount, error); break;
+			case OrcaBinarySectionId::StringOffsets: bound = Bind(section, m_stringOffsets, m_stringOffsetCount, error); break;
+			default: break;
+			}
+			if (!bound) return false;
+		}
+
+		// Indices are checked once here so the tables can be trusted (and bulk-copied) afterwards.
+		if (m_stringOffsetCount < 2 || m_stringOffsets[0] != 0 || m_stringOffsets[1] != 0 || m_stringOffsets[m_stringOffsetCount - 1] != m_stringByteCount)
+		{
+			return SetError(error, "Corrupt string table");
+		}
+		for (size_t i = 1; i < m_stringOffsetCount; ++i)
+		{
+			if (m_stringOffsets[i] < m_stringOffsets[i - 1]) return SetError(error, "Corrupt string table");
+		}
+		const uint64_t stringCount = m_stringOffsetCount - 1;
+
+		if (m_transformCount != m_entityCount)
+		{
+			return SetError(error, "Entity and transform counts differ");
+		}
+		for (size_t i = 0; i < m_entityCount; ++i)
+		{
+			const EntityRecord& entity = m_entities[i];
+			if (entity.nameId >= stringCount || entity.tagId >= stringCount
+				|| (entity.parent != SceneDocument::kNoParent && entity.parent >= m_entityCount)
+				|| static_cast<uint64_t>(entity.firstComponent) + entity.componentCount > m_componentCount)
+			{
+				return SetError(error, "Corrupt entity table");
+			}
+		}
+
+		for (size_t i = 0; i < m_componentCount; ++i)
+		{
+			const ComponentRecord& component = m_components[i];
+			if (component.typeId >= stringCount || static_cast<uint64_t>(component.firstProperty) + component.propertyCount > m_propertyCount)
+			{
+				return SetError(error, "Corrupt component table");
+			}
+		}
+
+		auto validProperties = [&](const PropertyRecord* properties, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const PropertyRecord& property = properties[i];
+				if (property.nameId >= stringCount) return false;
+
+				switch (property.type)
+				{
+				case PropertyType::Null:
+				case PropertyType::Bool:
+				case PropertyType::Number:
+					break;
+				case PropertyType::String:
+					if (property.value >= stringCount) return false;
+					break;
+				case PropertyType::NumberArray:
+				case PropertyType::StringArray:
+					if (static_cast<uint64_t>(property.value) + property.count > m_propertyDataCount) return false;
+					if (property.type == PropertyType::StringArray)
+					{
+						for (uint32_t e = 0; e < property.count; ++e)
+						{
+							if (m_propertyData[property.value + e] >= stringCount) return false;
+						}
+					}
+					break;
+				default:
+					return false;
+				}
+			}
+			return true;
+		};
+
+		if (!validProperties(m_properties, m_propertyCount) || !validProperties(m_sceneProperties, m_scenePropertyCount))
+		{
+			return SetError(error, "Corrupt property table");
+		}
+		return true;
+	}
+
+	std::string_view OrcaBinarySceneView::String(uint32_t id) const
+	{
+		if (id + static_cast<size_t>(1) >= m_stringOffsetCount) return {};
+		return std::string_view(m_stringBytes + m_stringOffsets[id], m_stringOffsets[id + 1] - m_stringOffsets[id]);
+	}
+
+	void OrcaBinarySceneView::CopyTo(SceneDocument& document) const
+	{
+		document.Clear();
+		document.Strings().Assign(m_stringBytes, m_stringByteCount, m_stringOffsets, m_stringOffsetCount);
+		document.Entities().assign(m_entities, m_entities + m_entityCount);
+		document.Transforms().assign(m_transforms, m_transforms + m_transformCount);
+		document.Components().assign(m_components, m_components + m_componentCount);
+		document.Properties().assign(m_properties, m_properties + m_propertyCount);
+		document.SceneProperties().assign(m_sceneProperties, m_sceneProperties + m_scenePropertyCount);
+		document.PropertyData().assign(m_propertyData, m_propertyData + m_propertyDataCount);
+	}
+
+	bool WriteOrcaBinaryScene(const SceneDocument& document, const SceneWriteSink& sink)
+	{
+		const SectionSource sources[] =
+		{
+			{ OrcaBinarySectionId::Entities, sizeof(EntityRecord), document.Entities().data(), document.Entities().size() },
+			{ OrcaBinarySectionId::Transforms, sizeof(TransformData), document.Transforms().data(), document.Transforms().size() },
+			{ OrcaBinarySectionId::Components, sizeof(ComponentRecord), document.Components().data(), document.Components().size() },
+			{ OrcaBinarySectionId::Properties, sizeof(PropertyRecord), document.Properties().data(), document.Properties().size() },
+			{ OrcaBinarySectionId::SceneProperties, sizeof(PropertyRecord), document.SceneProperties().data(), document.SceneProperties().size() },
+			{ OrcaBinarySectionId::PropertyData, sizeof(uint32_t), document.PropertyData().data(), document.PropertyData().size() },
+			{ OrcaBinarySectionId::StringBytes, 1, document.Strings().Bytes().data(), document.Strings().Bytes().size() },
+			{ OrcaBinarySectionId::StringOffsets, sizeof(uint32_t), document.Strings().Offsets().data(), document.Strings().Offsets().size() },
+		};
+		constexpr uint32_t kSectionCount = sizeof(sources) / sizeof(sources[0]);
+
+		OrcaBinarySection sections[kSectionCount];
+		uint64_t offset = AlignUp(sizeof(OrcaBinarySceneHeader) + sizeof(sections));
+		for (uint32_t i = 0; i < kSectionCount; ++i)
+		{
+			sections[i].id = sources[i].id;
+			sections[i].elementSize = sources[i].elementSize;
+			sections[i].offset = offset;
+			sections[i].count = sources[i].count;
+			offset = AlignUp(offset + sources[i].count * sources[i].elementSize);
+		}
+
+		OrcaBinarySceneHeader header;
+		std::memcpy(header.magic, kMagic, sizeof(kMagic));
+		header.version = kOrcaBinarySceneVersion;
+		header.headerSize = sizeof(OrcaBinarySceneHeader);
+		header.sectionCount = kSectionCount;
+		header.fileSize = offset;
+
+		static const char kPadding[kSectionAlignment] = {};
+		uint64_t written = 0;
+		auto write = [&](const void* data, uint64_t size)
+		{
+			written += size;
+			return size == 0 || sink(static_cast<const char*>(data), static_cast<size_t>(size));
+		};
+
+		if (!write(&header, sizeof(header)) || !write(sections, sizeof(sections)))
+		{
+			return false;
+		}
+
+		// Each table goes to the sink straight from the document's storage.
+		for (uint32_t i = 0; i < kSectionCount; ++i)
+		{
+			if (!write(kPadding, sections[i].offset - written)) return false;
+			if (!write(sources[i].data, sources[i].count * sources[i].elementSize)) return false;
+		}
+		return write(kPadding, header.fileSize - written);
+	}
+
+	bool ReadOrcaBinaryScene(const char* data, size_t size, SceneDocument& document, std::string* error)
+	{
+		OrcaBinarySceneView view;
+		if (!view.Open(data, size, error))
+		{
+			document.Clear();
+			return false;
+		}
+
+		view.CopyTo(document);
+		return true;
+	}
+}
\ No newline at end of file
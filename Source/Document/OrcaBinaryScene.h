@@ -0,0 +1,129 @@
+#pragma once
+
+#ifndef ORCA_BINARY_SCENE_H
+#define ORCA_BINARY_SCENE_H
+
+#include "SceneDocument.h"
+#include <string>
+
+namespace Orca
+{
+	/**
+	 * .orcab layout (little-endian, version 1):
+	 *
+	 *   OrcaBinarySceneHeader
+	 *   OrcaBinarySection[sectionCount]
+	 *   section data, each starting on a 16-byte boundary
+	 *
+	 * Every section is a packed array of the record types from SceneDocument.h, so a mapped file
+	 * can be used in place or copied into the document tables with one memcpy per table.
+	 * Readers skip section ids they don't know; a layout change bumps the version.
+	 */
+	enum class OrcaBinarySectionId : uint32_t
+	{
+		Entities = 1,
+		Transforms,
+		Components,
+		Properties,
+		SceneProperties,
+		PropertyData,
+		StringBytes,
+		StringOffsets
+	};
+
+	struct OrcaBinarySceneHeader
+	{
+		char magic[8];          // "ORCASCNB"
+		uint16_t version;
+		uint16_t headerSize;    // sizeof(OrcaBinarySceneHeader)
+		uint32_t sectionCount;
+		uint64_t fileSize;
+	};
+
+	struct OrcaBinarySection
+	{
+		OrcaBinarySectionId id;
+		uint32_t elementSize;
+		uint64_t offset;
+		uint64_t count;
+	};
+
+	static_assert(sizeof(OrcaBinarySceneHeader) == 24, "OrcaBinarySceneHeader is part of the file format");
+	static_assert(sizeof(OrcaBinarySection) == 24, "OrcaBinarySection is part of the file format");
+	static_assert(sizeof(EntityRecord) == 40, "EntityRecord is part of the .orcab format");
+	static_assert(sizeof(TransformData) == 36, "TransformData is part of the .orcab format");
+	static_assert(sizeof(ComponentRecord) == 16, "ComponentRecord is part of the .orcab format");
+	static_assert(sizeof(PropertyRecord) == 16, "PropertyRecord is part of the .orcab format");
+
+	constexpr uint16_t kOrcaBinarySceneVersion = 1;
+
+	/**
+	 * @brief Validated, zero-copy view of an .orcab image. The data must stay alive (and mapped)
+	 *        while the view is used.
+	 */
+	class OrcaBinarySceneView
+	{
+	public:
+		/**
+		 * @brief Checks the header, section bounds and every index stored in the tables,
+		 *        so later access never needs range checks.
+		 */
+		bool Open(const char* data, size_t size, std::string* error = nullptr);
+
+		size_t EntityCount() const { return m_entityCount; }
+		const EntityRecord* Entities() const { return m_entities; }
+		const TransformData* Transforms() const { return m_transforms; }
+
+		size_t ComponentCount() const { return m_componentCount; }
+		const ComponentRecord* Components() const { return m_components; }
+
+		std::string_view String(uint32_t id) const;
+
+		/**
+		 * @brief Bulk-copies every table into the document, replacing its contents.
+		 */
+		void CopyTo(SceneDocument& document) const;
+
+	private:
+		template <typename T>
+		bool Bind(const OrcaBinarySection& section, const T*& table, size_t& count, std::string* error);
+
+		const char* m_data = nullptr;
+		size_t m_size = 0;
+
+		const EntityRecord* m_entities = nullptr;
+		const TransformData* m_transforms = nullptr;
+		const ComponentRecord* m_components = nullptr;
+		const PropertyRecord* m_properties = nullptr;
+		const PropertyRecord* m_sceneProperties = nullptr;
+		const uint32_t* m_propertyData = nullptr;
+		const char* m_stringBytes = nullptr;
+		const uint32_t* m_stringOffsets = nullptr;
+
+		size_t m_entityCount = 0;
+		size_t m_transformCount = 0;
+		size_t m_componentCount = 0;
+		size_t m_propertyCount = 0;
+		size_t m_scenePropertyCount = 0;
+		size_t m_propertyDataCount = 0;
+		size_t m_stringByteCount = 0;
+		size_t m_stringOffsetCount = 0;
+	};
+
+	/**
+	 * @brief Serializes the document as .orcab.
+	 */
+	bool WriteOrcaBinaryScene(const SceneDocument& document, const SceneWriteSink& sink);
+
+	/**
+	 * @brief Opens an .orcab image and copies it into the document.
+	 */
+	bool ReadOrcaBinaryScene(const char* data, size_t size, SceneDocument& document, std::string* error = nullptr);
+
+	/**
+	 * @brief True when the data starts with the .orcab magic, regardless of the file extension.
+	 */
+	bool IsOrcaBinaryScene(const char* data, size_t size);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include "OrcaJsonReader.h"
+#include <charconv>
+#include <cstring>
+
+namespace Orca
+{
+	namespace
+	{
+		void AppendUtf8(std::string& out, uint32_t codePoint)
+		{
+			if (codePoint < 0x80)
+			{
+				out.push_back(static_cast<char>(codePoint));
+			}
+			else if (codePoint < 0x800)
+			{
+				out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+				out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+			}
+			else if (codePoint < 0x10000)
+			{
+				out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+				out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+				out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+			}
+			else
+			{
+				out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+				out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+				out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+				out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+			}
+		}
+
+		bool ReadHex4(const char* text, uint32_t& out)
+		{
+			out = 0;
+			for (int i = 0; i < 4; ++i)
+			{
+				char c = text[i];
+				uint32_t digit;
+				if (c >= '0' && c <= '9') digit = static_cast<uint32_t>(c - '0');
+				else if (c >= 'a' && c <= 'f') digit = static_cast<uint32_t>(c - 'a' + 10);
+				else if (c >= 'A' && c <= 'F') digit = static_cast<uint32_t>(c - 'A' + 10);
+				else return false;
+				out = (out << 4) | digit;
+			}
+			return true;
+		}
+	}
+
+	OrcaJsonReader::OrcaJsonReader(const char* data, size_t size)
+		: m_begin(data), m_end(data + size), m_cursor(data)
+	{
+	}
+
+	bool OrcaJsonReader::Fail(const char* message)
+	{
+		if (!m_error.empty()) return false;
+
+		size_t line = 1;
+		const char* lineStart = m_begin;
+		for (const char* p = m_begin; p < m_cursor; ++p)
+		{
+			if (*p == '\n')
+			{
+				++line;
+				lineStart = p + 1;
+			}
+		}
+
+		m_errorOffset = static_cast<size_t>(m_cursor - m_begin);
+		m_error = std::to_string(line) + ":" + std::to_string(m_cursor - lineStart + 1) + ": " + message;
+		return false;
+	}
+
+	bool OrcaJsonReader::SkipWhitespace()
+	{
+		while (m_cursor < m_end)
+		{
+			const unsigned char c = static_cast<unsigned char>(*m_cursor);
+			const size_t remaining = static_cast<size_t>(m_end - m_cursor);
+
+			if (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+			{
+				++m_cursor;
+			}
+			else if (c == '/' && remaining >= 2 && m_cursor[1] == '/')
+			{
+				const void* newline = std::memchr(m_cursor, '\n', remaining);
+				m_cursor = newline ? static_cast<const char*>(newline) + 1 : m_end;
+			}
+			else if (c == '/' && remaining >= 2 && m_cursor[1] == '*')
+			{
+				const char* close = m_cursor + 2;
+				while (close + 1 < m_end && !(close[0] == '*' && close[1] == '/')) ++close;
+				if (close + 1 >= m_end) return Fail("Unterminated comment");
+				m_cursor = close + 2;
+			}
+			else if (c == 0xEF && remaining >= 3 && static_cast<unsigned char>(m_cursor[1]) == 0xBB && static_cast<unsigned char>(m_cursor[2]) == 0xBF)
+			{
+				m_cursor += 3; // BOM
+			}
+			else if (c == 0xEF && remaining >= 3 && static_cast<unsigned char>(m_cursor[1]) == 0xBF && static_cast<unsigned char>(m_cursor[2]) == 0xBD)
+			{
+				// U+FFFD: older project templates were saved with mangled non-breaking space indentation.
+				m_cursor += 3;
+			}
+			else if (c == 0xC2 && remaining >= 2 && static_cast<unsigned char>(m_cursor[1]) == 0xA0)
+			{
+				m_cursor += 2; // U+00A0 in UTF-8
+			}
+			else if (c == 0xA0)
+			{
+				++m_cursor; // U+00A0 in Latin-1
+			}
+			else
+			{
+				break;
+			}
+		}
+		return true;
+	}
+
+	bool OrcaJsonReader::ReadString(std::string_view& out)
+	{
+		const char* start = ++m_cursor;
+
+		// Fast path: no escapes, hand out a view of the input itself.
+		const char* p = start;
+		while (p < m_end && *p != '"' && *p != '\\') ++p;
+		if (p == m_end) return Fail("Unterminated string");
+
+		if (*p == '"')
+		{
+			out = std::string_view(start, static_cast<size_t>(p - start));
+			m_cursor = p + 1;
+			return true;
+		}
+
+		m_scratch.assign(start, p);
+		while (p < m_end)
+		{
+			char c = *p;
+			if (c == '"')
+			{
+				out = m_scratch;
+				m_cursor = p + 1;
+				return true;
+			}
+			if (c != '\\')
+			{
+				m_scratch.push_back(c);
+				++p;
+				continue;
+			}
+
+			if (p + 1 >= m_end) break;
+			char escape = p[1];
+			p += 2;
+
+			switch (escape)
+			{
+			case '"': m_scratch.push_back('"'); break;
+			case '\\': m_scratch.push_back('\\'); break;
+			case '/': m_scratch.push_back('/'); break;
+			case 'b': m_scratch.push_back('\b'); break;
+			case 'f': m_scratch.push_back('\f'); break;
+			case 'n': m_scratch.push_back('\n'); break;
+			case 'r': m_scratch.push_back('\r'); break;
+			case 't': m_scratch.push_back('\t'); break;
+			case 'u':
+			{
+				uint32_t codePoint = 0;
+				if (m_end - p < 4 || !ReadHex4(p, codePoint))
+				{
+					m_cursor = p;
+					return Fail("Invalid \\u escape");
+				}
+				p += 4;
+
+				// Surrogate pair: combine with the following \uDC00-\uDFFF.
+				uint32_t low = 0;
+				if (codePoint >= 0xD800 && codePoint <= 0xDBFF && m_end - p >= 6 && p[0] == '\\' && p[1] == 'u' && ReadHex4(p + 2, low) && low >= 0xDC00 && low <= 0xDFFF)
+				{
+					codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+					p += 6;
+				}
+				AppendUtf8(m_scratch, codePoint);
+				break;
+			}
+			default:
+				m_cursor = p - 2;
+				return Fail("Invalid escape sequence");
+			}
+		}
+
+		return Fail("Unterminated string");
+	}
+
+	bool OrcaJsonReader::ReadNumber(double& out)
+	{
+		const char* start = m_cursor;
+		const char* p = start;
+		while (p < m_end && ((*p >= '0' && *p <= '9') || *p == '-' || *p == '+' || *p == '.' || *p == 'e' || *p == 'E')) ++p;
+
+		// from_chars is locale independent and doesn't need a terminated copy of the token.
+		auto result = std::from_chars(start, p, out);
+		if (result.ec != std::errc() || result.ptr != p)
+		{
+			return Fail("Invalid number");
+		}
+
+		m_cursor = p;
+		return true;
+	}
+
+	bool OrcaJsonReader::ReadLiteral(const char* literal, size_t length)
+	{
+		if (static_cast<size_t>(m_end - m_cursor) < length || std::memcmp(m_cursor, literal, length) != 0)
+		{
+			return Fail("Unexpected character");
+		}
+		m_cursor += length;
+		return true;
+	}
+}
\ No newline at end of file
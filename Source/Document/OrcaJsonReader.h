@@ -0,0 +1,214 @@
+#pragma once
+
+#ifndef ORCA_JSON_READER_H
+#define ORCA_JSON_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Orca
+{
+	/**
+	 * @brief Streaming (SAX) reader for the JSON dialect used by .orca files.
+	 *
+	 * On top of plain JSON it accepts // and block comments, trailing commas, a UTF-8 BOM and
+	 * non-breaking spaces as whitespace. It never builds a tree: each token is handed to the
+	 * handler as it is read, and strings without escapes point straight into the input buffer.
+	 *
+	 * Handler interface (every callback returns false to stop parsing):
+	 *   StartObject(), EndObject(), StartArray(), EndArray(), Key(std::string_view),
+	 *   String(std::string_view), Number(double), Bool(bool), Null()
+	 * Views passed to Key() and String() are only valid until the callback returns.
+	 */
+	class OrcaJsonReader
+	{
+	public:
+		OrcaJsonReader(const char* data, size_t size);
+
+		template <typename Handler>
+		bool Parse(Handler& handler);
+
+		/** @brief "line:column: message" for the first syntax error, empty after success. */
+		const std::string& Error() const { return m_error; }
+		size_t ErrorOffset() const { return m_errorOffset; }
+
+		/** @brief Used by handlers to reject otherwise valid input at the current position. */
+		bool Fail(const char* message);
+
+	private:
+		enum class Expect : uint8_t
+		{
+			Value,
+			ArrayValue,
+			Key,
+			CommaOrEnd
+		};
+
+		bool Reject() { return m_error.empty() ? Fail("Value rejected") : false; }
+		bool SkipWhitespace();
+		bool ReadString(std::string_view& out);
+		bool ReadNumber(double& out);
+		bool ReadLiteral(const char* literal, size_t length);
+
+		const char* m_begin;
+		const char* m_end;
+		const char* m_cursor;
+
+		std::string m_scratch;
+		std::string m_error;
+		size_t m_errorOffset = 0;
+	};
+
+	template <typename Handler>
+	bool OrcaJsonReader::Parse(Handler& handler)
+	{
+		constexpr size_t kMaxDepth = 512;
+
+		m_cursor = m_begin;
+		m_error.clear();
+
+		// Containers still open; '{' or '['.
+		std::vector<char> stack;
+		stack.reserve(32);
+		Expect expect = Expect::Value;
+
+		for (;;)
+		{
+			if (!SkipWhitespace()) return false;
+
+			if (m_cursor == m_end)
+			{
+				if (stack.empty() && expect == Expect::CommaOrEnd) return true;
+				return Fail("Unexpected end of file");
+			}
+
+			const char c = *m_cursor;
+
+			if (expect == Expect::CommaOrEnd)
+			{
+				if (stack.empty()) return Fail("Unexpected data after the end of the document");
+
+				if (c == ',')
+				{
+					++m_cursor;
+					expect = stack.back() == '{' ? Expect::Key : Expect::ArrayValue;
+				}
+				else if (c == '}' && stack.back() == '{')
+				{
+					++m_cursor;
+					stack.pop_back();
+					if (!handler.EndObject()) return Reject();
+				}
+				else if (c == ']' && stack.back() == '[')
+				{
+					++m_cursor;
+					stack.pop_back();
+					if (!handler.EndArray()) return Reject();
+				}
+				else
+				{
+					return Fail(stack.back() == '{' ? "Expected ',' or '}'" : "Expected ',' or ']'");
+				}
+				continue;
+			}
+
+			if (expect == Expect::Key)
+			{
+				// Also reached after a comma, which is what makes trailing commas legal.
+				if (c == '}')
+				{
+					++m_cursor;
+					stack.pop_back();
+					if (!handler.EndObject()) return Reject();
+					expect = Expect::CommaOrEnd;
+					continue;
+				}
+				if (c != '"') return Fail("Expected a property name");
+
+				std::string_view key;
+				if (!ReadString(key)) return false;
+				if (!SkipWhitespace()) return false;
+				if (m_cursor == m_end || *m_cursor != ':') return Fail("Expected ':' after the property name");
+				++m_cursor;
+
+				if (!handler.Key(key)) return Reject();
+				expect = Expect::Value;
+				continue;
+			}
+
+			if (expect == Expect::ArrayValue && c == ']')
+			{
+				++m_cursor;
+				stack.pop_back();
+				if (!handler.EndArray()) return Reject();
+				expect = Expect::CommaOrEnd;
+				continue;
+			}
+
+			bool accepted = true;
+			switch (c)
+			{
+			case '{':
+				if (stack.size() == kMaxDepth) return Fail("Nesting is too deep");
+				++m_cursor;
+				stack.push_back('{');
+				accepted = handler.StartObject();
+				expect = Expect::Key;
+				break;
+
+			case '[':
+				if (stack.size() == kMaxDepth) return Fail("Nesting is too deep");
+				++m_cursor;
+				stack.push_back('[');
+				accepted = handler.StartArray();
+				expect = Expect::ArrayValue;
+				break;
+
+			case '"':
+			{
+				std::string_view text;
+				if (!ReadString(text)) return false;
+				accepted = handler.String(text);
+				expect = Expect::CommaOrEnd;
+				break;
+			}
+
+			case 't':
+				if (!ReadLiteral("true", 4)) return false;
+				accepted = handler.Bool(true);
+				expect = Expect::CommaOrEnd;
+				break;
+
+			case 'f':
+				if (!ReadLiteral("false", 5)) return false;
+				accepted = handler.Bool(false);
+				expect = Expect::CommaOrEnd;
+				break;
+
+			case 'n':
+				if (!ReadLiteral("null", 4)) return false;
+				accepted = handler.Null();
+				expect = Expect::CommaOrEnd;
+				break;
+
+			default:
+				if (c == '-' || (c >= '0' && c <= '9'))
+				{
+					double number = 0.0;
+					if (!ReadNumber(number)) return false;
+					accepted = handler.Number(number);
+					expect = Expect::CommaOrEnd;
+					break;
+				}
+				return Fail("Unexpected character");
+			}
+
+			if (!accepted) return Reject();
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,487 @@
+#include "OrcaSceneParser.h"
+#include "OrcaJsonReader.h"
+#include <unordered_map>
+#include <utility>
+
+namespace Orca
+{
+	namespace
+	{
+		enum class Context : uint8_t
+		{
+			Root,
+			Scene,
+			GameObjects,
+			Entity,
+			Transform,
+			TransformVector,
+			Components,
+			Component,
+			PropertyObject,
+			PropertyArray,
+			Hierarchy,
+			HierarchyList,
+			Skip
+		};
+
+		struct Frame
+		{
+			Context context;
+			uint32_t pathLength; // m_path is cut back to this when the frame closes.
+		};
+
+		/**
+		 * Reader handler that writes straight into the document tables. Where a value lands is
+		 * decided by the innermost open container (the frame stack) and the last key seen.
+		 */
+		class SceneBuilder
+		{
+		public:
+			SceneBuilder(OrcaJsonReader& reader, SceneDocument& document)
+				: m_reader(reader), m_document(document)
+			{
+				m_frames.reserve(16);
+			}
+
+			bool Key(std::string_view key)
+			{
+				m_key.assign(key.data(), key.size());
+				return true;
+			}
+
+			bool StartObject()
+			{
+				if (m_frames.empty())
+				{
+					Push(Context::Root);
+					return true;
+				}
+
+				switch (Top())
+				{
+				case Context::Root:
+					if (m_key == "Scene")
+					{
+						Push(Context::Scene);
+						m_path += "Scene.";
+					}
+					else
+					{
+						BeginPropertyObject();
+					}
+					break;
+
+				case Context::Scene:
+					if (m_key == "Hierarchy") Push(Context::Hierarchy);
+					else if (m_key == "GameObjects") Push(Context::Skip);
+					else BeginPropertyObject();
+					break;
+
+				case Context::GameObjects:
+					BeginEntity();
+					break;
+
+				case Context::Entity:
+					Push(m_key == "Transform" ? Context::Transform : Context::Skip);
+					break;
+
+				case Context::Components:
+					BeginComponent();
+					break;
+
+				case Context::Component:
+				case Context::PropertyObject:
+					BeginPropertyObject();
+					break;
+
+				case Context::PropertyArray:
+					m_arrayValid = false;
+					Push(Context::Skip);
+					break;
+
+				default:
+					Push(Context::Skip);
+					break;
+				}
+				return true;
+			}
+
+			bool EndObject()
+			{
+				switch (Top())
+				{
+				case Context::Entity:
+				{
+					EntityRecord& entity = m_document.Entities().back();
+					entity.componentCount = static_cast<uint32_t>(m_document.Components().size()) - entity.firstComponent;
+					break;
+				}
+				case Context::Component:
+				{
+					ComponentRecord& component = m_document.Components().back();
+					component.propertyCount = static_cast<uint32_t>(m_document.Properties().size()) - component.firstProperty;
+					m_inComponent = false;
+					break;
+				}
+				case Context::Root:
+					ResolveHierarchy();
+					break;
+				default:
+					break;
+				}
+
+				Pop();
+				return true;
+			}
+
+			bool StartArray()
+			{
+				if (m_frames.empty())
+				{
+					return m_reader.Fail("A scene file must contain an object");
+				}
+
+				switch (Top())
+				{
+				case Context::Root:
+				case Context::Component:
+				case Context::PropertyObject:
+					BeginPropertyArray();
+					break;
+
+				case Context::Scene:
+					if (m_key == "GameObjects") Push(Context::GameObjects);
+					else if (m_key == "Hierarchy") Push(Context::Skip);
+					else BeginPropertyArray();
+					break;
+
+				case Context::Entity:
+					Push(m_key == "Components" ? Context::Components : Context::Skip);
+					break;
+
+				case Context::Transform:
+					BeginTransformVector();
+					break;
+
+				case Context::Hierarchy:
+					if (m_key == "Root")
+					{
+						m_hierarchyParent = Guid();
+					}
+					else if (!Guid::Parse(m_key, m_hierarchyParent))
+					{
+						return m_reader.Fail("Hierarchy keys must be \"Root\" or a parent GUID");
+					}
+					Push(Context::HierarchyList);
+					break;
+
+				case Context::PropertyArray:
+					m_arrayValid = false;
+					Push(Context::Skip);
+					break;
+
+				default:
+					Push(Context::Skip);
+					break;
+				}
+				return true;
+			}
+
+			bool EndArray()
+			{
+				if (Top() == Context::PropertyArray) EndPropertyArray();
+				Pop();
+				return true;
+			}
+
+			bool String(std::string_view text)
+			{
+				if (m_frames.empty()) return m_reader.Fail("A scene file must contain an object");
+
+				switch (Top())
+				{
+				case Context::Root:
+				case Context::Scene:
+				case Context::PropertyObject:
+					AddProperty(PropertyType::String, Intern(text));
+					break;
+
+				case Context::Component:
+					if (m_key == "Type") m_document.Components().back().typeId = Intern(text);
+					else AddProperty(PropertyType::String, Intern(text));
+					break;
+
+				case Context::Entity:
+				{
+					EntityRecord& entity = m_document.Entities().back();
+					if (m_key == "Name") entity.nameId = Intern(text);
+					else if (m_key == "Tag") entity.tagId = Intern(text);
+					else if (m_key == "GUID" && !Guid::Parse(text, entity.guid)) return m_reader.Fail("Invalid GUID");
+					break;
+				}
+
+				case Context::PropertyArray:
+					AddArrayElement(PropertyType::StringArray, Intern(text));
+					break;
+
+				case Context::HierarchyList:
+				{
+					Guid child;
+					if (!Guid::Parse(text, child)) return m_reader.Fail("Invalid GUID in the hierarchy");
+					if (!m_hierarchyParent.IsNull()) m_links.emplace_back(m_hierarchyParent, child);
+					break;
+				}
+
+				default:
+					break;
+				}
+				return true;
+			}
+
+			bool Number(double number)
+			{
+				if (m_frames.empty()) return m_reader.Fail("A scene file must contain an object");
+
+				const float value = static_cast<float>(number);
+
+				switch (Top())
+				{
+				case Context::Root:
+				case Context::Scene:
+				case Context::Component:
+				case Context::PropertyObject:
+					AddProperty(PropertyType::Number, SceneDocument::FloatBits(value));
+					break;
+
+				case Context::TransformVector:
+					if (m_vectorIndex < 3) m_vectorTarget[m_vectorIndex] = value;
+					++m_vectorIndex;
+					break;
+
+				case Context::PropertyArray:
+					AddArrayElement(PropertyType::NumberArray, SceneDocument::FloatBits(value));
+					break;
+
+				default:
+					break;
+				}
+				return true;
+			}
+
+			bool Bool(bool value)
+			{
+				return Scalar(PropertyType::Bool, value ? 1u : 0u);
+			}
+
+			bool Null()
+			{
+				return Scalar(PropertyType::Null, 0);
+			}
+
+		private:
+			Context Top() const { return m_frames.back().context; }
+
+			void Push(Context context)
+			{
+				m_frames.push_back({ context, static_cast<uint32_t>(m_path.size()) });
+			}
+
+			void Pop()
+			{
+				m_path.resize(m_frames.back().pathLength);
+				m_frames.pop_back();
+			}
+
+			uint32_t Intern(std::string_view text)
+			{
+				return m_document.Strings().Intern(text);
+			}
+
+			/** Component properties are named relative to the component, everything else from the root. */
+			uint32_t PropertyName()
+			{
+				std::string_view prefix(m_path);
+				if (m_inComponent) prefix.remove_prefix(m_componentPathStart);
+
+				m_name.assign(prefix.data(), prefix.size());
+				m_name += m_key;
+				return Intern(m_name);
+			}
+
+			std::vector<PropertyRecord>& PropertyTarget()
+			{
+				return m_inComponent ? m_document.Properties() : m_document.SceneProperties();
+			}
+
+			bool Scalar(PropertyType type, uint32_t value)
+			{
+				if (m_frames.empty()) return m_reader.Fail("A scene file must contain an object");
+
+				switch (Top())
+				{
+				case Context::Root:
+				case Context::Scene:
+				case Context::Component:
+				case Context::PropertyObject:
+					AddProperty(type, value);
+					break;
+				case Context::PropertyArray:
+					m_arrayValid = false;
+					break;
+				default:
+					break;
+				}
+				return true;
+			}
+
+			void AddProperty(PropertyType type, uint32_t value)
+			{
+				PropertyRecord property;
+				property.nameId = PropertyName();
+				property.type = type;
+				property.value = value;
+				PropertyTarget().push_back(property);
+			}
+
+			void BeginPropertyObject()
+			{
+				Push(Context::PropertyObject);
+				m_path += m_key;
+				m_path += '.';
+			}
+
+			void BeginPropertyArray()
+			{
+				m_arrayName = PropertyName();
+				m_arrayFirst = static_cast<uint32_t>(m_document.PropertyData().size());
+				m_arrayType = PropertyType::NumberArray;
+				m_arrayValid = true;
+				Push(Context::PropertyArray);
+			}
+
+			void AddArrayElement(PropertyType type, uint32_t value)
+			{
+				std::vector<uint32_t>& data = m_document.PropertyData();
+				if (data.size() == m_arrayFirst) m_arrayType = type;
+				else if (m_arrayType != type) m_arrayValid = false;
+				data.push_back(value);
+			}
+
+			/** Arrays mixing strings and numbers, or holding containers, are dropped. */
+			void EndPropertyArray()
+			{
+				std::vector<uint32_t>& data = m_document.PropertyData();
+				if (!m_arrayValid)
+				{
+					data.resize(m_arrayFirst);
+					return;
+				}
+
+				PropertyRecord property;
+				property.nameId = m_arrayName;
+				property.type = m_arrayType;
+				property.count = static_cast<uint32_t>(data.size()) - m_arrayFirst;
+				property.value = m_arrayFirst;
+				PropertyTarget().push_back(property);
+			}
+
+			void BeginEntity()
+			{
+				EntityRecord entity;
+				entity.firstComponent = static_cast<uint32_t>(m_document.Components().size());
+				m_document.Entities().push_back(entity);
+				m_document.Transforms().emplace_back();
+				Push(Context::Entity);
+			}
+
+			void BeginComponent()
+			{
+				ComponentRecord component;
+				component.firstProperty = static_cast<uint32_t>(m_document.Properties().size());
+				m_document.Components().push_back(component);
+
+				Push(Context::Component);
+				m_inComponent = true;
+				m_componentPathStart = m_path.size();
+			}
+
+			void BeginTransformVector()
+			{
+				TransformData& transform = m_document.Transforms().back();
+				if (m_key == "Position") m_vectorTarget = transform.position;
+				else if (m_key == "Rotation") m_vectorTarget = transform.rotation;
+				else if (m_key == "Scale") m_vectorTarget = transform.scale;
+				else
+				{
+					Push(Context::Skip);
+					return;
+				}
+
+				m_vectorIndex = 0;
+				Push(Context::TransformVector);
+			}
+
+			/** Root-level entities need no work; parent links are only resolved when there are any. */
+			void ResolveHierarchy()
+			{
+				if (m_links.empty()) return;
+
+				std::vector<EntityRecord>& entities = m_document.Entities();
+				std::unordered_map<Guid, uint32_t, GuidHash> indices;
+				indices.reserve(entities.size());
+				for (uint32_t i = 0; i < entities.size(); ++i)
+				{
+					if (!entities[i].guid.IsNull()) indices.emplace(entities[i].guid, i);
+				}
+
+				for (const auto& link : m_links)
+				{
+					auto parent = indices.find(link.first);
+					auto child = indices.find(link.second);
+					if (parent != indices.end() && child != indices.end() && parent->second != child->second)
+					{
+						entities[child->second].parent = parent->second;
+					}
+				}
+			}
+
+			OrcaJsonReader& m_reader;
+			SceneDocument& m_document;
+
+			std::vector<Frame> m_frames;
+			std::string m_path;
+			std::string m_key;
+			std::string m_name;
+
+			bool m_inComponent = false;
+			size_t m_componentPathStart = 0;
+
+			uint32_t m_arrayName = 0;
+			uint32_t m_arrayFirst = 0;
+			PropertyType m_arrayType = PropertyType::NumberArray;
+			bool m_arrayValid = true;
+
+			float* m_vectorTarget = nullptr;
+			int m_vectorIndex = 0;
+
+			Guid m_hierarchyParent;
+			std::vector<std::pair<Guid, Guid>> m_links; // (parent, child)
+		};
+	}
+
+	bool ParseOrcaScene(const char* data, size_t size, SceneDocument& document, std::string* error)
+	{
+		document.Clear();
+
+		OrcaJsonReader reader(data, size);
+		SceneBuilder builder(reader, document);
+
+		if (!reader.Parse(builder))
+		{
+			if (error) *error = reader.Error();
+			document.Clear();
+			return false;
+		}
+		return true;
+	}
+}
\ No newline at end of file
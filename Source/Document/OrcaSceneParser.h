@@ -0,0 +1,23 @@
+#pragma once
+
+#ifndef ORCA_SCENE_PARSER_H
+#define ORCA_SCENE_PARSER_H
+
+#include "SceneDocument.h"
+#include <string>
+
+namespace Orca
+{
+	/**
+	 * @brief Builds a SceneDocument from .orca text in a single streaming pass.
+	 *
+	 * Entities come from Scene.GameObjects, parents from Scene.Hierarchy ("Root" or a parent GUID
+	 * mapped to child GUIDs). Every other value is kept as a scene property under its dotted path,
+	 * so it survives a save. Unknown keys inside a GameObject are ignored.
+	 *
+	 * @param error Receives "line:column: message" on failure.
+	 */
+	bool ParseOrcaScene(const char* data, size_t size, SceneDocument& document, std::string* error = nullptr);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,473 @@
+#include "OrcaSceneWriter.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr size_t kFlushBytes = 1 << 20;
+		constexpr std::string_view kScenePrefix = "Scene.";
+
+		class TextOutput
+		{
+		public:
+			explicit TextOutput(const SceneWriteSink& sink)
+				: m_sink(sink)
+			{
+				m_buffer.reserve(kFlushBytes + 4096);
+			}
+
+			void Append(std::string_view text) { m_buffer.append(text.data(), text.size()); }
+			void Append(char c) { m_buffer.push_back(c); }
+
+			void NewLine(int depth)
+			{
+				m_buffer.push_back('\n');
+				m_buffer.append(static_cast<size_t>(depth) * 4, ' ');
+			}
+
+			void String(std::string_view text)
+			{
+				static const char kHex[] = "0123456789abcdef";
+
+				m_buffer.push_back('"');
+				for (char c : text)
+				{
+					unsigned char byte = static_cast<unsigned char>(c);
+					if (c == '"' || c == '\\')
+					{
+						m_buffer.push_back('\\');
+						m_buffer.push_back(c);
+					}
+					else if (byte < 0x20)
+					{
+						m_buffer.append("\\u00");
+						m_buffer.push_back(kHex[byte >> 4]);
+						m_buffer.push_back(kHex[byte & 0xF]);
+					}
+					else
+					{
+						m_buffer.push_back(c);
+					}
+				}
+				m_buffer.push_back('"');
+			}
+
+			void Key(std::string_view key)
+			{
+				String(key);
+				m_buffer.append(": ");
+			}
+
+			/** Shortest text that reads back as the same float; always has a decimal point like hand-written files. */
+			void Number(float value)
+			{
+				if (!std::isfinite(value)) value = 0.0f;
+
+				char text[32];
+				auto result = std::to_chars(text, text + sizeof(text), value);
+				std::string_view written(text, static_cast<size_t>(result.ptr - text));
+				m_buffer.append(written.data(), written.size());
+				if (written.find_first_of(".e") == std::string_view::npos) m_buffer.append(".0");
+			}
+
+			void Vector(const float* values, size_t count)
+			{
+				m_buffer.push_back('[');
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (i) m_buffer.append(", ");
+					Number(values[i]);
+				}
+				m_buffer.push_back(']');
+			}
+
+			bool MaybeFlush()
+			{
+				return m_buffer.size() >= kFlushBytes ? Flush() : m_ok;
+			}
+
+			bool Flush()
+			{
+				if (m_ok && !m_buffer.empty()) m_ok = m_sink(m_buffer.data(), m_buffer.size());
+				m_buffer.clear();
+				return m_ok;
+			}
+
+		private:
+			const SceneWriteSink& m_sink;
+			std::string m_buffer;
+			bool m_ok = true;
+		};
+
+		void WriteValue(TextOutput& out, const SceneDocument& document, const PropertyRecord& property)
+		{
+			const std::vector<uint32_t>& data = document.PropertyData();
+
+			switch (property.type)
+			{
+			case PropertyType::Null:
+				out.Append("null");
+				break;
+			case PropertyType::Bool:
+				out.Append(property.value ? "true" : "false");
+				break;
+			case PropertyType::Number:
+				out.Number(SceneDocument::BitsToFloat(property.value));
+				break;
+			case PropertyType::String:
+				out.String(document.Strings().View(property.value));
+				break;
+			case PropertyType::NumberArray:
+				out.Append('[');
+				for (uint32_t i = 0; i < property.count; ++i)
+				{
+					if (i) out.Append(", ");
+					out.Number(SceneDocument::BitsToFloat(data[property.value + i]));
+				}
+				out.Append(']');
+				break;
+			case PropertyType::StringArray:
+				out.Append('[');
+				for (uint32_t i = 0; i < property.count; ++i)
+				{
+					if (i) out.Append(", ");
+					out.String(document.Strings().View(data[property.value + i]));
+				}
+				out.Append(']');
+				break;
+			}
+		}
+
+		/**
+		 * Writes members of one JSON object at @p depth. Dotted property names are turned back
+		 * into nested objects; properties that share a prefix are expected to be adjacent,
+		 * which is how the parser produces them.
+		 */
+		class MemberWriter
+		{
+		public:
+			MemberWriter(TextOutput& out, int depth)
+				: m_out(out), m_depth(depth)
+			{
+				m_first.push_back(true);
+			}
+
+			void BeginMember(std::string_view key)
+			{
+				CloseTo(0);
+				Separator();
+				m_out.Key(key);
+			}
+
+			void Property(const SceneDocument& document, const PropertyRecord& property, size_t stripPrefix)
+			{
+				std::string_view name = document.Strings().View(property.nameId);
+				name.remove_prefix(std::min(stripPrefix, name.size()));
+
+				m_segments.clear();
+				size_t start = 0;
+				for (size_t dot = name.find('.'); dot != std::string_view::npos; dot = name.find('.', start))
+				{
+					m_segments.push_back(name.substr(start, dot - start));
+					start = dot + 1;
+				}
+				std::string_view leaf = name.substr(start);
+
+				size_t common = 0;
+				while (common < m_open.size() && common < m_segments.size() && m_open[common] == m_segments[common]) ++common;
+				CloseTo(common);
+
+				for (size_t i = common; i < m_segments.size(); ++i)
+				{
+					Separator();
+					m_out.Key(m_segments[i]);
+					m_out.Append('{');
+					m_open.push_back(m_segments[i]);
+					m_first.push_back(true);
+				}
+
+				Separator();
+				m_out.Key(leaf);
+				WriteValue(m_out, document, property);
+			}
+
+			/** Closes nested objects; the caller closes the object it opened. */
+			void Finish()
+			{
+				CloseTo(0);
+			}
+
+		private:
+			void Separator()
+			{
+				if (!m_first.back()) m_out.Append(',');
+				m_first.back() = false;
+				m_out.NewLine(m_depth + static_cast<int>(m_open.size()));
+			}
+
+			void CloseTo(size_t level)
+			{
+				while (m_open.size() > level)
+				{
+					m_open.pop_back();
+					m_first.pop_back();
+					m_out.NewLine(m_depth + static_cast<int>(m_open.size()));
+					m_out.Append('}');
+				}
+			}
+
+			TextOutput& m_out;
+			int m_depth;
+			std::vector<std::string_view> m_open;
+			std::vector<std::string_view> m_segments;
+			std::vector<bool> m_first;
+		};
+
+		void WriteEntity(TextOutput& out, const SceneDocument& document, const EntityRecord& entity, const TransformData& transform, std::string_view name)
+		{
+			out.Append('{');
+			out.NewLine(4);
+			out.Key("Name");
+			out.String(name);
+			if (!entity.guid.IsNull())
+			{
+				out.Append(',');
+				out.NewLine(4);
+				out.Key("GUID");
+				out.String(entity.guid.ToString());
+			}
+			out.Append(',');
+			out.NewLine(4);
+			out.Key("Tag");
+			out.String(document.Strings().View(entity.tagId));
+
+			out.Append(',');
+			out.NewLine(4);
+			out.Append("\"Transform\": {");
+			out.NewLine(5);
+			out.Key("Position");
+			out.Vector(transform.position, 3);
+			out.Append(',');
+			out.NewLine(5);
+			out.Key("Rotation");
+			out.Vector(transform.rotation, 3);
+			out.Append(',');
+			out.NewLine(5);
+			out.Key("Scale");
+			out.Vector(transform.scale, 3);
+			out.NewLine(4);
+			out.Append('}');
+
+			out.Append(',');
+			out.NewLine(4);
+			out.Append("\"Components\": [");
+			for (uint32_t c = 0; c < entity.componentCount; ++c)
+			{
+				const ComponentRecord& component = document.Components()[entity.firstComponent + c];
+
+				if (c)
+				{
+					out.Append(", {");
+				}
+				else
+				{
+					out.NewLine(5);
+					out.Append('{');
+				}
+
+				MemberWriter members(out, 6);
+				members.BeginMember("Type");
+				out.String(document.Strings().View(component.typeId));
+				for (uint32_t p = 0; p < component.propertyCount; ++p)
+				{
+					members.Property(document, document.Properties()[component.firstProperty + p], 0);
+				}
+				members.Finish();
+
+				out.NewLine(5);
+				out.Append('}');
+			}
+			if (entity.componentCount) out.NewLine(4);
+			out.Append(']');
+
+			out.NewLine(3);
+			out.Append('}');
+		}
+
+		void WriteGuidList(TextOutput& out, const std::vector<EntityRecord>& records, const std::vector<uint32_t>& entities, size_t begin, size_t end)
+		{
+			out.Append('[');
+			bool first = true;
+			for (size_t i = begin; i < end; ++i)
+			{
+				const Guid& guid = records[entities[i]].guid;
+				if (guid.IsNull()) continue;
+
+				if (!first) out.Append(',');
+				first = false;
+				out.NewLine(4);
+				out.String(guid.ToString());
+			}
+			if (!first) out.NewLine(3);
+			out.Append(']');
+		}
+
+		/** "Root" lists top-level entities, then each parent GUID lists its children. */
+		void WriteHierarchy(TextOutput& out, const std::vector<EntityRecord>& entities)
+		{
+			const uint32_t count = static_cast<uint32_t>(entities.size());
+
+			// Counting sort of entities by parent; slot `count` collects the roots.
+			std::vector<uint32_t> start(static_cast<size_t>(count) + 2, 0);
+			for (const EntityRecord& entity : entities)
+			{
+				uint32_t parent = entity.parent < count ? entity.parent : count;
+				++start[parent + 1];
+			}
+			for (size_t i = 1; i < start.size(); ++i) start[i] += start[i - 1];
+
+			std::vector<uint32_t> ordered(count);
+			std::vector<uint32_t> cursor(start.begin(), start.end() - 1);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				uint32_t parent = entities[i].parent < count ? entities[i].parent : count;
+				ordered[cursor[parent]++] = i;
+			}
+
+			out.Append('{');
+			out.NewLine(3);
+			out.Key("Root");
+			WriteGuidList(out, entities, ordered, start[count], start[count + 1]);
+
+			for (uint32_t parent = 0; parent < count; ++parent)
+			{
+				if (start[parent] == start[parent + 1] || entities[parent].guid.IsNull()) continue;
+
+				out.Append(',');
+				out.NewLine(3);
+				out.Key(entities[parent].guid.ToString());
+				WriteGuidList(out, entities, ordered, start[parent], start[parent + 1]);
+				out.MaybeFlush();
+			}
+
+			out.NewLine(2);
+			out.Append('}');
+		}
+
+		/**
+		 * Everything around the GameObjects array and the Hierarchy object, which the callbacks
+		 * write. Returns false as soon as the sink refuses data.
+		 */
+		template <typename WriteEntities, typename WriteHierarchyObject>
+		bool WriteScene(const SceneDocument& document, size_t entityCount, const SceneWriteSink& sink,
+			WriteEntities&& writeEntities, WriteHierarchyObject&& writeHierarchy)
+		{
+			TextOutput out(sink);
+
+			std::vector<PropertyRecord> rootProperties;
+			std::vector<PropertyRecord> sceneProperties;
+			for (const PropertyRecord& property : document.SceneProperties())
+			{
+				std::string_view name = document.Strings().View(property.nameId);
+				(name.substr(0, kScenePrefix.size()) == kScenePrefix ? sceneProperties : rootProperties).push_back(property);
+			}
+
+			out.Append('{');
+			MemberWriter root(out, 1);
+			for (const PropertyRecord& property : rootProperties) root.Property(document, property, 0);
+
+			root.BeginMember("Scene");
+			out.Append('{');
+			{
+				MemberWriter scene(out, 2);
+				for (const PropertyRecord& property : sceneProperties) scene.Property(document, property, kScenePrefix.size());
+
+				scene.BeginMember("GameObjects");
+				out.Append('[');
+				if (!writeEntities(out)) return false;
+				if (entityCount) out.NewLine(2);
+				out.Append(']');
+
+				scene.BeginMember("Hierarchy");
+				scene.Finish();
+				writeHierarchy(out);
+			}
+			out.NewLine(1);
+			out.Append('}');
+
+			root.Finish();
+			out.NewLine(0);
+			out.Append("}\n");
+			return out.Flush();
+		}
+	}
+
+	bool WriteOrcaScene(const SceneDocument& document, const SceneWriteSink& sink)
+	{
+		const size_t count = document.EntityCount();
+		return WriteScene(document, count, sink, [&](TextOutput& out)
+		{
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				if (i) out.Append(',');
+				out.NewLine(3);
+				WriteEntity(out, document, document.Entities()[i], document.Transforms()[i], document.EntityName(i));
+				if (!out.MaybeFlush()) return false;
+			}
+			return true;
+		},
+		[&](TextOutput& out) { WriteHierarchy(out, document.Entities()); });
+	}
+
+	bool WriteOrcaScene(const SceneDocument& document, const OrcaScenePieces& pieces, const SceneWriteSink& sink)
+	{
+		return WriteScene(document, pieces.entityCount, sink, [&](TextOutput& out)
+		{
+			for (std::string_view piece : pieces.entities)
+			{
+				out.Append(piece);
+				if (!out.MaybeFlush()) return false;
+			}
+			return true;
+		},
+		[&](TextOutput& out) { out.Append(pieces.hierarchy); });
+	}
+
+	void AppendOrcaEntityText(const SceneDocument& document, const EntityRecord* records, const TransformData* transforms,
+		const std::string_view* names, size_t count, bool firstInScene, std::string& text)
+	{
+		const SceneWriteSink sink = [&text](const char* data, size_t size)
+		{
+			text.append(data, size);
+			return true;
+		};
+
+		TextOutput out(sink);
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (i || !firstInScene) out.Append(',');
+			out.NewLine(3);
+			WriteEntity(out, document, records[i], transforms[i], names[i]);
+			out.MaybeFlush();
+		}
+		out.Flush();
+	}
+
+	void AppendOrcaHierarchyText(const std::vector<EntityRecord>& entities, std::string& text)
+	{
+		const SceneWriteSink sink = [&text](const char* data, size_t size)
+		{
+			text.append(data, size);
+			return true;
+		};
+
+		TextOutput out(sink);
+		WriteHierarchy(out, entities);
+		out.Flush();
+	}
+}
\ No newline at end of file
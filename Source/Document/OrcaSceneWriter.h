@@ -0,0 +1,49 @@
+#pragma once
+
+#ifndef ORCA_SCENE_WRITER_H
+#define ORCA_SCENE_WRITER_H
+
+#include "SceneDocument.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Orca
+{
+	/**
+	 * @brief Writes the document as .orca text that ParseOrcaScene reads back unchanged.
+	 *        Dotted property names become nested objects again; output goes to the sink in
+	 *        chunks of about 1 MB so large scenes never sit in memory as one string.
+	 */
+	bool WriteOrcaScene(const SceneDocument& document, const SceneWriteSink& sink);
+
+	/**
+	 * @brief Text produced ahead of time by AppendOrcaEntityText and AppendOrcaHierarchyText,
+	 *        so unchanged parts of a scene can be reused from one save to the next.
+	 */
+	struct OrcaScenePieces
+	{
+		size_t entityCount = 0;
+		std::vector<std::string_view> entities;   // in entity order, concatenated as-is
+		std::string_view hierarchy;
+	};
+
+	/**
+	 * @brief Writes the scene settings from the document around pre-serialized entities and
+	 *        hierarchy. Produces the same bytes as the plain overload for the same data.
+	 */
+	bool WriteOrcaScene(const SceneDocument& document, const OrcaScenePieces& pieces, const SceneWriteSink& sink);
+
+	/**
+	 * @brief Appends "GameObjects" entries for a run of entities. Components come from the
+	 *        document; records, transforms and names are passed in so an edited copy can be
+	 *        written without building a whole document. firstInScene drops the leading comma.
+	 */
+	void AppendOrcaEntityText(const SceneDocument& document, const EntityRecord* records, const TransformData* transforms,
+		const std::string_view* names, size_t count, bool firstInScene, std::string& text);
+
+	/** @brief Appends the "Hierarchy" object for the given entity records. */
+	void AppendOrcaHierarchyText(const std::vector<EntityRecord>& entities, std::string& text);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include "SceneBenchmarks.h"
+#include "SceneDocument.h"
+#include "SceneFile.h"
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QRandomGenerator>
+#include <algorithm>
+#include <limits>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr qsizetype kWriteChunk = 1 << 20;
+
+		// How often a dynamic synthetic scene gives an object each extra.
+		constexpr uint32_t kLightEvery = 64;
+		constexpr uint32_t kRigidbodyEvery = 16;
+		constexpr uint32_t kOccluderEvery = 256;
+
+		QByteArray Vector(float x, float y, float z)
+		{
+			return "[" + QByteArray::number(x, 'f', 3) + ", " + QByteArray::number(y, 'f', 3) + ", " + QByteArray::number(z, 'f', 3) + "]";
+		}
+
+		/** Touches roughly what the scene loader reads so the DOM isn't measured half-built. */
+		size_t WalkJsonScene(const QJsonDocument& json)
+		{
+			const QJsonArray objects = json.object().value("Scene").toObject().value("GameObjects").toArray();
+			double checksum = 0.0;
+			for (const QJsonValue& value : objects)
+			{
+				const QJsonObject object = value.toObject();
+				checksum += object.value("Name").toString().size();
+				checksum += object.value("GUID").toString().size();
+
+				const QJsonObject transform = object.value("Transform").toObject();
+				for (const char* key : { "Position", "Rotation", "Scale" })
+				{
+					for (const QJsonValue& component : transform.value(key).toArray()) checksum += component.toDouble();
+				}
+
+				for (const QJsonValue& component : object.value("Components").toArray())
+				{
+					checksum += component.toObject().size();
+				}
+			}
+			// Keeps the reads from being optimized away.
+			static volatile double s_sink = 0.0;
+			s_sink = checksum;
+			return static_cast<size_t>(objects.size());
+		}
+	}
+
+	bool WriteSyntheticScene(const QString& path, uint32_t objectCount, QString* error, bool dynamic)
+	{
+		QFile file(path);
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+			if (error) *error = file.errorString();
+			return false;
+		}
+
+		QRandomGenerator random(1234);
+		QByteArray buffer;
+		buffer.reserve(kWriteChunk + 4096);
+
+		buffer += "{\n    \"ProjectName\": \"Synthetic\",\n    \"EngineVersion\": \"0.9.1\",\n    \"Scene\": {\n";
+		buffer += "        \"Environment\": {\"Skybox\": \"DefaultSky\", \"AmbientLight\": [0.1, 0.1, 0.1, 1.0]},\n";
+		buffer += "        \"GameObjects\": [\n";
+
+		for (uint32_t i = 0; i < objectCount; ++i)
+		{
+			QByteArray guid = QByteArray::number(i, 16).rightJustified(8, '0') + "-0000-4000-8000-" + QByteArray::number(i, 16).rightJustified(12, '0');
+			float x = static_cast<float>(random.bounded(1000.0)), y = static_cast<float>(random.bounded(100.0)), z = static_cast<float>(random.bounded(1000.0));
+			QByteArray rotation = Vector(0.0f, static_cast<float>(random.bounded(360.0)), 0.0f);
+
+			// The sun shines along its +Z axis, so it is tilted down onto the scene.
+			const bool sun = dynamic && i == 0;
+			if (sun) rotation = Vector(50.0f, 30.0f, 0.0f);
+
+			buffer += "            {\"Name\": \"Object_" + QByteArray::number(i) + "\", \"GUID\": \"" + guid + "\", \"Tag\": \"Untagged\", ";
+			buffer += "\"Transform\": {\"Position\": " + Vector(x, y, z) + ", \"Rotation\": " + rotation + ", \"Scale\": [1.0, 1.0, 1.0]}, ";
+			buffer += "\"Components\": [{\"Type\": \"MeshRenderer\", \"Properties\": {\"Mesh\": \"Meshes/Cube.obj\", \"Material\": \"Materials/Default.mat\", \"CastShadows\": true";
+			if (dynamic && i % kOccluderEvery == kOccluderEvery / 2) buffer += ", \"Occluder\": true";
+			buffer += "}}";
+			if (sun)
+			{
+				buffer += ", {\"Type\": \"LightComponent\", \"Properties\": {\"Type\": \"Directional\", \"Intensity\": 1.0, \"Color\": [1.0, 0.95, 0.9]}}";
+			}
+			else if (dynamic && i % kLightEvery == 0)
+			{
+				buffer += ", {\"Type\": \"LightComponent\", \"Properties\": {\"Type\": \"Point\", \"Intensity\": 2.0, \"Range\": 40.0, \"Color\": [1.0, 0.8, 0.6]}}";
+			}
+			if (dynamic && i % kRigidbodyEvery == kRigidbodyEvery / 2)
+			{
+				buffer += ", {\"Type\": \"RigidbodyComponent\", \"Properties\": {\"UseGravity\": true, \"Drag\": 0.1}}";
+			}
+			buffer += "]}";
+			buffer += (i + 1 < objectCount) ? ",\n" : "\n";
+
+			if (buffer.size() >= kWriteChunk)
+			{
+				if (file.write(buffer) != buffer.size())
+				{
+					if (error) *error = file.errorString();
+					return false;
+				}
+				buffer.clear();
+			}
+		}
+
+		buffer += "        ],\n        \"Hierarchy\": {\"Root\": []}\n    }\n}\n";
+		if (file.write(buffer) != buffer.size())
+		{
+			if (error) *error = file.errorString();
+			return false;
+		}
+		return true;
+	}
+
+	SceneParseBenchmarkResult BenchmarkSceneParse(const QString& path, int iterations)
+	{
+		SceneParseBenchmarkResult result;
+		result.fileBytes = QFile(path).size();
+		result.orcaMs = std::numeric_limits<double>::max();
+		result.qjsonMs = std::numeric_limits<double>::max();
+		iterations = std::max(iterations, 1);
+
+		QElapsedTimer timer;
+		for (int i = 0; i < iterations; ++i)
+		{
+			SceneDocument document;
+			QString error;
+
+			timer.start();
+			result.orcaOk = LoadSceneFile(path, document, &error);
+			result.orcaMs = std::min(result.orcaMs, timer.nsecsElapsed() / 1e6);
+
+			if (!result.orcaOk)
+			{
+				result.orcaError = error;
+				break;
+			}
+			result.entities = document.EntityCount();
+			result.documentBytes = document.MemoryBytes();
+		}
+
+		for (int i = 0; i < iterations; ++i)
+		{
+			timer.start();
+
+			QFile file(path);
+			if (!file.open(QIODevice::ReadOnly))
+			{
+				result.qjsonError = file.errorString();
+				break;
+			}
+
+			QJsonParseError parseError;
+			QJsonDocument json = QJsonDocument::fromJson(file.readAll(), &parseError);
+			if (json.isNull())
+			{
+				result.qjsonError = QString("%1 at offset %2").arg(parseError.errorString()).arg(parseError.offset);
+				break;
+			}
+
+			WalkJsonScene(json);
+			result.qjsonMs = std::min(result.qjsonMs, timer.nsecsElapsed() / 1e6);
+			result.qjsonOk = true;
+		}
+
+		if (!result.orcaOk) result.orcaMs = 0.0;
+		if (!result.qjsonOk) result.qjsonMs = 0.0;
+		return result;
+	}
+
+	SceneFormatBenchmarkResult BenchmarkSceneFormats(const QString& orcaPath, int iterations)
+	{
+		SceneFormatBenchmarkResult result;
+		result.binaryPath = QFileInfo(orcaPath).path() + "/" + QFileInfo(orcaPath).completeBaseName() + ".orcab";
+		iterations = std::max(iterations, 1);
+
+		SceneDocument document;
+		if (!LoadSceneFile(orcaPath, document, &result.error) || !SaveSceneFile(result.binaryPath, document, &result.error))
+		{
+			return result;
+		}
+		result.entities = document.EntityCount();
+		result.textBytes = QFile(orcaPath).size();
+		result.binaryBytes = QFile(result.binaryPath).size();
+
+		auto bestLoad = [&](const QString& path, double& bestMs)
+		{
+			QElapsedTimer timer;
+			bestMs = std::numeric_limits<double>::max();
+			for (int i = 0; i < iterations; ++i)
+			{
+				SceneDocument loaded;
+				timer.start();
+				if (!LoadSceneFile(path, loaded, &result.error)) return false;
+				bestMs = std::min(bestMs, timer.nsecsElapsed() / 1e6);
+			}
+			return true;
+		};
+
+		result.ok = bestLoad(orcaPath, result.textMs) && bestLoad(result.binaryPath, result.binaryMs);
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#ifndef SCENE_BENCHMARKS_H
+#define SCENE_BENCHMARKS_H
+
+#include <QtCore/QString>
+#include <cstdint>
+
+namespace Orca
+{
+	struct SceneParseBenchmarkResult
+	{
+		qint64 fileBytes = 0;
+		size_t entities = 0;
+		size_t documentBytes = 0;
+
+		bool orcaOk = false;
+		double orcaMs = 0.0;
+		QString orcaError;
+
+		bool qjsonOk = false;
+		double qjsonMs = 0.0;
+		QString qjsonError;
+
+		static double MegabytesPerSecond(qint64 bytes, double ms) { return ms > 0.0 ? (bytes / 1e6) / (ms / 1000.0) : 0.0; }
+	};
+
+	struct SceneFormatBenchmarkResult
+	{
+		bool ok = false;
+		QString error;
+		QString binaryPath;
+
+		size_t entities = 0;
+		qint64 textBytes = 0;
+		qint64 binaryBytes = 0;
+		double textMs = 0.0;
+		double binaryMs = 0.0;
+	};
+
+	/**
+	 * @brief Writes a .orca scene with the given number of objects, each with a transform and a
+	 *        MeshRenderer. No comments, so QJsonDocument can read it as well. With @p dynamic the
+	 *        first object is a directional light and some of the rest carry point lights,
+	 *        Rigidbodies or the Occluder flag, so lighting, culling and play mode have work.
+	 */
+	bool WriteSyntheticScene(const QString& path, uint32_t objectCount, QString* error = nullptr, bool dynamic = false);
+
+	/**
+	 * @brief Loads the file with LoadSceneFile and with QFile + QJsonDocument, keeping the best of
+	 *        @p iterations runs for each. Both timings include reading the file.
+	 */
+	SceneParseBenchmarkResult BenchmarkSceneParse(const QString& path, int iterations = 3);
+
+	/**
+	 * @brief Converts a .orca scene to .orcab next to it, then compares LoadSceneFile on both
+	 *        (best of @p iterations, file mapping included).
+	 */
+	SceneFormatBenchmarkResult BenchmarkSceneFormats(const QString& orcaPath, int iterations = 3);
+}
+
+#endif
\ No newline at end of file
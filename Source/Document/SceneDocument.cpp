@@ -0,0 +1,208 @@
+#include "SceneDocument.h"
+#include <algorithm>
+
+namespace Orca
+{
+	namespace
+	{
+		int HexValue(char c)
+		{
+			if (c >= '0' && c <= '9') return c - '0';
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+			return -1;
+		}
+
+		uint64_t HashBytes(std::string_view text)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (char c : text)
+			{
+				hash ^= static_cast<unsigned char>(c);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+	}
+
+	bool Guid::Parse(std::string_view text, Guid& out)
+	{
+		uint64_t words[2] = { 0, 0 };
+		int digits = 0;
+
+		for (char c : text)
+		{
+			if (c == '-') continue;
+
+			int value = HexValue(c);
+			if (value < 0 || digits == 32) return false;
+
+			uint64_t& word = words[digits / 16];
+			word = (word << 4) | static_cast<uint64_t>(value);
+			++digits;
+		}
+
+		if (digits != 32) return false;
+		out.high = words[0];
+		out.low = words[1];
+		return true;
+	}
+
+	std::string Guid::ToString() const
+	{
+		static const char kHex[] = "0123456789abcdef";
+		std::string text;
+		text.reserve(36);
+
+		for (int i = 0; i < 32; ++i)
+		{
+			if (i == 8 || i == 12 || i == 16 || i == 20) text.push_back('-');
+			uint64_t word = i < 16 ? high : low;
+			text.push_back(kHex[(word >> ((15 - (i % 16)) * 4)) & 0xF]);
+		}
+		return text;
+	}
+
+	StringPool::StringPool()
+	{
+		Clear();
+	}
+
+	void StringPool::Clear()
+	{
+		m_bytes.clear();
+		m_offsets.assign(2, 0);
+		m_slots.assign(64, 0);
+		m_slots[HashBytes({}) & (m_slots.size() - 1)] = 1;
+	}
+
+	void StringPool::Reserve(size_t strings, size_t bytes)
+	{
+		m_bytes.reserve(bytes);
+		m_offsets.reserve(strings + 1);
+
+		size_t slotCount = std::max<size_t>(m_slots.size(), 64);
+		while (slotCount < strings * 2) slotCount *= 2;
+		if (slotCount != m_slots.size()) Rehash(slotCount);
+	}
+
+	uint32_t StringPool::Find(std::string_view text, uint64_t hash, size_t& slot) const
+	{
+		size_t mask = m_slots.size() - 1;
+		for (slot = hash & mask; m_slots[slot] != 0; slot = (slot + 1) & mask)
+		{
+			uint32_t id = m_slots[slot] - 1;
+			if (View(id) == text) return id;
+		}
+		return 0xFFFFFFFFu;
+	}
+
+	uint32_t StringPool::Intern(std::string_view text)
+	{
+		if (text.empty()) return 0;
+		if (m_slots.empty()) Reserve(Size(), m_bytes.size());
+
+		uint64_t hash = HashBytes(text);
+		size_t slot = 0;
+		uint32_t existing = Find(text, hash, slot);
+		if (existing != 0xFFFFFFFFu) return existing;
+
+		uint32_t id = static_cast<uint32_t>(Size());
+		m_bytes.insert(m_bytes.end(), text.begin(), text.end());
+		m_offsets.push_back(static_cast<uint32_t>(m_bytes.size()));
+		m_slots[slot] = id + 1;
+
+		// Keep the load factor under one half so probe chains stay short.
+		if (Size() * 2 > m_slots.size()) Rehash(m_slots.size() * 2);
+		return id;
+	}
+
+	std::string_view StringPool::View(uint32_t id) const
+	{
+		if (id >= Size()) return {};
+		return std::string_view(m_bytes.data() + m_offsets[id], m_offsets[id + 1] - m_offsets[id]);
+	}
+
+	void StringPool::Rehash(size_t slotCount)
+	{
+		m_slots.assign(slotCount, 0);
+		size_t mask = slotCount - 1;
+
+		for (uint32_t id = 0; id < Size(); ++id)
+		{
+			size_t slot = HashBytes(View(id)) & mask;
+			while (m_slots[slot] != 0) slot = (slot + 1) & mask;
+			m_slots[slot] = id + 1;
+		}
+	}
+
+	bool StringPool::Assign(const char* bytes, size_t byteCount, const uint32_t* offsets, size_t offsetCount)
+	{
+		if (offsetCount < 2 || offsets[0] != 0 || offsets[1] != 0 || offsets[offsetCount - 1] != byteCount)
+		{
+			return false;
+		}
+		for (size_t i = 1; i < offsetCount; ++i)
+		{
+			if (offsets[i] < offsets[i - 1]) return false;
+		}
+
+		m_bytes.assign(bytes, bytes + byteCount);
+		m_offsets.assign(offsets, offsets + offsetCount);
+
+		// The lookup table is only needed to intern new strings; build it on the first Intern().
+		m_slots.clear();
+		return true;
+	}
+
+	size_t StringPool::MemoryBytes() const
+	{
+		return m_bytes.capacity() + m_offsets.capacity() * sizeof(uint32_t) + m_slots.capacity() * sizeof(uint32_t);
+	}
+
+	void SceneDocument::Clear()
+	{
+		m_strings.Clear();
+		m_entities.clear();
+		m_transforms.clear();
+		m_components.clear();
+		m_properties.clear();
+		m_sceneProperties.clear();
+		m_propertyData.clear();
+	}
+
+	void SceneDocument::Reserve(size_t entities)
+	{
+		m_entities.reserve(entities);
+		m_transforms.reserve(entities);
+	}
+
+	float SceneDocument::PropertyNumber(const PropertyRecord& property, uint32_t element) const
+	{
+		if (property.type == PropertyType::Number) return BitsToFloat(property.value);
+		if (property.type == PropertyType::NumberArray && element < property.count)
+		{
+			return BitsToFloat(m_propertyData[property.value + element]);
+		}
+		return 0.0f;
+	}
+
+	uint32_t SceneDocument::FindEntity(const Guid& guid) const
+	{
+		for (size_t i = 0; i < m_entities.size(); ++i)
+		{
+			if (m_entities[i].guid == guid) return static_cast<uint32_t>(i);
+		}
+		return kNoParent;
+	}
+
+	size_t SceneDocument::MemoryBytes() const
+	{
+		return m_strings.MemoryBytes()
+			+ m_entities.capacity() * sizeof(EntityRecord)
+			+ m_transforms.capacity() * sizeof(TransformData)
+			+ m_components.capacity() * sizeof(ComponentRecord)
+			+ (m_properties.capacity() + m_sceneProperties.capacity()) * sizeof(PropertyRecord)
+			+ m_propertyData.capacity() * sizeof(uint32_t);
+	}
+}
\ No newline at end of file
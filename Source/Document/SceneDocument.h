@@ -0,0 +1,202 @@
+#pragma once
+
+#ifndef SCENE_DOCUMENT_H
+#define SCENE_DOCUMENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Orca
+{
+	/**
+	 * @brief 128-bit object identifier, stored as two integers instead of the 36-character text form.
+	 */
+	struct Guid
+	{
+		uint64_t high = 0;
+		uint64_t low = 0;
+
+		bool IsNull() const { return high == 0 && low == 0; }
+		bool operator==(const Guid& other) const { return high == other.high && low == other.low; }
+		bool operator!=(const Guid& other) const { return !(*this == other); }
+
+		/**
+		 * @brief Parses "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" (dashes optional).
+		 */
+		static bool Parse(std::string_view text, Guid& out);
+
+		std::string ToString() const;
+	};
+
+	struct GuidHash
+	{
+		size_t operator()(const Guid& guid) const { return static_cast<size_t>(guid.high * 0x9E3779B97F4A7C15ull ^ guid.low); }
+	};
+
+	/**
+	 * @brief Interned, immutable strings addressed by a 32-bit id. Id 0 is always the empty string.
+	 *        Storage is one byte blob plus an offset table, so it can be written out as-is.
+	 */
+	class StringPool
+	{
+	public:
+		StringPool();
+
+		uint32_t Intern(std::string_view text);
+		std::string_view View(uint32_t id) const;
+
+		size_t Size() const { return m_offsets.size() - 1; }
+		void Clear();
+		void Reserve(size_t strings, size_t bytes);
+
+		const std::vector<char>& Bytes() const { return m_bytes; }
+		const std::vector<uint32_t>& Offsets() const { return m_offsets; }
+
+		/**
+		 * @brief Replaces the contents with a blob and offset table produced by Bytes()/Offsets().
+		 */
+		bool Assign(const char* bytes, size_t byteCount, const uint32_t* offsets, size_t offsetCount);
+
+		size_t MemoryBytes() const;
+
+	private:
+		uint32_t Find(std::string_view text, uint64_t hash, size_t& slot) const;
+		void Rehash(size_t slotCount);
+
+		std::vector<char> m_bytes;
+		std::vector<uint32_t> m_offsets; // Size() + 1 entries; string i spans [m_offsets[i], m_offsets[i + 1]).
+		std::vector<uint32_t> m_slots;   // Open-addressed id + 1, 0 when empty.
+	};
+
+	struct TransformData
+	{
+		float position[3] = { 0.0f, 0.0f, 0.0f };
+		float rotation[3] = { 0.0f, 0.0f, 0.0f };
+		float scale[3] = { 1.0f, 1.0f, 1.0f };
+	};
+
+	enum class PropertyType : uint8_t
+	{
+		Null,
+		Bool,
+		Number,
+		String,
+		NumberArray,
+		StringArray
+	};
+
+	/**
+	 * @brief One component or scene setting. Nested JSON objects are flattened into dotted names
+	 *        ("Properties.FOV"); array elements live in SceneDocument::PropertyData().
+	 */
+	struct PropertyRecord
+	{
+		uint32_t nameId = 0;
+		PropertyType type = PropertyType::Null;
+		uint8_t reserved[3] = {};
+		uint32_t count = 1;
+		uint32_t value = 0; // Bool: 0/1, Number: float bits, String: string id, arrays: first PropertyData() index.
+	};
+
+	struct ComponentRecord
+	{
+		uint32_t typeId = 0;
+		uint32_t firstProperty = 0;
+		uint32_t propertyCount = 0;
+		uint32_t reserved = 0;
+	};
+
+	struct EntityRecord
+	{
+		Guid guid;
+		uint32_t nameId = 0;
+		uint32_t tagId = 0;
+		uint32_t parent = 0xFFFFFFFFu;
+		uint32_t firstComponent = 0;
+		uint32_t componentCount = 0;
+		uint32_t reserved = 0;
+	};
+
+	/**
+	 * @brief Receives serialized scene bytes in order; returns false to abort the write.
+	 */
+	using SceneWriteSink = std::function<bool(const char* data, size_t size)>;
+
+	/**
+	 * @brief Editor-side scene data in flat tables: entity i owns Transforms()[i] and the
+	 *        component range it points into. Nothing is allocated per entity.
+	 */
+	class SceneDocument
+	{
+	public:
+		static constexpr uint32_t kNoParent = 0xFFFFFFFFu;
+
+		void Clear();
+		void Reserve(size_t entities);
+
+		StringPool& Strings() { return m_strings; }
+		const StringPool& Strings() const { return m_strings; }
+
+		std::vector<EntityRecord>& Entities() { return m_entities; }
+		const std::vector<EntityRecord>& Entities() const { return m_entities; }
+
+		std::vector<TransformData>& Transforms() { return m_transforms; }
+		const std::vector<TransformData>& Transforms() const { return m_transforms; }
+
+		std::vector<ComponentRecord>& Components() { return m_components; }
+		const std::vector<ComponentRecord>& Components() const { return m_components; }
+
+		std::vector<PropertyRecord>& Properties() { return m_properties; }
+		const std::vector<PropertyRecord>& Properties() const { return m_properties; }
+
+		/** @brief Project and scene settings that aren't entities ("ProjectName", "Scene.Environment.Skybox"). */
+		std::vector<PropertyRecord>& SceneProperties() { return m_sceneProperties; }
+		const std::vector<PropertyRecord>& SceneProperties() const { return m_sceneProperties; }
+
+		std::vector<uint32_t>& PropertyData() { return m_propertyData; }
+		const std::vector<uint32_t>& PropertyData() const { return m_propertyData; }
+
+		size_t EntityCount() const { return m_entities.size(); }
+		size_t ComponentCount() const { return m_components.size(); }
+
+		std::string_view EntityName(uint32_t entity) const { return m_strings.View(m_entities[entity].nameId); }
+
+		/** @brief Element of a Number or NumberArray property as a float. */
+		float PropertyNumber(const PropertyRecord& property, uint32_t element = 0) const;
+
+		/** @brief Linear search; callers that need many lookups should build their own map. */
+		uint32_t FindEntity(const Guid& guid) const;
+
+		size_t MemoryBytes() const;
+
+		static uint32_t FloatBits(float value)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return bits;
+		}
+
+		static float BitsToFloat(uint32_t bits)
+		{
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+	private:
+		StringPool m_strings;
+		std::vector<EntityRecord> m_entities;
+		std::vector<TransformData> m_transforms;
+		std::vector<ComponentRecord> m_components;
+		std::vector<PropertyRecord> m_properties;
+		std::vector<PropertyRecord> m_sceneProperties;
+		std::vector<uint32_t> m_propertyData;
+	};
+}
+
+#endif
\ No newline at end of file
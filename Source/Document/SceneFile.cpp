@@ -0,0 +1,123 @@
+#include "SceneFile.h"
+#include "OrcaSceneParser.h"
+#include "OrcaSceneWriter.h"
+#include "OrcaBinaryScene.h"
+#include "../Core/MemoryTracker.h"
+#include "../Core/Profiler.h"
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+
+namespace Orca
+{
+	bool MappedFile::Open(const QString& path, QString* error)
+	{
+		Close();
+
+		m_file.setFileName(path);
+		if (!m_file.open(QIODevice::ReadOnly))
+		{
+			if (error) *error = m_file.errorString();
+			return false;
+		}
+
+		m_size = static_cast<size_t>(m_file.size());
+		if (m_size == 0)
+		{
+			return true;
+		}
+
+		m_mapped = m_file.map(0, m_file.size());
+		if (m_mapped)
+		{
+			m_data = reinterpret_cast<const char*>(m_mapped);
+			return true;
+		}
+
+		// Some file systems (network shares, pipes) can't be mapped.
+		m_fallback = m_file.readAll();
+		if (static_cast<size_t>(m_fallback.size()) != m_size)
+		{
+			if (error) *error = m_file.errorString();
+			Close();
+			return false;
+		}
+		m_data = m_fallback.constData();
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_mapped)
+		{
+			m_file.unmap(m_mapped);
+			m_mapped = nullptr;
+		}
+		if (m_file.isOpen())
+		{
+			m_file.close();
+		}
+		m_fallback.clear();
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	bool LoadSceneFile(const QString& path, SceneDocument& document, QString* error)
+	{
+		ORCA_PROFILE_ZONE("LoadSceneFile");
+		MemoryTagScope memoryTag(MemoryTag::Scene);
+
+		MappedFile file;
+		QString openError;
+		if (!file.Open(path, &openError))
+		{
+			if (error) *error = QString("Couldn't open %1: %2").arg(path, openError);
+			return false;
+		}
+
+		std::string parseError;
+		if (IsOrcaBinaryScene(file.Data(), file.Size()))
+		{
+			if (!ReadOrcaBinaryScene(file.Data(), file.Size(), document, &parseError))
+			{
+				if (error) *error = QString("%1: %2").arg(QFileInfo(path).fileName(), QString::fromStdString(parseError));
+				return false;
+			}
+			return true;
+		}
+
+		if (!ParseOrcaScene(file.Data(), file.Size(), document, &parseError))
+		{
+			if (error) *error = QString("%1:%2").arg(QFileInfo(path).fileName(), QString::fromStdString(parseError));
+			return false;
+		}
+		return true;
+	}
+
+	bool SaveSceneFile(const QString& path, const SceneDocument& document, QString* error)
+	{
+		ORCA_PROFILE_ZONE("SaveSceneFile");
+		MemoryTagScope memoryTag(MemoryTag::Scene);
+
+		QSaveFile file(path);
+		if (!file.open(QIODevice::WriteOnly))
+		{
+			if (error) *error = file.errorString();
+			return false;
+		}
+
+		SceneWriteSink sink = [&file](const char* data, size_t size)
+		{
+			return file.write(data, static_cast<qint64>(size)) == static_cast<qint64>(size);
+		};
+
+		bool binary = path.endsWith(".orcab", Qt::CaseInsensitive);
+		bool written = binary ? WriteOrcaBinaryScene(document, sink) : WriteOrcaScene(document, sink);
+		if (!written || !file.commit())
+		{
+			if (error) *error = file.errorString();
+			file.cancelWriting();
+			return false;
+		}
+		return true;
+	}
+}
\ No newline at end of file
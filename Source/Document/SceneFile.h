@@ -0,0 +1,55 @@
+#pragma once
+
+#ifndef SCENE_FILE_H
+#define SCENE_FILE_H
+
+#include "SceneDocument.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+namespace Orca
+{
+	/**
+	 * @brief Read-only view of a whole file. Memory-mapped when the platform allows it,
+	 *        read into memory otherwise.
+	 */
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile() { Close(); }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const QString& path, QString* error = nullptr);
+		void Close();
+
+		const char* Data() const { return m_data; }
+		size_t Size() const { return m_size; }
+		bool IsMapped() const { return m_mapped != nullptr; }
+
+	private:
+		QFile m_file;
+		uchar* m_mapped = nullptr;
+		QByteArray m_fallback;
+		const char* m_data = nullptr;
+		size_t m_size = 0;
+	};
+
+	/**
+	 * @brief Loads a .orca or .orcab scene into the document, replacing its contents.
+	 *        The format is detected from the file contents, not the extension.
+	 * @param error Receives a readable reason (with line and column for syntax errors) on failure.
+	 */
+	bool LoadSceneFile(const QString& path, SceneDocument& document, QString* error = nullptr);
+
+	/**
+	 * @brief Writes the document as .orcab when the path ends in ".orcab", as .orca text otherwise.
+	 *        The file is replaced atomically; a failed save leaves the previous one intact.
+	 */
+	bool SaveSceneFile(const QString& path, const SceneDocument& document, QString* error = nullptr);
+}
+
+#endif
\ No newline at end of file
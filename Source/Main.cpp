@@ -1,42 +1,63 @@
 ﻿#include <QtWidgets/QApplication>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QFile>
+#include <QtCore/QStandardPaths>
 #include <QtWidgets/QMessageBox>
 #include "Core/EditorApp.h"
 #include "Panel/WelcomeScreen.h"
+#include "Core/EditorLog.h"
+#include "Core/EditorTheme.h"
+#include "Core/StartupTrace.h"
 #include <Core/Logger.h>
 #include <QtCore/QObject>
 
 int main(int argc, char* argv[])
 {
+	Orca::StartupTrace::Mark("main");
 	QCoreApplication::setAttribute(Qt::AA_UseDesktopOpenGL);
+	// Scene viewports share programs, meshes and textures, so their contexts share one group.
+	QCoreApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
 
 	QApplication app(argc, argv);
     app.setApplicationName("Orca(R) Studio");
     app.setOrganizationName("Orca");
-	app.setStyle("Fusion");
+	Orca::EditorTheme::Apply(app);
+
+	Orca::EditorLog::Initialize(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/Logs");
 
 	QString projectPath = "";
 
 	Orca::WelcomeScreen w_screen;
+	Orca::StartupTrace::MarkWhenPainted(&w_screen, "welcome visible");
 
 	QObject::connect(&w_screen, &Orca::WelcomeScreen::projectOpened,
 		[&projectPath](const QString& path) {projectPath = path; });
 
-    if(w_screen.exec() == QDialog::Accepted)
+    const int welcomeResult = w_screen.exec();
+    Orca::StartupTrace::Mark("welcome closed");
+
+    if(welcomeResult == QDialog::Accepted)
     {
         qDebug() << "Welcome Screen accepted. Opening project:" << projectPath;
 
         Orca::EditorApp editor;
+        Orca::StartupTrace::Mark("editor constructed");
+        Orca::StartupTrace::MarkWhenPainted(&editor, "editor visible");
         editor.show();
 
-        return app.exec();
+        if (!projectPath.isEmpty())
+        {
+            editor.OpenProject(projectPath);
+        }
+
+        int result = app.exec();
+        Orca::EditorLog::Shutdown();
+        return result;
     }
     else
     {
         qDebug() << "Welcome Screen cancelled. Exiting application.";
+        Orca::EditorLog::Shutdown();
         return 0;
     }
-
-	return app.exec();
 }
\ No newline at end of file
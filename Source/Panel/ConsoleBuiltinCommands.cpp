@@ -0,0 +1,366 @@
+#include "ConsoleBuiltinCommands.h"
+#include "ConsoleCommandRegistry.h"
+#include "ConsolePanel.h"
+#include "InspectorBenchmark.h"
+#include "SceneViewport.h"
+#include "../Core/EditorStats.h"
+#include "../Core/EditorTickScheduler.h"
+#include "../Core/MemoryTracker.h"
+#include "../Core/Profiler.h"
+#include "../Core/StartupTrace.h"
+#include "../Document/SceneBenchmarks.h"
+#include <QtCore/QLocale>
+#include <QtCore/QPointer>
+#include <algorithm>
+#include <numeric>
+
+namespace Orca::Editor
+{
+	namespace
+	{
+		QString Bytes(uint64_t bytes)
+		{
+			return QLocale::system().formattedDataSize(static_cast<qint64>(bytes));
+		}
+
+		void RunParseBenchmark(const QString& path, ConsoleCommandContext& context)
+		{
+			SceneParseBenchmarkResult result = BenchmarkSceneParse(path);
+			if (!result.orcaOk)
+			{
+				context.Error(result.orcaError);
+				return;
+			}
+
+			context.Print(QString("parse %1: %2, %3 entities, document %4")
+				.arg(path, Bytes(static_cast<uint64_t>(result.fileBytes))).arg(result.entities).arg(Bytes(result.documentBytes)));
+			context.Print(QString("  .orca reader  %1 ms (%2 MB/s)").arg(result.orcaMs, 0, 'f', 1)
+				.arg(SceneParseBenchmarkResult::MegabytesPerSecond(result.fileBytes, result.orcaMs), 0, 'f', 1));
+
+			if (result.qjsonOk)
+			{
+				context.Print(QString("  QJsonDocument %1 ms (%2 MB/s)").arg(result.qjsonMs, 0, 'f', 1)
+					.arg(SceneParseBenchmarkResult::MegabytesPerSecond(result.fileBytes, result.qjsonMs), 0, 'f', 1));
+			}
+			else
+			{
+				context.Warn(QString("  QJsonDocument failed: %1").arg(result.qjsonError));
+			}
+		}
+
+		void RunFormatBenchmark(const QString& path, ConsoleCommandContext& context)
+		{
+			SceneFormatBenchmarkResult result = BenchmarkSceneFormats(path);
+			if (!result.ok)
+			{
+				context.Error(result.error);
+				return;
+			}
+
+			context.Print(QString("formats %1: %2 entities").arg(path).arg(result.entities));
+			context.Print(QString("  .orca   %1  %2 ms").arg(Bytes(static_cast<uint64_t>(result.textBytes)), 10).arg(result.textMs, 0, 'f', 1));
+			context.Print(QString("  .orcab  %1  %2 ms (%3x faster, written to %4)").arg(Bytes(static_cast<uint64_t>(result.binaryBytes)), 10)
+				.arg(result.binaryMs, 0, 'f', 1).arg(result.binaryMs > 0.0 ? result.textMs / result.binaryMs : 0.0, 0, 'f', 1).arg(result.binaryPath));
+		}
+
+		void RunInspectorBenchmark(int rows, ConsoleCommandContext& context)
+		{
+			InspectorBenchmarkResult result = BenchmarkInspectorRows(rows);
+			context.Print(QString("inspector: %1 rows, %2 widgets").arg(result.rows).arg(result.widgets));
+			context.Print(QString("  theme        build %1 ms, repolish %2 ms").arg(result.themeBuildMs, 0, 'f', 1).arg(result.themeRepolishMs, 0, 'f', 1));
+			context.Print(QString("  style sheets build %1 ms, repolish %2 ms").arg(result.styleSheetBuildMs, 0, 'f', 1).arg(result.styleSheetRepolishMs, 0, 'f', 1));
+		}
+
+		// Steady-state frames must not touch the heap; transient work belongs in the frame arena.
+		// The camera pans so culling, light binning and shadow pages redo their work every frame.
+		void RunAllocationCheck(SceneViewport& viewport, int frames, ConsoleCommandContext& context)
+		{
+			// One full turn of the pan, so the measured frames revisit views the warm-up has seen.
+			constexpr int kWarmupFrames = SceneViewport::kBenchmarkPanFrames;
+
+			if (!ORCA_MEMORY_TRACKING) { context.Warn("Heap tracking is compiled out (ORCA_MEMORY_TRACKING=0)."); return; }
+			if (viewport.RenderBenchmarkFrames(kWarmupFrames, true).empty()) { context.Error("The viewport is not ready to render."); return; }
+			if (!viewport.Playing()) context.Print("allocs: not in play mode, so play step uploads are left out");
+
+			uint64_t total = 0;
+			uint64_t worst = 0;
+			int framesAllocating = 0;
+			for (int i = 0; i < frames; ++i)
+			{
+				viewport.RenderBenchmarkFrames(1, true);
+				const uint64_t allocations = viewport.LastFrameHeapAllocations();
+				total += allocations;
+				worst = std::max(worst, allocations);
+				if (allocations > 0) ++framesAllocating;
+			}
+
+			if (total == 0)
+			{
+				context.Print(QString("allocs: %1 panning frames after %2 warm-up frames, no renderer operator new on any thread").arg(frames).arg(kWarmupFrames));
+				return;
+			}
+			context.Error(QString("allocs: %1 of %2 frames allocated, %3 allocations in total, at most %4 in one frame")
+				.arg(framesAllocating).arg(frames).arg(total).arg(worst));
+		}
+
+		double Percentile(const std::vector<double>& sorted, double fraction)
+		{
+			if (sorted.empty()) return 0.0;
+			size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+			return sorted[std::min(index, sorted.size() - 1)];
+		}
+
+		void RegisterGeneralCommands(ConsoleCommandRegistry& registry)
+		{
+			registry.Register({ "help", "help [command]", "Lists commands, or shows usage for one.",
+				[&registry](const QStringList& args, ConsoleCommandContext& context)
+				{
+					if (!args.isEmpty())
+					{
+						const ConsoleCommand* command = registry.Find(args.front());
+						if (!command) { context.Error(QString("Unknown command: %1").arg(args.front())); return; }
+						context.Print(QString("%1 - %2").arg(command->usage, command->help));
+						return;
+					}
+					for (const ConsoleCommand* command : registry.Commands())
+					{
+						context.Print(QString("%1 - %2").arg(command->usage, -28).arg(command->help));
+					}
+				},
+				[&registry](const QStringList& args) { return args.size() == 1 ? registry.CompleteName(QString()) : QStringList(); } });
+
+			registry.Register({ "clear", "clear", "Hides everything logged so far (still searchable in the log file).",
+				[](const QStringList&, ConsoleCommandContext& context)
+				{
+					if (context.Panel()) context.Panel()->ClearView();
+					context.Print("Console cleared.");
+				} });
+
+			registry.Register({ "echo", "echo <text>", "Prints its arguments.",
+				[](const QStringList& args, ConsoleCommandContext& context) { context.Print(args.join(' ')); } });
+		}
+
+		void RegisterPerformanceCommands(ConsoleCommandRegistry& registry)
+		{
+			registry.Register({ "stats", "stats", "Frame/GPU time, draw calls and scene entity counts.",
+				[](const QStringList&, ConsoleCommandContext& context)
+				{
+					const EditorStats& stats = EditorStats::Get();
+					FrameStats frame = stats.Frame();
+					double fps = frame.frameIntervalMs > 0.0 ? 1000.0 / frame.frameIntervalMs : 0.0;
+
+					context.Print(QString("Frame %1: CPU %2 ms, GPU %3 ms, interval %4 ms (%5 fps)")
+						.arg(frame.frameIndex).arg(frame.cpuMs, 0, 'f', 2).arg(frame.gpuMs, 0, 'f', 2)
+						.arg(frame.frameIntervalMs, 0, 'f', 2).arg(fps, 0, 'f', 1));
+					context.Print(QString("Draw calls %1, triangles %2, heap allocations %3").arg(frame.drawCalls).arg(frame.triangles).arg(frame.heapAllocations));
+					context.Print(QString("Entities %1, components %2").arg(stats.EntityCount()).arg(stats.ComponentCount()));
+				} });
+
+			registry.Register({ "startup", "startup [trace <file>]", "Start-up timeline from process start to the first viewport frame.",
+				[](const QStringList& args, ConsoleCommandContext& context)
+				{
+					if (args.value(0) == "trace")
+					{
+						if (args.size() != 2) { context.Error("Usage: startup trace <file>"); return; }
+
+						QString error;
+						if (!StartupTrace::WriteChromeTrace(args[1], &error)) { context.Error(QString("Could not write the trace: %1").arg(error)); return; }
+						context.Print(QString("Wrote the start-up trace to %1").arg(args[1]));
+						return;
+					}
+
+					for (const QString& line : StartupTrace::Report()) context.Print(line);
+					if (!StartupTrace::IsFinished()) context.Print("The viewport has not drawn its first frame yet.");
+				},
+				[](const QStringList& args) { return args.size() == 1 ? QStringList{ "trace" } : QStringList(); } });
+
+			registry.Register({ "ticks", "ticks", "Editor tick rate and each panel's update cost against its budget.",
+				[](const QStringList&, ConsoleCommandContext& context)
+				{
+					const EditorTickScheduler& scheduler = EditorTickScheduler::Get();
+					context.Print(QString("Ticking at %1 Hz").arg(scheduler.CurrentHz()));
+
+					for (const TickClientStats& client : scheduler.Stats())
+					{
+						const QString line = QString("%1: %2 updates, %3 skipped, last %4 ms, worst %5 ms (budget %6 ms)")
+							.arg(client.name).arg(client.updates).arg(client.skipped).arg(client.lastMs, 0, 'f', 3)
+							.arg(client.worstMs, 0, 'f', 3).arg(client.budgetMs, 0, 'f', 1);
+						if (client.overruns > 0) context.Warn(line + QString(", %1 overruns").arg(client.overruns));
+						else context.Print(line);
+					}
+				} });
+
+			// The file can be given to either subcommand; "stop" falls back to the one from "start".
+			// The profiler records all the time, so a capture is just the window between the two.
+			static QString s_profilePath;
+			static qint64 s_profileStartNs = -1;
+			registry.Register({ "profile", "profile start|stop <file>", "Captures a Chrome trace of editor frames and commands.",
+				[](const QStringList& args, ConsoleCommandContext& context)
+				{
+					const QString action = args.value(0);
+
+					if (action == "start")
+					{
+						if (s_profileStartNs >= 0) { context.Error("A capture is already running."); return; }
+						s_profileStartNs = Profiler::NowNs();
+						s_profilePath = args.value(1);
+						context.Print("Profiling started.");
+					}
+					else if (action == "stop")
+					{
+						if (s_profileStartNs < 0) { context.Error("Profile capture failed: no capture is running"); return; }
+						QString path = args.value(1, s_profilePath);
+						if (path.isEmpty()) { context.Error("Usage: profile stop <file>"); return; }
+
+						const ProfileCapture capture = Profiler::Get().Capture(s_profileStartNs);
+						size_t zones = 0;
+						for (const ProfileThread& thread : capture.threads) zones += thread.zones.size();
+
+						QString error;
+						if (!capture.Save(path, &error)) { context.Error(QString("Profile capture failed: %1").arg(error)); return; }
+						s_profileStartNs = -1;
+						context.Print(QString("Wrote %1 zones over %2 frames to %3").arg(zones).arg(capture.frames.size()).arg(path));
+					}
+					else
+					{
+						context.Print(s_profileStartNs >= 0 ? QString("Capturing for %1 s").arg((Profiler::NowNs() - s_profileStartNs) / 1e9, 0, 'f', 1) : QString("Not capturing."));
+					}
+				},
+				[](const QStringList& args) { return args.size() == 1 ? QStringList{ "start", "stop" } : QStringList(); } });
+
+			registry.Register({ "genscene", "genscene <file> <objects>", "Writes a synthetic .orca scene for benchmarking.",
+				[](const QStringList& args, ConsoleCommandContext& context)
+				{
+					bool ok = false;
+					uint32_t objects = args.value(1).toUInt(&ok);
+					if (args.size() != 2 || !ok) { context.Error("Usage: genscene <file> <objects>"); return; }
+
+					QString error;
+					if (!WriteSyntheticScene(args.front(), objects, &error)) { context.Error(QString("genscene failed: %1").arg(error)); return; }
+					context.Print(QString("Wrote %1 objects to %2").arg(objects).arg(args.front()));
+				} });
+
+			registry.Register({ "mem", "mem", "Memory use per subsystem.",
+				[](const QStringList&, ConsoleCommandContext& context)
+				{
+					context.Print(QString("%1 %2 %3 %4").arg("Heap tag", -12).arg("Live", 12).arg("Peak", 12).arg("Allocations", 12));
+					for (int tag = 0; tag < static_cast<int>(MemoryTag::Count); ++tag)
+					{
+						const MemoryTagStats stats = MemoryTracker::Stats(static_cast<MemoryTag>(tag));
+						context.Print(QString("%1 %2 %3 %4").arg(MemoryTracker::TagName(static_cast<MemoryTag>(tag)), -12)
+							.arg(Bytes(stats.liveBytes), 12).arg(Bytes(stats.peakBytes), 12).arg(stats.allocations, 12));
+					}
+					context.Print(QString());
+
+					uint64_t tracked = 0;
+					for (const auto& entry : EditorStats::Get().MemoryReport())
+					{
+						context.Print(QString("%1 %2").arg(entry.first, -12).arg(Bytes(entry.second)));
+						tracked += entry.second;
+					}
+					context.Print(QString("%1 %2").arg("Tracked", -12).arg(Bytes(tracked)));
+					context.Print(QString("%1 %2").arg("Process RSS", -12).arg(Bytes(EditorStats::ProcessResidentBytes())));
+				} });
+
+			registry.Register({ "gc", "gc <cache>", "Releases unused entries from a cache (e.g. gc assets).",
+				[](const QStringList& args, ConsoleCommandContext& context)
+				{
+					const QStringList targets = EditorStats::Get().ReclaimerNames();
+					if (args.isEmpty())
+					{
+						context.Print(targets.isEmpty() ? QString("No caches registered.") : QString("Caches: %1").arg(targets.join(", ")));
+						return;
+					}
+
+					// Print only logs, so the result can be reported from whichever thread collected.
+					const QString name = args.front();
+					ConsoleCommandContext report = context;
+					const bool found = EditorStats::Get().Reclaim(name, [report, name](uint64_t freed) mutable
+					{
+						report.Print(QString("gc %1: released %2").arg(name, Bytes(freed)));
+					});
+					if (!found) context.Error(QString("No cache named '%1' is loaded.").arg(name));
+				},
+				[](const QStringList& args) { return args.size() == 1 ? EditorStats::Get().ReclaimerNames() : QStringList(); } });
+		}
+	}
+
+	void RegisterBuiltinCommands()
+	{
+		static bool s_registered = false;
+		if (s_registered) return;
+		s_registered = true;
+
+		ConsoleCommandRegistry& registry = ConsoleCommandRegistry::Get();
+		RegisterGeneralCommands(registry);
+		RegisterPerformanceCommands(registry);
+	}
+
+	void RegisterBenchCommand(Orca::SceneViewport* viewport)
+	{
+		QPointer<Orca::SceneViewport> target(viewport);
+
+		ConsoleCommandRegistry::Get().Unregister("bench");
+		ConsoleCommandRegistry::Get().Register({ "bench", "bench <scene> <frames> | bench parse|formats <file> | bench inspector [rows] | bench allocs [frames]",
+			"Frame time percentiles, scene parse throughput, .orca vs .orcab load time, inspector widget styling cost, or steady-state frame heap allocations.",
+			[target](const QStringList& args, ConsoleCommandContext& context)
+			{
+				if (args.value(0) == "parse")
+				{
+					if (args.size() != 2) { context.Error("Usage: bench parse <file>"); return; }
+					RunParseBenchmark(args[1], context);
+					return;
+				}
+				if (args.value(0) == "formats")
+				{
+					if (args.size() != 2) { context.Error("Usage: bench formats <file.orca>"); return; }
+					RunFormatBenchmark(args[1], context);
+					return;
+				}
+
+				if (args.value(0) == "inspector")
+				{
+					bool ok = true;
+					const int rows = args.size() > 1 ? args[1].toInt(&ok) : 500;
+					if (args.size() > 2 || !ok || rows <= 0) { context.Error("Usage: bench inspector [rows]"); return; }
+					RunInspectorBenchmark(rows, context);
+					return;
+				}
+
+				if (!target) { context.Error("No viewport to benchmark."); return; }
+
+				if (args.value(0) == "allocs")
+				{
+					bool ok = true;
+					const int frames = args.size() > 1 ? args[1].toInt(&ok) : 300;
+					if (args.size() > 2 || !ok || frames <= 0) { context.Error("Usage: bench allocs [frames]"); return; }
+					RunAllocationCheck(*target, frames, context);
+					return;
+				}
+
+				bool ok = false;
+				int frames = args.value(1).toInt(&ok);
+				if (args.size() != 2 || !ok || frames <= 0) { context.Error("Usage: bench <scene> <frames>"); return; }
+
+				if (args.front() != "current")
+				{
+					context.Error("Only the open scene can be benchmarked yet; use 'bench current <frames>'.");
+					return;
+				}
+
+				std::vector<double> times = target->RenderBenchmarkFrames(frames);
+				if (times.empty()) { context.Error("The viewport is not ready to render."); return; }
+
+				std::vector<double> sorted = times;
+				std::sort(sorted.begin(), sorted.end());
+				double mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+
+				context.Print(QString("bench %1: %2 frames, mean %3 ms (%4 fps), min %5, p50 %6, p95 %7, p99 %8, max %9 ms")
+					.arg(args.front()).arg(frames).arg(mean, 0, 'f', 3).arg(1000.0 / mean, 0, 'f', 1)
+					.arg(sorted.front(), 0, 'f', 3).arg(Percentile(sorted, 0.5), 0, 'f', 3)
+					.arg(Percentile(sorted, 0.95), 0, 'f', 3).arg(Percentile(sorted, 0.99), 0, 'f', 3)
+					.arg(sorted.back(), 0, 'f', 3));
+			},
+			[](const QStringList& args) { return args.size() == 1 ? QStringList{ "current", "parse", "formats", "inspector", "allocs" } : QStringList(); } });
+	}
+}
\ No newline at end of file
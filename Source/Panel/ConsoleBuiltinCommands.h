@@ -0,0 +1,22 @@
+#pragma once
+
+#ifndef CONSOLE_BUILTIN_COMMANDS_H
+#define CONSOLE_BUILTIN_COMMANDS_H
+
+namespace Orca { class SceneViewport; }
+
+namespace Orca::Editor
+{
+	/**
+	 * @brief Registers help, clear, echo and the performance commands (stats, startup, ticks, profile, genscene, mem, gc).
+	 *        Safe to call more than once.
+	 */
+	void RegisterBuiltinCommands();
+
+	/**
+	 * @brief Registers "bench", which drives frames on the given viewport.
+	 */
+	void RegisterBenchCommand(Orca::SceneViewport* viewport);
+}
+
+#endif
\ No newline at end of file
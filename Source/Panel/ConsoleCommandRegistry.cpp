@@ -0,0 +1,201 @@
+#include "ConsoleCommandRegistry.h"
+#include "../Core/EditorLog.h"
+#include <algorithm>
+
+namespace Orca::Editor
+{
+	namespace
+	{
+		QString CommonPrefix(const QStringList& words)
+		{
+			if (words.isEmpty()) return QString();
+
+			QString prefix = words.front();
+			for (const QString& word : words)
+			{
+				int length = 0;
+				while (length < prefix.size() && length < word.size() && prefix[length] == word[length]) ++length;
+				prefix.truncate(length);
+			}
+			return prefix;
+		}
+	}
+
+	// --- ConsoleCommandContext ---
+
+	void ConsoleCommandContext::Print(const QString& text)
+	{
+		ORCA_LOG_INFO("Console", "{}", text);
+	}
+
+	void ConsoleCommandContext::Warn(const QString& text)
+	{
+		ORCA_LOG_WARNING("Console", "{}", text);
+	}
+
+	void ConsoleCommandContext::Error(const QString& text)
+	{
+		ORCA_LOG_ERROR("Console", "{}", text);
+	}
+
+	// --- ConsoleCommandRegistry ---
+
+	ConsoleCommandRegistry& ConsoleCommandRegistry::Get()
+	{
+		static ConsoleCommandRegistry s_registry;
+		return s_registry;
+	}
+
+	bool ConsoleCommandRegistry::Register(ConsoleCommand command)
+	{
+		if (command.name.isEmpty() || !command.execute || m_commands.contains(command.name))
+		{
+			return false;
+		}
+
+		TrieNode* node = &m_root;
+		for (QChar c : command.name)
+		{
+			std::unique_ptr<TrieNode>& child = node->children[c];
+			if (!child) child = std::make_unique<TrieNode>();
+			node = child.get();
+		}
+		node->terminal = true;
+
+		m_commands.insert(command.name, std::move(command));
+		return true;
+	}
+
+	void ConsoleCommandRegistry::Unregister(const QString& name)
+	{
+		if (!m_commands.remove(name)) return;
+
+		TrieNode* node = &m_root;
+		for (QChar c : name)
+		{
+			auto it = node->children.find(c);
+			if (it == node->children.end()) return;
+			node = it->second.get();
+		}
+		node->terminal = false;
+	}
+
+	const ConsoleCommand* ConsoleCommandRegistry::Find(const QString& name) const
+	{
+		auto it = m_commands.constFind(name);
+		return it != m_commands.constEnd() ? &it.value() : nullptr;
+	}
+
+	QList<const ConsoleCommand*> ConsoleCommandRegistry::Commands() const
+	{
+		QList<const ConsoleCommand*> commands;
+		for (const QString& name : CompleteName(QString()))
+		{
+			commands.append(Find(name));
+		}
+		return commands;
+	}
+
+	bool ConsoleCommandRegistry::Execute(const QString& line, ConsoleCommandContext& context) const
+	{
+		QStringList tokens = Tokenize(line);
+		if (tokens.isEmpty()) return true;
+
+		const ConsoleCommand* command = Find(tokens.takeFirst());
+		if (!command) return false;
+
+		command->execute(tokens, context);
+		return true;
+	}
+
+	QStringList ConsoleCommandRegistry::CompleteName(const QString& prefix) const
+	{
+		const TrieNode* node = &m_root;
+		for (QChar c : prefix)
+		{
+			auto it = node->children.find(c);
+			if (it == node->children.end()) return QStringList();
+			node = it->second.get();
+		}
+
+		QStringList names;
+		QString path = prefix;
+		CollectNames(*node, path, names);
+		return names;
+	}
+
+	void ConsoleCommandRegistry::CollectNames(const TrieNode& node, QString& prefix, QStringList& out) const
+	{
+		if (node.terminal) out.append(prefix);
+
+		// std::map keeps children ordered, so names come out sorted.
+		for (const auto& [c, child] : node.children)
+		{
+			prefix.append(c);
+			CollectNames(*child, prefix, out);
+			prefix.chop(1);
+		}
+	}
+
+	QString ConsoleCommandRegistry::CompleteLine(const QString& line, QStringList* candidates) const
+	{
+		QStringList tokens = Tokenize(line);
+		const bool startsNewWord = line.isEmpty() || line.back().isSpace();
+		if (startsNewWord) tokens.append(QString());
+
+		QStringList matches;
+		if (tokens.size() == 1)
+		{
+			matches = CompleteName(tokens.front());
+		}
+		else if (const ConsoleCommand* command = Find(tokens.front()))
+		{
+			if (command->complete)
+			{
+				const QString partial = tokens.back();
+				for (const QString& option : command->complete(tokens.mid(1)))
+				{
+					if (option.startsWith(partial)) matches.append(option);
+				}
+			}
+		}
+
+		if (matches.isEmpty()) return line;
+
+		if (candidates && matches.size() > 1) *candidates = matches;
+
+		tokens.back() = matches.size() == 1 ? matches.front() + ' ' : CommonPrefix(matches);
+		QString completed = tokens.join(' ');
+		return completed.size() >= line.size() ? completed : line;
+	}
+
+	QStringList ConsoleCommandRegistry::Tokenize(const QString& line)
+	{
+		QStringList tokens;
+		QString current;
+		bool quoted = false;
+		bool inToken = false;
+
+		for (QChar c : line)
+		{
+			if (c == '"')
+			{
+				quoted = !quoted;
+				inToken = true;
+			}
+			else if (c.isSpace() && !quoted)
+			{
+				if (inToken) tokens.append(current);
+				current.clear();
+				inToken = false;
+			}
+			else
+			{
+				current.append(c);
+				inToken = true;
+			}
+		}
+		if (inToken) tokens.append(current);
+		return tokens;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#ifndef CONSOLE_COMMAND_REGISTRY_H
+#define CONSOLE_COMMAND_REGISTRY_H
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <functional>
+#include <map>
+#include <memory>
+
+namespace Orca::Editor
+{
+	class ConsolePanel;
+
+	/**
+	 * @brief What a running command can talk to: output lines and the console it was typed into.
+	 */
+	class ConsoleCommandContext
+	{
+	public:
+		explicit ConsoleCommandContext(ConsolePanel* panel) : m_panel(panel) {}
+
+		void Print(const QString& text);
+		void Warn(const QString& text);
+		void Error(const QString& text);
+
+		ConsolePanel* Panel() const { return m_panel; }
+
+	private:
+		ConsolePanel* m_panel;
+	};
+
+	struct ConsoleCommand
+	{
+		QString name;
+		QString usage;   // e.g. "profile start|stop <file>"
+		QString help;
+
+		std::function<void(const QStringList& args, ConsoleCommandContext& context)> execute;
+
+		/**
+		 * @brief Optional. Given the arguments typed so far (the last one possibly partial),
+		 *        returns candidates for the last argument.
+		 */
+		std::function<QStringList(const QStringList& args)> complete;
+	};
+
+	/**
+	 * @brief Console commands, registered by whichever subsystem owns them.
+	 *
+	 * Names are kept in a prefix trie so Tab completion does not scan every command.
+	 */
+	class ConsoleCommandRegistry
+	{
+	public:
+		static ConsoleCommandRegistry& Get();
+
+		/**
+		 * @brief Adds a command. Returns false if the name is already taken.
+		 */
+		bool Register(ConsoleCommand command);
+		void Unregister(const QString& name);
+
+		const ConsoleCommand* Find(const QString& name) const;
+		QList<const ConsoleCommand*> Commands() const;
+
+		/**
+		 * @brief Parses and runs one input line. Returns false if the command is unknown.
+		 */
+		bool Execute(const QString& line, ConsoleCommandContext& context) const;
+
+		/**
+		 * @brief Command names starting with prefix, sorted.
+		 */
+		QStringList CompleteName(const QString& prefix) const;
+
+		/**
+		 * @brief Completes the last word of line as far as it is unambiguous.
+		 * @param candidates Receives every candidate when the completion is ambiguous.
+		 */
+		QString CompleteLine(const QString& line, QStringList* candidates = nullptr) const;
+
+		static QStringList Tokenize(const QString& line);
+
+	private:
+		ConsoleCommandRegistry() = default;
+
+		struct TrieNode
+		{
+			std::map<QChar, std::unique_ptr<TrieNode>> children;
+			bool terminal = false;
+		};
+
+		void CollectNames(const TrieNode& node, QString& prefix, QStringList& out) const;
+
+	private:
+		TrieNode m_root;
+		QHash<QString, ConsoleCommand> m_commands;
+	};
+}
+
+#endif
\ No newline at end of file
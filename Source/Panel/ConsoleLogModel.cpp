@@ -0,0 +1,206 @@
+#include "ConsoleLogModel.h"
+#include "../Core/EditorTheme.h"
+#include "../Core/LogStore.h"
+#include <QtCore/QDateTime>
+#include <QtGui/QColor>
+#include <algorithm>
+
+namespace Orca::Editor
+{
+	ConsoleLogModel::ConsoleLogModel(QObject* parent)
+		: QAbstractListModel(parent)
+	{
+	}
+
+	int ConsoleLogModel::rowCount(const QModelIndex& parent) const
+	{
+		if (parent.isValid()) return 0;
+		return static_cast<int>(m_collapsed ? m_groups.size() : m_rows.size());
+	}
+
+	QVariant ConsoleLogModel::data(const QModelIndex& index, int role) const
+	{
+		if (!index.isValid() || index.row() >= rowCount()) return QVariant();
+
+		if (m_collapsed)
+		{
+			const CollapsedRow& group = m_groups[static_cast<size_t>(index.row())];
+			return LineData(group.lastSequence, role, &group);
+		}
+		return LineData(m_rows[static_cast<size_t>(index.row())], role, nullptr);
+	}
+
+	QVariant ConsoleLogModel::LineData(quint64 sequence, int role, const CollapsedRow* group) const
+	{
+		const LogStore& store = LogStore::Get();
+
+		std::shared_ptr<LogChunk> chunk = store.ChunkFor(sequence);
+		const LogRecord* record = store.Record(chunk, sequence);
+		if (!record) return QVariant();
+
+		auto timeOf = [](qint64 unixNs) { return QDateTime::fromMSecsSinceEpoch(unixNs / 1000000).toString("hh:mm:ss"); };
+
+		switch (role)
+		{
+		case Qt::DisplayRole:
+		{
+			QString prefix = QString("[%1]").arg(timeOf(record->unixNs));
+			if (group && group->count > 1)
+			{
+				prefix = QString("[%1 - %2] x%3").arg(timeOf(group->firstUnixNs), timeOf(group->lastUnixNs)).arg(group->count);
+			}
+			return QString("%1 <%2> %3: %4").arg(prefix, LogSeverityName(record->severity),
+				store.CategoryName(record->categoryId), record->text);
+		}
+		case Qt::ToolTipRole:
+			if (!group) return QVariant();
+			return QString("%1 occurrences\nFirst: %2\nLast: %3").arg(group->count)
+				.arg(QDateTime::fromMSecsSinceEpoch(group->firstUnixNs / 1000000).toString(Qt::ISODateWithMs),
+					QDateTime::fromMSecsSinceEpoch(group->lastUnixNs / 1000000).toString(Qt::ISODateWithMs));
+		case Qt::ForegroundRole:
+			switch (record->severity)
+			{
+			case LogSeverity::Trace:
+			case LogSeverity::Debug: return EditorTheme::Color(ThemeRole::MutedText);
+			case LogSeverity::Warning: return EditorTheme::Color(ThemeRole::Warning);
+			case LogSeverity::Error:
+			case LogSeverity::Fatal: return EditorTheme::Color(ThemeRole::Error);
+			default: return QVariant();
+			}
+		case Qt::UserRole:
+			return sequence;
+		default:
+			return QVariant();
+		}
+	}
+
+	void ConsoleLogModel::onMatchesFound(quint64 generation, const QVector<quint64>& sequences, bool reset)
+	{
+		if (generation != m_generation) return;
+
+		if (reset)
+		{
+			beginResetModel();
+			m_rows.clear();
+			m_groups.clear();
+			m_groupIndex.clear();
+			m_lineCount = 0;
+			endResetModel();
+		}
+
+		if (sequences.isEmpty()) return;
+		m_lineCount += static_cast<quint64>(sequences.size());
+
+		if (m_collapsed)
+		{
+			AppendCollapsed(sequences);
+			return;
+		}
+
+		int first = static_cast<int>(m_rows.size());
+		beginInsertRows(QModelIndex(), first, first + static_cast<int>(sequences.size()) - 1);
+		m_rows.insert(m_rows.end(), sequences.begin(), sequences.end());
+		endInsertRows();
+	}
+
+	void ConsoleLogModel::AppendCollapsed(const QVector<quint64>& sequences)
+	{
+		const LogStore& store = LogStore::Get();
+		const int existingRows = static_cast<int>(m_groups.size());
+		int firstChanged = existingRows;
+		int lastChanged = -1;
+
+		std::vector<CollapsedRow> added;
+		std::shared_ptr<LogChunk> chunk;
+
+		for (quint64 sequence : sequences)
+		{
+			if (!chunk || sequence - chunk->firstSequence >= LogChunk::kLines)
+			{
+				chunk = store.ChunkFor(sequence);
+			}
+			const LogRecord* record = store.Record(chunk, sequence);
+			if (!record) continue;
+
+			auto it = m_groupIndex.constFind(record->templateHash);
+			if (it != m_groupIndex.constEnd())
+			{
+				int row = it.value();
+				CollapsedRow& group = row < existingRows ? m_groups[static_cast<size_t>(row)] : added[static_cast<size_t>(row - existingRows)];
+				group.lastSequence = sequence;
+				group.lastUnixNs = record->unixNs;
+				++group.count;
+
+				if (row < existingRows)
+				{
+					firstChanged = std::min(firstChanged, row);
+					lastChanged = std::max(lastChanged, row);
+				}
+				continue;
+			}
+
+			m_groupIndex.insert(record->templateHash, existingRows + static_cast<int>(added.size()));
+			added.push_back({ record->templateHash, sequence, 1, record->unixNs, record->unixNs });
+		}
+
+		// Repeats of known messages never insert rows, they only repaint the counters.
+		if (lastChanged >= firstChanged)
+		{
+			emit dataChanged(index(firstChanged), index(lastChanged), { Qt::DisplayRole, Qt::ToolTipRole });
+		}
+
+		if (!added.empty())
+		{
+			beginInsertRows(QModelIndex(), existingRows, existingRows + static_cast<int>(added.size()) - 1);
+			m_groups.insert(m_groups.end(), added.begin(), added.end());
+			endInsertRows();
+		}
+	}
+
+	void ConsoleLogModel::onLinesEvicted(quint64 firstRetained)
+	{
+		if (!m_collapsed)
+		{
+			auto it = std::lower_bound(m_rows.begin(), m_rows.end(), firstRetained);
+			int count = static_cast<int>(it - m_rows.begin());
+			if (count == 0) return;
+
+			beginRemoveRows(QModelIndex(), 0, count - 1);
+			m_rows.erase(m_rows.begin(), it);
+			m_lineCount -= static_cast<quint64>(count);
+			endRemoveRows();
+			return;
+		}
+
+		// Groups whose latest line is gone have nothing left to show. Remove them in
+		// contiguous runs from the back so the remaining row numbers stay valid.
+		bool removedAny = false;
+		for (int row = static_cast<int>(m_groups.size()) - 1; row >= 0; --row)
+		{
+			if (m_groups[static_cast<size_t>(row)].lastSequence >= firstRetained) continue;
+
+			int runEnd = row;
+			while (row > 0 && m_groups[static_cast<size_t>(row - 1)].lastSequence < firstRetained) --row;
+
+			beginRemoveRows(QModelIndex(), row, runEnd);
+			for (int i = row; i <= runEnd; ++i) m_lineCount -= m_groups[static_cast<size_t>(i)].count;
+			m_groups.erase(m_groups.begin() + row, m_groups.begin() + runEnd + 1);
+			endRemoveRows();
+			removedAny = true;
+		}
+
+		if (removedAny)
+		{
+			RebuildGroupIndex();
+		}
+	}
+
+	void ConsoleLogModel::RebuildGroupIndex()
+	{
+		m_groupIndex.clear();
+		for (int row = 0; row < static_cast<int>(m_groups.size()); ++row)
+		{
+			m_groupIndex.insert(m_groups[static_cast<size_t>(row)].templateHash, row);
+		}
+	}
+}
\ No newline at end of file
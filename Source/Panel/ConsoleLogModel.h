@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef CONSOLE_LOG_MODEL_H
+#define CONSOLE_LOG_MODEL_H
+
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+#include <vector>
+
+namespace Orca::Editor
+{
+	/**
+	 * @brief List model over the log lines currently matching the console's query.
+	 *
+	 * Rows are only sequence numbers into the LogStore; text is pulled from the
+	 * store when a row is actually painted. In collapsed mode each row is one
+	 * distinct message template, and repeats only bump its counter in place.
+	 */
+	class ConsoleLogModel : public QAbstractListModel
+	{
+		Q_OBJECT
+	public:
+		explicit ConsoleLogModel(QObject* parent = nullptr);
+
+		int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+		QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+		/**
+		 * @brief Only results tagged with this generation are accepted from now on.
+		 */
+		void SetGeneration(quint64 generation) { m_generation = generation; }
+
+		/**
+		 * @brief Switches between one row per line and one row per unique message.
+		 *        Takes effect with the next reset, so callers re-submit their query.
+		 */
+		void SetCollapsed(bool collapsed) { m_collapsed = collapsed; }
+		bool IsCollapsed() const { return m_collapsed; }
+
+		/** Total lines represented, which differs from rowCount() when collapsed. */
+		quint64 LineCount() const { return m_lineCount; }
+
+	public slots:
+		void onMatchesFound(quint64 generation, const QVector<quint64>& sequences, bool reset);
+		void onLinesEvicted(quint64 firstRetained);
+
+	private:
+		struct CollapsedRow
+		{
+			quint64 templateHash = 0;
+			quint64 lastSequence = 0;
+			quint32 count = 0;
+			qint64 firstUnixNs = 0;
+			qint64 lastUnixNs = 0;
+		};
+
+		void AppendCollapsed(const QVector<quint64>& sequences);
+		void RebuildGroupIndex();
+		QVariant LineData(quint64 sequence, int role, const CollapsedRow* group) const;
+
+	private:
+		std::vector<quint64> m_rows;
+		std::vector<CollapsedRow> m_groups;
+		QHash<quint64, int> m_groupIndex;
+
+		quint64 m_generation = 0;
+		quint64 m_lineCount = 0;
+		bool m_collapsed = false;
+	};
+}
+
+#endif
\ No newline at end of file
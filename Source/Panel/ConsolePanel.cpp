@@ -1,63 +1,279 @@
 #include "ConsolePanel.h"
+#include "ConsoleLogModel.h"
+#include "ConsoleCommandRegistry.h"
+#include "ConsoleBuiltinCommands.h"
+#include "../Core/EditorLog.h"
+#include "../Core/EditorTheme.h"
+#include "../Core/Profiler.h"
+#include <QtGui/QKeyEvent>
 #include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QHBoxLayout>
 #include <QtWidgets/QScrollBar>
-#include <QtCore/QDateTime>
+#include <QtWidgets/QMenu>
 #include <QtCore/QDebug>
 
 namespace Orca::Editor
 {
+	namespace
+	{
+		struct SeverityToggle
+		{
+			const char* label;
+			uint32_t mask;
+		};
+
+		// Trace is folded into Debug and Fatal into Error; four toggles cover every severity.
+		const SeverityToggle kSeverityToggles[] =
+		{
+			{ "Debug", (1u << static_cast<int>(LogSeverity::Trace)) | (1u << static_cast<int>(LogSeverity::Debug)) },
+			{ "Info", 1u << static_cast<int>(LogSeverity::Info) },
+			{ "Warnings", 1u << static_cast<int>(LogSeverity::Warning) },
+			{ "Errors", (1u << static_cast<int>(LogSeverity::Error)) | (1u << static_cast<int>(LogSeverity::Fatal)) },
+		};
+	}
+
 	ConsolePanel::ConsolePanel(QWidget* parent)
-		: Panel(parent)
+		: Panel("Console", parent), m_model(new ConsoleLogModel(this))
 	{
 		setWindowTitle("Console");
 
-		m_logOutput = new QTextEdit();
-		m_logOutput->setReadOnly(true);	
-		m_logOutput->document()->setMaximumBlockCount(10000);
+		m_logOutput = new QListView();
+		m_logOutput->setModel(m_model);
+		m_logOutput->setUniformItemSizes(true);
+		m_logOutput->setSelectionMode(QAbstractItemView::ExtendedSelection);
+		m_logOutput->setEditTriggers(QAbstractItemView::NoEditTriggers);
 
 		m_commandInput = new QLineEdit();
 		m_commandInput->setPlaceholderText("Enter a command...");
 
 		QVBoxLayout* layout = new QVBoxLayout(this);
 		layout->setContentsMargins(5, 5, 5, 5);
+		layout->addWidget(CreateFilterBar());
 		layout->addWidget(m_logOutput);
 		layout->addWidget(m_commandInput);
 		setLayout(layout);
 
 		connect(m_commandInput, &QLineEdit::returnPressed,
 				this, &ConsolePanel::handleCommandInput);
+
+		// Tab would otherwise move focus away; it completes commands instead.
+		m_commandInput->installEventFilter(this);
+		RegisterBuiltinCommands();
+
+		// Stay pinned to the newest line unless the user scrolled away from it.
+		connect(m_logOutput->verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int value)
+		{
+			m_followTail = value >= m_logOutput->verticalScrollBar()->maximum();
+		});
+		connect(m_model, &QAbstractItemModel::rowsInserted, this, [this]()
+		{
+			if (m_followTail) m_logOutput->scrollToBottom();
+		});
+
+		m_searchWorker = std::make_unique<Orca::LogSearchWorker>(LogStore::Get());
+		connect(m_searchWorker.get(), &Orca::LogSearchWorker::matchesFound, m_model, &ConsoleLogModel::onMatchesFound);
+		connect(m_searchWorker.get(), &Orca::LogSearchWorker::linesEvicted, m_model, &ConsoleLogModel::onLinesEvicted);
+		connect(m_searchWorker.get(), &Orca::LogSearchWorker::scanFinished, this, &ConsolePanel::onScanFinished);
+		m_searchWorker->Start();
+
+		m_searchDebounce.setSingleShot(true);
+		m_searchDebounce.setInterval(150);
+		connect(&m_searchDebounce, &QTimer::timeout, this, &ConsolePanel::submitQuery);
+
+		submitQuery();
+	}
+
+	ConsolePanel::~ConsolePanel()
+	{
+		// Stop the worker before the model it feeds goes away.
+		m_searchWorker.reset();
+	}
+
+	QWidget* ConsolePanel::CreateFilterBar()
+	{
+		QWidget* bar = new QWidget(this);
+		QHBoxLayout* barLayout = new QHBoxLayout(bar);
+		barLayout->setContentsMargins(0, 0, 0, 0);
+		barLayout->setSpacing(4);
+
+		for (int i = 0; i < 4; ++i)
+		{
+			QToolButton* toggle = new QToolButton(bar);
+			toggle->setText(kSeverityToggles[i].label);
+			toggle->setCheckable(true);
+			toggle->setChecked(true);
+			connect(toggle, &QToolButton::toggled, this, &ConsolePanel::submitQuery);
+			barLayout->addWidget(toggle);
+			m_severityButtons[i] = toggle;
+		}
+
+		m_categoryButton = new QToolButton(bar);
+		m_categoryButton->setText("Categories");
+		m_categoryButton->setPopupMode(QToolButton::InstantPopup);
+		QMenu* categoryMenu = new QMenu(m_categoryButton);
+		connect(categoryMenu, &QMenu::aboutToShow, this, &ConsolePanel::PopulateCategoryMenu);
+		m_categoryButton->setMenu(categoryMenu);
+		barLayout->addWidget(m_categoryButton);
+
+		m_searchInput = new QLineEdit(bar);
+		m_searchInput->setPlaceholderText("Search log...");
+		m_searchInput->setClearButtonEnabled(true);
+		connect(m_searchInput, &QLineEdit::textChanged, this, [this]() { m_searchDebounce.start(); });
+		barLayout->addWidget(m_searchInput, 1);
+
+		m_regexToggle = new QCheckBox("Regex", bar);
+		connect(m_regexToggle, &QCheckBox::toggled, this, &ConsolePanel::submitQuery);
+		barLayout->addWidget(m_regexToggle);
+
+		m_caseToggle = new QCheckBox("Aa", bar);
+		m_caseToggle->setToolTip("Match case");
+		connect(m_caseToggle, &QCheckBox::toggled, this, &ConsolePanel::submitQuery);
+		barLayout->addWidget(m_caseToggle);
+
+		m_collapseToggle = new QCheckBox("Collapse", bar);
+		m_collapseToggle->setToolTip("Show repeated messages once, with a counter");
+		connect(m_collapseToggle, &QCheckBox::toggled, this, [this](bool collapsed)
+		{
+			m_model->SetCollapsed(collapsed);
+			submitQuery();
+		});
+		barLayout->addWidget(m_collapseToggle);
+
+		m_statusLabel = new QLabel(bar);
+		m_statusLabel->setMinimumWidth(110);
+		barLayout->addWidget(m_statusLabel);
+
+		return bar;
 	}
 
-	void ConsolePanel::logMessage(const QString& message, const QString& type = "LOG")
+	void ConsolePanel::PopulateCategoryMenu()
 	{
-		QString timestamp = QDateTime::currentDateTime().toString("hh:mm:ss");
-		QString formattedMessage = QString("[%1] <%2>: %3").arg(timestamp, type, message);
+		QMenu* menu = m_categoryButton->menu();
+		menu->clear();
 
-		m_logOutput->append(formattedMessage);
-		m_logOutput->verticalScrollBar()->setValue(m_logOutput->verticalScrollBar()->maximum());
+		for (const QString& category : LogStore::Get().CategoryNames())
+		{
+			QAction* action = menu->addAction(category);
+			action->setCheckable(true);
+			action->setChecked(!m_hiddenCategories.contains(category));
+			connect(action, &QAction::toggled, this, [this, category](bool visible)
+			{
+				if (visible) m_hiddenCategories.remove(category);
+				else m_hiddenCategories.insert(category);
+				submitQuery();
+			});
+		}
 	}
 
-	void ConsolePanel::handleCommandInput()
+	void ConsolePanel::submitQuery()
 	{
-		QString command = m_commandInput->text().trimmed();
-		if (command.isEmpty()) return;
+		Orca::LogQuery query;
+		query.text = m_searchInput->text();
+		query.regex = m_regexToggle->isChecked();
+		query.caseSensitive = m_caseToggle->isChecked();
+		query.fromSequence = m_clearedBefore;
 
-		logMessage(command, "COMMAND");
+		query.severityMask = 0;
+		for (int i = 0; i < 4; ++i)
+		{
+			if (m_severityButtons[i]->isChecked()) query.severityMask |= kSeverityToggles[i].mask;
+		}
 
-		if (command == "clear") 
+		QStringList categories = LogStore::Get().CategoryNames();
+		for (int id = 0; id < categories.size() && id < static_cast<int>(query.hiddenCategories.size()); ++id)
 		{
-			m_logOutput->clear();
-			logMessage("Console cleared.", "SYSTEM");
+			if (m_hiddenCategories.contains(categories[id])) query.hiddenCategories.set(static_cast<size_t>(id));
 		}
-		else if (command.startsWith("echo ")) 
+
+		if (query.regex && !QRegularExpression(query.text).isValid())
+		{
+			m_statusLabel->setText("Invalid regex");
+			EditorTheme::SetTextRole(m_statusLabel, ThemeRole::Error);
+			return;
+		}
+
+		m_followTail = true;
+		m_model->SetGeneration(m_searchWorker->SetQuery(query));
+		m_statusLabel->setText("Searching...");
+		EditorTheme::SetTextRole(m_statusLabel, ThemeRole::Text);
+	}
+
+	void ConsolePanel::onScanFinished(quint64 /*generation*/)
+	{
+		if (m_model->IsCollapsed())
+		{
+			m_statusLabel->setText(QString("%1 unique / %2").arg(m_model->rowCount()).arg(m_model->LineCount()));
+		}
+		else
+		{
+			m_statusLabel->setText(QString("%1 lines").arg(m_model->LineCount()));
+		}
+	}
+
+	void ConsolePanel::logMessage(const QString& message, const QString& type)
+	{
+		if (type == "ERROR")
+		{
+			ORCA_LOG_ERROR("Console", "{}", message);
+		}
+		else if (type == "WARNING")
+		{
+			ORCA_LOG_WARNING("Console", "{}", message);
+		}
+		else if (type == "COMMAND")
+		{
+			ORCA_LOG_INFO("Command", "> {}", message);
+		}
+		else
 		{
-			logMessage(command.mid(5).trimmed(), "SYSTEM");
+			ORCA_LOG_INFO("Console", "{}", message);
 		}
-		else 
+	}
+
+	void ConsolePanel::handleCommandInput()
+	{
+		QString command = m_commandInput->text().trimmed();
+		if (command.isEmpty()) return;
+
+		logMessage(command, "COMMAND");
+
+		ConsoleCommandContext context(this);
 		{
-			logMessage(QString("Unknown command: %1").arg(command), "ERROR");
+			ORCA_PROFILE_ZONE("Console::Command");
+			if (!ConsoleCommandRegistry::Get().Execute(command, context))
+			{
+				logMessage(QString("Unknown command: %1 (try 'help')").arg(ConsoleCommandRegistry::Tokenize(command).value(0)), "ERROR");
+			}
 		}
 
 		m_commandInput->clear();
 	}
+
+	void ConsolePanel::ClearView()
+	{
+		// The retained log is kept for search; clearing only hides what came before.
+		m_clearedBefore = LogStore::Get().Appended();
+		submitQuery();
+	}
+
+	bool ConsolePanel::eventFilter(QObject* watched, QEvent* event)
+	{
+		if (watched == m_commandInput && event->type() == QEvent::KeyPress)
+		{
+			QKeyEvent* keyEvent = static_cast<QKeyEvent*>(event);
+			if (keyEvent->key() == Qt::Key_Tab)
+			{
+				QStringList candidates;
+				QString completed = ConsoleCommandRegistry::Get().CompleteLine(m_commandInput->text(), &candidates);
+				m_commandInput->setText(completed);
+
+				if (candidates.size() > 1)
+				{
+					logMessage(candidates.join("  "), "SYSTEM");
+				}
+				return true;
+			}
+		}
+		return Panel::eventFilter(watched, event);
+	}
 }
\ No newline at end of file
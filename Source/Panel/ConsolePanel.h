@@ -4,24 +4,43 @@
 #define CONSOLE_PANEL_H
 
 #include "Panel.h"
-#include <QtWidgets/QTextEdit>
+#include "../Core/LogSearchWorker.h"
+#include <QtWidgets/QListView>
 #include <QtWidgets/QLineEdit>
+#include <QtWidgets/QCheckBox>
+#include <QtWidgets/QToolButton>
+#include <QtWidgets/QLabel>
+#include <QtCore/QTimer>
+#include <QtCore/QSet>
+#include <memory>
 
 namespace Orca::Editor
 {
-    class ConsolePanel : public Panel 
+    class ConsoleLogModel;
+
+    class ConsolePanel : public Panel
     {
         Q_OBJECT
     public:
         explicit ConsolePanel(QWidget* parent = nullptr);
-        ~ConsolePanel() override = default;
+        ~ConsolePanel() override;
+
+        QWidget* GetWidget() override { return this; }
+
+        /**
+         * @brief Hides everything logged so far. Lines stay in the store and the log file.
+         */
+        void ClearView();
+
+    protected:
+        bool eventFilter(QObject* watched, QEvent* event) override;
 
     public slots:
         /**
          * @brief Slot to receive and display a new log message.
          * @param message The log message to append.
          */
-        void logMessage(const QString& message, const QString& type);
+        void logMessage(const QString& message, const QString& type = "LOG");
 
     private slots:
         /**
@@ -29,9 +48,36 @@ namespace Orca::Editor
          */
         void handleCommandInput();
 
+        /**
+         * @brief Rebuilds the query from the filter widgets and hands it to the search worker.
+         */
+        void submitQuery();
+
+        void onScanFinished(quint64 generation);
+
+    private:
+        QWidget* CreateFilterBar();
+        void PopulateCategoryMenu();
+
     private:
-        QTextEdit* m_logOutput;
+        QListView* m_logOutput;
         QLineEdit* m_commandInput;
+
+        QLineEdit* m_searchInput;
+        QCheckBox* m_regexToggle;
+        QCheckBox* m_caseToggle;
+        QCheckBox* m_collapseToggle;
+        QToolButton* m_severityButtons[4];
+        QToolButton* m_categoryButton;
+        QLabel* m_statusLabel;
+        QTimer m_searchDebounce;
+
+        QSet<QString> m_hiddenCategories;
+        quint64 m_clearedBefore = 0;
+        bool m_followTail = true;
+
+        ConsoleLogModel* m_model;
+        std::unique_ptr<Orca::LogSearchWorker> m_searchWorker;
     };
 }
 
@@ -0,0 +1,240 @@
+#include "ConsoleRenderCommands.h"
+#include "ConsoleCommandRegistry.h"
+#include "SceneViewport.h"
+#include <QtCore/QLocale>
+#include <algorithm>
+
+namespace Orca::Editor
+{
+	namespace
+	{
+		QString Bytes(uint64_t bytes)
+		{
+			return QLocale::system().formattedDataSize(static_cast<qint64>(bytes));
+		}
+
+		using ViewportCommand = std::function<void(SceneViewport& viewport, const QStringList& args, ConsoleCommandContext& context)>;
+
+		struct ViewName
+		{
+			const char* name;
+			ViewportCamera camera;
+		};
+
+		constexpr ViewName kViewNames[] = {
+			{ "perspective", ViewportCamera::Perspective },
+			{ "top", ViewportCamera::Top },
+			{ "front", ViewportCamera::Front },
+			{ "game", ViewportCamera::Game }
+		};
+
+		const ViewName* FindView(const QString& name)
+		{
+			for (const ViewName& view : kViewNames)
+			{
+				if (name == QLatin1String(view.name)) return &view;
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Replaces the command with one that runs on a viewport from @p viewports: the one named
+		 * by a leading view argument, which is then dropped, or else the first. Viewports are
+		 * looked up on every call, so views opened later can be named and closed ones can't.
+		 */
+		void RegisterViewportCommand(const ViewportList& viewports, const QString& name, const QString& usage, const QString& help,
+			ViewportCommand execute, std::function<QStringList(const QStringList& args)> complete = nullptr)
+		{
+			// "shadows [cast ...]" becomes "shadows [<view>] [cast ...]".
+			const QString viewUsage = QString(usage).insert(name.size(), QLatin1String(" [<view>]"));
+			const QString viewHelp = help + " <view> is perspective, top, front or game; the last focused viewport by default.";
+
+			ConsoleCommandRegistry& registry = ConsoleCommandRegistry::Get();
+			registry.Unregister(name);
+			registry.Register({ name, viewUsage, viewHelp,
+				[viewports, execute](const QStringList& args, ConsoleCommandContext& context)
+				{
+					const std::vector<SceneViewport*> candidates = viewports ? viewports() : std::vector<SceneViewport*>();
+					const ViewName* view = FindView(args.value(0));
+					if (!view)
+					{
+						if (candidates.empty()) { context.Error("No viewport is rendering."); return; }
+						execute(*candidates.front(), args, context);
+						return;
+					}
+
+					auto found = std::find_if(candidates.begin(), candidates.end(), [view](SceneViewport* viewport) { return viewport->Camera() == view->camera; });
+					if (found == candidates.end()) { context.Error(QString("The %1 view isn't open.").arg(QLatin1String(view->name))); return; }
+					execute(**found, args.mid(1), context);
+				},
+				[complete](const QStringList& args)
+				{
+					if (args.size() > 1 && FindView(args[0])) return complete ? complete(args.mid(1)) : QStringList();
+
+					QStringList options = complete ? complete(args) : QStringList();
+					if (args.size() == 1)
+					{
+						for (const ViewName& view : kViewNames) options.append(QLatin1String(view.name));
+					}
+					return options;
+				} });
+		}
+
+		void RegisterTextureCommand(const ViewportList& viewports)
+		{
+			RegisterViewportCommand(viewports, "textures", "textures [budget <MB>]", "Texture streaming residency, or sets the VRAM budget.",
+				[](SceneViewport& view, const QStringList& args, ConsoleCommandContext& context)
+				{
+					TextureStreamer& textures = view.Textures();
+					if (args.value(0) == "budget")
+					{
+						bool ok = false;
+						const qint64 megabytes = args.value(1).toLongLong(&ok);
+						if (args.size() != 2 || !ok || megabytes <= 0) { context.Error("Usage: textures budget <MB>"); return; }
+
+						textures.SetBudget(static_cast<uint64_t>(megabytes) << 20);
+						view.update();
+					}
+					else if (!args.isEmpty())
+					{
+						context.Error("Usage: textures [budget <MB>]");
+						return;
+					}
+
+					const TextureStreamerStats stats = textures.Stats();
+					context.Print(QString("textures: %1 known, %2 resident, %3 at full requested detail")
+						.arg(stats.textures).arg(stats.resident).arg(stats.complete));
+					context.Print(QString("VRAM %1 of %2 budget, %3 uploaded last frame")
+						.arg(Bytes(stats.residentBytes), Bytes(stats.budgetBytes), Bytes(stats.uploadedBytes)));
+				},
+				[](const QStringList& args) { return args.size() == 1 ? QStringList{ "budget" } : QStringList(); });
+		}
+
+		void RegisterRenderGraphCommand(const ViewportList& viewports)
+		{
+			RegisterViewportCommand(viewports, "rendergraph", "rendergraph", "Viewport render passes with timings, and the targets they share.",
+				[](SceneViewport& view, const QStringList&, ConsoleCommandContext& context)
+				{
+					const RenderGraphReport report = view.Graph().Report();
+					if (report.passes.empty()) { context.Error("The viewport hasn't built its render graph yet."); return; }
+
+					context.Print("pass                          CPU ms    GPU ms");
+					for (size_t i = 0; i < report.passes.size(); ++i)
+					{
+						const RenderPassReport& pass = report.passes[i];
+						const QString label = QString("%1 %2").arg(i, 2).arg(QString(pass.name));
+						if (pass.culled)
+						{
+							context.Print(QString("%1  culled").arg(label, -28));
+							continue;
+						}
+						const QString gpu = pass.gpuMs < 0.0 ? QString("-") : QString::number(pass.gpuMs, 'f', 3);
+						context.Print(QString("%1  %2  %3").arg(label, -28).arg(pass.cpuMs, 8, 'f', 3).arg(gpu, 8));
+					}
+
+					context.Print("target                        slot  size        passes");
+					for (const RenderResourceReport& resource : report.resources)
+					{
+						const QString slot = resource.imported ? QString("in") : resource.physical < 0 ? QString("-") : QString::number(resource.physical);
+						const QString passes = resource.firstPass < 0 ? QString("unused") : QString("%1-%2").arg(resource.firstPass).arg(resource.lastPass);
+						context.Print(QString("%1  %2  %3  %4").arg(QString(resource.name), -28).arg(slot, 4).arg(Bytes(resource.bytes), -10).arg(passes));
+					}
+
+					context.Print(QString("transient targets %1, allocated %2 (aliasing saved %3)")
+						.arg(Bytes(report.transientBytes), Bytes(report.allocatedBytes), Bytes(report.transientBytes - report.allocatedBytes)));
+				});
+		}
+
+		void RegisterLightingCommand(const ViewportList& viewports)
+		{
+			RegisterViewportCommand(viewports, "lights", "lights", "Scene lights and how they were binned into the viewport's clusters.",
+				[](SceneViewport& view, const QStringList&, ConsoleCommandContext& context)
+				{
+					const ClusteredLightingStats stats = view.Lighting().Stats();
+					context.Print(QString("lights: %1 point, %2 spot, %3 directional")
+						.arg(stats.pointLights).arg(stats.spotLights).arg(stats.directionalLights));
+					context.Print(QString("clusters: %1 x %2 x %3, %4 light references, busiest %5 (limit %6)")
+						.arg(ClusteredLighting::kTilesX).arg(ClusteredLighting::kTilesY).arg(ClusteredLighting::kSlices)
+						.arg(stats.clusterEntries).arg(stats.busiestCluster).arg(ClusteredLighting::kMaxLightsPerCluster));
+					if (stats.droppedEntries > 0) context.Error(QString("%1 light references over the cluster limit were dropped").arg(stats.droppedEntries));
+					context.Print(QString("last binned in %1 ms").arg(stats.binMs, 0, 'f', 3));
+				});
+		}
+
+		void RegisterShadowCommand(const ViewportList& viewports, const CastShadowsSetter& setCastsShadows)
+		{
+			RegisterViewportCommand(viewports, "shadows", "shadows [cast <entity> on|off]", "Shadow cascades and casters, or overrides an entity's Cast Shadows.",
+				[setCastsShadows](SceneViewport& view, const QStringList& args, ConsoleCommandContext& context)
+				{
+					if (args.value(0) == "cast")
+					{
+						bool ok = false;
+						const uint32_t entity = args.value(1).toUInt(&ok);
+						const QString state = args.value(2);
+						if (args.size() != 3 || !ok || (state != "on" && state != "off")) { context.Error("Usage: shadows cast <entity> on|off"); return; }
+
+						// Every view and the Inspector, so they keep agreeing.
+						if (setCastsShadows) setCastsShadows(entity, state == "on");
+						else view.SetCastsShadows(entity, state == "on");
+						context.Print(QString("entity %1 %2 shadows").arg(entity).arg(view.Shadows().CastsShadows(entity) ? "casts" : "doesn't cast"));
+						return;
+					}
+					else if (!args.isEmpty())
+					{
+						context.Error("Usage: shadows [cast <entity> on|off]");
+						return;
+					}
+
+					const CascadedShadowStats stats = view.Shadows().Stats();
+					context.Print(QString("casters: %1 static, %2 dynamic").arg(stats.staticCasters).arg(stats.dynamicCasters));
+					context.Print(QString("cascades: %1 x %2^2, splits at %3, %4, %5, %6")
+						.arg(CascadedShadows::kCascades).arg(CascadedShadows::kResolution)
+						.arg(stats.splits[0], 0, 'f', 1).arg(stats.splits[1], 0, 'f', 1).arg(stats.splits[2], 0, 'f', 1).arg(stats.splits[3], 0, 'f', 1));
+					context.Print(QString("static pages: %1 redrawn last frame, %2 since the scene loaded; VRAM %3")
+						.arg(stats.pagesRenderedLastFrame).arg(stats.pagesRendered).arg(Bytes(stats.gpuBytes)));
+				},
+				[](const QStringList& args) { return args.size() == 1 ? QStringList{ "cast" } : (args.size() == 3 ? QStringList{ "on", "off" } : QStringList()); });
+		}
+
+		void RegisterOcclusionCommand(const ViewportList& viewports)
+		{
+			RegisterViewportCommand(viewports, "occlusion", "occlusion [on|off]", "What the viewport's occlusion culling hid last time, or turns it on or off.",
+				[](SceneViewport& view, const QStringList& args, ConsoleCommandContext& context)
+				{
+					if (args.size() == 1 && (args[0] == "on" || args[0] == "off"))
+					{
+						view.SetOcclusionCulling(args[0] == "on");
+					}
+					else if (!args.isEmpty())
+					{
+						context.Error("Usage: occlusion [on|off]");
+						return;
+					}
+
+					if (!view.OcclusionCulling())
+					{
+						context.Print(QString("occlusion culling off, drawing all %1 instances").arg(view.DrawnInstances()));
+						return;
+					}
+
+					const OcclusionCullingStats stats = view.Occlusion().Stats();
+					context.Print(QString("occluders: %1, %2 triangles rasterized into %3 x %4")
+						.arg(stats.occluders).arg(stats.occluderTriangles).arg(OcclusionCuller::kWidth).arg(OcclusionCuller::kHeight));
+					context.Print(QString("tested %1: %2 outside the frustum, %3 occluded; %4 drawn, occluders included")
+						.arg(stats.tested).arg(stats.frustumCulled).arg(stats.occlusionCulled).arg(stats.visible));
+					context.Print(QString("last culled in %1 ms (raster %2 ms, test %3 ms)")
+						.arg(stats.rasterMs + stats.testMs, 0, 'f', 3).arg(stats.rasterMs, 0, 'f', 3).arg(stats.testMs, 0, 'f', 3));
+				},
+				[](const QStringList& args) { return args.size() == 1 ? QStringList{ "on", "off" } : QStringList(); });
+		}
+	}
+
+	void RegisterRenderCommands(ViewportList viewports, CastShadowsSetter setCastsShadows)
+	{
+		RegisterTextureCommand(viewports);
+		RegisterRenderGraphCommand(viewports);
+		RegisterLightingCommand(viewports);
+		RegisterShadowCommand(viewports, setCastsShadows);
+		RegisterOcclusionCommand(viewports);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#ifndef CONSOLE_RENDER_COMMANDS_H
+#define CONSOLE_RENDER_COMMANDS_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Orca { class SceneViewport; }
+
+namespace Orca::Editor
+{
+	/** @brief The open viewports, the one the user last focused first. */
+	using ViewportList = std::function<std::vector<Orca::SceneViewport*>()>;
+
+	/** @brief Changes an entity's Cast Shadows setting in every viewport and the Inspector. */
+	using CastShadowsSetter = std::function<void(uint32_t entity, bool castsShadows)>;
+
+	/**
+	 * @brief Registers the commands that inspect and tune a viewport's rendering: textures,
+	 *        rendergraph, lights, shadows and occlusion. Each takes an optional view name
+	 *        (perspective, top, front, game) and otherwise acts on the first of @p viewports.
+	 *        "shadows cast" goes through @p setCastsShadows rather than one view. Calling it
+	 *        again rebinds them.
+	 */
+	void RegisterRenderCommands(ViewportList viewports, CastShadowsSetter setCastsShadows);
+}
+
+#endif
\ No newline at end of file
@@ -1,10 +1,29 @@
 #include <QtWidgets/QHeaderView>
 #include "HierarchyPanel.h"
 #include <Scene/Scene.h>
+#include "../Core/ProjectLoader.h"
 #include <iostream>
 
 namespace Orca::Editor
 {
+	void AppendHierarchyItems(const LoadedScene& scene, size_t first, size_t end, QTreeWidgetItem* root, std::vector<QTreeWidgetItem*>& items)
+	{
+		const SceneDocument& document = *scene.document;
+		const std::vector<EntityRecord>& entities = document.Entities();
+
+		for (size_t i = first; i < end; ++i)
+		{
+			const uint32_t entity = scene.hierarchyOrder[i];
+			const uint32_t parent = entities[entity].parent;
+			QTreeWidgetItem* parentItem = parent < entities.size() && items[parent] ? items[parent] : root;
+
+			std::string_view name = document.EntityName(entity);
+			QTreeWidgetItem* item = new QTreeWidgetItem(parentItem, QStringList() << QString::fromUtf8(name.data(), static_cast<qsizetype>(name.size())));
+			item->setData(0, Qt::UserRole, entity);
+			items[entity] = item;
+		}
+	}
+
 	HierarchyPanel::HierarchyPanel(QWidget* parent)
 		: Panel("Hierarchy", parent), m_treeWidget(new QTreeWidget(this)), m_layout(new QVBoxLayout(this))
 	{
@@ -16,8 +35,6 @@ namespace Orca::Editor
 		this->setLayout(m_layout);
 
 		connect(m_treeWidget, &QTreeWidget::itemClicked, this, &HierarchyPanel::onItemSelected);
-
-		this->setStyleSheet("QTreeWidget { background-color: #2e2e2e; color: %dcdcdc border: 1px solid #3c3c3c; border-radius: 4px }");
 	}
 
 	HierarchyPanel::~HierarchyPanel() {}
@@ -8,11 +8,19 @@
 #include <QtWidgets/QVBoxLayout>
 #include <QtWidgets/QWidget>
 #include <memory>
+#include <vector>
 
-namespace Orca { class Scene; }
+namespace Orca { class Scene; struct LoadedScene; }
 
 namespace Orca::Editor
 {
+	/**
+	 * @brief Adds tree items for scene.hierarchyOrder[first, end) under their parents' items, or
+	 *        under @p root for top-level entities. @p items is indexed by entity and holds one slot
+	 *        per entity; parents come first in hierarchyOrder, so their items already exist.
+	 */
+	void AppendHierarchyItems(const LoadedScene& scene, size_t first, size_t end, QTreeWidgetItem* root, std::vector<QTreeWidgetItem*>& items);
+
 	class HierarchyPanel : public Panel
 	{
 		Q_OBJECT
@@ -0,0 +1,135 @@
+#include "InspectorBenchmark.h"
+#include "../Core/EditorTheme.h"
+#include <QtCore/QElapsedTimer>
+#include <QtWidgets/QGroupBox>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QStyle>
+#include <QtWidgets/QVBoxLayout>
+#include <algorithm>
+#include <memory>
+
+namespace Orca
+{
+	namespace
+	{
+		enum class Styling
+		{
+			Theme,
+			StyleSheets
+		};
+
+		// The sheets EditorApp and InspectorPanel used to set.
+		const char* const kPanelSheet = "QWidget { background-color: #252526; color: #ccc; font-size: 10pt; }"
+			" QLineEdit { background-color: #333333; border: 1px solid #444444; padding: 2px; border-radius: 3px; color: white; }";
+		const char* const kGroupSheet = "QGroupBox { border: 1px solid #3c3c3c; border-radius: 4px; margin-top: 10px; font-weight: bold; padding-top: 10px; }"
+			" QGroupBox::title { subcontrol-origin: margin; subcontrol-position: top left; padding: 0 3px; background-color: #2e2e2e; color: #88c0d0; }";
+		const char* const kAxisSheets[3] = { "QLineEdit { color: #ff6666; }", "QLineEdit { color: #66ff66; }", "QLineEdit { color: #6666ff; }" };
+		const ThemeRole kAxisRoles[3] = { ThemeRole::AxisX, ThemeRole::AxisY, ThemeRole::AxisZ };
+		const char* const kRowLabels[3] = { "Position", "Rotation", "Scale" };
+
+		std::unique_ptr<QWidget> BuildRows(int rows, Styling styling)
+		{
+			auto root = std::make_unique<QWidget>();
+			root->setAttribute(Qt::WA_DontShowOnScreen);
+			if (styling == Styling::StyleSheets) root->setStyleSheet(kPanelSheet);
+
+			QVBoxLayout* layout = new QVBoxLayout(root.get());
+			QVBoxLayout* groupLayout = nullptr;
+			QGroupBox* group = nullptr;
+			for (int row = 0; row < rows; ++row)
+			{
+				if (row % 3 == 0)
+				{
+					group = new QGroupBox(QString("Component %1").arg(row / 3), root.get());
+					if (styling == Styling::StyleSheets) group->setStyleSheet(kGroupSheet);
+					groupLayout = new QVBoxLayout(group);
+					layout->addWidget(group);
+				}
+
+				QWidget* rowWidget = new QWidget(group);
+				QHBoxLayout* rowLayout = new QHBoxLayout(rowWidget);
+				rowLayout->setContentsMargins(0, 0, 0, 0);
+				rowLayout->setSpacing(5);
+
+				QLabel* label = new QLabel(kRowLabels[row % 3], rowWidget);
+				label->setFixedWidth(60);
+				rowLayout->addWidget(label);
+
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					QLineEdit* field = new QLineEdit("0.0", rowWidget);
+					if (styling == Styling::StyleSheets) field->setStyleSheet(kAxisSheets[axis]);
+					else EditorTheme::SetTextRole(field, kAxisRoles[axis]);
+					rowLayout->addWidget(field);
+				}
+				groupLayout->addWidget(rowWidget);
+			}
+			return root;
+		}
+
+		// What show() would do before the first paint.
+		void Realize(QWidget* root)
+		{
+			root->ensurePolished();
+			root->layout()->activate();
+		}
+
+		void Repolish(QWidget* root, Styling styling)
+		{
+			if (styling == Styling::StyleSheets)
+			{
+				// A changed sheet on the root is matched again against every descendant.
+				root->setStyleSheet(root->styleSheet() + " ");
+			}
+			else
+			{
+				// What QApplication::setStyle() does to each widget.
+				QList<QWidget*> widgets = root->findChildren<QWidget*>();
+				widgets.prepend(root);
+				for (QWidget* widget : widgets)
+				{
+					widget->style()->unpolish(widget);
+					widget->style()->polish(widget);
+				}
+			}
+			Realize(root);
+		}
+
+		double ElapsedMs(const QElapsedTimer& timer)
+		{
+			return timer.nsecsElapsed() / 1e6;
+		}
+	}
+
+	InspectorBenchmarkResult BenchmarkInspectorRows(int rows, int iterations)
+	{
+		InspectorBenchmarkResult result;
+		result.rows = rows;
+		result.themeBuildMs = result.themeRepolishMs = result.styleSheetBuildMs = result.styleSheetRepolishMs = 1e300;
+
+		for (int i = 0; i < std::max(1, iterations); ++i)
+		{
+			for (Styling styling : { Styling::Theme, Styling::StyleSheets })
+			{
+				QElapsedTimer timer;
+				timer.start();
+				std::unique_ptr<QWidget> root = BuildRows(rows, styling);
+				Realize(root.get());
+				const double buildMs = ElapsedMs(timer);
+
+				timer.restart();
+				Repolish(root.get(), styling);
+				const double repolishMs = ElapsedMs(timer);
+
+				double& bestBuild = styling == Styling::Theme ? result.themeBuildMs : result.styleSheetBuildMs;
+				double& bestRepolish = styling == Styling::Theme ? result.themeRepolishMs : result.styleSheetRepolishMs;
+				bestBuild = std::min(bestBuild, buildMs);
+				bestRepolish = std::min(bestRepolish, repolishMs);
+				result.widgets = static_cast<int>(root->findChildren<QWidget*>().size()) + 1;
+			}
+		}
+		return result;
+	}
+}
\ No newline at end of file
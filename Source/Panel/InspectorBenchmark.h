@@ -0,0 +1,33 @@
+#pragma once
+
+#ifndef INSPECTOR_BENCHMARK_H
+#define INSPECTOR_BENCHMARK_H
+
+namespace Orca
+{
+	struct InspectorBenchmarkResult
+	{
+		int rows = 0;
+		int widgets = 0;
+
+		// Palette roles and EditorStyle, as the editor is styled now.
+		double themeBuildMs = 0.0;
+		double themeRepolishMs = 0.0;
+
+		// The per-widget style sheets the inspector used before EditorTheme.
+		double styleSheetBuildMs = 0.0;
+		double styleSheetRepolishMs = 0.0;
+	};
+
+	/**
+	 * @brief Builds an off-screen inspector of @p rows transform rows (a label and three axis
+	 *        fields each, three rows per component box) both ways, keeping the best of
+	 *        @p iterations runs.
+	 *
+	 * "Build" covers construction, polishing and layout, which is what showing the panel costs.
+	 * "Repolish" re-applies the styling to the finished tree, as a theme change would. GUI thread only.
+	 */
+	InspectorBenchmarkResult BenchmarkInspectorRows(int rows, int iterations = 3);
+}
+
+#endif
\ No newline at end of file
@@ -1,10 +1,11 @@
 #include "InspectorPanel.h"
+#include "../Core/EditorTheme.h"
 #include <QtWidgets/QLineEdit>
 #include <QtWidgets/QHBoxLayout>
 #include <QtWidgets/QDoubleSpinBox>
 #include <QtWidgets/QPushButton>
-#include <QtWidgets/QCheckBox>
 #include <QtWidgets/QStyleFactory>
+#include <QtCore/QSignalBlocker>
 #include <iostream>
 
 namespace Orca::Editor
@@ -24,15 +25,15 @@ namespace Orca::Editor
 		m_scrollArea->setWidgetResizable(true);
 		m_scrollArea->setWidget(m_contentWidget);
 		m_scrollArea->setFrameShape(QFrame::NoFrame);
-
-		m_scrollArea->setStyleSheet("QScrollArea { background-color: transparent; }");
+		m_scrollArea->viewport()->setAutoFillBackground(false);
+		m_contentWidget->setAutoFillBackground(false);
 
 		// 3. Main Layout
 		m_mainLayout->addWidget(m_scrollArea);
 		m_mainLayout->setContentsMargins(0, 0, 0, 0);
 		this->setLayout(m_mainLayout);
 
-		SetSelectedEntity(0);
+		DrawEntityProperties();
 	}
 
 	void InspectorPanel::Update(float deltaTime)
@@ -49,8 +50,18 @@ namespace Orca::Editor
 		}
 	}
 
+	void InspectorPanel::SetCastShadows(bool castShadows)
+	{
+		if (!m_castShadows) return;
+
+		QSignalBlocker blocker(m_castShadows);
+		m_castShadows->setChecked(castShadows);
+	}
+
 	void InspectorPanel::DrawEntityProperties()
 	{
+		m_castShadows = nullptr;
+
 		QLayoutItem* item;
 		while ((item = m_contentLayout->takeAt(0)) != nullptr) 
 		{
@@ -58,11 +69,15 @@ namespace Orca::Editor
 			delete item;
 		}
 
-		if (m_selectedEntityID <= 0)
+		if (m_selectedEntityID < 0)
 		{
 			QLabel* placeholder = new QLabel("Select an Entity in the Hierarchy", m_contentWidget);
 			placeholder->setAlignment(Qt::AlignCenter);
-			placeholder->setStyleSheet("QLabel { color: #808080; font-style: italic; padding: 50px; }");
+			placeholder->setMargin(50);
+			QFont placeholderFont = placeholder->font();
+			placeholderFont.setItalic(true);
+			placeholder->setFont(placeholderFont);
+			EditorTheme::SetTextRole(placeholder, ThemeRole::MutedText);
 			m_contentLayout->addWidget(placeholder);
 			return;
 		}
@@ -71,7 +86,12 @@ namespace Orca::Editor
 		std::cout << "Inspecting Entity ID: " << m_selectedEntityID << " (" << entityName.toStdString() << ")" << std::endl;
 
 		QLabel* nameLabel = new QLabel(entityName, m_contentWidget);
-		nameLabel->setStyleSheet("QLabel { font-size: 16pt; font-weight: bold; margin-bottom: 10px; color: #f0f0f0; }");
+		QFont nameFont = nameLabel->font();
+		nameFont.setPointSizeF(16.0);
+		nameFont.setBold(true);
+		nameLabel->setFont(nameFont);
+		nameLabel->setContentsMargins(0, 0, 0, 10);
+		EditorTheme::SetTextRole(nameLabel, ThemeRole::BrightText);
 		m_contentLayout->addWidget(nameLabel);
 
 		m_contentLayout->addWidget(DrawTransformComponent(entityName));
@@ -79,19 +99,8 @@ namespace Orca::Editor
 		m_contentLayout->addWidget(DrawMeshRendererComponent());
 
 		QPushButton* addComponentButton = new QPushButton("+ Add Component", m_contentWidget);
-		addComponentButton->setStyleSheet(R"(
-			QPushButton {
-				background-color: #555555;
-				border: 1px solid #777777;
-				padding: 8px;
-				margin-top: 20px;
-				border-radius: 4px;
-				color: white;
-			}
-			QPushButton:hover {
-				background-color: #6a6a6a;
-			}
-		)");
+		addComponentButton->setMinimumHeight(32);
+		m_contentLayout->addSpacing(20);
 		m_contentLayout->addWidget(addComponentButton);
 	}
 
@@ -115,23 +124,6 @@ namespace Orca::Editor
 		QGroupBox* groupBox = new QGroupBox("Transform", m_contentWidget);
 		QVBoxLayout* groupLayout = new QVBoxLayout(groupBox);
 
-		groupBox->setStyleSheet(R"(
-			QGroupBox {
-				border: 1px solid #3c3c3c;
-				border-radius: 4px;
-				margin-top: 10px;
-				font-weight: bold;
-				padding-top: 10px;
-			}
-			QGroupBox::title {
-				subcontrol-origin: margin;
-				subcontrol-position: top left; /* Position the title */
-				padding: 0 3px;
-				background-color: #2e2e2e; /* Match panel background */
-				color: #88c0d0; /* Highlight color for component headers */
-			}
-		)");
-
 		groupLayout->addWidget(CreatePropertyRow("Position (X,Y,Z)"));
 		groupLayout->addWidget(CreatePropertyRow("Rotation (X,Y,Z)"));
 		groupLayout->addWidget(CreatePropertyRow("Scale (X,Y,Z)"));
@@ -146,23 +138,6 @@ namespace Orca::Editor
 		QGroupBox* groupBox = new QGroupBox("Mesh Renderer", m_contentWidget);
 		QVBoxLayout* groupLayout = new QVBoxLayout(groupBox);
 
-		groupBox->setStyleSheet(R"(
-			QGroupBox {
-				border: 2px solid #5d5d5d;
-				border-radius: 4px;
-				margin-top: 10px;
-				font-weight: bold;
-				padding-top: 10px;
-			}
-			QGroupBox::title {
-				subcontrol-origin: margin;
-				subcontrol-position: top left;
-				padding: 0 3px;
-				background-color: #2e2e2e;
-				color: #88c0d0;
-			}
-		)");
-
 		QWidget* materialRow = new QWidget(m_contentWidget);
 		QHBoxLayout* materialLayout = new QHBoxLayout(materialRow);
 		materialLayout->setContentsMargins(0, 0, 0, 0);
@@ -170,7 +145,6 @@ namespace Orca::Editor
 		materialLayout->addWidget(new QLabel("Material:", materialRow));
 		QLineEdit* materialInput = new QLineEdit("DefaultMaterial", materialRow);
 		materialInput->setReadOnly(true);
-		materialInput->setStyleSheet("QLineEdit { background-color: #444444; border: 1px solid #555555; color: #dcdcdc; padding: 2px; border-radius: 2px; }");
 		materialLayout->addWidget(materialInput);
 		QPushButton* selectButton = new QPushButton("...", materialRow);
 		selectButton->setFixedWidth(30);
@@ -179,7 +153,13 @@ namespace Orca::Editor
 
 		groupLayout->addWidget(materialRow);
 
-		groupLayout->addWidget(new QCheckBox("Cast Shadows", m_contentWidget));
+		m_castShadows = new QCheckBox("Cast Shadows", m_contentWidget);
+		m_castShadows->setChecked(true);
+		connect(m_castShadows, &QCheckBox::toggled, this, [this](bool checked)
+		{
+			emit castShadowsChanged(m_selectedEntityID, checked);
+		});
+		groupLayout->addWidget(m_castShadows);
 
 		groupLayout->setContentsMargins(10, 15, 10, 10);
 		groupBox->setLayout(groupLayout);
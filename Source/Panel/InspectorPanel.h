@@ -8,6 +8,7 @@
 #include <QtWidgets/QVBoxLayout>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QGroupBox>
+#include <QtWidgets/QCheckBox>
 #include <memory>
 
 namespace Orca { class Scene; }
@@ -26,8 +27,16 @@ namespace Orca::Editor
 		void Update(float deltaTime) override;
 
 	public slots:
+		/** @brief Shows an entity's components; -1 shows that nothing is selected. */
 		void SetSelectedEntity(int entityID);
 
+		/** @brief Shows the selected entity's Cast Shadows state without emitting castShadowsChanged(). */
+		void SetCastShadows(bool castShadows);
+
+	signals:
+		/** @brief The Cast Shadows box of the selected entity's MeshRenderer was toggled. */
+		void castShadowsChanged(int entityID, bool castShadows);
+
 	private:
 		void DrawEntityProperties();
 
@@ -38,13 +47,14 @@ namespace Orca::Editor
 		QWidget* CreatePropertyRow(const QString& label, const QVariant& value = QVariant());
 
 	private:
-		int m_selectedEntityID = 0;
+		int m_selectedEntityID = -1;
 
 		QVBoxLayout* m_mainLayout;
 		QScrollArea* m_scrollArea;
 
 		QWidget* m_contentWidget;
 		QVBoxLayout* m_contentLayout;
+		QCheckBox* m_castShadows = nullptr;
 	};
 }
 
@@ -1,17 +1,16 @@
 #include "Panel.h"
+#include "../Core/EditorTickScheduler.h"
 
 namespace Orca::Editor
 {
 	Panel::Panel(const QString& panelName, QWidget* parent)
 		: name(panelName), QWidget(parent)
 	{
-        setStyleSheet(R"(
-            QWidget {
-                background-color: #2e2e2e;
-                color: #dcdcdc; /* Light gray text */
-                border: 1px solid #3c3c3c;
-                border-radius: 4px;
-            }
-        )");
+		// Colors come from the application-wide EditorTheme; a style sheet here would be
+		// re-parsed for every child widget.
+
+		// Update() is virtual, but it is only called from later ticks, by which time the
+		// derived panel is fully constructed.
+		EditorTickScheduler::Get().Register(this, panelName, [this](float deltaTime) { Update(deltaTime); });
 	}
 }
\ No newline at end of file
@@ -0,0 +1,493 @@
+#include "ProfilerPanel.h"
+#include "../Core/EditorLog.h"
+#include "../Core/EditorTheme.h"
+#include "../Core/EditorTickScheduler.h"
+#include <QtCore/QMap>
+#include <QtGui/QHelpEvent>
+#include <QtGui/QMouseEvent>
+#include <QtGui/QPainter>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QScrollArea>
+#include <QtWidgets/QSplitter>
+#include <QtWidgets/QToolButton>
+#include <QtWidgets/QToolTip>
+#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QVBoxLayout>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace Orca::Editor
+{
+	namespace
+	{
+		constexpr double kFrameBudgetMs = 1000.0 / 60.0;
+
+		// With no frames (the viewport only paints when something changes) the timeline shows this much.
+		constexpr qint64 kIdleWindowNs = 100'000'000;
+
+		QColor ZoneColor(const char* name)
+		{
+			const uint hue = qHash(QByteArray::fromRawData(name, static_cast<int>(std::strlen(name)))) % 360;
+			return QColor::fromHsv(static_cast<int>(hue), 90, 150);
+		}
+
+		QString Ms(double ms)
+		{
+			return QString::number(ms, 'f', ms < 10.0 ? 3 : 1);
+		}
+	}
+
+	/**
+	 * @brief One bar per frame, newest on the right; the inner bar is GPU time. Click to pick a frame.
+	 */
+	class FrameGraphView : public QWidget
+	{
+	public:
+		static constexpr int kBarWidth = 3;
+		static constexpr int kBarStride = kBarWidth + 1;
+
+		std::function<void(int)> onFrameClicked;
+
+		explicit FrameGraphView(QWidget* parent) : QWidget(parent)
+		{
+			setFixedHeight(90);
+		}
+
+		void SetFrames(const std::vector<ProfileFrame>* frames, int selected)
+		{
+			m_frames = frames;
+			m_selected = selected;
+			update();
+		}
+
+	protected:
+		void paintEvent(QPaintEvent*) override
+		{
+			QPainter painter(this);
+			painter.fillRect(rect(), EditorTheme::Color(ThemeRole::Window));
+
+			if (!m_frames || m_frames->empty())
+			{
+				painter.setPen(EditorTheme::Color(ThemeRole::MutedText));
+				painter.drawText(rect(), Qt::AlignCenter, tr("No frames recorded yet"));
+				return;
+			}
+
+			// Idle gaps between on-demand repaints would flatten everything else, so the scale
+			// stops at three budgets and taller bars are clipped.
+			const int first = FirstVisible();
+			double tallest = 0.0;
+			for (size_t i = first; i < m_frames->size(); ++i) tallest = std::max(tallest, (*m_frames)[i].CpuMs());
+			const double scaleMs = tallest > 2.0 * kFrameBudgetMs ? 3.0 * kFrameBudgetMs : 2.0 * kFrameBudgetMs;
+			const double pixelsPerMs = height() / scaleMs;
+
+			for (size_t i = first; i < m_frames->size(); ++i)
+			{
+				const ProfileFrame& frame = (*m_frames)[i];
+				const int x = static_cast<int>(i - first) * kBarStride;
+				const double cpuMs = frame.CpuMs();
+
+				QColor color = EditorTheme::Color(cpuMs > 2.0 * kFrameBudgetMs ? ThemeRole::Error : cpuMs > kFrameBudgetMs ? ThemeRole::Header : ThemeRole::Accent);
+				if (static_cast<int>(i) == m_selected) color = EditorTheme::Color(ThemeRole::BrightText);
+
+				const double barHeight = std::min<double>(height(), cpuMs * pixelsPerMs);
+				painter.fillRect(QRectF(x, height() - barHeight, kBarWidth, barHeight), color);
+
+				if (frame.gpuMs >= 0.0)
+				{
+					const double gpuHeight = std::min<double>(height(), frame.gpuMs * pixelsPerMs);
+					painter.fillRect(QRectF(x + 1, height() - gpuHeight, kBarWidth - 2, gpuHeight), EditorTheme::Color(ThemeRole::Success));
+				}
+			}
+
+			painter.setPen(QPen(EditorTheme::Color(ThemeRole::MutedText), 1, Qt::DashLine));
+			for (int budgets = 1; budgets * kFrameBudgetMs < scaleMs; ++budgets)
+			{
+				const int y = height() - static_cast<int>(budgets * kFrameBudgetMs * pixelsPerMs);
+				painter.drawLine(0, y, width(), y);
+				painter.drawText(QPoint(width() - 60, y - 2), QString("%1 ms").arg(budgets * kFrameBudgetMs, 0, 'f', 1));
+			}
+		}
+
+		void mousePressEvent(QMouseEvent* event) override
+		{
+			if (!m_frames || m_frames->empty() || !onFrameClicked) return;
+
+			const int frame = FirstVisible() + static_cast<int>(event->position().x()) / kBarStride;
+			if (frame >= 0 && frame < static_cast<int>(m_frames->size())) onFrameClicked(frame);
+		}
+
+	private:
+		int FirstVisible() const
+		{
+			return std::max(0, static_cast<int>(m_frames->size()) - width() / kBarStride);
+		}
+
+	private:
+		const std::vector<ProfileFrame>* m_frames = nullptr;
+		int m_selected = -1;
+	};
+
+	/**
+	 * @brief A lane per thread with zones stacked by nesting depth, over one time range.
+	 */
+	class ZoneTimelineView : public QWidget
+	{
+	public:
+		static constexpr int kGutter = 90;
+		static constexpr int kRowHeight = 16;
+		static constexpr int kLaneGap = 6;
+
+		explicit ZoneTimelineView(QWidget* parent = nullptr) : QWidget(parent)
+		{
+			setMouseTracking(true);
+		}
+
+		void SetRange(const ProfileCapture* capture, qint64 beginNs, qint64 endNs)
+		{
+			m_capture = capture;
+			m_beginNs = beginNs;
+			m_endNs = std::max(endNs, beginNs + 1);
+
+			// Hits point into the previous capture until the next paint.
+			m_hits.clear();
+			m_lanes.clear();
+			int top = kLaneGap;
+			for (const ProfileThread& thread : capture->threads)
+			{
+				int rows = 0;
+				for (const ProfileZone& zone : thread.zones)
+				{
+					if (zone.endNs > m_beginNs && zone.beginNs < m_endNs) rows = std::max(rows, zone.depth + 1);
+				}
+				if (rows == 0) continue;
+
+				m_lanes.push_back({ &thread, top, rows });
+				top += rows * kRowHeight + kLaneGap;
+			}
+			setMinimumHeight(top);
+			update();
+		}
+
+	protected:
+		void paintEvent(QPaintEvent*) override
+		{
+			QPainter painter(this);
+			painter.fillRect(rect(), EditorTheme::Color(ThemeRole::Panel));
+			m_hits.clear();
+
+			if (m_lanes.empty())
+			{
+				painter.setPen(EditorTheme::Color(ThemeRole::MutedText));
+				painter.drawText(rect(), Qt::AlignCenter, tr("No zones in this frame"));
+				return;
+			}
+
+			const double pixelsPerNs = (width() - kGutter) / static_cast<double>(m_endNs - m_beginNs);
+			const QFontMetrics metrics = painter.fontMetrics();
+
+			for (const Lane& lane : m_lanes)
+			{
+				painter.setPen(EditorTheme::Color(ThemeRole::MutedText));
+				painter.drawText(QRect(4, lane.top, kGutter - 8, kRowHeight), Qt::AlignLeft | Qt::AlignVCenter,
+					metrics.elidedText(lane.thread->name, Qt::ElideRight, kGutter - 8));
+
+				for (const ProfileZone& zone : lane.thread->zones)
+				{
+					if (zone.endNs <= m_beginNs || zone.beginNs >= m_endNs) continue;
+
+					const double left = kGutter + std::max<qint64>(0, zone.beginNs - m_beginNs) * pixelsPerNs;
+					const double right = kGutter + (std::min(zone.endNs, m_endNs) - m_beginNs) * pixelsPerNs;
+					const QRectF box(left, lane.top + zone.depth * kRowHeight, std::max(1.0, right - left), kRowHeight - 1);
+
+					painter.fillRect(box, ZoneColor(zone.name));
+					if (box.width() > 24.0)
+					{
+						painter.setPen(EditorTheme::Color(ThemeRole::BrightText));
+						painter.drawText(box.adjusted(3, 0, -3, 0), Qt::AlignLeft | Qt::AlignVCenter,
+							metrics.elidedText(QString::fromUtf8(zone.name), Qt::ElideRight, static_cast<int>(box.width()) - 6));
+					}
+					m_hits.push_back({ box, &zone });
+				}
+			}
+		}
+
+		bool event(QEvent* event) override
+		{
+			if (event->type() == QEvent::ToolTip)
+			{
+				const QHelpEvent* help = static_cast<QHelpEvent*>(event);
+				auto hit = std::find_if(m_hits.rbegin(), m_hits.rend(), [help](const Hit& hit) { return hit.rect.contains(help->pos()); });
+				if (hit != m_hits.rend())
+				{
+					QToolTip::showText(help->globalPos(), QString("%1\n%2 ms").arg(QString::fromUtf8(hit->zone->name), Ms((hit->zone->endNs - hit->zone->beginNs) / 1e6)), this);
+				}
+				else
+				{
+					QToolTip::hideText();
+				}
+				return true;
+			}
+			return QWidget::event(event);
+		}
+
+	private:
+		struct Lane
+		{
+			const ProfileThread* thread;
+			int top;
+			int rows;
+		};
+
+		struct Hit
+		{
+			QRectF rect;
+			const ProfileZone* zone;
+		};
+
+	private:
+		const ProfileCapture* m_capture = nullptr;
+		qint64 m_beginNs = 0;
+		qint64 m_endNs = 1;
+		std::vector<Lane> m_lanes;
+		std::vector<Hit> m_hits;
+	};
+
+	ProfilerPanel::ProfilerPanel(QWidget* parent)
+		: Panel("Profiler", parent)
+	{
+		setWindowTitle("Profiler");
+
+		m_graph = new FrameGraphView(this);
+		m_graph->onFrameClicked = [this](int frame) { SelectFrame(frame); };
+
+		m_timeline = new ZoneTimelineView();
+		QScrollArea* timelineScroll = new QScrollArea();
+		timelineScroll->setWidget(m_timeline);
+		timelineScroll->setWidgetResizable(true);
+		timelineScroll->setFrameShape(QFrame::NoFrame);
+
+		m_tables = new QTreeWidget();
+		m_tables->setHeaderLabels({ "Name", "Count", "Time / Value", "Max" });
+		m_tables->setUniformRowHeights(true);
+		m_tables->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+		m_tables->header()->setStretchLastSection(false);
+
+		QSplitter* split = new QSplitter(Qt::Horizontal);
+		split->addWidget(timelineScroll);
+		split->addWidget(m_tables);
+		split->setStretchFactor(0, 3);
+		split->setStretchFactor(1, 2);
+
+		QVBoxLayout* layout = new QVBoxLayout(this);
+		layout->setContentsMargins(5, 5, 5, 5);
+		layout->addWidget(CreateToolBar());
+		layout->addWidget(m_graph);
+		layout->addWidget(split, 1);
+
+		// Copying the rings out of a busy editor takes longer than the default budget.
+		EditorTickScheduler::Get().SetBudget(this, 6.0);
+	}
+
+	QWidget* ProfilerPanel::CreateToolBar()
+	{
+		QWidget* bar = new QWidget(this);
+		QHBoxLayout* barLayout = new QHBoxLayout(bar);
+		barLayout->setContentsMargins(0, 0, 0, 0);
+		barLayout->setSpacing(4);
+
+		m_pauseButton = new QToolButton(bar);
+		m_pauseButton->setText("Pause");
+		m_pauseButton->setCheckable(true);
+		connect(m_pauseButton, &QToolButton::toggled, this, [this](bool paused)
+		{
+			if (!paused) m_sinceRefresh = kRefreshSeconds;
+		});
+		barLayout->addWidget(m_pauseButton);
+
+		m_liveButton = new QToolButton(bar);
+		m_liveButton->setText("Live");
+		m_liveButton->setToolTip("Drop the loaded capture and show the editor again");
+		m_liveButton->setEnabled(false);
+		connect(m_liveButton, &QToolButton::clicked, this, &ProfilerPanel::GoLive);
+		barLayout->addWidget(m_liveButton);
+
+		QToolButton* saveButton = new QToolButton(bar);
+		saveButton->setText("Save...");
+		connect(saveButton, &QToolButton::clicked, this, &ProfilerPanel::SaveCapture);
+		barLayout->addWidget(saveButton);
+
+		QToolButton* loadButton = new QToolButton(bar);
+		loadButton->setText("Load...");
+		connect(loadButton, &QToolButton::clicked, this, &ProfilerPanel::LoadCapture);
+		barLayout->addWidget(loadButton);
+
+		m_summary = new QLabel(bar);
+		barLayout->addWidget(m_summary, 1);
+		return bar;
+	}
+
+	void ProfilerPanel::Update(float deltaTime)
+	{
+		if (m_fromFile || m_pauseButton->isChecked()) return;
+
+		m_sinceRefresh += deltaTime;
+		if (m_sinceRefresh < kRefreshSeconds) return;
+		m_sinceRefresh = 0.0f;
+
+		m_capture = Profiler::Get().Capture(Profiler::NowNs() - kLiveWindowNs);
+		m_selectedFrame = -1;
+		Refresh();
+	}
+
+	void ProfilerPanel::SaveCapture()
+	{
+		const QString path = QFileDialog::getSaveFileName(this, tr("Save Profiler Capture"), QString(), tr("Chrome traces (*.json)"));
+		if (path.isEmpty()) return;
+
+		QString error;
+		if (!m_capture.Save(path, &error)) ORCA_LOG_ERROR("Editor", "Could not save the profiler capture to {}: {}", path, error);
+		else ORCA_LOG_INFO("Editor", "Saved the profiler capture to {}", path);
+	}
+
+	void ProfilerPanel::LoadCapture()
+	{
+		const QString path = QFileDialog::getOpenFileName(this, tr("Load Profiler Capture"), QString(), tr("Chrome traces (*.json)"));
+		if (path.isEmpty()) return;
+
+		ProfileCapture capture;
+		QString error;
+		if (!ProfileCapture::Load(path, capture, &error))
+		{
+			ORCA_LOG_ERROR("Editor", "Could not load the profiler capture {}: {}", path, error);
+			return;
+		}
+
+		m_capture = std::move(capture);
+		m_fromFile = true;
+		m_selectedFrame = -1;
+		m_pauseButton->setEnabled(false);
+		m_liveButton->setEnabled(true);
+		Refresh();
+	}
+
+	void ProfilerPanel::GoLive()
+	{
+		m_fromFile = false;
+		m_liveButton->setEnabled(false);
+		m_pauseButton->setEnabled(true);
+		m_pauseButton->setChecked(false);
+		m_sinceRefresh = kRefreshSeconds;
+	}
+
+	void ProfilerPanel::SelectFrame(int frame)
+	{
+		m_selectedFrame = frame;
+		if (!m_fromFile) m_pauseButton->setChecked(true);
+		Refresh();
+	}
+
+	void ProfilerPanel::Refresh()
+	{
+		const std::vector<ProfileFrame>& frames = m_capture.frames;
+		const int shown = frames.empty() ? -1 : m_selectedFrame >= 0 ? m_selectedFrame : static_cast<int>(frames.size()) - 1;
+		m_graph->SetFrames(&frames, shown);
+
+		if (shown < 0)
+		{
+			m_timeline->SetRange(&m_capture, m_capture.endNs - kIdleWindowNs, m_capture.endNs);
+			FillTables(m_capture.endNs - kIdleWindowNs, m_capture.endNs);
+			m_summary->setText(m_fromFile ? tr("Capture has no frames") : tr("Waiting for the viewport to draw"));
+			return;
+		}
+
+		const ProfileFrame& frame = frames[shown];
+		m_timeline->SetRange(&m_capture, frame.beginNs, frame.endNs);
+		FillTables(frame.beginNs, frame.endNs);
+
+		double totalMs = 0.0;
+		for (const ProfileFrame& each : frames) totalMs += each.CpuMs();
+		const double averageMs = totalMs / frames.size();
+
+		QString summary = QString("Frame %1: %2 ms").arg(frame.index).arg(frame.CpuMs(), 0, 'f', 2);
+		summary += frame.gpuMs >= 0.0 ? QString(", GPU %1 ms").arg(frame.gpuMs, 0, 'f', 2) : QString(", GPU pending");
+		summary += QString("   |   %1 frames, average %2 ms (%3 fps)").arg(frames.size()).arg(averageMs, 0, 'f', 2).arg(averageMs > 0.0 ? 1000.0 / averageMs : 0.0, 0, 'f', 1);
+		m_summary->setText(summary);
+	}
+
+	void ProfilerPanel::FillTables(qint64 beginNs, qint64 endNs)
+	{
+		struct Totals
+		{
+			int count = 0;
+			double totalMs = 0.0;
+			double maxMs = 0.0;
+		};
+
+		m_tables->clear();
+
+		QMap<QByteArray, Totals> zones;
+		for (const ProfileThread& thread : m_capture.threads)
+		{
+			for (const ProfileZone& zone : thread.zones)
+			{
+				if (zone.beginNs < beginNs || zone.beginNs >= endNs) continue;
+
+				Totals& totals = zones[QByteArray(zone.name)];
+				const double ms = (zone.endNs - zone.beginNs) / 1e6;
+				++totals.count;
+				totals.totalMs += ms;
+				totals.maxMs = std::max(totals.maxMs, ms);
+			}
+		}
+
+		QVector<QPair<QByteArray, Totals>> sorted;
+		for (auto it = zones.cbegin(); it != zones.cend(); ++it) sorted.append({ it.key(), it.value() });
+		std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.totalMs > b.second.totalMs; });
+
+		QTreeWidgetItem* zoneGroup = new QTreeWidgetItem(m_tables, { "Zones" });
+		for (const auto& [name, totals] : sorted)
+		{
+			new QTreeWidgetItem(zoneGroup, { QString::fromUtf8(name), QString::number(totals.count), Ms(totals.totalMs), Ms(totals.maxMs) });
+		}
+
+		// Loaded captures carry the same numbers as "Update <panel>" zones.
+		if (!m_fromFile)
+		{
+			QTreeWidgetItem* panelGroup = new QTreeWidgetItem(m_tables, { "Panel updates" });
+			for (const TickClientStats& client : EditorTickScheduler::Get().Stats())
+			{
+				QTreeWidgetItem* item = new QTreeWidgetItem(panelGroup, { client.name, QString::number(client.updates), Ms(client.lastMs), Ms(client.worstMs) });
+				item->setToolTip(0, QString("Budget %1 ms, %2 overruns, %3 ticks skipped while hidden")
+					.arg(client.budgetMs, 0, 'f', 1).arg(client.overruns).arg(client.skipped));
+				if (client.overruns > 0) item->setForeground(0, EditorTheme::Color(ThemeRole::Error));
+			}
+		}
+
+		QMap<QByteArray, QPair<int, double>> counters;
+		QMap<QByteArray, double> counterMax;
+		for (const ProfileCounterSample& sample : m_capture.counters)
+		{
+			if (sample.timeNs >= endNs) break;
+
+			const QByteArray name(sample.name);
+			QPair<int, double>& latest = counters[name];
+			++latest.first;
+			latest.second = sample.value;
+			counterMax[name] = counterMax.contains(name) ? std::max(counterMax[name], sample.value) : sample.value;
+		}
+
+		QTreeWidgetItem* counterGroup = new QTreeWidgetItem(m_tables, { "Counters" });
+		for (auto it = counters.cbegin(); it != counters.cend(); ++it)
+		{
+			new QTreeWidgetItem(counterGroup, { QString::fromUtf8(it.key()), QString::number(it->first), QString::number(it->second, 'g', 8), QString::number(counterMax[it.key()], 'g', 8) });
+		}
+
+		m_tables->expandAll();
+		for (int column = 1; column < m_tables->columnCount(); ++column) m_tables->resizeColumnToContents(column);
+	}
+}
\ No newline at end of file
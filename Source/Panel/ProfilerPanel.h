@@ -0,0 +1,62 @@
+#pragma once
+
+#ifndef PROFILER_PANEL_H
+#define PROFILER_PANEL_H
+
+#include "Panel.h"
+#include "../Core/Profiler.h"
+
+class QLabel;
+class QToolButton;
+class QTreeWidget;
+
+namespace Orca::Editor
+{
+	class FrameGraphView;
+	class ZoneTimelineView;
+
+	/**
+	 * @brief Frame-time graph, per-thread zone timeline and zone/panel/counter tables over the
+	 *        profiler's recent history or a capture loaded from disk.
+	 *
+	 * Live data is refreshed from Update(), so a closed or tabbed-away profiler costs nothing.
+	 * Clicking a frame pauses the live view on it.
+	 */
+	class ProfilerPanel : public Panel
+	{
+		Q_OBJECT
+	public:
+		/** @brief How much history the live view shows. */
+		static constexpr qint64 kLiveWindowNs = 5'000'000'000;
+		static constexpr float kRefreshSeconds = 0.25f;
+
+		explicit ProfilerPanel(QWidget* parent = nullptr);
+
+		QWidget* GetWidget() override { return this; }
+		void Update(float deltaTime) override;
+
+	private:
+		QWidget* CreateToolBar();
+		void SaveCapture();
+		void LoadCapture();
+		void GoLive();
+		void SelectFrame(int frame);
+		void Refresh();
+		void FillTables(qint64 beginNs, qint64 endNs);
+
+	private:
+		ProfileCapture m_capture;
+		bool m_fromFile = false;
+		int m_selectedFrame = -1;       // index into m_capture.frames, -1 = newest
+		float m_sinceRefresh = kRefreshSeconds;
+
+		QToolButton* m_pauseButton;
+		QToolButton* m_liveButton;
+		QLabel* m_summary;
+		FrameGraphView* m_graph;
+		ZoneTimelineView* m_timeline;
+		QTreeWidget* m_tables;
+	};
+}
+
+#endif
\ No newline at end of file
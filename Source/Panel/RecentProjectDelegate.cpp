@@ -0,0 +1,83 @@
+#include "RecentProjectDelegate.h"
+#include "RecentProjectsModel.h"
+#include "../Core/EditorTheme.h"
+#include <QtCore/QDateTime>
+#include <QtGui/QPainter>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr int kRowHeight = 74;
+		constexpr int kMargin = 8;
+		constexpr int kThumbnailWidth = 103;   // 16:9 at the row's inner height
+		constexpr int kDateWidth = 130;
+	}
+
+	QSize RecentProjectDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex&) const
+	{
+		return QSize(option.rect.width(), kRowHeight);
+	}
+
+	void RecentProjectDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+	{
+		painter->save();
+
+		const QRect row = option.rect;
+		const bool selected = option.state & QStyle::State_Selected;
+		const bool hovered = option.state & QStyle::State_MouseOver;
+		const bool missing = index.data(RecentProjectsModel::StatusRole).toInt() == RecentProjectsModel::Missing;
+
+		if (selected) painter->fillRect(row, EditorTheme::Color(ThemeRole::Accent));
+		else if (hovered) painter->fillRect(row, EditorTheme::Color(ThemeRole::Input));
+		painter->setPen(EditorTheme::Color(ThemeRole::Input));
+		painter->drawLine(row.bottomLeft(), row.bottomRight());
+
+		const QRect thumbnailRect(row.left() + kMargin, row.top() + kMargin, kThumbnailWidth, row.height() - 2 * kMargin);
+		const QImage thumbnail = index.data(RecentProjectsModel::ThumbnailRole).value<QImage>();
+		if (!thumbnail.isNull())
+		{
+			painter->setRenderHint(QPainter::SmoothPixmapTransform);
+			painter->drawImage(thumbnailRect, thumbnail);
+		}
+		else
+		{
+			painter->fillRect(thumbnailRect, EditorTheme::Color(ThemeRole::Window));
+			painter->setPen(EditorTheme::Color(ThemeRole::ButtonHover));
+			painter->drawRect(thumbnailRect.adjusted(0, 0, -1, -1));
+		}
+
+		const QColor primary = EditorTheme::Color(selected ? ThemeRole::BrightText : (missing ? ThemeRole::MutedText : ThemeRole::Text));
+		const QColor secondary = selected ? EditorTheme::Color(ThemeRole::BrightText).darker(115) : EditorTheme::Color(ThemeRole::MutedText);
+
+		const int textLeft = thumbnailRect.right() + 2 * kMargin;
+		const QRect textRect(textLeft, row.top() + kMargin, row.right() - textLeft - kDateWidth - kMargin, row.height() - 2 * kMargin);
+		const int half = textRect.height() / 2;
+
+		QFont nameFont = option.font;
+		nameFont.setBold(true);
+		painter->setFont(nameFont);
+		painter->setPen(primary);
+		QString name = index.data(RecentProjectsModel::NameRole).toString();
+		if (missing) name += tr(" (missing)");
+		painter->drawText(QRect(textRect.left(), textRect.top(), textRect.width(), half), Qt::AlignLeft | Qt::AlignBottom,
+			QFontMetrics(nameFont).elidedText(name, Qt::ElideRight, textRect.width()));
+
+		QFont detailFont = option.font;
+		detailFont.setPointSizeF(option.font.pointSizeF() * 0.9);
+		painter->setFont(detailFont);
+		painter->setPen(secondary);
+		const QString directory = index.data(RecentProjectsModel::DirectoryRole).toString();
+		painter->drawText(QRect(textRect.left(), textRect.top() + half, textRect.width(), half), Qt::AlignLeft | Qt::AlignTop,
+			QFontMetrics(detailFont).elidedText(directory, Qt::ElideMiddle, textRect.width()));
+
+		const QDateTime modified = index.data(RecentProjectsModel::ModifiedRole).toDateTime();
+		if (modified.isValid())
+		{
+			const QRect dateRect(row.right() - kDateWidth - kMargin, row.top(), kDateWidth, row.height());
+			painter->drawText(dateRect, Qt::AlignRight | Qt::AlignVCenter, modified.toString("MM/dd/yyyy h:mm AP"));
+		}
+
+		painter->restore();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#ifndef RECENT_PROJECT_DELEGATE_H
+#define RECENT_PROJECT_DELEGATE_H
+
+#include <QtWidgets/QStyledItemDelegate>
+
+namespace Orca
+{
+	/**
+	 * @brief Paints a RecentProjectsModel row (thumbnail, name, folder, date) directly,
+	 *        instead of a widget tree per row.
+	 */
+	class RecentProjectDelegate : public QStyledItemDelegate
+	{
+	public:
+		using QStyledItemDelegate::QStyledItemDelegate;
+
+		void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+		QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "RecentProjectsModel.h"
+#include "../Asset/ContentHash.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QPointer>
+#include <QtCore/QSettings>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVariantMap>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr int kThumbnailWidth = 160;
+		constexpr int kThumbnailHeight = 90;
+	}
+
+	RecentProjectsModel::RecentProjectsModel(QObject* parent)
+		: QAbstractListModel(parent)
+	{
+		LoadIndex();
+		StartProbes();
+	}
+
+	int RecentProjectsModel::rowCount(const QModelIndex& parent) const
+	{
+		return parent.isValid() ? 0 : static_cast<int>(m_entries.size());
+	}
+
+	QVariant RecentProjectsModel::data(const QModelIndex& index, int role) const
+	{
+		if (!index.isValid() || index.row() >= static_cast<int>(m_entries.size())) return QVariant();
+
+		const Entry& entry = m_entries[static_cast<size_t>(index.row())];
+		switch (role)
+		{
+		case Qt::DisplayRole:
+		case NameRole: return entry.name;
+		case Qt::ToolTipRole:
+		case PathRole: return entry.path;
+		case DirectoryRole: return entry.directory;
+		case ModifiedRole: return entry.modifiedMs ? QDateTime::fromMSecsSinceEpoch(entry.modifiedMs) : QDateTime();
+		case StatusRole: return entry.status;
+		case ThumbnailRole: return entry.thumbnail;
+		default: return QVariant();
+		}
+	}
+
+	void RecentProjectsModel::LoadIndex()
+	{
+		// Pure settings reads: nothing here may touch the project files themselves.
+		QSettings settings("OrcaStudio", "OrcaStudio");
+		const QStringList paths = settings.value("RecentProjects/files", QStringList()).toStringList();
+		const QVariantMap cache = settings.value("RecentProjects/index", QVariantMap()).toMap();
+
+		m_entries.reserve(static_cast<size_t>(paths.size()));
+		for (const QString& path : paths)
+		{
+			Entry entry;
+			entry.path = path;
+
+			// String work only; QFileInfo would stat the file.
+			const QString normalized = QDir::fromNativeSeparators(path);
+			const qsizetype slash = normalized.lastIndexOf('/');
+			entry.directory = slash >= 0 ? normalized.left(slash) : QString();
+			entry.name = normalized.mid(slash + 1).section('.', 0, 0);
+
+			const QVariantMap cached = cache.value(path).toMap();
+			entry.modifiedMs = cached.value("modified", 0).toLongLong();
+			entry.status = cached.value("missing", false).toBool() ? Missing : Unknown;
+			m_entries.push_back(entry);
+		}
+	}
+
+	void RecentProjectsModel::SaveIndex() const
+	{
+		QVariantMap cache;
+		for (const Entry& entry : m_entries)
+		{
+			QVariantMap cached;
+			cached.insert("modified", entry.modifiedMs);
+			cached.insert("missing", entry.status == Missing);
+			cache.insert(entry.path, cached);
+		}
+
+		QSettings settings("OrcaStudio", "OrcaStudio");
+		settings.setValue("RecentProjects/index", cache);
+	}
+
+	void RecentProjectsModel::StartProbes()
+	{
+		QPointer<RecentProjectsModel> guard(this);
+		for (const Entry& entry : m_entries)
+		{
+			const QString path = entry.path;
+			QThreadPool::globalInstance()->start([guard, path]()
+			{
+				ProbeResult result;
+				result.path = path;
+
+				const QFileInfo info(path);
+				result.exists = info.isFile();
+				if (result.exists)
+				{
+					result.modifiedMs = info.lastModified().toMSecsSinceEpoch();
+					result.thumbnail.load(ThumbnailPath(path));
+				}
+
+				// The model may be gone by now; the guard is only dereferenced on the GUI thread.
+				QMetaObject::invokeMethod(QCoreApplication::instance(), [guard, result]()
+				{
+					if (guard) guard->ApplyProbe(result);
+				}, Qt::QueuedConnection);
+			});
+		}
+	}
+
+	void RecentProjectsModel::ApplyProbe(const ProbeResult& result)
+	{
+		for (size_t row = 0; row < m_entries.size(); ++row)
+		{
+			Entry& entry = m_entries[row];
+			if (entry.path != result.path) continue;
+
+			entry.status = result.exists ? Present : Missing;
+			if (result.exists) entry.modifiedMs = result.modifiedMs;
+			entry.thumbnail = result.thumbnail;
+
+			const QModelIndex changed = index(static_cast<int>(row));
+			emit dataChanged(changed, changed);
+			SaveIndex();
+			return;
+		}
+	}
+
+	void RecentProjectsModel::Remove(const QString& projectFile)
+	{
+		for (size_t row = 0; row < m_entries.size(); ++row)
+		{
+			if (m_entries[row].path != projectFile) continue;
+
+			beginRemoveRows(QModelIndex(), static_cast<int>(row), static_cast<int>(row));
+			m_entries.erase(m_entries.begin() + static_cast<std::ptrdiff_t>(row));
+			endRemoveRows();
+			break;
+		}
+
+		QSettings settings("OrcaStudio", "OrcaStudio");
+		QStringList paths = settings.value("RecentProjects/files", QStringList()).toStringList();
+		paths.removeAll(projectFile);
+		settings.setValue("RecentProjects/files", paths);
+		SaveIndex();
+		QFile::remove(ThumbnailPath(projectFile));
+	}
+
+	QString RecentProjectsModel::ThumbnailPath(const QString& projectFile)
+	{
+		const QByteArray key = QDir::cleanPath(projectFile).toUtf8();
+		const quint64 hash = ContentHash(key.constData(), static_cast<size_t>(key.size()));
+		return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+			+ QString("/Thumbnails/%1.png").arg(hash, 16, 16, QChar('0'));
+	}
+
+	bool RecentProjectsModel::SaveThumbnail(const QString& projectFile, const QImage& image)
+	{
+		if (image.isNull()) return false;
+
+		const QString path = ThumbnailPath(projectFile);
+		QDir().mkpath(QFileInfo(path).path());
+
+		// Fill the thumbnail and crop the overflow so the scene isn't squashed.
+		const QImage scaled = image.scaled(kThumbnailWidth, kThumbnailHeight, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+		const QImage cropped = scaled.copy((scaled.width() - kThumbnailWidth) / 2, (scaled.height() - kThumbnailHeight) / 2,
+			kThumbnailWidth, kThumbnailHeight);
+		return cropped.save(path, "PNG");
+	}
+}
\ No newline at end of file
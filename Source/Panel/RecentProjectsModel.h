@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef RECENT_PROJECTS_MODEL_H
+#define RECENT_PROJECTS_MODEL_H
+
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QStringList>
+#include <QtGui/QImage>
+#include <vector>
+
+namespace Orca
+{
+	/**
+	 * @brief The welcome screen's recent projects, shown straight from a cached index.
+	 *
+	 * Rows come from QSettings with the modification time and existence recorded the last time
+	 * they were checked, so the list is complete before any file system call. Each project is
+	 * then probed on its own pool thread (a stalled network mount only holds up its own row),
+	 * and rows update in place as answers and thumbnails arrive.
+	 */
+	class RecentProjectsModel : public QAbstractListModel
+	{
+		Q_OBJECT
+	public:
+		enum Role
+		{
+			PathRole = Qt::UserRole,
+			NameRole,
+			DirectoryRole,
+			ModifiedRole,     // QDateTime, invalid when never probed
+			StatusRole,       // Status
+			ThumbnailRole     // QImage, null when there is none
+		};
+
+		enum Status
+		{
+			Unknown,
+			Present,
+			Missing
+		};
+
+		explicit RecentProjectsModel(QObject* parent = nullptr);
+
+		int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+		QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+		/** @brief Drops a project from the list and from the persisted index. */
+		void Remove(const QString& projectFile);
+
+		/** @brief Where the thumbnail for a project is cached; local to this machine. */
+		static QString ThumbnailPath(const QString& projectFile);
+
+		/** @brief Saves the scene thumbnail shown for the project next time the launcher opens. */
+		static bool SaveThumbnail(const QString& projectFile, const QImage& image);
+
+	private:
+		struct Entry
+		{
+			QString path;
+			QString name;
+			QString directory;
+			qint64 modifiedMs = 0;
+			Status status = Unknown;
+			QImage thumbnail;
+		};
+
+		struct ProbeResult
+		{
+			QString path;
+			bool exists = false;
+			qint64 modifiedMs = 0;
+			QImage thumbnail;
+		};
+
+		void LoadIndex();
+		void SaveIndex() const;
+		void StartProbes();
+		void ApplyProbe(const ProbeResult& result);
+
+		std::vector<Entry> m_entries;
+	};
+}
+
+#endif
\ No newline at end of file
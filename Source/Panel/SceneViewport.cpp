@@ -1,60 +1,40 @@
 #include "SceneViewport.h"
+#include "../Core/EditorStats.h"
+#include "../Core/EditorTickScheduler.h"
+#include "../Core/MemoryTracker.h"
+#include "../Core/PlaySession.h"
+#include "../Core/Profiler.h"
+#include "../Core/StartupTrace.h"
 #include <Renderer/Mesh.h>
 #include <QtGui/QSurfaceFormat>
 #include <QtGui/QVector3D>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QtMath>
+#include <QtGui/QOpenGLContext>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <Core/Logger.h>
 
-static const float cubeVertices[] = 
-{
-	-1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
-	 1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
-	 1.0f,  1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
-	-1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
-	 1.0f,  1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
-	-1.0f,  1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
-
-	 1.0f, -1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-	-1.0f, -1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-	-1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-	 1.0f, -1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-	-1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-	 1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
-
-	  1.0f, -1.0f,  1.0f, 0.0f, 0.0f, 1.0f,
-	  1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 1.0f,
-	  1.0f,  1.0f, -1.0f, 0.0f, 0.0f, 1.0f,
-	  1.0f, -1.0f,  1.0f, 0.0f, 0.0f, 1.0f,
-	  1.0f,  1.0f, -1.0f, 0.0f, 0.0f, 1.0f,
-	  1.0f,  1.0f,  1.0f, 0.0f, 0.0f, 1.0f,
-
-	  -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 0.0f,
-	  -1.0f, -1.0f,  1.0f, 1.0f, 1.0f, 0.0f,
-	  -1.0f,  1.0f,  1.0f, 1.0f, 1.0f, 0.0f,
-	  -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 0.0f,
-	  -1.0f,  1.0f,  1.0f, 1.0f, 1.0f, 0.0f,
-	  -1.0f,  1.0f, -1.0f, 1.0f, 1.0f, 0.0f,
-
-	  -1.0f,  1.0f,  1.0f, 0.0f, 1.0f, 1.0f,
-	   1.0f,  1.0f,  1.0f, 0.0f, 1.0f, 1.0f,
-	   1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 1.0f,
-	  -1.0f,  1.0f,  1.0f, 0.0f, 1.0f, 1.0f,
-	   1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 1.0f,
-	  -1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 1.0f,
-
-	  -1.0f, -1.0f, -1.0f, 1.0f, 0.0f, 1.0f,
-	   1.0f, -1.0f, -1.0f, 1.0f, 0.0f, 1.0f,
-	   1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 1.0f,
-	  -1.0f, -1.0f, -1.0f, 1.0f, 0.0f, 1.0f,
-	   1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 1.0f,
-	  -1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 1.0f
-};
-
 namespace Orca
 {
-	static float s_RotationAngle = 0.0f;
+	static constexpr float kNearPlane = 0.1f;
+	static constexpr int kInstanceMatrixUnit = 4;    // after the lighting's 0-2 and the shadow map's 3
 
-	SceneViewport::SceneViewport(QWidget* parent)
+	static const char* CameraName(ViewportCamera camera)
+	{
+		switch (camera)
+		{
+		case ViewportCamera::Top: return "Top View";
+		case ViewportCamera::Front: return "Front View";
+		case ViewportCamera::Game: return "Game View";
+		default: return "Scene Viewport";
+		}
+	}
+
+	SceneViewport::SceneViewport(QWidget* parent, ViewportCamera camera)
 		: QOpenGLWidget(parent)
+		, m_Camera(camera)
 	{
 		QSurfaceFormat format;
 		format.setDepthBufferSize(24);
@@ -62,22 +42,69 @@ namespace Orca
 		format.setProfile(QSurfaceFormat::CoreProfile);
 		setFormat(format);
 
-		connect(&m_Timer, &QTimer::timeout, this, [this]()
-			{
-				this->update();
-			});
+		// Only repaints while something animates, so a still viewport costs nothing per tick.
+		// Hidden and tabbed-away viewports aren't ticked or painted at all.
+		EditorTickScheduler::Get().Register(this, CameraName(camera), [this](float deltaTime) { Tick(deltaTime); });
 
 		setFocusPolicy(Qt::StrongFocus);
-		setWindowTitle(tr("Scene Viewport"));
+		setWindowTitle(tr(CameraName(camera)));
 	}
 
 	SceneViewport::~SceneViewport()
 	{
+		// The context outlives this part of the object; don't let its teardown call back in.
+		if (context()) QObject::disconnect(context(), nullptr, this, nullptr);
+		ReleaseGL();
+	}
+
+	void SceneViewport::ReleaseGL()
+	{
+		// Also runs when a floating dock moves the viewport to a new context.
+		makeCurrent();
+		m_RenderGraph.Clear();
+		m_Lighting.Clear();
+		m_Shadows.Clear();
+		m_IndexBuffer.destroy();
+		m_VAO.destroy();
+		for (auto& pair : m_GpuTimers)
+		{
+			for (QOpenGLTimerQuery& query : pair) query.destroy();
+		}
+		std::fill(std::begin(m_GpuTimerPending), std::end(m_GpuTimerPending), false);
+		if (m_ResourcesAcquired) RenderResourceCache::Get().Release();
+		m_ResourcesAcquired = false;
+		m_Program = nullptr;
+		m_ShadowProgram = nullptr;
+		doneCurrent();
+	}
+
+	void SceneViewport::SetProjectRoot(const QString& projectRoot)
+	{
+		RenderResourceCache::Get().Shaders().SetProjectRoot(projectRoot);
+		ReloadShaders({ "." });
+	}
+
+	void SceneViewport::ReloadShaders(const QStringList& changedPaths)
+	{
+		// Before initializeGL() there is nothing to reload; Load() will pick the overrides up.
+		if (!isValid() || !m_Program) return;
+
+		// Other viewports pick the new programs up through the shader generation.
 		makeCurrent();
-		delete m_Program;
+		if (RenderResourceCache::Get().ReloadShaders(changedPaths) > 0) update();
 		doneCurrent();
 	}
 
+	void SceneViewport::RefreshPrograms()
+	{
+		RenderResourceCache& cache = RenderResourceCache::Get();
+		if (m_ShaderGeneration == cache.ShaderGeneration()) return;
+
+		m_Program = cache.Shaders().Program("Forward");
+		m_ShadowProgram = cache.Shaders().Program("ShadowDepth");
+		m_ShaderGeneration = cache.ShaderGeneration();
+	}
+
 	bool SceneViewport::InitializeShaders()
 	{
 		const char* vertexSrc = 
@@ -85,46 +112,163 @@ namespace Orca
 			"\n"
 			"layout (location = 0) in vec3 aPos;\n"
 			"layout (location = 1) in vec3 aColor;\n"
+			"layout (location = 2) in uint aInstance;\n"
 			"\n"
 			"uniform mat4 model;\n"
 			"uniform mat4 view;\n"
 			"uniform mat4 projection;\n"
+			"uniform samplerBuffer instanceMatrices;   // four texels per instance, one per column\n"
 			"\n"
 			"out vec3 vColor;\n"
+			"out vec3 vWorldPos;\n"
+			"out float vViewDepth;\n"
+			"\n"
+			"mat4 InstanceMatrix()\n"
+			"{\n"
+			"    int texel = int(aInstance) * 4;\n"
+			"    return mat4(texelFetch(instanceMatrices, texel), texelFetch(instanceMatrices, texel + 1),\n"
+			"                texelFetch(instanceMatrices, texel + 2), texelFetch(instanceMatrices, texel + 3));\n"
+			"}\n"
 			"\n"
 			"void main()\n"
 			"{\n"
-			"    gl_Position = projection * view * model * vec4(aPos, 1.0);\n"
+			"    vec4 world = model * InstanceMatrix() * vec4(aPos, 1.0);\n"
+			"    vec4 viewPos = view * world;\n"
+			"    gl_Position = projection * viewPos;\n"
 			"    vColor = aColor;\n"
+			"    vWorldPos = world.xyz;\n"
+			"    vViewDepth = -viewPos.z;\n"
 			"}\n";
 
+		// Point and spot lights come from the cluster under the fragment; see ClusteredLighting.
 		const char* fragmentSrc =
 			"#version 330 core\n"
 			"\n"
 			"in vec3 vColor;\n"
+			"in vec3 vWorldPos;\n"
+			"in float vViewDepth;\n"
 			"out vec4 FragColor;\n"
 			"\n"
+			"uniform int lightingEnabled;\n"
+			"uniform vec3 ambientLight;\n"
+			"uniform int directionalCount;\n"
+			"uniform vec3 directionalDirections[4];\n"
+			"uniform vec3 directionalColors[4];\n"
+			"\n"
+			"uniform samplerBuffer lights;        // position + range, color + cos outer, direction + cos inner\n"
+			"uniform usamplerBuffer clusterGrid;  // first index + count per cluster\n"
+			"uniform usamplerBuffer lightIndices;\n"
+			"uniform ivec3 clusterCounts;\n"
+			"uniform vec2 clusterTileSize;\n"
+			"uniform vec2 clusterDepth;           // slice = log(depth) * x + y\n"
+			"\n"
+			"uniform int shadowsEnabled;\n"
+			"uniform sampler2DArrayShadow shadowMap;\n"
+			"uniform mat4 shadowMatrices[4];\n"
+			"uniform vec4 cascadeSplits;          // far distance of each cascade\n"
+			"uniform vec4 cascadeTexelSizes;      // world units per shadow texel\n"
+			"\n"
+			"float DirectionalShadow(vec3 normal)\n"
+			"{\n"
+			"	if (shadowsEnabled == 0) return 1.0;\n"
+			"\n"
+			"	int cascade = int(dot(vec4(greaterThan(vec4(vViewDepth), cascadeSplits)), vec4(1.0)));\n"
+			"	if (cascade > 3) return 1.0;\n"
+			"\n"
+			"	// Pushing the lookup out along the normal by about a texel keeps slopes from shadowing themselves.\n"
+			"	vec3 position = vWorldPos + normal * cascadeTexelSizes[cascade] * 1.5;\n"
+			"	vec4 coord = shadowMatrices[cascade] * vec4(position, 1.0);\n"
+			"	if (any(lessThan(coord.xyz, vec3(0.0))) || any(greaterThan(coord.xyz, vec3(1.0)))) return 1.0;\n"
+			"	return texture(shadowMap, vec4(coord.xy, float(cascade), coord.z));\n"
+			"}\n"
+			"\n"
 			"void main()\n"
 			"{\n"
-			"	FragColor = vec4(vColor, 1.0);\n"
+			"	if (lightingEnabled == 0)\n"
+			"	{\n"
+			"		FragColor = vec4(vColor, 1.0);\n"
+			"		return;\n"
+			"	}\n"
+			"\n"
+			"	vec3 normal = normalize(cross(dFdx(vWorldPos), dFdy(vWorldPos)));\n"
+			"	vec3 light = ambientLight;\n"
+			"	for (int i = 0; i < directionalCount; ++i)\n"
+			"	{\n"
+			"		float shadow = i == 0 ? DirectionalShadow(normal) : 1.0;\n"
+			"		light += directionalColors[i] * max(dot(normal, -directionalDirections[i]), 0.0) * shadow;\n"
+			"	}\n"
+			"	if (clusterCounts.z == 0)\n"
+			"	{\n"
+			"		FragColor = vec4(vColor * light, 1.0);\n"
+			"		return;\n"
+			"	}\n"
+			"\n"
+			"	ivec2 tile = clamp(ivec2(gl_FragCoord.xy / clusterTileSize), ivec2(0), clusterCounts.xy - 1);\n"
+			"	int slice = clamp(int(floor(log(max(vViewDepth, 1e-4)) * clusterDepth.x + clusterDepth.y)), 0, clusterCounts.z - 1);\n"
+			"	uvec2 range = texelFetch(clusterGrid, (slice * clusterCounts.y + tile.y) * clusterCounts.x + tile.x).xy;\n"
+			"	for (uint i = 0u; i < range.y; ++i)\n"
+			"	{\n"
+			"		int texel = int(texelFetch(lightIndices, int(range.x + i)).x) * 3;\n"
+			"		vec4 positionRange = texelFetch(lights, texel);\n"
+			"		vec4 colorOuter = texelFetch(lights, texel + 1);\n"
+			"		vec4 directionInner = texelFetch(lights, texel + 2);\n"
+			"\n"
+			"		vec3 toLight = positionRange.xyz - vWorldPos;\n"
+			"		float lightDistance = length(toLight);\n"
+			"		vec3 direction = toLight / max(lightDistance, 1e-4);\n"
+			"		float window = clamp(1.0 - pow(lightDistance / positionRange.w, 4.0), 0.0, 1.0);\n"
+			"		float attenuation = window * window / (lightDistance * lightDistance + 1.0);\n"
+			"		if (colorOuter.w > -1.5)\n"
+			"		{\n"
+			"			attenuation *= smoothstep(colorOuter.w, directionInner.w, dot(-direction, directionInner.xyz));\n"
+			"		}\n"
+			"		light += colorOuter.rgb * max(dot(normal, direction), 0.0) * attenuation;\n"
+			"	}\n"
+			"\n"
+			"	FragColor = vec4(vColor * light, 1.0);\n"
 			"}\n";
 
-		m_Program = new QOpenGLShaderProgram(this);
-
-		if (!m_Program->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexSrc))
-		{
-			Logger::Log(LogLevel::Warning, "Couldn't compile the vertex shader!");
-			return false;
-		}
-		if (!m_Program->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentSrc))
+		// The first viewport builds the programs; the rest find them in the shared library.
+		ShaderLibrary& shaders = RenderResourceCache::Get().Shaders();
+		m_ShaderGeneration = RenderResourceCache::Get().ShaderGeneration();
+		m_Program = shaders.Program("Forward");
+		if (!m_Program) m_Program = shaders.Load("Forward", vertexSrc, fragmentSrc);
+		if (!m_Program)
 		{
-			Logger::Log(LogLevel::Warning, "Couldn't compile the fragment shader!");
+			Logger::Log(LogLevel::Warning, "Couldn't build the shader program!");
 			return false;
 		}
-		if (!m_Program->link())
+
+		// Depth only, for the shadow cascades; same attribute locations as Forward.
+		const char* shadowVertexSrc =
+			"#version 330 core\n"
+			"\n"
+			"layout (location = 0) in vec3 aPos;\n"
+			"layout (location = 2) in uint aInstance;\n"
+			"\n"
+			"uniform mat4 lightViewProjection;\n"
+			"uniform samplerBuffer instanceMatrices;\n"
+			"\n"
+			"void main()\n"
+			"{\n"
+			"    int texel = int(aInstance) * 4;\n"
+			"    mat4 world = mat4(texelFetch(instanceMatrices, texel), texelFetch(instanceMatrices, texel + 1),\n"
+			"                      texelFetch(instanceMatrices, texel + 2), texelFetch(instanceMatrices, texel + 3));\n"
+			"    gl_Position = lightViewProjection * world * vec4(aPos, 1.0);\n"
+			"}\n";
+
+		const char* shadowFragmentSrc =
+			"#version 330 core\n"
+			"\n"
+			"void main()\n"
+			"{\n"
+			"}\n";
+
+		m_ShadowProgram = shaders.Program("ShadowDepth");
+		if (!m_ShadowProgram) m_ShadowProgram = shaders.Load("ShadowDepth", shadowVertexSrc, shadowFragmentSrc);
+		if (!m_ShadowProgram)
 		{
-			Logger::Log(LogLevel::Warning, "Couldn't link the shader program!");
-			return false;
+			Logger::Log(LogLevel::Warning, "Couldn't build the shadow shader program; shadows are off.");
 		}
 
 		return true;
@@ -132,15 +276,16 @@ namespace Orca
 
 	void SceneViewport::InitializeGeometry()
 	{
+		if (!m_Program) return;
+
+		// Vertex arrays aren't shared between contexts, so each viewport points its own at the
+		// shared mesh.
 		m_VAO.create();
 		m_VAO.bind();
 
-		m_VBO.create();
-		m_VBO.bind();
-
-		m_VBO.allocate(cubeVertices, sizeof(cubeVertices));
+		this->glBindBuffer(GL_ARRAY_BUFFER, RenderResourceCache::Get().MeshBuffer());
 
-		const int stride = 6 * sizeof(float);
+		const int stride = RenderResourceCache::kMeshStride * sizeof(float);
 
 		m_Program->bind();
 
@@ -150,12 +295,96 @@ namespace Orca
 		m_Program->enableAttributeArray(1);
 		m_Program->setAttributeBuffer(1, GL_FLOAT, 3 * sizeof(float), 3, stride);
 
+		// Each drawn instance reads its matrix from the shared buffer by this index.
+		static const uint32_t previewInstance = 0;
+		m_IndexBuffer.create();
+		m_IndexBuffer.bind();
+		m_IndexBuffer.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+		m_IndexBuffer.allocate(&previewInstance, sizeof(previewInstance));
+
+		this->glEnableVertexAttribArray(2);
+		this->glVertexAttribIPointer(2, 1, GL_UNSIGNED_INT, sizeof(uint32_t), nullptr);
+		this->glVertexAttribDivisor(2, 1);
+
 		m_VAO.release();
-		m_VBO.release();
+		m_IndexBuffer.release();
+		this->glBindBuffer(GL_ARRAY_BUFFER, 0);
+		m_DrawCount = 1;
+		m_IndicesDirty = true;
+	}
+
+	void SceneViewport::BuildRenderGraph()
+	{
+		m_RenderGraph.Reset();
+		const RenderResource backbuffer = m_RenderGraph.ImportBackbuffer("Backbuffer");
+		const RenderResource shadowMap = m_RenderGraph.ImportTexture("Shadow Map");
+
+		m_RenderGraph.AddPass("Light Culling",
+			[](RenderPassBuilder& pass) { pass.SideEffect(); },
+			[this]() { m_Lighting.Update(ViewMatrix(), m_Projection, m_ClipNear, m_ClipFar); });
+
+		// World-anchored pages make this free until the camera leaves them or static casters change.
+		m_RenderGraph.AddPass("Shadows",
+			[shadowMap](RenderPassBuilder& pass) { pass.Write(shadowMap); },
+			[this]()
+			{
+				if (!m_ShadowProgram) return;
+				const float* direction = m_Lighting.DirectionalCount() > 0 ? m_Lighting.DirectionalDirection(0) : nullptr;
+				const RenderResourceCache& cache = RenderResourceCache::Get();
+				m_Shadows.Render(ViewMatrix(), m_Projection, m_ClipNear, m_ClipFar, direction,
+					cache.InstanceTexture(), cache.StaticVersion(), *m_ShadowProgram);
+			});
+
+		m_RenderGraph.AddPass("Occlusion Culling",
+			[](RenderPassBuilder& pass) { pass.SideEffect(); },
+			[this]() { CullInstances(); });
+
+		m_RenderGraph.AddPass("Scene",
+			[backbuffer, shadowMap](RenderPassBuilder& pass)
+			{
+				pass.Read(shadowMap);
+				pass.WriteColor(backbuffer);
+			},
+			[this]() { DrawScene(); });
+
+		m_RenderGraph.AddPass("Texture Streaming",
+			[](RenderPassBuilder& pass) { pass.SideEffect(); },
+			[this]() { RenderResourceCache::Get().Textures().Update(m_FrameArena); });
+	}
+
+	size_t SceneViewport::UploadInstances(const std::vector<float>& matrices, size_t first, size_t maxCount)
+	{
+		if (!isValid() || !m_ResourcesAcquired) return 0;
+
+		// The next frame of each viewport re-indexes (and re-culls) against the new version.
+		makeCurrent();
+		const size_t count = RenderResourceCache::Get().UploadInstances(matrices, first, maxCount, false);
+		doneCurrent();
+
+		update();
+		return count;
+	}
+
+	void SceneViewport::SetCameraTarget(const QVector3D& target)
+	{
+		m_CameraTarget = target;
+		update();
+	}
+
+	void SceneViewport::FrameBounds(const QVector3D& center, float radius)
+	{
+		// Far enough back that the sphere fits the 45 degree field of view; the orthographic
+		// views show the same height.
+		m_CameraTarget = center;
+		m_CameraDistance = std::max(5.0f, radius / std::sin(qDegreesToRadians(22.5f)));
+		m_FarPlane = std::max(100.0f, m_CameraDistance + 2.0f * radius);
+		UpdateProjection(height() > 0 ? static_cast<float>(width()) / height() : 1.0f);
+		update();
 	}
 
 	void SceneViewport::initializeGL()
 	{
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
 		this->initializeOpenGLFunctions();
 
 		Logger::Log(LogLevel::Info, std::string("OpenGL context version: ") + (const char*)this->glGetString(GL_VERSION));
@@ -163,54 +392,342 @@ namespace Orca
 		this->glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 		this->glEnable(GL_DEPTH_TEST);
 
+		// Programs, the mesh, instances and textures are created by whichever viewport comes first.
+		RenderResourceCache& cache = RenderResourceCache::Get();
+		cache.Acquire();
+		m_ResourcesAcquired = true;
+		QObject::connect(context(), &QOpenGLContext::aboutToBeDestroyed, this, [this]() { ReleaseGL(); });
+
 		if (!this->InitializeShaders())
 		{
 			Logger::Log(LogLevel::Fatal, "Failed to initialize OpenGL Shaders!");
 		}
 		this->InitializeGeometry();
+		m_Lighting.Initialize();
+		m_Shadows.Initialize(cache.MeshBuffer(), RenderResourceCache::kMeshVertexCount);
+		m_Occlusion.SetMesh(RenderResourceCache::MeshVertices(), RenderResourceCache::kMeshVertexCount, RenderResourceCache::kMeshStride);
+		m_RenderGraph.Initialize();
+		BuildRenderGraph();
+
+		// Timer queries are optional (GL 3.3 has them, GLES/software contexts may not).
+		m_GpuTimersReady = true;
+		for (auto& pair : m_GpuTimers)
+		{
+			for (QOpenGLTimerQuery& query : pair) m_GpuTimersReady = m_GpuTimersReady && query.create();
+		}
+	}
+
+	void SceneViewport::CollectGpuTimings()
+	{
+		int slot = m_GpuTimerFrame % kGpuTimerQueries;
+		if (!m_GpuTimerPending[slot]) return;
+
+		QOpenGLTimerQuery* pair = m_GpuTimers[slot];
+		if (!pair[1].isResultAvailable()) return;
+
+		GLuint64 begin = pair[0].waitForResult();
+		GLuint64 end = pair[1].waitForResult();
+		EditorStats::Get().RecordGpuTime((end - begin) / 1e6);
+		ORCA_PROFILE_GPU(m_GpuTimerProfileFrame[slot], (end - begin) / 1e6);
+		m_GpuTimerPending[slot] = false;
+	}
+
+	std::vector<double> SceneViewport::RenderBenchmarkFrames(int frames, bool panCamera, const std::function<void()>& beforeFrame)
+	{
+		std::vector<double> times;
+		if (!isValid()) return times;
+
+		RefreshPrograms();
+		if (!m_Program || !m_Program->isLinked()) return times;
+
+		const QVector3D target = m_CameraTarget;
+		const float panRadius = 0.1f * m_CameraDistance;
+		times.reserve(static_cast<size_t>(frames));
+		QElapsedTimer timer;
+		for (int i = 0; i < frames; ++i)
+		{
+			timer.start();
+			if (panCamera)
+			{
+				const float angle = qDegreesToRadians(360.0f * (m_BenchmarkPanFrame++ % kBenchmarkPanFrames) / kBenchmarkPanFrames);
+				m_CameraTarget = target + panRadius * QVector3D(std::cos(angle), 0.0f, std::sin(angle));
+			}
+
+			// Tick() makes the context current for its uploads and releases it again.
+			Tick(1.0f / 60.0f);
+			makeCurrent();
+			if (beforeFrame) beforeFrame();
+			glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
+			paintGL();
+			glFinish();
+			doneCurrent();
+			times.push_back(timer.nsecsElapsed() / 1e6);
+		}
+
+		m_CameraTarget = target;
+		update();
+		return times;
 	}
 
 	void SceneViewport::paintGL()
 	{
+		RefreshPrograms();
 		if (!m_Program || !m_Program->isLinked()) return;
 
+		// The editor tick marks frames; every view painted until the next tick belongs to the current one.
+		const uint64_t profileFrame = ORCA_PROFILE_CURRENT_FRAME();
+		ORCA_PROFILE_ZONE("SceneViewport::Paint");
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+		const uint64_t allocationsBefore = MemoryTracker::Stats(MemoryTag::Renderer).allocations;
+		m_FrameArena.Reset();
+		QElapsedTimer cpuTimer;
+		cpuTimer.start();
+
+		int timerSlot = m_GpuTimerFrame % kGpuTimerQueries;
+		if (m_GpuTimersReady)
+		{
+			CollectGpuTimings();
+			if (!m_GpuTimerPending[timerSlot])
+			{
+				m_GpuTimers[timerSlot][0].recordTimestamp();
+				m_GpuTimerProfileFrame[timerSlot] = profileFrame;
+			}
+		}
+
+		// Compiles once, then again only on resize; a compiled graph doesn't allocate.
+		if (m_RenderGraph.NeedsCompile(m_FramebufferWidth, m_FramebufferHeight))
+		{
+			m_RenderGraph.Compile(m_FramebufferWidth, m_FramebufferHeight);
+		}
+		m_RenderGraph.Execute(defaultFramebufferObject());
+
+		if (m_GpuTimersReady && !m_GpuTimerPending[timerSlot])
+		{
+			m_GpuTimers[timerSlot][1].recordTimestamp();
+			m_GpuTimerPending[timerSlot] = true;
+		}
+		++m_GpuTimerFrame;
+
+		m_FrameHeapAllocations = m_TickHeapAllocations + MemoryTracker::Stats(MemoryTag::Renderer).allocations - allocationsBefore;
+		m_TickHeapAllocations = 0;
+		EditorStats::Get().RecordFrame(cpuTimer.nsecsElapsed() / 1e6, 1, 12 * static_cast<uint64_t>(m_DrawCount), m_FrameHeapAllocations);
+		ORCA_PROFILE_COUNTER("Draw calls", 1);
+		ORCA_PROFILE_COUNTER("Triangles", 12 * static_cast<uint64_t>(m_DrawCount));
+		ORCA_PROFILE_COUNTER("Frame heap allocations", m_FrameHeapAllocations);
+		MemoryTracker::PublishCounters();
+		StartupTrace::Finish("first frame");
+	}
+
+	void SceneViewport::CullInstances()
+	{
+		const RenderResourceCache& cache = RenderResourceCache::Get();
+		const uint64_t version = cache.InstanceVersion();
+		const size_t count = cache.InstanceCount();
+		const bool culling = m_OcclusionCulling && cache.SceneLoaded();
+
+		// A still camera over still instances keeps the last result and costs nothing.
+		const QMatrix4x4 viewProjection = m_Projection * ViewMatrix();
+		if (!m_IndicesDirty && version == m_IndexedVersion && (!culling || viewProjection == m_CulledViewProjection)) return;
+
+		m_IndexedVersion = version;
+		m_CulledViewProjection = viewProjection;
+		if (culling)
+		{
+			m_Occlusion.Cull(cache.InstanceMatrices(), count, viewProjection, m_VisibleInstances);
+		}
+		else
+		{
+			// Everything, which only needs a new list when the count changes.
+			if (!m_IndicesDirty && m_VisibleInstances.size() == count) return;
+			m_VisibleInstances.resize(count);
+			std::iota(m_VisibleInstances.begin(), m_VisibleInstances.end(), 0u);
+		}
+		m_IndicesDirty = false;
+
+		// 4 bytes per drawn instance; the matrices themselves are uploaded once for every view.
+		m_IndexBuffer.bind();
+		m_IndexBuffer.allocate(m_VisibleInstances.data(), static_cast<int>(m_VisibleInstances.size() * sizeof(uint32_t)));
+		m_IndexBuffer.release();
+		m_DrawCount = m_VisibleInstances.size();
+	}
+
+	void SceneViewport::DrawScene()
+	{
 		this->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		m_Program->bind();
 		m_VAO.bind();
 
-		QMatrix4x4 view;
-		view.lookAt(QVector3D(0.0f, 0.0f, 5.0f),
-			QVector3D(0.0f, 0.0f, 0.0f),
-			QVector3D(0.0f, 1.0f, 0.0f));
-
 		QMatrix4x4 model;
 
-		model.rotate(s_RotationAngle, 0.0f, 1.0f, 0.0f);
-
-		s_RotationAngle += 0.5f;
-		if (s_RotationAngle > 360.0f) 
+		const RenderResourceCache& cache = RenderResourceCache::Get();
+		if (!cache.SceneLoaded())
 		{
-			s_RotationAngle -= 360.0f;
+			model.rotate(m_PreviewAngle, 0.0f, 1.0f, 0.0f);
 		}
 
 		m_Program->setUniformValue("projection", m_Projection);
-		m_Program->setUniformValue("view", view);
+		m_Program->setUniformValue("view", ViewMatrix());
 		m_Program->setUniformValue("model", model);
+		m_Lighting.Bind(*m_Program, 0, m_FramebufferWidth, m_FramebufferHeight);
+		m_Shadows.Bind(*m_Program, 3);
+
+		m_Program->setUniformValue("instanceMatrices", kInstanceMatrixUnit);
+		this->glActiveTexture(GL_TEXTURE0 + kInstanceMatrixUnit);
+		this->glBindTexture(GL_TEXTURE_BUFFER, cache.InstanceTexture());
+		this->glActiveTexture(GL_TEXTURE0);
 
-		this->glDrawArrays(GL_TRIANGLES, 0, 36);
+		this->glDrawArraysInstanced(GL_TRIANGLES, 0, RenderResourceCache::kMeshVertexCount, static_cast<GLsizei>(m_DrawCount));
 
 		m_VAO.release();
 		m_Program->release();
 	}
 
-	void SceneViewport::resizeGL(int w, int h)
+	const float* SceneViewport::GameCameraMatrix() const
 	{
-		this->glViewport(0, 0, w, h);
+		// Read from the shared instances, so the game view follows a camera moved by play mode.
+		const RenderResourceCache& cache = RenderResourceCache::Get();
+		if (m_Camera != ViewportCamera::Game || m_SceneCamera.entity == SceneCamera::kNone || !cache.SceneLoaded()) return nullptr;
+		if (m_SceneCamera.entity >= cache.InstanceCount()) return nullptr;
+		return cache.InstanceMatrices() + static_cast<size_t>(m_SceneCamera.entity) * 16;
+	}
 
-		m_Projection.setToIdentity();
+	QMatrix4x4 SceneViewport::ViewMatrix() const
+	{
+		QMatrix4x4 view;
+		if (const float* world = GameCameraMatrix())
+		{
+			// The camera looks along its entity's +Z axis, with the entity's +Y up.
+			const QVector3D eye(world[12], world[13], world[14]);
+			const QVector3D forward(world[8], world[9], world[10]);
+			view.lookAt(eye, eye + forward.normalized(), QVector3D(world[4], world[5], world[6]));
+		}
+		else if (m_Camera == ViewportCamera::Top)
+		{
+			view.lookAt(m_CameraTarget + QVector3D(0.0f, m_CameraDistance, 0.0f),
+				m_CameraTarget,
+				QVector3D(0.0f, 0.0f, -1.0f));
+		}
+		else
+		{
+			view.lookAt(m_CameraTarget + QVector3D(0.0f, 0.0f, m_CameraDistance),
+				m_CameraTarget,
+				QVector3D(0.0f, 1.0f, 0.0f));
+		}
+		return view;
+	}
+
+	void SceneViewport::SetScene(std::shared_ptr<const LoadedScene> scene)
+	{
+		if (scene)
+		{
+			m_Lighting.SetLights(scene->lights, scene->ambientLight);
+			m_Lighting.SetTransforms(scene->worldMatrices);
+		}
+		m_SceneCamera = scene ? scene->camera : SceneCamera();
+		m_Occlusion.SetOccluders(scene ? scene->renderFlags : std::vector<uint8_t>());
+		m_Shadows.SetScene(std::move(scene));
+		m_IndicesDirty = true;
+		UpdateProjection(height() > 0 ? static_cast<float>(width()) / height() : 1.0f);
+		update();
+	}
+
+	void SceneViewport::SetOcclusionCulling(bool enabled)
+	{
+		if (m_OcclusionCulling == enabled) return;
+
+		// The next frame rebuilds the instance list: the culled set, or back to everything.
+		m_OcclusionCulling = enabled;
+		m_IndicesDirty = true;
+		update();
+	}
+
+	void SceneViewport::SetCastsShadows(uint32_t entity, bool castsShadows)
+	{
+		m_Shadows.SetCastsShadows(entity, castsShadows);
+		update();
+	}
+
+	void SceneViewport::SetPlaySession(PlaySession* session)
+	{
+		m_PlaySession = session;
+		m_PlayStep = ~uint64_t(0);
+		RenderResourceCache::Get().SetPlayStep(~uint64_t(0));
+	}
+
+	void SceneViewport::Tick(float deltaTime)
+	{
+		RenderResourceCache& cache = RenderResourceCache::Get();
+		if (m_PlaySession)
+		{
+			const PlayFrame& frame = m_PlaySession->Latest();
+			if (!frame.worldMatrices.empty() && frame.step != m_PlayStep && isValid() && m_ResourcesAcquired)
+			{
+				m_PlayStep = frame.step;
+
+				// Every viewport follows the session; the first one to see a step uploads it for all.
+				const bool upload = cache.PlayStep() != frame.step;
+				if (upload) makeCurrent();
+				{
+					// Part of the next frame's work, so charged to it (see LastFrameHeapAllocations).
+					MemoryTagScope memoryTag(MemoryTag::Renderer);
+					const uint64_t allocationsBefore = MemoryTracker::Stats(MemoryTag::Renderer).allocations;
+
+					// Only rigidbodies move, so the cached static shadow pages stay valid.
+					if (upload) cache.UploadInstances(frame.worldMatrices, 0, frame.worldMatrices.size() / 16, true);
+					m_Lighting.SetTransforms(frame.worldMatrices);
+					m_TickHeapAllocations += MemoryTracker::Stats(MemoryTag::Renderer).allocations - allocationsBefore;
+				}
+				if (upload)
+				{
+					doneCurrent();
+					cache.SetPlayStep(frame.step);
+				}
+				update();
+			}
+			return;
+		}
+
+		// Another viewport uploaded instances or rebuilt the shaders.
+		if (cache.InstanceVersion() != m_IndexedVersion || cache.ShaderGeneration() != m_ShaderGeneration) update();
+
+		if (cache.SceneLoaded()) return;
+
+		m_PreviewAngle = std::fmod(m_PreviewAngle + 30.0f * deltaTime, 360.0f);
+		update();
+	}
+
+	void SceneViewport::resizeGL(int w, int h)
+	{
+		// The graph sets the viewport per pass, in device pixels.
+		m_FramebufferWidth = std::max(1, static_cast<int>(std::lround(w * devicePixelRatioF())));
+		m_FramebufferHeight = std::max(1, static_cast<int>(std::lround(h * devicePixelRatioF())));
 
 		float aspectRatio = (h > 0) ? (float)w / h : 1.0f;
-		m_Projection.perspective(45.0f, aspectRatio, 0.1f, 100.0f);
+		UpdateProjection(aspectRatio);
+	}
+
+	void SceneViewport::UpdateProjection(float aspectRatio)
+	{
+		m_Projection.setToIdentity();
+		m_ClipNear = kNearPlane;
+		m_ClipFar = m_FarPlane;
+		if (m_Camera == ViewportCamera::Game && m_SceneCamera.entity != SceneCamera::kNone)
+		{
+			m_ClipNear = m_SceneCamera.nearPlane;
+			m_ClipFar = m_SceneCamera.farPlane;
+			m_Projection.perspective(m_SceneCamera.fieldOfView, aspectRatio, m_ClipNear, m_ClipFar);
+		}
+		else if (m_Camera == ViewportCamera::Top || m_Camera == ViewportCamera::Front)
+		{
+			// As tall as the perspective view's field of view at the framed target.
+			const float halfHeight = m_CameraDistance * std::tan(qDegreesToRadians(22.5f));
+			const float halfWidth = halfHeight * aspectRatio;
+			m_Projection.ortho(-halfWidth, halfWidth, -halfHeight, halfHeight, m_ClipNear, m_ClipFar);
+		}
+		else
+		{
+			m_Projection.perspective(45.0f, aspectRatio, m_ClipNear, m_ClipFar);
+		}
 	}
 }
\ No newline at end of file
@@ -3,22 +3,140 @@
 #ifndef SCENE_VIEWPORT_H
 #define SCENE_VIEWPORT_H
 
-#include <QtCore/QTimer>
+#include "../Render/CascadedShadows.h"
+#include "../Render/ClusteredLighting.h"
+#include "../Render/OcclusionCuller.h"
+#include "../Render/RenderGraph.h"
+#include "../Render/RenderResourceCache.h"
+#include "../Core/FrameArena.h"
+#include <QtCore/QStringList>
 #include <QtOpenGL/QOpenGLBuffer>
-#include <QtGui/QOpenGLFunctions>
+#include <QtGui/QOpenGLExtraFunctions>
 #include <QtOpenGL/QOpenGLShaderProgram>
 #include <QtOpenGLWidgets/QOpenGLWidget>
 #include <QtOpenGL/QOpenGLVertexArrayObject>
+#include <QtOpenGL/QOpenGLTimerQuery>
 #include <QtGui/QMatrix4x4>
+#include <QtGui/QVector3D>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace Orca
 {
-	class SceneViewport : public QOpenGLWidget, protected QOpenGLFunctions
+	class PlaySession;
+
+	/** @brief How a scene viewport looks at the scene. */
+	enum class ViewportCamera
+	{
+		Perspective,    // from in front of the scene
+		Top,            // orthographic, looking down
+		Front,          // orthographic, from in front
+		Game            // through the scene's CameraComponent; Perspective if it has none
+	};
+
+	/**
+	 * @brief One view of the scene. Programs, the mesh, the instance matrices and textures come
+	 *        from RenderResourceCache and are shared by every viewport; each view keeps only its
+	 *        camera-dependent state (culling, light clusters, shadow cascades) and a list of the
+	 *        instances it draws. A hidden view doesn't tick or paint.
+	 */
+	class SceneViewport : public QOpenGLWidget, protected QOpenGLExtraFunctions
 	{
 	public:
-		explicit SceneViewport(QWidget* parent = nullptr);
+		explicit SceneViewport(QWidget* parent = nullptr, ViewportCamera camera = ViewportCamera::Perspective);
 		~SceneViewport() override;
 
+		ViewportCamera Camera() const { return m_Camera; }
+
+		/** @brief Frames RenderBenchmarkFrames() takes to pan the camera once around its target. */
+		static constexpr int kBenchmarkPanFrames = 120;
+
+		/**
+		 * @brief Runs frames back to back as the editor does, a Tick() and a paint each, waiting
+		 *        for the GPU after each one. With @p panCamera the camera target circles where it
+		 *        is, one turn every kBenchmarkPanFrames frames counted across calls, and is put
+		 *        back afterwards. @p beforeFrame runs with the context current before each paint.
+		 * @return Per-frame wall time in milliseconds; empty if the viewport can't render yet.
+		 */
+		std::vector<double> RenderBenchmarkFrames(int frames, bool panCamera = false, const std::function<void()>& beforeFrame = nullptr);
+
+		/** @brief Lets the project's Assets/Shaders override the built-in shaders, for every viewport. */
+		void SetProjectRoot(const QString& projectRoot);
+
+		/** @brief Recompiles shaders touched by a batch of project-relative changed paths, for every viewport. */
+		void ReloadShaders(const QStringList& changedPaths);
+
+		/**
+		 * @brief Uploads up to maxCount world matrices (16 floats each, column-major) starting at
+		 *        instance `first`; first == 0 starts a new scene of matrices.size() / 16 instances.
+		 *        Uploaded instances are drawn right away, so a large scene appears progressively.
+		 *        The instances are shared, so one upload through any viewport updates them all.
+		 * @return Number of instances uploaded.
+		 */
+		size_t UploadInstances(const std::vector<float>& matrices, size_t first, size_t maxCount);
+
+		/** @brief Points the camera at a bounding sphere. */
+		void FrameBounds(const QVector3D& center, float radius);
+
+		/** @brief Where the camera looks; moving it keeps the camera's distance and direction. */
+		QVector3D CameraTarget() const { return m_CameraTarget; }
+		void SetCameraTarget(const QVector3D& target);
+
+		/** @brief Texture streaming for every viewport; only use it with a viewport's context current. */
+		TextureStreamer& Textures() { return RenderResourceCache::Get().Textures(); }
+
+		/** @brief The passes drawing this viewport, for timing and memory reports. */
+		const RenderGraph& Graph() const { return m_RenderGraph; }
+
+		const ClusteredLighting& Lighting() const { return m_Lighting; }
+
+		const CascadedShadows& Shadows() const { return m_Shadows; }
+
+		const OcclusionCuller& Occlusion() const { return m_Occlusion; }
+
+		/**
+		 * @brief Takes the scene's render setup: its LightComponents, placed as in its world matrices,
+		 *        the shadow casters of the first directional light, the occluders and the game camera.
+		 */
+		void SetScene(std::shared_ptr<const LoadedScene> scene);
+
+		/**
+		 * @brief Culls instances outside the frustum or behind the scene's occluders before drawing
+		 *        them; on by default. Culling reruns only when the camera or the instances change.
+		 */
+		void SetOcclusionCulling(bool enabled);
+		bool OcclusionCulling() const { return m_OcclusionCulling; }
+
+		/** @brief Instances the last frame drew, after culling. */
+		size_t DrawnInstances() const { return m_DrawCount; }
+
+		/** @brief Overrides an entity's Cast Shadows setting for this viewport. */
+		void SetCastsShadows(uint32_t entity, bool castsShadows);
+
+		/**
+		 * @brief operator new calls charged to MemoryTag::Renderer, on any thread, by the last
+		 *        paintGL() and the play uploads of the ticks before it; 0 once the frame arena has
+		 *        warmed up. Worker threads inherit the tag, so binning and culling count; direct
+		 *        malloc calls, Qt containers' included, don't.
+		 */
+		uint64_t LastFrameHeapAllocations() const { return m_FrameHeapAllocations; }
+
+		/**
+		 * @brief Shows @p session's newest frame on every tick instead of the edit scene; null
+		 *        stops following it. The session must outlive this, or be unset first.
+		 */
+		void SetPlaySession(PlaySession* session);
+		bool Playing() const { return m_PlaySession != nullptr; }
+
+		/**
+		 * @brief Called by the editor tick while the viewport is on screen. Uploads the play
+		 *        session's latest frame while playing, unless another viewport already did;
+		 *        otherwise repaints after shared changes and keeps the placeholder cube turning
+		 *        until a scene is loaded.
+		 */
+		void Tick(float deltaTime);
+
 	protected:
 		void initializeGL() override;
 		void paintGL() override;
@@ -27,13 +145,66 @@ namespace Orca
 	private:
 		bool InitializeShaders();
 		void InitializeGeometry();
+		void ReleaseGL();
+		void RefreshPrograms();
+		void BuildRenderGraph();
+		void CullInstances();
+		void DrawScene();
+		const float* GameCameraMatrix() const;
+		QMatrix4x4 ViewMatrix() const;
+		void CollectGpuTimings();
+		void UpdateProjection(float aspectRatio);
+
+		ViewportCamera m_Camera = ViewportCamera::Perspective;
+		bool m_ResourcesAcquired = false;
+		RenderGraph m_RenderGraph;
+		ClusteredLighting m_Lighting;
+		CascadedShadows m_Shadows;
+		OcclusionCuller m_Occlusion;
+		int m_FramebufferWidth = 0;     // device pixels
+		int m_FramebufferHeight = 0;
+
+		// Scratch memory for one frame, reset at the start of paintGL().
+		FrameArena m_FrameArena;
+		uint64_t m_FrameHeapAllocations = 0;
+		uint64_t m_TickHeapAllocations = 0;      // by play uploads since the last paint
+		int m_BenchmarkPanFrame = 0;
 
+		PlaySession* m_PlaySession = nullptr;
+		uint64_t m_PlayStep = ~uint64_t(0);    // step of the frame last uploaded
+
+		// Owned by RenderResourceCache; looked up again when its shader generation changes.
 		QOpenGLShaderProgram* m_Program = nullptr;
-		QOpenGLBuffer m_VBO;
+		QOpenGLShaderProgram* m_ShadowProgram = nullptr;
+		uint64_t m_ShaderGeneration = 0;
+
+		// Indices into the shared instance matrices of what this view draws: all of them, or the
+		// culled set. Rebuilt only when the camera or the instances change.
+		QOpenGLBuffer m_IndexBuffer;
+		std::vector<uint32_t> m_VisibleInstances;
+		size_t m_DrawCount = 1;
+		uint64_t m_IndexedVersion = 0;             // RenderResourceCache::InstanceVersion() of the list
+		QMatrix4x4 m_CulledViewProjection;
+		bool m_OcclusionCulling = true;
+		bool m_IndicesDirty = true;
+		float m_PreviewAngle = 0.0f;
+
+		SceneCamera m_SceneCamera;
+		QVector3D m_CameraTarget;
+		float m_CameraDistance = 5.0f;
+		float m_FarPlane = 100.0f;                 // deep enough for the framed bounds
+		float m_ClipNear = 0.1f;                   // of m_Projection
+		float m_ClipFar = 100.0f;
 		QOpenGLVertexArrayObject m_VAO;
 		QMatrix4x4 m_Projection;
 
-		QTimer m_Timer;
+		// Read back a few frames late so the CPU never stalls on the query result.
+		static constexpr int kGpuTimerQueries = 3;
+		QOpenGLTimerQuery m_GpuTimers[kGpuTimerQueries][2];
+		bool m_GpuTimerPending[kGpuTimerQueries] = {};
+		uint64_t m_GpuTimerProfileFrame[kGpuTimerQueries] = {};
+		int m_GpuTimerFrame = 0;
+		bool m_GpuTimersReady = false;
 	};
 }
 
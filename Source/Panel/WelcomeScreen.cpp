@@ -1,12 +1,14 @@
 #include "WelcomeScreen.h"
+#include "RecentProjectDelegate.h"
+#include "RecentProjectsModel.h"
+#include "../Core/EditorTheme.h"
 #include <QtWidgets/QVBoxLayout>
 #include <QtWidgets/QHBoxLayout>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QPushButton>
-#include <QtWidgets/QListWidget>
+#include <QtWidgets/QListView>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QMessageBox>
-#include <QtWidgets/QListWidgetItem>
 #include <QtCore/QDateTime>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
@@ -22,50 +24,11 @@ namespace Orca
         this->setWindowTitle("Welcome to Orca Studio");
         this->setMinimumSize(900, 600);
         this->setWindowFlags(Qt::Dialog | Qt::WindowCloseButtonHint | Qt::WindowMinimizeButtonHint);
-        this->setStyleSheet(R"(QDialog { background-color: #1e1e1e; color: #ccc; }
-               QWidget { background-color: #252526; color: #ccc; }
-               QLabel { color: #ccc; }
-               
-               // Primary Action Buttons (New/Open)
-               QPushButton#PrimaryButton {
-                 background-color: #007acc;
-                 color: white;
-                 font-size: 11pt;
-                 font-weight: bold;
-                 padding: 10px;
-                 border-radius: 5px;
-                 border: none;
-               }
-               QPushButton#PrimaryButton:hover { background-color: #008cd9; }
-               
-               // Recent Projects List
-               QListWidget {
-                 background-color: #252526;
-                 border: 1px solid #3a3a3a;
-                 border-radius: 5px;
-               }
-               QListWidget::item { padding: 8px; border-bottom: 1px solid #333333; }
-               QListWidget::item:hover { background-color: #3a3a3a; }
-               QListWidget::item:selected { background-color: #007acc; color: white; }
-    )");
-
         SetupUI();
     }
 
     // --- Private Helper Functions for Persistence ---
 
-    /**
-     * @brief Loads the list of recent project file paths from persistent QSettings.
-     * @return A QStringList containing the full file paths of recent projects.
-     */
-    QStringList WelcomeScreen::LoadRecentProjectsPaths()
-    {
-        // Use OrcaStudio as organization and application name for QSettings scope
-        QSettings settings("OrcaStudio", "OrcaStudio");
-        // Read the list of recent file paths, defaulting to an empty list
-        return settings.value("RecentProjects/files", QStringList()).toStringList();
-    }
-
     /**
      * @brief Adds the given path to the persistent recent projects list, moving it to the top.
      * @param path The full path of the project file (.orca) to add.
@@ -102,7 +65,7 @@ namespace Orca
 
         QWidget* leftPanel = new QWidget();
         leftPanel->setFixedWidth(320);
-        leftPanel->setStyleSheet("QWidget { background-color: #2d2d2d; border-right: 1px solid #3a3a3a; }");
+        EditorTheme::SetBackgroundRole(leftPanel, ThemeRole::Chrome);
         QVBoxLayout* leftLayout = new QVBoxLayout(leftPanel);
         leftLayout->setContentsMargins(30, 40, 30, 30);
         leftLayout->setAlignment(Qt::AlignTop | Qt::AlignLeft);
@@ -111,21 +74,24 @@ namespace Orca
         leftLayout->addWidget(logoLabel);
 
         QLabel* versionLabel = new QLabel("Version 0.7.8 (Engine Preview)");
-        versionLabel->setStyleSheet("QLabel { color: #999; margin-bottom: 40px; }");
+        EditorTheme::SetTextRole(versionLabel, ThemeRole::MutedText);
         leftLayout->addWidget(versionLabel);
+        leftLayout->addSpacing(40);
 
         QLabel* startLabel = new QLabel("<span style='color: #ccc; font-size: 14pt;'>Start a Project</span>");
-        startLabel->setStyleSheet("QLabel { margin-top: 10px; margin-bottom: 15px; }");
+        startLabel->setContentsMargins(0, 10, 0, 15);
         leftLayout->addWidget(startLabel);
 
         QPushButton* newButton = new QPushButton(tr("New Project"));
-        newButton->setObjectName("PrimaryButton");
+        EditorTheme::SetPrimary(newButton);
+        newButton->setMinimumHeight(40);
         newButton->setToolTip("Create a blank project or use a template.");
         connect(newButton, &QPushButton::clicked, this, &WelcomeScreen::onNewProjectClicked);
         leftLayout->addWidget(newButton);
 
         QPushButton* openButton = new QPushButton(tr("Open Existing"));
-        openButton->setObjectName("PrimaryButton");
+        EditorTheme::SetPrimary(openButton);
+        openButton->setMinimumHeight(40);
         openButton->setToolTip("Open an existing Orca project file (.orca).");
         connect(openButton, &QPushButton::clicked, this, &WelcomeScreen::onOpenProjectClicked);
         leftLayout->addWidget(openButton);
@@ -133,7 +99,7 @@ namespace Orca
         leftLayout->addStretch(1);
 
         QLabel* linksLabel = new QLabel("<span style='color: #999; font-size: 10pt;'>Resources</span>");
-        linksLabel->setStyleSheet("QLabel { margin-bottom: 10px; }");
+        linksLabel->setContentsMargins(0, 0, 0, 10);
         leftLayout->addWidget(linksLabel);
 
         leftLayout->addWidget(new QLabel("<a href='#' style='color: #007acc;'>Documentation</a>"));
@@ -149,61 +115,18 @@ namespace Orca
         QLabel* recentTitle = new QLabel("<span style='color: #ccc; font-size: 14pt;'>Recent Projects</span>");
         rightLayout->addWidget(recentTitle);
 
-        QListWidget* recentList = new QListWidget();
+        QListView* recentList = new QListView();
         recentList->setFont(QFont("Segoe UI", 10));
+        recentList->setMouseTracking(true);
+        recentList->setUniformItemSizes(true);
 
-        // Load actual persistent paths
-        QStringList recentProjectPaths = LoadRecentProjectsPaths();
-
-        for (const QString& fullPath : recentProjectPaths)
-        {
-            QFileInfo fileInfo(fullPath);
-
-            // Skip entries where the file no longer exists
-            if (!fileInfo.exists() || !fileInfo.isFile())
-            {
-                continue;
-            }
+        // Rows come from the cached index right away; existence, dates and thumbnails are
+        // probed in the background and fill in as they arrive.
+        m_recentModel = new RecentProjectsModel(recentList);
+        recentList->setModel(m_recentModel);
+        recentList->setItemDelegate(new RecentProjectDelegate(recentList));
 
-            QListWidgetItem* item = new QListWidgetItem(recentList);
-
-            QWidget* widget = new QWidget();
-            QHBoxLayout* itemLayout = new QHBoxLayout(widget);
-            itemLayout->setContentsMargins(5, 5, 5, 5);
-
-            // Project Name (File name without extension)
-            QString projectName = fileInfo.baseName();
-            QLabel* nameLabel = new QLabel(QString("<b>%1</b>").arg(projectName));
-            nameLabel->setObjectName("nameLabel");
-
-            // Project Path (Directory path)
-            QLabel* pathLabel = new QLabel(fileInfo.dir().path());
-            pathLabel->setStyleSheet("QLabel { color: #777; font-size: 9pt; }");
-
-            QVBoxLayout* textLayout = new QVBoxLayout();
-            textLayout->addWidget(nameLabel);
-            textLayout->addWidget(pathLabel);
-            textLayout->setSpacing(1);
-
-            // Date: Use the last modified date from the actual file info
-            QString dateString = fileInfo.lastModified().toString("MM/dd/yyyy h:mm AP");
-            QLabel* dateLabel = new QLabel(dateString);
-            dateLabel->setStyleSheet("QLabel { color: #999; font-size: 9pt; }");
-            dateLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-            dateLabel->setFixedWidth(120); // Fixed width to align dates nicely
-
-            itemLayout->addLayout(textLayout);
-            itemLayout->addStretch(1);
-            itemLayout->addWidget(dateLabel);
-
-            item->setSizeHint(widget->sizeHint());
-            recentList->setItemWidget(item, widget);
-
-            // Store the actual full path in the item's data for retrieval later
-            item->setData(Qt::UserRole, fullPath);
-        }
-
-        connect(recentList, &QListWidget::doubleClicked, this, &WelcomeScreen::onRecentProjectClicked);
+        connect(recentList, &QListView::doubleClicked, this, &WelcomeScreen::onRecentProjectClicked);
 
         rightLayout->addWidget(recentList);
 
@@ -354,11 +277,7 @@ namespace Orca
     {
         if (index.isValid())
         {
-            QListWidget* recentList = (QListWidget*)sender();
-            QListWidgetItem* item = recentList->item(index.row());
-
-            // Retrieve the actual full path stored in Qt::UserRole, removing the need for mock path construction
-            QString projectPath = item->data(Qt::UserRole).toString();
+            QString projectPath = index.data(RecentProjectsModel::PathRole).toString();
 
             if (!projectPath.isEmpty())
             {
@@ -368,7 +287,7 @@ namespace Orca
                 if (!fileInfo.exists())
                 {
                     QMessageBox::critical(this, tr("Project Not Found"), tr("The project file '%1' no longer exists at this location. It will be removed from the recent list.").arg(fileInfo.fileName()));
-                    // A proper implementation would also remove the path from QSettings here
+                    m_recentModel->Remove(projectPath);
                     return;
                 }
 
@@ -9,6 +9,8 @@
 
 namespace Orca
 {
+    class RecentProjectsModel;
+
     class WelcomeScreen : public QDialog
     {
         Q_OBJECT
@@ -28,10 +30,11 @@ namespace Orca
     private:
         void SetupUI();
 
-        QStringList LoadRecentProjectsPaths();
         void UpdateRecentProjectsList(const QString& path);
 
         bool CreateNewProject(const QString& path);
+
+        RecentProjectsModel* m_recentModel = nullptr;
     };
 }
 
@@ -0,0 +1,367 @@
+#include "CascadedShadows.h"
+#include "../Core/EditorLog.h"
+#include "../Core/MemoryTracker.h"
+#include "../Core/Profiler.h"
+#include <QtGui/QVector3D>
+#include <QtGui/QVector4D>
+#include <algorithm>
+#include <cmath>
+
+namespace Orca
+{
+	void CascadedShadows::Initialize(GLuint meshBuffer, int vertexCount)
+	{
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+		initializeOpenGLFunctions();
+
+		m_meshBuffer = meshBuffer;
+		m_vertexCount = vertexCount;
+		CreateArray(m_staticArray, m_staticFramebuffers);
+		SetupBatch(m_static);
+		SetupBatch(m_dynamic);
+
+		m_initialized = true;
+		m_staticDirty = true;
+		m_dynamicDirty = true;
+	}
+
+	void CascadedShadows::Clear()
+	{
+		if (!m_initialized) return;
+
+		DeleteArray(m_staticArray, m_staticFramebuffers);
+		DeleteArray(m_frameArray, m_frameFramebuffers);
+		for (CasterBatch* batch : { &m_static, &m_dynamic })
+		{
+			glDeleteVertexArrays(1, &batch->vao);
+			glDeleteBuffers(1, &batch->instances);
+			*batch = CasterBatch();
+		}
+		for (Cascade& cascade : m_cascades) cascade.cached = false;
+		m_initialized = false;
+	}
+
+	void CascadedShadows::CreateArray(GLuint& texture, GLuint* framebuffers)
+	{
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, kResolution, kResolution, kCascades, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, nullptr);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+		glGenFramebuffers(kCascades, framebuffers);
+		const GLenum none = GL_NONE;
+		for (int layer = 0; layer < kCascades; ++layer)
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[layer]);
+			glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0, layer);
+			glDrawBuffers(1, &none);
+			glReadBuffer(GL_NONE);
+
+			const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+			if (status != GL_FRAMEBUFFER_COMPLETE)
+			{
+				ORCA_LOG_ERROR("Renderer", "Shadow cascade {} framebuffer incomplete (0x{})", layer, QString::number(status, 16));
+			}
+		}
+		m_stats.gpuBytes += static_cast<uint64_t>(kResolution) * kResolution * 4 * kCascades;
+	}
+
+	void CascadedShadows::DeleteArray(GLuint& texture, GLuint* framebuffers)
+	{
+		if (!texture) return;
+
+		glDeleteFramebuffers(kCascades, framebuffers);
+		glDeleteTextures(1, &texture);
+		std::fill(framebuffers, framebuffers + kCascades, 0u);
+		texture = 0;
+		m_stats.gpuBytes -= static_cast<uint64_t>(kResolution) * kResolution * 4 * kCascades;
+	}
+
+	void CascadedShadows::SetupBatch(CasterBatch& batch)
+	{
+		glGenVertexArrays(1, &batch.vao);
+		glGenBuffers(1, &batch.instances);
+		glBindVertexArray(batch.vao);
+
+		// Same layout as the viewport's mesh: position at 0, the instance's entity index at 2.
+		glBindBuffer(GL_ARRAY_BUFFER, m_meshBuffer);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
+
+		glBindBuffer(GL_ARRAY_BUFFER, batch.instances);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+		glEnableVertexAttribArray(2);
+		glVertexAttribIPointer(2, 1, GL_UNSIGNED_INT, sizeof(uint32_t), nullptr);
+		glVertexAttribDivisor(2, 1);
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void CascadedShadows::UploadBatch(CasterBatch& batch, const std::vector<uint32_t>& entities)
+	{
+		batch.count = static_cast<GLsizei>(entities.size());
+		if (batch.count == 0) return;
+
+		glBindBuffer(GL_ARRAY_BUFFER, batch.instances);
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(entities.size() * sizeof(uint32_t)), entities.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void CascadedShadows::SetScene(std::shared_ptr<const LoadedScene> scene)
+	{
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+		m_scene = std::move(scene);
+		m_flags.clear();
+		m_dynamicEntities.clear();
+		if (m_scene)
+		{
+			m_flags = m_scene->renderFlags;
+			m_flags.resize(m_scene->worldMatrices.size() / 16, 0);
+			for (uint32_t entity = 0; entity < m_flags.size(); ++entity)
+			{
+				if (m_flags[entity] & LoadedScene::kDynamic) m_dynamicEntities.push_back(entity);
+			}
+		}
+
+		m_stats.pagesRendered = 0;
+		m_staticDirty = true;
+		m_dynamicDirty = true;
+	}
+
+	void CascadedShadows::SetCastsShadows(uint32_t entity, bool castsShadows)
+	{
+		if (entity >= m_flags.size() || CastsShadows(entity) == castsShadows) return;
+
+		if (castsShadows) m_flags[entity] |= LoadedScene::kCastsShadows;
+		else m_flags[entity] &= static_cast<uint8_t>(~LoadedScene::kCastsShadows);
+
+		if (m_flags[entity] & LoadedScene::kDynamic) m_dynamicDirty = true;
+		else m_staticDirty = true;
+	}
+
+	bool CascadedShadows::CastsShadows(uint32_t entity) const
+	{
+		return entity < m_flags.size() && (m_flags[entity] & LoadedScene::kCastsShadows);
+	}
+
+
+	void CascadedShadows::UploadStatic()
+	{
+		m_scratch.clear();
+		for (uint32_t entity = 0; entity < m_flags.size(); ++entity)
+		{
+			if ((m_flags[entity] & (LoadedScene::kCastsShadows | LoadedScene::kDynamic)) == LoadedScene::kCastsShadows)
+			{
+				m_scratch.push_back(entity);
+			}
+		}
+		UploadBatch(m_static, m_scratch);
+		m_stats.staticCasters = static_cast<uint32_t>(m_static.count);
+
+		for (Cascade& cascade : m_cascades) cascade.cached = false;
+		m_staticDirty = false;
+	}
+
+	void CascadedShadows::UploadDynamic()
+	{
+		// Only a changed Cast Shadows flag gets here; moving casters just changes the shared matrices.
+		m_scratch.clear();
+		for (uint32_t entity : m_dynamicEntities)
+		{
+			if (m_flags[entity] & LoadedScene::kCastsShadows) m_scratch.push_back(entity);
+		}
+		UploadBatch(m_dynamic, m_scratch);
+		m_stats.dynamicCasters = static_cast<uint32_t>(m_dynamic.count);
+		m_dynamicDirty = false;
+	}
+
+	void CascadedShadows::Render(const QMatrix4x4& view, const QMatrix4x4& projection, float nearPlane, float farPlane,
+		const float* lightDirection, GLuint instanceMatrices, uint64_t staticVersion, QOpenGLShaderProgram& depthProgram)
+	{
+		m_enabled = false;
+		m_stats.pagesRenderedLastFrame = 0;
+		if (!m_initialized || !m_scene || !lightDirection) return;
+
+		ORCA_PROFILE_ZONE("CascadedShadows::Render");
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+		if (staticVersion != m_staticVersion)
+		{
+			for (Cascade& cascade : m_cascades) cascade.cached = false;
+			m_staticVersion = staticVersion;
+		}
+		if (m_staticDirty) UploadStatic();
+		if (m_dynamicDirty) UploadDynamic();
+		if (m_static.count == 0 && m_dynamic.count == 0) return;
+
+		m_enabled = true;
+		FitCascades(view, projection, nearPlane, farPlane, lightDirection);
+
+		glViewport(0, 0, kResolution, kResolution);
+		glDepthMask(GL_TRUE);
+		glEnable(GL_POLYGON_OFFSET_FILL);
+		glPolygonOffset(2.0f, 4.0f);
+
+		for (int c = 0; c < kCascades; ++c)
+		{
+			Cascade& cascade = m_cascades[c];
+			if (cascade.cached && cascade.cachedFor == cascade.lightViewProjection) continue;
+
+			DrawBatch(m_static, m_staticFramebuffers[c], cascade.lightViewProjection, instanceMatrices, depthProgram, true);
+			cascade.cachedFor = cascade.lightViewProjection;
+			cascade.cached = true;
+			++m_stats.pagesRenderedLastFrame;
+		}
+		m_stats.pagesRendered += static_cast<uint64_t>(m_stats.pagesRenderedLastFrame);
+
+		if (m_dynamic.count > 0)
+		{
+			if (!m_frameArray) CreateArray(m_frameArray, m_frameFramebuffers);
+
+			// Start each cascade from its cached static page, then add whatever moves.
+			for (int c = 0; c < kCascades; ++c)
+			{
+				glBindFramebuffer(GL_READ_FRAMEBUFFER, m_staticFramebuffers[c]);
+				glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_frameFramebuffers[c]);
+				glBlitFramebuffer(0, 0, kResolution, kResolution, 0, 0, kResolution, kResolution, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+				DrawBatch(m_dynamic, m_frameFramebuffers[c], m_cascades[c].lightViewProjection, instanceMatrices, depthProgram, false);
+			}
+		}
+		else if (m_frameArray)
+		{
+			DeleteArray(m_frameArray, m_frameFramebuffers);
+		}
+
+		glDisable(GL_POLYGON_OFFSET_FILL);
+		ORCA_PROFILE_COUNTER("Shadow pages rendered", m_stats.pagesRenderedLastFrame);
+	}
+
+	void CascadedShadows::FitCascades(const QMatrix4x4& view, const QMatrix4x4& projection, float nearPlane, float farPlane, const float* lightDirection)
+	{
+		QVector3D direction(lightDirection[0], lightDirection[1], lightDirection[2]);
+		direction.normalize();
+		const QVector3D up = std::abs(direction.y()) > 0.99f ? QVector3D(1.0f, 0.0f, 0.0f) : QVector3D(0.0f, 1.0f, 0.0f);
+
+		// Rotation only: the light space axes depend on the direction alone, so snapping works.
+		QMatrix4x4 lightView;
+		lightView.lookAt(QVector3D(0.0f, 0.0f, 0.0f), direction, up);
+
+		const QMatrix4x4 inverseView = view.inverted();
+		const float tanX = 1.0f / projection(0, 0);
+		const float tanY = 1.0f / projection(1, 1);
+		const float spread = tanX * tanX + tanY * tanY;    // squared corner offset per unit of depth
+		const bool orthographic = projection(3, 3) != 0.0f; // then tanX and tanY are the half extents
+
+		const QVector3D sceneCenter = lightView.map(QVector3D(m_scene->boundsCenter[0], m_scene->boundsCenter[1], m_scene->boundsCenter[2]));
+		const float sceneRadius = m_scene->boundsRadius;
+
+		// Depth covers everything in the scene that could shade a slice, in whole units, so it
+		// doesn't follow the camera either.
+		const float nearDepth = std::floor(-sceneCenter.z() - sceneRadius);
+		const float farDepth = std::ceil(-sceneCenter.z() + sceneRadius);
+
+		QMatrix4x4 toTexture;
+		toTexture.translate(0.5f, 0.5f, 0.5f);
+		toTexture.scale(0.5f);
+
+		float previous = nearPlane;
+		for (int c = 0; c < kCascades; ++c)
+		{
+			const float fraction = static_cast<float>(c + 1) / kCascades;
+			const float logarithmic = nearPlane * std::pow(farPlane / nearPlane, fraction);
+			const float even = nearPlane + (farPlane - nearPlane) * fraction;
+			const float next = kSplitLambda * logarithmic + (1.0f - kSplitLambda) * even;
+
+			// Smallest sphere around the slice: its center sits on the view axis, equally far from
+			// the near and far corners, unless that lies past the far plane. An orthographic slice
+			// is a box, centered halfway.
+			float centerDepth = 0.5f * (previous + next) * (1.0f + spread);
+			float radius;
+			if (orthographic)
+			{
+				centerDepth = 0.5f * (previous + next);
+				radius = std::sqrt(0.25f * (next - previous) * (next - previous) + spread);
+			}
+			else if (centerDepth >= next)
+			{
+				centerDepth = next;
+				radius = next * std::sqrt(spread);
+			}
+			else
+			{
+				radius = std::sqrt((previous - centerDepth) * (previous - centerDepth) + previous * previous * spread);
+			}
+			const float pageRadius = std::ceil(radius * kPageMargin * 16.0f) / 16.0f;
+			const float texel = 2.0f * pageRadius / kResolution;
+			const QVector3D center = lightView.map(inverseView.map(QVector3D(0.0f, 0.0f, -centerDepth)));
+
+			// The page stays put in world space while the slice is inside it, and moves by whole
+			// texels to recenter on the slice when it leaves, so a moving camera only redraws a
+			// page every (pageRadius - radius) units of travel.
+			Cascade& cascade = m_cascades[c];
+			const bool inside = cascade.pageRadius == pageRadius
+				&& std::abs(center.x() - cascade.pageCenter.x()) + radius <= pageRadius
+				&& std::abs(center.y() - cascade.pageCenter.y()) + radius <= pageRadius;
+			if (!inside || lightView != m_lightView)
+			{
+				cascade.pageCenter = QVector2D(std::floor(center.x() / texel) * texel, std::floor(center.y() / texel) * texel);
+				cascade.pageRadius = pageRadius;
+			}
+			const float x = cascade.pageCenter.x();
+			const float y = cascade.pageCenter.y();
+
+			QMatrix4x4 lightProjection;
+			lightProjection.ortho(x - pageRadius, x + pageRadius, y - pageRadius, y + pageRadius, nearDepth, farDepth);
+
+			cascade.lightViewProjection = lightProjection * lightView;
+			cascade.shadowMatrix = toTexture * cascade.lightViewProjection;
+			cascade.farDistance = next;
+			cascade.texelSize = texel;
+			m_stats.splits[c] = next;
+			previous = next;
+		}
+		m_lightView = lightView;
+	}
+
+	void CascadedShadows::DrawBatch(const CasterBatch& batch, GLuint framebuffer, const QMatrix4x4& lightViewProjection, GLuint instanceMatrices,
+		QOpenGLShaderProgram& depthProgram, bool clear)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		if (clear) glClear(GL_DEPTH_BUFFER_BIT);
+		if (batch.count == 0) return;
+
+		depthProgram.bind();
+		depthProgram.setUniformValue("lightViewProjection", lightViewProjection);
+		depthProgram.setUniformValue("instanceMatrices", 0);
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_BUFFER, instanceMatrices);
+		glBindVertexArray(batch.vao);
+		glDrawArraysInstanced(GL_TRIANGLES, 0, m_vertexCount, batch.count);
+		glBindVertexArray(0);
+		depthProgram.release();
+	}
+
+	void CascadedShadows::Bind(QOpenGLShaderProgram& program, int unit)
+	{
+		// A shadow sampler may not share a unit with the lighting's buffer samplers, even unused.
+		program.setUniformValue("shadowMap", unit);
+		program.setUniformValue("shadowsEnabled", m_enabled ? 1 : 0);
+		if (!m_enabled) return;
+
+		QMatrix4x4 matrices[kCascades];
+		for (int c = 0; c < kCascades; ++c) matrices[c] = m_cascades[c].shadowMatrix;
+		program.setUniformValueArray("shadowMatrices", matrices, kCascades);
+		program.setUniformValue("cascadeSplits", QVector4D(m_cascades[0].farDistance, m_cascades[1].farDistance, m_cascades[2].farDistance, m_cascades[3].farDistance));
+		program.setUniformValue("cascadeTexelSizes", QVector4D(m_cascades[0].texelSize, m_cascades[1].texelSize, m_cascades[2].texelSize, m_cascades[3].texelSize));
+
+		glActiveTexture(GL_TEXTURE0 + unit);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_frameArray && m_dynamic.count > 0 ? m_frameArray : m_staticArray);
+		glActiveTexture(GL_TEXTURE0);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#pragma once
+
+#ifndef CASCADED_SHADOWS_H
+#define CASCADED_SHADOWS_H
+
+#include "../Core/ProjectLoader.h"
+#include <QtGui/QMatrix4x4>
+#include <QtGui/QVector2D>
+#include <QtGui/QOpenGLExtraFunctions>
+#include <QtOpenGL/QOpenGLShaderProgram>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Orca
+{
+	struct CascadedShadowStats
+	{
+		uint32_t staticCasters = 0;
+		uint32_t dynamicCasters = 0;
+		int pagesRenderedLastFrame = 0;    // static cascade pages re-rendered by the last Render()
+		uint64_t pagesRendered = 0;        // since the scene was set
+		uint64_t gpuBytes = 0;
+		float splits[4] = {};              // far distance of each cascade
+	};
+
+	/**
+	 * @brief Cascaded shadow maps for the scene's first directional light.
+	 *
+	 * Casters are entities flagged LoadedScene::kCastsShadows. Static ones are rendered into a
+	 * cached page per cascade, which is only redrawn when its light matrix or the static casters
+	 * change. Each page is a square fixed in light space, kPageMargin times wider than the
+	 * bounding sphere of its cascade's slice, with a depth range spanning the scene bounds; it
+	 * only moves (by whole texels) once the slice leaves it, so a moving camera redraws a page
+	 * now and then rather than every frame. Dynamic casters (LoadedScene::kDynamic) are drawn
+	 * every frame on top of a copy of the static pages; a scene without any samples the static
+	 * pages directly, so a still scene costs no shadow rendering.
+	 *
+	 * Casters are drawn by entity index from the shared instance matrix buffer (see
+	 * RenderResourceCache), so the batches only hold indices and moving casters uploads nothing.
+	 *
+	 * All GL calls need the owning context current, and the owner must call Clear() before the
+	 * context goes away.
+	 */
+	class CascadedShadows : protected QOpenGLExtraFunctions
+	{
+	public:
+		static constexpr int kCascades = 4;
+		static constexpr int kResolution = 1024;
+
+		/** @brief Blend between logarithmic (1) and even (0) cascade splits. */
+		static constexpr float kSplitLambda = 0.75f;
+
+		/** @brief A page's half extent over its slice's bounding radius: the camera travel it absorbs. */
+		static constexpr float kPageMargin = 1.25f;
+
+		CascadedShadows() = default;
+
+		CascadedShadows(const CascadedShadows&) = delete;
+		CascadedShadows& operator=(const CascadedShadows&) = delete;
+
+		/** @brief @p meshBuffer holds the caster mesh: @p vertexCount positions with a 6-float stride. */
+		void Initialize(GLuint meshBuffer, int vertexCount);
+
+		/** @brief Deletes every GL object. */
+		void Clear();
+
+		/** @brief Takes the casters and their edit-mode placement from @p scene; null removes them. */
+		void SetScene(std::shared_ptr<const LoadedScene> scene);
+
+		/** @brief Overrides an entity's CastShadows flag. Redraws the static pages if it is static. */
+		void SetCastsShadows(uint32_t entity, bool castsShadows);
+		bool CastsShadows(uint32_t entity) const;
+
+		/**
+		 * @brief Moves pages the camera has left and brings the shadow maps up to date. Leaves
+		 *        the framebuffer binding to the caller. @p lightDirection null disables shadows.
+		 *        Casters are placed by @p instanceMatrices, a buffer texture of four RGBA32F
+		 *        texels per entity; a new @p staticVersion means the static ones moved.
+		 */
+		void Render(const QMatrix4x4& view, const QMatrix4x4& projection, float nearPlane, float farPlane,
+			const float* lightDirection, GLuint instanceMatrices, uint64_t staticVersion, QOpenGLShaderProgram& depthProgram);
+
+		/** @brief Sets the shadow uniforms on the bound @p program and binds the shadow map to @p unit. */
+		void Bind(QOpenGLShaderProgram& program, int unit);
+
+		CascadedShadowStats Stats() const { return m_stats; }
+
+	private:
+		struct Cascade
+		{
+			QMatrix4x4 lightViewProjection;
+			QMatrix4x4 shadowMatrix;       // world to shadow map texture coordinates and depth
+			QMatrix4x4 cachedFor;          // the matrix the static page was drawn with
+			QVector2D pageCenter;          // in light space
+			float pageRadius = 0.0f;       // half extent; 0 until the page is placed
+			bool cached = false;
+			float farDistance = 0.0f;
+			float texelSize = 0.0f;        // world units per shadow texel
+		};
+
+		struct CasterBatch
+		{
+			GLuint vao = 0;
+			GLuint instances = 0;
+			GLsizei count = 0;
+		};
+
+		void CreateArray(GLuint& texture, GLuint* framebuffers);
+		void DeleteArray(GLuint& texture, GLuint* framebuffers);
+		void SetupBatch(CasterBatch& batch);
+		void UploadBatch(CasterBatch& batch, const std::vector<uint32_t>& entities);
+		void UploadStatic();
+		void UploadDynamic();
+		void FitCascades(const QMatrix4x4& view, const QMatrix4x4& projection, float nearPlane, float farPlane, const float* lightDirection);
+		void DrawBatch(const CasterBatch& batch, GLuint framebuffer, const QMatrix4x4& lightViewProjection, GLuint instanceMatrices,
+			QOpenGLShaderProgram& depthProgram, bool clear);
+
+		std::shared_ptr<const LoadedScene> m_scene;
+		std::vector<uint8_t> m_flags;                   // LoadedScene::renderFlags with overrides
+		std::vector<uint32_t> m_dynamicEntities;
+		std::vector<uint32_t> m_scratch;                // caster indices being uploaded
+
+		Cascade m_cascades[kCascades];
+		QMatrix4x4 m_lightView;                         // the pages were placed for
+		uint64_t m_staticVersion = 0;                   // of the instance matrices the pages were drawn with
+		bool m_enabled = false;
+		bool m_staticDirty = false;
+		bool m_dynamicDirty = false;
+
+		bool m_initialized = false;
+		GLuint m_meshBuffer = 0;
+		int m_vertexCount = 0;
+		CasterBatch m_static;
+		CasterBatch m_dynamic;
+		GLuint m_staticArray = 0;                       // cached static pages, one layer per cascade
+		GLuint m_frameArray = 0;                        // static copy plus dynamic casters; only with dynamic casters
+		GLuint m_staticFramebuffers[kCascades] = {};
+		GLuint m_frameFramebuffers[kCascades] = {};
+
+		CascadedShadowStats m_stats;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,426 @@
+#include "ClusteredLighting.h"
+#include "../Core/EditorLog.h"
+#include "../Core/MemoryTracker.h"
+#include "../Core/Profiler.h"
+#include "../Core/WorkerPool.h"
+#include <QtCore/QElapsedTimer>
+#include <QtGui/QVector2D>
+#include <QtGui/QVector3D>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ORCA_CLUSTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr float kPi = 3.14159265358979f;
+
+		void Normalize(float* v)
+		{
+			const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+			if (length < 1e-6f) { v[0] = 0.0f; v[1] = 0.0f; v[2] = 1.0f; return; }
+			for (int i = 0; i < 3; ++i) v[i] /= length;
+		}
+
+		int Clamp(int value, int low, int high)
+		{
+			return std::min(std::max(value, low), high);
+		}
+	}
+
+	void ClusteredLighting::Initialize()
+	{
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+		initializeOpenGLFunctions();
+
+		static const GLenum formats[3] = { GL_RGBA32F, GL_RG32UI, GL_R16UI };
+		glGenBuffers(3, m_buffers);
+		glGenTextures(3, m_textures);
+		for (int i = 0; i < 3; ++i)
+		{
+			Upload(m_buffers[i], nullptr, 0);
+			glBindTexture(GL_TEXTURE_BUFFER, m_textures[i]);
+			glTexBuffer(GL_TEXTURE_BUFFER, formats[i], m_buffers[i]);
+		}
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+		m_initialized = true;
+		m_lightsDirty = true;
+		m_binDirty = true;
+	}
+
+	void ClusteredLighting::Clear()
+	{
+		if (!m_initialized) return;
+
+		glDeleteTextures(3, m_textures);
+		glDeleteBuffers(3, m_buffers);
+		std::fill(std::begin(m_textures), std::end(m_textures), 0u);
+		std::fill(std::begin(m_buffers), std::end(m_buffers), 0u);
+		m_initialized = false;
+	}
+
+	void ClusteredLighting::SetLights(const std::vector<SceneLight>& lights, const float ambientLight[3])
+	{
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+		m_lights.clear();
+		m_directional.clear();
+		for (const SceneLight& light : lights)
+		{
+			if (light.type == SceneLightType::Directional) m_directional.push_back(light);
+			else m_lights.push_back(light);
+		}
+
+		if (m_lights.size() > static_cast<size_t>(kMaxLights))
+		{
+			ORCA_LOG_WARNING("Renderer", "{} point and spot lights; only the first {} are shaded", m_lights.size(), kMaxLights);
+			m_lights.resize(kMaxLights);
+		}
+		if (m_directional.size() > static_cast<size_t>(kMaxDirectionalLights))
+		{
+			ORCA_LOG_WARNING("Renderer", "{} directional lights; only the first {} are shaded", m_directional.size(), kMaxDirectionalLights);
+			m_directional.resize(kMaxDirectionalLights);
+		}
+
+		std::copy(ambientLight, ambientLight + 3, m_ambient);
+		m_gpuLights.resize(m_lights.size());
+		m_bounds.resize(m_lights.size());
+		if (!m_lights.empty() && m_clusterLights.empty())
+		{
+			m_clusterCounts.resize(kClusterCount);
+			m_clusterLights.resize(static_cast<size_t>(kClusterCount) * kMaxLightsPerCluster);
+			m_grid.resize(static_cast<size_t>(kClusterCount) * 2);
+		}
+		m_indices.reserve(static_cast<size_t>(kClusterCount) * std::min<size_t>(m_lights.size(), kMaxLightsPerCluster));
+
+		m_stats = ClusteredLightingStats();
+		m_stats.directionalLights = static_cast<int>(m_directional.size());
+		for (const SceneLight& light : m_lights)
+		{
+			if (light.type == SceneLightType::Spot) ++m_stats.spotLights;
+			else ++m_stats.pointLights;
+		}
+
+		m_lightsDirty = true;
+		m_binDirty = true;
+	}
+
+	void ClusteredLighting::SetTransforms(const std::vector<float>& worldMatrices)
+	{
+		static const float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+		auto matrixOf = [&worldMatrices](uint32_t entity)
+		{
+			const size_t offset = static_cast<size_t>(entity) * 16;
+			return offset + 16 <= worldMatrices.size() ? worldMatrices.data() + offset : identity;
+		};
+
+		for (size_t i = 0; i < m_lights.size(); ++i)
+		{
+			const SceneLight& light = m_lights[i];
+			const float* world = matrixOf(light.entity);
+			GpuLight& gpu = m_gpuLights[i];
+			std::copy(world + 12, world + 15, gpu.position);
+			std::copy(world + 8, world + 11, gpu.direction);
+			Normalize(gpu.direction);
+			std::copy(light.color, light.color + 3, gpu.color);
+			gpu.range = light.range;
+			const bool spot = light.type == SceneLightType::Spot;
+			gpu.cosOuter = spot ? std::cos(0.5f * light.outerAngle * kPi / 180.0f) : -2.0f;
+			gpu.cosInner = spot ? std::cos(0.5f * light.innerAngle * kPi / 180.0f) : -1.0f;
+		}
+
+		for (size_t i = 0; i < m_directional.size(); ++i)
+		{
+			const float* world = matrixOf(m_directional[i].entity);
+			std::copy(world + 8, world + 11, m_directionalDirections[i]);
+			Normalize(m_directionalDirections[i]);
+			std::copy(m_directional[i].color, m_directional[i].color + 3, m_directionalColors[i]);
+		}
+
+		m_lightsDirty = true;
+		m_binDirty = true;
+	}
+
+	void ClusteredLighting::Update(const QMatrix4x4& view, const QMatrix4x4& projection, float nearPlane, float farPlane)
+	{
+		if (!m_initialized || m_lights.empty()) return;
+
+		ORCA_PROFILE_ZONE("ClusteredLighting::Update");
+		if (projection != m_projection || m_sliceNear[0] != nearPlane || m_sliceNear[kSlices] != farPlane)
+		{
+			BuildFroxels(projection, nearPlane, farPlane);
+			m_projection = projection;
+			m_binDirty = true;
+		}
+		if (view != m_view)
+		{
+			m_view = view;
+			m_binDirty = true;
+		}
+
+		if (m_lightsDirty)
+		{
+			Upload(m_buffers[0], m_gpuLights.data(), m_gpuLights.size() * sizeof(GpuLight));
+			m_lightsDirty = false;
+		}
+		if (!m_binDirty) return;
+
+		QElapsedTimer timer;
+		timer.start();
+		ComputeBounds(view);
+		std::fill(m_clusterCounts.begin(), m_clusterCounts.end(), 0);
+		{
+			ORCA_PROFILE_ZONE("ClusteredLighting::Bin");
+			// Each slice owns its clusters, so workers never write to the same list.
+			WorkerPool::Get().ParallelFor(kSlices, [this](size_t slice) { BinSlice(static_cast<int>(slice)); }, m_lights.size() >= kParallelBinLights);
+		}
+		Compact();
+
+		Upload(m_buffers[1], m_grid.data(), m_grid.size() * sizeof(uint32_t));
+		Upload(m_buffers[2], m_indices.data(), m_indices.size() * sizeof(uint16_t));
+		m_binDirty = false;
+
+		m_stats.binMs = timer.nsecsElapsed() / 1e6;
+		ORCA_PROFILE_COUNTER("Clustered light entries", m_stats.clusterEntries);
+	}
+
+	void ClusteredLighting::BuildFroxels(const QMatrix4x4& projection, float nearPlane, float farPlane)
+	{
+		nearPlane = std::max(nearPlane, 1e-4f);
+		farPlane = std::max(farPlane, nearPlane * 1.001f);
+		m_projectionScale[0] = projection(0, 0);
+		m_projectionScale[1] = projection(1, 1);
+		m_orthographic = projection(3, 3) != 0.0f;
+
+		const float logRatio = std::log(farPlane / nearPlane);
+		m_depthScale = kSlices / logRatio;
+		m_depthBias = -std::log(nearPlane) * m_depthScale;
+		for (int slice = 0; slice <= kSlices; ++slice)
+		{
+			m_sliceNear[slice] = nearPlane * std::exp(logRatio * slice / kSlices);
+		}
+		m_sliceNear[0] = nearPlane;
+		m_sliceNear[kSlices] = farPlane;
+
+		// A tile's edges are rays from the eye, so its box spans the slice's near and far depths.
+		// Orthographic tiles are straight columns, the same size at every depth.
+		for (int slice = 0; slice < kSlices; ++slice)
+		{
+			const float d0 = m_orthographic ? 1.0f : m_sliceNear[slice];
+			const float d1 = m_orthographic ? 1.0f : m_sliceNear[slice + 1];
+			for (int x = 0; x < kTilesX; ++x)
+			{
+				const float left = -1.0f + 2.0f * x / kTilesX;
+				const float right = -1.0f + 2.0f * (x + 1) / kTilesX;
+				m_tileMinX[slice][x] = std::min(left * d0, left * d1) / m_projectionScale[0];
+				m_tileMaxX[slice][x] = std::max(right * d0, right * d1) / m_projectionScale[0];
+			}
+			for (int y = 0; y < kTilesY; ++y)
+			{
+				const float bottom = -1.0f + 2.0f * y / kTilesY;
+				const float top = -1.0f + 2.0f * (y + 1) / kTilesY;
+				m_tileMinY[slice][y] = std::min(bottom * d0, bottom * d1) / m_projectionScale[1];
+				m_tileMaxY[slice][y] = std::max(top * d0, top * d1) / m_projectionScale[1];
+			}
+		}
+	}
+
+	void ClusteredLighting::ComputeBounds(const QMatrix4x4& view)
+	{
+		const float* m = view.constData();
+		const float nearPlane = m_sliceNear[0];
+		const float farPlane = m_sliceNear[kSlices];
+		auto sliceOf = [this](float depth) { return Clamp(static_cast<int>(std::floor(std::log(depth) * m_depthScale + m_depthBias)), 0, kSlices - 1); };
+		auto tileOf = [](float ndc, int tiles) { return Clamp(static_cast<int>(std::floor((ndc + 1.0f) * 0.5f * tiles)), 0, tiles - 1); };
+
+		for (size_t i = 0; i < m_lights.size(); ++i)
+		{
+			const GpuLight& light = m_gpuLights[i];
+			Bounds& bounds = m_bounds[i];
+
+			// Spot lights are bound by the smallest sphere around their cone.
+			float world[3] = { light.position[0], light.position[1], light.position[2] };
+			float radius = light.range;
+			if (light.cosOuter > -1.5f)
+			{
+				const float halfAngle = std::acos(light.cosOuter);
+				const float offset = halfAngle > 0.25f * kPi ? light.range * light.cosOuter : 0.5f * light.range / light.cosOuter;
+				radius = halfAngle > 0.25f * kPi ? light.range * std::sin(halfAngle) : offset;
+				for (int axis = 0; axis < 3; ++axis) world[axis] += light.direction[axis] * offset;
+			}
+
+			bounds.center[0] = m[0] * world[0] + m[4] * world[1] + m[8] * world[2] + m[12];
+			bounds.center[1] = m[1] * world[0] + m[5] * world[1] + m[9] * world[2] + m[13];
+			bounds.center[2] = -(m[2] * world[0] + m[6] * world[1] + m[10] * world[2] + m[14]);
+			bounds.radius = radius;
+			bounds.firstSlice = 1;
+			bounds.lastSlice = 0;
+
+			const float nearest = std::max(bounds.center[2] - radius, nearPlane);
+			const float farthest = std::min(bounds.center[2] + radius, farPlane);
+			if (nearest > farthest) continue;
+
+			// x / depth is monotonic in depth, so the extremes sit at the nearest or farthest depth.
+			const float nearDivisor = m_orthographic ? 1.0f : nearest;
+			const float farDivisor = m_orthographic ? 1.0f : farthest;
+			float rect[4];
+			for (int axis = 0; axis < 2; ++axis)
+			{
+				const float low = bounds.center[axis] - radius;
+				const float high = bounds.center[axis] + radius;
+				rect[axis] = std::min(low / nearDivisor, low / farDivisor) * m_projectionScale[axis];
+				rect[axis + 2] = std::max(high / nearDivisor, high / farDivisor) * m_projectionScale[axis];
+			}
+			if (rect[0] > 1.0f || rect[1] > 1.0f || rect[2] < -1.0f || rect[3] < -1.0f) continue;
+
+			bounds.firstSlice = sliceOf(nearest);
+			bounds.lastSlice = sliceOf(farthest);
+			bounds.tiles[0] = tileOf(rect[0], kTilesX);
+			bounds.tiles[1] = tileOf(rect[1], kTilesY);
+			bounds.tiles[2] = tileOf(rect[2], kTilesX);
+			bounds.tiles[3] = tileOf(rect[3], kTilesY);
+		}
+	}
+
+	void ClusteredLighting::BinSlice(int slice)
+	{
+		const float d0 = m_sliceNear[slice];
+		const float d1 = m_sliceNear[slice + 1];
+		const float* minX = m_tileMinX[slice];
+		const float* maxX = m_tileMaxX[slice];
+
+		for (size_t i = 0; i < m_bounds.size(); ++i)
+		{
+			const Bounds& bounds = m_bounds[i];
+			if (slice < bounds.firstSlice || slice > bounds.lastSlice) continue;
+
+			// Squared distance from the sphere's center to each froxel box, one axis at a time.
+			const float dz = std::max(std::max(d0 - bounds.center[2], 0.0f), bounds.center[2] - d1);
+			const float remaining = bounds.radius * bounds.radius - dz * dz;
+			if (remaining < 0.0f) continue;
+
+			const uint16_t index = static_cast<uint16_t>(i);
+			for (int y = bounds.tiles[1]; y <= bounds.tiles[3]; ++y)
+			{
+				const float dy = std::max(std::max(m_tileMinY[slice][y] - bounds.center[1], 0.0f), bounds.center[1] - m_tileMaxY[slice][y]);
+				const float limit = remaining - dy * dy;
+				if (limit < 0.0f) continue;
+
+				const size_t row = (static_cast<size_t>(slice) * kTilesY + y) * kTilesX;
+				auto append = [&](int x)
+				{
+					const size_t cluster = row + x;
+					const uint16_t count = m_clusterCounts[cluster];
+					if (count < kMaxLightsPerCluster) m_clusterLights[cluster * kMaxLightsPerCluster + count] = index;
+					if (count < 0xFFFF) m_clusterCounts[cluster] = count + 1;
+				};
+
+				int x = bounds.tiles[0];
+#if ORCA_CLUSTER_SSE2
+				// Four tiles of the row per test; lanes outside the light's tile range are masked off.
+				const __m128 center = _mm_set1_ps(bounds.center[0]);
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 threshold = _mm_set1_ps(limit);
+				for (int group = x & ~3; group <= bounds.tiles[2]; group += 4)
+				{
+					const __m128 below = _mm_sub_ps(_mm_load_ps(minX + group), center);
+					const __m128 above = _mm_sub_ps(center, _mm_load_ps(maxX + group));
+					const __m128 dx = _mm_max_ps(_mm_max_ps(below, above), zero);
+					const int mask = _mm_movemask_ps(_mm_cmple_ps(_mm_mul_ps(dx, dx), threshold));
+					for (int lane = 0; lane < 4; ++lane)
+					{
+						const int tile = group + lane;
+						if ((mask & (1 << lane)) && tile >= bounds.tiles[0] && tile <= bounds.tiles[2]) append(tile);
+					}
+				}
+				x = bounds.tiles[2] + 1;
+#endif
+
+				for (; x <= bounds.tiles[2]; ++x)
+				{
+					const float dx = std::max(std::max(minX[x] - bounds.center[0], 0.0f), bounds.center[0] - maxX[x]);
+					if (dx * dx <= limit) append(x);
+				}
+			}
+		}
+	}
+
+	void ClusteredLighting::Compact()
+	{
+		uint32_t total = 0;
+		uint32_t busiest = 0;
+		uint32_t dropped = 0;
+		for (int cluster = 0; cluster < kClusterCount; ++cluster)
+		{
+			const uint32_t count = m_clusterCounts[cluster];
+			const uint32_t kept = std::min<uint32_t>(count, kMaxLightsPerCluster);
+			m_grid[cluster * 2] = total;
+			m_grid[cluster * 2 + 1] = kept;
+			total += kept;
+			busiest = std::max(busiest, count);
+			dropped += count - kept;
+		}
+
+		// Reserved for every cluster full in SetLights(), so rebinning doesn't allocate.
+		m_indices.resize(total);
+		for (int cluster = 0; cluster < kClusterCount; ++cluster)
+		{
+			const uint16_t* first = m_clusterLights.data() + static_cast<size_t>(cluster) * kMaxLightsPerCluster;
+			std::copy(first, first + m_grid[cluster * 2 + 1], m_indices.begin() + m_grid[cluster * 2]);
+		}
+
+		if (dropped > 0 && m_stats.droppedEntries == 0)
+		{
+			ORCA_LOG_WARNING("Renderer", "Some clusters have more than {} lights; {} light references were dropped", kMaxLightsPerCluster, dropped);
+		}
+		m_stats.clusterEntries = total;
+		m_stats.busiestCluster = busiest;
+		m_stats.droppedEntries = dropped;
+	}
+
+	void ClusteredLighting::Upload(GLuint buffer, const void* data, size_t bytes)
+	{
+		// Orphan the old storage so the driver doesn't wait for frames still reading it.
+		glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+		glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(std::max<size_t>(bytes, 16)), nullptr, GL_STREAM_DRAW);
+		if (bytes > 0) glBufferSubData(GL_TEXTURE_BUFFER, 0, static_cast<GLsizeiptr>(bytes), data);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	}
+
+	void ClusteredLighting::Bind(QOpenGLShaderProgram& program, int firstUnit, int viewportWidth, int viewportHeight)
+	{
+		// Samplers of different types may not share a unit, even unused ones, so always assign them.
+		program.setUniformValue("lights", firstUnit);
+		program.setUniformValue("clusterGrid", firstUnit + 1);
+		program.setUniformValue("lightIndices", firstUnit + 2);
+		program.setUniformValue("lightingEnabled", Enabled() ? 1 : 0);
+		if (!Enabled() || !m_initialized) return;
+
+		program.setUniformValue("ambientLight", QVector3D(m_ambient[0], m_ambient[1], m_ambient[2]));
+		program.setUniformValue("directionalCount", static_cast<GLint>(m_directional.size()));
+		if (!m_directional.empty())
+		{
+			const int count = static_cast<int>(m_directional.size());
+			program.setUniformValueArray("directionalDirections", &m_directionalDirections[0][0], count, 3);
+			program.setUniformValueArray("directionalColors", &m_directionalColors[0][0], count, 3);
+		}
+
+		// No clusters to walk when only directional lights exist; their buffers were never filled.
+		const GLint slices = m_lights.empty() ? 0 : kSlices;
+		glUniform3i(program.uniformLocation("clusterCounts"), kTilesX, kTilesY, slices);
+		program.setUniformValue("clusterTileSize", QVector2D(std::max(1, viewportWidth) / float(kTilesX), std::max(1, viewportHeight) / float(kTilesY)));
+		program.setUniformValue("clusterDepth", QVector2D(m_depthScale, m_depthBias));
+
+		for (int i = 0; i < 3; ++i)
+		{
+			glActiveTexture(GL_TEXTURE0 + firstUnit + i);
+			glBindTexture(GL_TEXTURE_BUFFER, m_textures[i]);
+		}
+		glActiveTexture(GL_TEXTURE0);
+	}
+}
\ No newline at end of file
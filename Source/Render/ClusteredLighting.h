@@ -0,0 +1,153 @@
+#pragma once
+
+#ifndef CLUSTERED_LIGHTING_H
+#define CLUSTERED_LIGHTING_H
+
+#include "../Core/ProjectLoader.h"
+#include <QtGui/QMatrix4x4>
+#include <QtGui/QOpenGLExtraFunctions>
+#include <QtOpenGL/QOpenGLShaderProgram>
+#include <cstdint>
+#include <vector>
+
+namespace Orca
+{
+	struct ClusteredLightingStats
+	{
+		int pointLights = 0;
+		int spotLights = 0;
+		int directionalLights = 0;      // shaded for every pixel, not clustered
+		uint32_t clusterEntries = 0;    // light references over all clusters
+		uint32_t busiestCluster = 0;
+		uint32_t droppedEntries = 0;    // references past kMaxLightsPerCluster
+		double binMs = 0.0;             // last time the lights were binned
+	};
+
+	/**
+	 * @brief Clustered forward lighting for point and spot lights.
+	 *
+	 * The view frustum is cut into kTilesX x kTilesY screen tiles and kSlices exponential depth
+	 * slices. Each light's bounding sphere is binned into the froxels it touches on the CPU,
+	 * slices spread over worker threads and four tiles tested at a time with SSE. The lights, the
+	 * per-cluster ranges and the light index lists go to the GPU as texture buffers, so the
+	 * fragment shader only visits the lights of its own cluster. Texture buffers and texelFetch
+	 * are GL 3.1, so this runs anywhere the viewport does, llvmpipe included.
+	 *
+	 * Binning only runs when the lights, their transforms or the camera change. All GL calls
+	 * need the owning context current, and the owner must call Clear() before the context goes away.
+	 */
+	class ClusteredLighting : protected QOpenGLExtraFunctions
+	{
+	public:
+		static constexpr int kTilesX = 16;
+		static constexpr int kTilesY = 9;
+		static constexpr int kSlices = 24;
+		static constexpr int kClusterCount = kTilesX * kTilesY * kSlices;
+		static constexpr int kMaxLightsPerCluster = 128;
+		static constexpr int kMaxLights = 65536;            // light indices are 16 bits
+		static constexpr int kMaxDirectionalLights = 4;
+
+		/** @brief Lights below this many are binned on the calling thread. */
+		static constexpr size_t kParallelBinLights = 256;
+
+		ClusteredLighting() = default;
+
+		ClusteredLighting(const ClusteredLighting&) = delete;
+		ClusteredLighting& operator=(const ClusteredLighting&) = delete;
+
+		void Initialize();
+
+		/** @brief Deletes the texture buffers. */
+		void Clear();
+
+		/** @brief Replaces the scene's lights; follow with SetTransforms(). */
+		void SetLights(const std::vector<SceneLight>& lights, const float ambientLight[3]);
+
+		/** @brief Places the lights from their entities' world matrices (16 floats each). */
+		void SetTransforms(const std::vector<float>& worldMatrices);
+
+		/** @brief False without any lights, in which case the scene is drawn unlit. */
+		bool Enabled() const { return !m_lights.empty() || !m_directional.empty(); }
+
+		/** @brief Directional lights shaded, at most kMaxDirectionalLights. */
+		int DirectionalCount() const { return static_cast<int>(m_directional.size()); }
+
+		/** @brief World-space direction light @p index travels in, normalized. */
+		const float* DirectionalDirection(int index) const { return m_directionalDirections[index]; }
+
+		/** @brief Rebins and uploads whatever changed since the last call. */
+		void Update(const QMatrix4x4& view, const QMatrix4x4& projection, float nearPlane, float farPlane);
+
+		/**
+		 * @brief Sets the lighting uniforms on the bound @p program and binds the texture buffers
+		 *        to units @p firstUnit .. @p firstUnit + 2.
+		 */
+		void Bind(QOpenGLShaderProgram& program, int firstUnit, int viewportWidth, int viewportHeight);
+
+		ClusteredLightingStats Stats() const { return m_stats; }
+
+	private:
+		// Three RGBA32F texels in the lights buffer.
+		struct GpuLight
+		{
+			float position[3];
+			float range;
+			float color[3];
+			float cosOuter;     // -2 for point lights
+			float direction[3];
+			float cosInner;
+		};
+
+		struct Bounds
+		{
+			float center[3];    // view space, x right, y up, z the distance in front of the camera
+			float radius;
+			int firstSlice;
+			int lastSlice;
+			int tiles[4];       // x0, y0, x1, y1
+		};
+
+		void BuildFroxels(const QMatrix4x4& projection, float nearPlane, float farPlane);
+		void ComputeBounds(const QMatrix4x4& view);
+		void BinSlice(int slice);
+		void Compact();
+		void Upload(GLuint buffer, const void* data, size_t bytes);
+
+		std::vector<SceneLight> m_lights;              // point and spot
+		std::vector<SceneLight> m_directional;
+		std::vector<GpuLight> m_gpuLights;
+		float m_ambient[3] = { 0.1f, 0.1f, 0.1f };
+		float m_directionalDirections[kMaxDirectionalLights][3] = {};
+		float m_directionalColors[kMaxDirectionalLights][3] = {};
+
+		// Froxel bounds in view space: x per tile and slice, y per tile row and slice.
+		alignas(16) float m_tileMinX[kSlices][kTilesX] = {};
+		alignas(16) float m_tileMaxX[kSlices][kTilesX] = {};
+		float m_tileMinY[kSlices][kTilesY] = {};
+		float m_tileMaxY[kSlices][kTilesY] = {};
+		float m_sliceNear[kSlices + 1] = {};
+		float m_projectionScale[2] = { 1.0f, 1.0f };
+		bool m_orthographic = false;
+		float m_depthScale = 0.0f;                     // slice = log(depth) * scale + bias
+		float m_depthBias = 0.0f;
+
+		std::vector<Bounds> m_bounds;
+		std::vector<uint16_t> m_clusterCounts;         // per cluster, while binning
+		std::vector<uint16_t> m_clusterLights;         // kMaxLightsPerCluster slots per cluster
+		std::vector<uint32_t> m_grid;                  // offset and count per cluster
+		std::vector<uint16_t> m_indices;
+
+		QMatrix4x4 m_view;
+		QMatrix4x4 m_projection;
+		bool m_lightsDirty = false;                    // m_gpuLights needs uploading
+		bool m_binDirty = false;
+
+		bool m_initialized = false;
+		GLuint m_buffers[3] = {};                      // lights, grid, indices
+		GLuint m_textures[3] = {};
+
+		ClusteredLightingStats m_stats;
+	};
+}
+
+#endif
\ No newline at end of file
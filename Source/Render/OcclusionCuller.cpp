@@ -0,0 +1,491 @@
+#include "OcclusionCuller.h"
+#include "../Core/MemoryTracker.h"
+#include "../Core/ProjectLoader.h"
+#include "../Core/Profiler.h"
+#include "../Core/WorkerPool.h"
+#include <QtCore/QElapsedTimer>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ORCA_OCCLUSION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Orca
+{
+	namespace
+	{
+		enum : uint8_t
+		{
+			kVisible = 0,
+			kOutsideFrustum = 1,
+			kOccluded = 2
+		};
+
+		constexpr float kFar = 1e30f;
+
+		// out = a * b, all column-major.
+		void Multiply(const float* a, const float* b, float* out)
+		{
+#if ORCA_OCCLUSION_SSE2
+			const __m128 c0 = _mm_loadu_ps(a);
+			const __m128 c1 = _mm_loadu_ps(a + 4);
+			const __m128 c2 = _mm_loadu_ps(a + 8);
+			const __m128 c3 = _mm_loadu_ps(a + 12);
+			for (int column = 0; column < 4; ++column)
+			{
+				const float* v = b + column * 4;
+				__m128 result = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+				result = _mm_add_ps(result, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+				result = _mm_add_ps(result, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+				result = _mm_add_ps(result, _mm_mul_ps(c3, _mm_set1_ps(v[3])));
+				_mm_storeu_ps(out + column * 4, result);
+			}
+#else
+			for (int column = 0; column < 4; ++column)
+			{
+				for (int row = 0; row < 4; ++row)
+				{
+					out[column * 4 + row] = a[row] * b[column * 4] + a[4 + row] * b[column * 4 + 1]
+						+ a[8 + row] * b[column * 4 + 2] + a[12 + row] * b[column * 4 + 3];
+				}
+			}
+#endif
+		}
+
+		// Bits [0, n) set, for n in [0, 32].
+		uint32_t LowBits(int n)
+		{
+			return n >= 32 ? 0xFFFFFFFFu : (1u << n) - 1u;
+		}
+
+		int ClampInt(int value, int low, int high)
+		{
+			return std::min(std::max(value, low), high);
+		}
+
+#if ORCA_OCCLUSION_SSE2
+		// Per lane, bits [0, n) set for a whole number n in [0, 32]. 2^n is built in the float
+		// exponent; 2^31 overflows the conversion, which then yields 0x80000000, the right bit anyway.
+		__m128i LowBits(__m128 n)
+		{
+			const __m128i exponent = _mm_add_epi32(_mm_cvttps_epi32(_mm_min_ps(n, _mm_set1_ps(31.0f))), _mm_set1_epi32(127));
+			const __m128i power = _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(exponent, 23)));
+			const __m128i bits = _mm_sub_epi32(power, _mm_set1_epi32(1));
+			return _mm_or_si128(bits, _mm_castps_si128(_mm_cmpge_ps(n, _mm_set1_ps(32.0f))));
+		}
+
+		// First pixel column whose center lies at or right of x, for x within one tile.
+		__m128 FirstColumn(__m128 x)
+		{
+			const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_sub_ps(x, _mm_set1_ps(0.5f)), _mm_setzero_ps()), _mm_set1_ps(32.0f));
+			const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(clamped));
+			return _mm_add_ps(truncated, _mm_and_ps(_mm_cmplt_ps(truncated, clamped), _mm_set1_ps(1.0f)));
+		}
+
+		bool AllZero(__m128i value)
+		{
+			return _mm_movemask_epi8(_mm_cmpeq_epi32(value, _mm_setzero_si128())) == 0xFFFF;
+		}
+#else
+		int FirstColumn(float x)
+		{
+			return static_cast<int>(std::ceil(std::min(std::max(x - 0.5f, 0.0f), 32.0f)));
+		}
+#endif
+	}
+
+	void OcclusionCuller::SetMesh(const float* vertices, int vertexCount, int stride)
+	{
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+		vertexCount -= vertexCount % 3;
+		m_positions.resize(static_cast<size_t>(vertexCount) * 3);
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			m_boundsMin[axis] = vertexCount > 0 ? kFar : 0.0f;
+			m_boundsMax[axis] = vertexCount > 0 ? -kFar : 0.0f;
+		}
+		for (int v = 0; v < vertexCount; ++v)
+		{
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				const float value = vertices[static_cast<size_t>(v) * stride + axis];
+				m_positions[static_cast<size_t>(v) * 3 + axis] = value;
+				m_boundsMin[axis] = std::min(m_boundsMin[axis], value);
+				m_boundsMax[axis] = std::max(m_boundsMax[axis], value);
+			}
+		}
+	}
+
+	void OcclusionCuller::SetOccluders(const std::vector<uint8_t>& renderFlags)
+	{
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+		m_occluders.clear();
+		m_isOccluder.assign(renderFlags.size(), 0);
+		for (uint32_t instance = 0; instance < renderFlags.size(); ++instance)
+		{
+			if (!(renderFlags[instance] & LoadedScene::kOccluder)) continue;
+			m_occluders.push_back(instance);
+			m_isOccluder[instance] = 1;
+		}
+
+		m_stats = OcclusionCullingStats();
+		m_stats.occluders = static_cast<uint32_t>(m_occluders.size());
+	}
+
+	void OcclusionCuller::Cull(const float* worldMatrices, size_t count, const QMatrix4x4& viewProjection, std::vector<uint32_t>& visible)
+	{
+		ORCA_PROFILE_ZONE("OcclusionCuller::Cull");
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+		QElapsedTimer timer;
+		timer.start();
+
+		// Occluders the scene hasn't uploaded yet are left out; m_occluders is ascending.
+		const size_t occluders = static_cast<size_t>(std::lower_bound(m_occluders.begin(), m_occluders.end(), static_cast<uint32_t>(std::min<size_t>(count, 0xFFFFFFFFu))) - m_occluders.begin());
+		const size_t trianglesPerMesh = m_positions.size() / 9;
+		const size_t triangleCount = occluders * trianglesPerMesh;
+		const bool parallel = triangleCount >= kParallelTriangles;
+		m_triangles.resize(triangleCount);
+		{
+			ORCA_PROFILE_ZONE("OcclusionCuller::Rasterize");
+			WorkerPool& workers = WorkerPool::Get();
+			workers.ParallelFor(occluders, [&](size_t occluder)
+			{
+				SetupOccluder(occluder, worldMatrices + static_cast<size_t>(m_occluders[occluder]) * 16, viewProjection);
+			}, parallel);
+
+			for (auto& row : m_tiles)
+			{
+				for (Tile& tile : row) tile = Tile{ { 0, 0, 0, 0 }, 0.0f, 1.0f };
+			}
+			// Each worker owns a row of tiles, so no tile is written by two threads.
+			if (triangleCount > 0)
+			{
+				workers.ParallelFor(kTilesY, [this](size_t tileY) { RasterizeTileRow(static_cast<int>(tileY)); }, parallel);
+			}
+		}
+		m_stats.occluderTriangles = static_cast<uint32_t>(std::count_if(m_triangles.begin(), m_triangles.end(), [](const ScreenTriangle& triangle) { return triangle.valid; }));
+		m_stats.rasterMs = timer.nsecsElapsed() / 1e6;
+		timer.restart();
+
+		m_results.resize(count);
+		{
+			ORCA_PROFILE_ZONE("OcclusionCuller::Test");
+			const size_t batches = (count + kTestBatch - 1) / kTestBatch;
+			WorkerPool::Get().ParallelFor(batches, [&](size_t batch)
+			{
+				const size_t end = std::min(count, (batch + 1) * kTestBatch);
+				for (size_t instance = batch * kTestBatch; instance < end; ++instance)
+				{
+					const bool occluder = instance < m_isOccluder.size() && m_isOccluder[instance];
+					m_results[instance] = occluder ? static_cast<uint8_t>(kVisible) : TestInstance(worldMatrices + instance * 16, viewProjection);
+				}
+			});
+		}
+
+		// Room for everything, so a view that sees more than ever before still doesn't allocate.
+		visible.clear();
+		visible.reserve(count);
+		m_stats.frustumCulled = 0;
+		m_stats.occlusionCulled = 0;
+		for (size_t instance = 0; instance < count; ++instance)
+		{
+			switch (m_results[instance])
+			{
+			case kVisible: visible.push_back(static_cast<uint32_t>(instance)); break;
+			case kOutsideFrustum: ++m_stats.frustumCulled; break;
+			default: ++m_stats.occlusionCulled; break;
+			}
+		}
+		m_stats.tested = static_cast<uint32_t>(count - occluders);
+		m_stats.visible = static_cast<uint32_t>(visible.size());
+		m_stats.testMs = timer.nsecsElapsed() / 1e6;
+
+		ORCA_PROFILE_COUNTER("Occlusion culled", m_stats.occlusionCulled);
+		ORCA_PROFILE_COUNTER("Frustum culled", m_stats.frustumCulled);
+	}
+
+	void OcclusionCuller::SetupOccluder(size_t occluder, const float* worldMatrix, const QMatrix4x4& viewProjection)
+	{
+		float mvp[16];
+		Multiply(viewProjection.constData(), worldMatrix, mvp);
+
+		const size_t trianglesPerMesh = m_positions.size() / 9;
+		ScreenTriangle* triangles = m_triangles.data() + occluder * trianglesPerMesh;
+		for (size_t t = 0; t < trianglesPerMesh; ++t)
+		{
+			ScreenTriangle& triangle = triangles[t];
+			triangle.valid = false;
+
+			float x[3], y[3], z[3];
+			bool clipped = false;
+			for (int v = 0; v < 3; ++v)
+			{
+				const float* p = m_positions.data() + (t * 3 + v) * 3;
+				float clip[4];
+				for (int row = 0; row < 4; ++row) clip[row] = mvp[row] * p[0] + mvp[4 + row] * p[1] + mvp[8 + row] * p[2] + mvp[12 + row];
+
+				// Past the near plane GL would clip it open, so it can't be trusted to hide anything.
+				if (clip[3] <= 0.0f || clip[2] < -clip[3]) { clipped = true; break; }
+				const float inverse = 1.0f / clip[3];
+				x[v] = (clip[0] * inverse * 0.5f + 0.5f) * kWidth;
+				y[v] = (clip[1] * inverse * 0.5f + 0.5f) * kHeight;
+				z[v] = clip[2] * inverse * 0.5f + 0.5f;
+			}
+			if (clipped) continue;
+
+			// Counter-clockwise with y up is front-facing; the back of a closed mesh is never nearer.
+			const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+			if (area <= 1e-6f) continue;
+
+			const float xMin = std::min({ x[0], x[1], x[2] });
+			const float xMax = std::max({ x[0], x[1], x[2] });
+			triangle.yMin = std::min({ y[0], y[1], y[2] });
+			triangle.yMax = std::max({ y[0], y[1], y[2] });
+			triangle.zMax = std::max({ z[0], z[1], z[2] });
+			if (xMax < 0.0f || xMin > kWidth || triangle.yMax < 0.0f || triangle.yMin > kHeight || triangle.zMax >= 1.0f) continue;
+
+			for (int e = 0; e < 3; ++e)
+			{
+				const int next = (e + 1) % 3;
+				const float dy = y[next] - y[e];
+				if (std::abs(dy) < 1e-6f)
+				{
+					// The vertical extent already bounds the rows a horizontal edge would.
+					triangle.edgeSide[e] = 0;
+					continue;
+				}
+				// The inside is left of every edge: an edge going up bounds the span on the right.
+				triangle.edgeSlope[e] = (x[next] - x[e]) / dy;
+				triangle.edgeOffset[e] = x[e] - triangle.edgeSlope[e] * y[e];
+				triangle.edgeSide[e] = dy > 0.0f ? 1 : -1;
+			}
+
+			triangle.zPlane[0] = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+			triangle.zPlane[1] = ((x[1] - x[0]) * (z[2] - z[0]) - (x[2] - x[0]) * (z[1] - z[0])) / area;
+			triangle.zPlane[2] = z[0] - triangle.zPlane[0] * x[0] - triangle.zPlane[1] * y[0];
+
+			triangle.tiles[0] = static_cast<int16_t>(ClampInt(static_cast<int>(std::floor(xMin / kTileWidth)), 0, kTilesX - 1));
+			triangle.tiles[1] = static_cast<int16_t>(ClampInt(static_cast<int>(std::floor(triangle.yMin / kTileHeight)), 0, kTilesY - 1));
+			triangle.tiles[2] = static_cast<int16_t>(ClampInt(static_cast<int>(std::floor(xMax / kTileWidth)), 0, kTilesX - 1));
+			triangle.tiles[3] = static_cast<int16_t>(ClampInt(static_cast<int>(std::floor(triangle.yMax / kTileHeight)), 0, kTilesY - 1));
+			triangle.valid = true;
+		}
+	}
+
+	void OcclusionCuller::RasterizeTileRow(int tileY)
+	{
+		Tile* row = m_tiles[tileY];
+		const float rowY = static_cast<float>(tileY * kTileHeight);
+
+		for (const ScreenTriangle& triangle : m_triangles)
+		{
+			if (!triangle.valid || tileY < triangle.tiles[1] || tileY > triangle.tiles[3]) continue;
+
+#if ORCA_OCCLUSION_SSE2
+			// One lane per pixel row, sampled at the pixel centers.
+			const __m128 y = _mm_add_ps(_mm_set1_ps(rowY), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+			__m128 left = _mm_set1_ps(-kFar);
+			__m128 right = _mm_set1_ps(kFar);
+			for (int e = 0; e < 3; ++e)
+			{
+				if (triangle.edgeSide[e] == 0) continue;
+				const __m128 crossing = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.edgeSlope[e]), y), _mm_set1_ps(triangle.edgeOffset[e]));
+				if (triangle.edgeSide[e] < 0) left = _mm_max_ps(left, crossing);
+				else right = _mm_min_ps(right, crossing);
+			}
+			const __m128 outside = _mm_or_ps(_mm_cmplt_ps(y, _mm_set1_ps(triangle.yMin)), _mm_cmpgt_ps(y, _mm_set1_ps(triangle.yMax)));
+			left = _mm_or_ps(_mm_and_ps(outside, _mm_set1_ps(kFar)), _mm_andnot_ps(outside, left));
+#else
+			float left[kTileHeight];
+			float right[kTileHeight];
+			for (int r = 0; r < kTileHeight; ++r)
+			{
+				const float y = rowY + r + 0.5f;
+				left[r] = y < triangle.yMin || y > triangle.yMax ? kFar : -kFar;
+				right[r] = kFar;
+				for (int e = 0; e < 3; ++e)
+				{
+					if (triangle.edgeSide[e] == 0) continue;
+					const float crossing = triangle.edgeSlope[e] * y + triangle.edgeOffset[e];
+					if (triangle.edgeSide[e] < 0) left[r] = std::max(left[r], crossing);
+					else right[r] = std::min(right[r], crossing);
+				}
+			}
+#endif
+
+			for (int tileX = triangle.tiles[0]; tileX <= triangle.tiles[2]; ++tileX)
+			{
+				const float tileLeft = static_cast<float>(tileX * kTileWidth);
+				Tile& tile = row[tileX];
+
+				// The plane's farthest point over the tile, but never past the triangle's far vertex.
+				const float tileDepth = triangle.zPlane[0] * tileLeft + triangle.zPlane[1] * rowY + triangle.zPlane[2]
+					+ std::max(triangle.zPlane[0] * kTileWidth, 0.0f) + std::max(triangle.zPlane[1] * kTileHeight, 0.0f);
+				const float depth = std::min(tileDepth, triangle.zMax);
+				if (depth >= tile.zMax1) continue;
+
+#if ORCA_OCCLUSION_SSE2
+				const __m128 offset = _mm_set1_ps(tileLeft);
+				const __m128i coverage = _mm_andnot_si128(LowBits(FirstColumn(_mm_sub_ps(left, offset))), LowBits(FirstColumn(_mm_sub_ps(right, offset))));
+				if (AllZero(coverage)) continue;
+
+				// Masked occlusion merge: start a new working layer when this triangle is much nearer
+				// than the current one, and once the working layer covers the tile it becomes its bound.
+				__m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(tile.mask));
+				if (AllZero(mask) || tile.zMax0 - depth > tile.zMax1 - tile.zMax0)
+				{
+					mask = coverage;
+					tile.zMax0 = depth;
+				}
+				else
+				{
+					mask = _mm_or_si128(mask, coverage);
+					tile.zMax0 = std::max(tile.zMax0, depth);
+				}
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(mask, _mm_set1_epi32(-1))) == 0xFFFF)
+				{
+					tile.zMax1 = tile.zMax0;
+					tile.zMax0 = 0.0f;
+					mask = _mm_setzero_si128();
+				}
+				_mm_store_si128(reinterpret_cast<__m128i*>(tile.mask), mask);
+#else
+				uint32_t coverage[kTileHeight];
+				bool empty = true;
+				bool full = true;
+				bool working = false;
+				for (int r = 0; r < kTileHeight; ++r)
+				{
+					coverage[r] = LowBits(FirstColumn(right[r] - tileLeft)) & ~LowBits(FirstColumn(left[r] - tileLeft));
+					empty = empty && coverage[r] == 0;
+					working = working || tile.mask[r] != 0;
+				}
+				if (empty) continue;
+
+				const bool restart = !working || tile.zMax0 - depth > tile.zMax1 - tile.zMax0;
+				tile.zMax0 = restart ? depth : std::max(tile.zMax0, depth);
+				for (int r = 0; r < kTileHeight; ++r)
+				{
+					tile.mask[r] = restart ? coverage[r] : tile.mask[r] | coverage[r];
+					full = full && tile.mask[r] == 0xFFFFFFFFu;
+				}
+				if (full)
+				{
+					tile.zMax1 = tile.zMax0;
+					tile.zMax0 = 0.0f;
+					std::fill(tile.mask, tile.mask + kTileHeight, 0u);
+				}
+#endif
+			}
+		}
+	}
+
+	uint8_t OcclusionCuller::TestInstance(const float* worldMatrix, const QMatrix4x4& viewProjection) const
+	{
+		float mvp[16];
+		Multiply(viewProjection.constData(), worldMatrix, mvp);
+
+		// The eight box corners in clip space, lanes 0-3 on the low z face and 4-7 on the high one.
+		alignas(16) float clip[4][8];
+#if ORCA_OCCLUSION_SSE2
+		const __m128 cornerX = _mm_setr_ps(m_boundsMin[0], m_boundsMax[0], m_boundsMin[0], m_boundsMax[0]);
+		const __m128 cornerY = _mm_setr_ps(m_boundsMin[1], m_boundsMin[1], m_boundsMax[1], m_boundsMax[1]);
+		__m128 outside[6] = { _mm_set1_ps(-1.0f), _mm_set1_ps(-1.0f), _mm_set1_ps(-1.0f), _mm_set1_ps(-1.0f), _mm_set1_ps(-1.0f), _mm_set1_ps(-1.0f) };
+		__m128 nearCrossing = _mm_setzero_ps();
+		for (int face = 0; face < 2; ++face)
+		{
+			const __m128 cornerZ = _mm_set1_ps(face ? m_boundsMax[2] : m_boundsMin[2]);
+			__m128 c[4];
+			for (int row = 0; row < 4; ++row)
+			{
+				c[row] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(mvp[row]), cornerX), _mm_mul_ps(_mm_set1_ps(mvp[4 + row]), cornerY)),
+					_mm_add_ps(_mm_mul_ps(_mm_set1_ps(mvp[8 + row]), cornerZ), _mm_set1_ps(mvp[12 + row])));
+				_mm_store_ps(clip[row] + face * 4, c[row]);
+			}
+			const __m128 negativeW = _mm_sub_ps(_mm_setzero_ps(), c[3]);
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				outside[axis * 2] = _mm_and_ps(outside[axis * 2], _mm_cmplt_ps(c[axis], negativeW));
+				outside[axis * 2 + 1] = _mm_and_ps(outside[axis * 2 + 1], _mm_cmpgt_ps(c[axis], c[3]));
+			}
+			nearCrossing = _mm_or_ps(nearCrossing, _mm_or_ps(_mm_cmplt_ps(c[2], negativeW), _mm_cmple_ps(c[3], _mm_setzero_ps())));
+		}
+		for (const __m128& plane : outside)
+		{
+			if (_mm_movemask_ps(plane) == 0xF) return kOutsideFrustum;
+		}
+		if (_mm_movemask_ps(nearCrossing) != 0) return kVisible;
+#else
+		bool nearCrossing = false;
+		int outside[6] = { 0, 0, 0, 0, 0, 0 };
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			const float p[3] = { (corner & 1) ? m_boundsMax[0] : m_boundsMin[0], (corner & 2) ? m_boundsMax[1] : m_boundsMin[1], (corner & 4) ? m_boundsMax[2] : m_boundsMin[2] };
+			for (int row = 0; row < 4; ++row) clip[row][corner] = mvp[row] * p[0] + mvp[4 + row] * p[1] + mvp[8 + row] * p[2] + mvp[12 + row];
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				outside[axis * 2] += clip[axis][corner] < -clip[3][corner];
+				outside[axis * 2 + 1] += clip[axis][corner] > clip[3][corner];
+			}
+			nearCrossing = nearCrossing || clip[2][corner] < -clip[3][corner] || clip[3][corner] <= 0.0f;
+		}
+		for (int count : outside)
+		{
+			if (count == 8) return kOutsideFrustum;
+		}
+		if (nearCrossing) return kVisible;
+#endif
+
+		float xMin = kFar, xMax = -kFar, yMin = kFar, yMax = -kFar, zMin = kFar;
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			const float inverse = 1.0f / clip[3][corner];
+			const float x = (clip[0][corner] * inverse * 0.5f + 0.5f) * kWidth;
+			const float y = (clip[1][corner] * inverse * 0.5f + 0.5f) * kHeight;
+			xMin = std::min(xMin, x);
+			xMax = std::max(xMax, x);
+			yMin = std::min(yMin, y);
+			yMax = std::max(yMax, y);
+			zMin = std::min(zMin, clip[2][corner] * inverse * 0.5f + 0.5f);
+		}
+
+		// Every pixel the box touches, not just those whose centers it covers.
+		const int x0 = std::max(0, static_cast<int>(std::floor(xMin)));
+		const int x1 = std::min(kWidth, static_cast<int>(std::ceil(xMax)));
+		const int y0 = std::max(0, static_cast<int>(std::floor(yMin)));
+		const int y1 = std::min(kHeight, static_cast<int>(std::ceil(yMax)));
+		if (x0 >= x1 || y0 >= y1) return kOutsideFrustum;
+
+		for (int tileY = y0 / kTileHeight; tileY <= (y1 - 1) / kTileHeight; ++tileY)
+		{
+			for (int tileX = x0 / kTileWidth; tileX <= (x1 - 1) / kTileWidth; ++tileX)
+			{
+				const Tile& tile = m_tiles[tileY][tileX];
+				if (zMin >= tile.zMax1) continue;
+				if (zMin < tile.zMax0) return kVisible;
+
+				// Between the two depths: hidden only where the working layer covers the box.
+				const int tileLeft = tileX * kTileWidth;
+				const uint32_t columns = LowBits(ClampInt(x1 - tileLeft, 0, 32)) & ~LowBits(ClampInt(x0 - tileLeft, 0, 32));
+				uint32_t rect[kTileHeight];
+				for (int r = 0; r < kTileHeight; ++r)
+				{
+					const int pixelY = tileY * kTileHeight + r;
+					rect[r] = pixelY >= y0 && pixelY < y1 ? columns : 0u;
+				}
+#if ORCA_OCCLUSION_SSE2
+				const __m128i uncovered = _mm_andnot_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(tile.mask)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(rect)));
+				if (!AllZero(uncovered)) return kVisible;
+#else
+				for (int r = 0; r < kTileHeight; ++r)
+				{
+					if (rect[r] & ~tile.mask[r]) return kVisible;
+				}
+#endif
+			}
+		}
+		return kOccluded;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#ifndef OCCLUSION_CULLER_H
+#define OCCLUSION_CULLER_H
+
+#include <QtGui/QMatrix4x4>
+#include <cstdint>
+#include <vector>
+
+namespace Orca
+{
+	struct OcclusionCullingStats
+	{
+		uint32_t occluders = 0;
+		uint32_t occluderTriangles = 0;    // front-facing triangles rasterized by the last Cull()
+		uint32_t tested = 0;
+		uint32_t frustumCulled = 0;
+		uint32_t occlusionCulled = 0;
+		uint32_t visible = 0;              // occluders included; they are never tested
+		double rasterMs = 0.0;
+		double testMs = 0.0;
+	};
+
+	/**
+	 * @brief CPU occlusion culling against a small masked depth buffer.
+	 *
+	 * Designated occluders are rasterized into a kWidth x kHeight buffer in the style of masked
+	 * software occlusion: no per-pixel depth, just tiles of 32 x 4 pixels that keep a coverage
+	 * bit per pixel, the farthest depth of the covered pixels and a depth bound for the whole
+	 * tile. Rows of tiles are rasterized on worker threads, four pixel rows at a time with SSE.
+	 * Every other instance's box is then tested against the frustum and the tiles it overlaps.
+	 *
+	 * Occluder triangles crossing the near plane are skipped and occludees crossing it are kept,
+	 * so a culled instance really is hidden, up to a pixel at occluder edges. Pure CPU work with
+	 * no GL calls; the caller submits what survives.
+	 */
+	class OcclusionCuller
+	{
+	public:
+		static constexpr int kWidth = 256;
+		static constexpr int kHeight = 144;
+		static constexpr int kTileWidth = 32;
+		static constexpr int kTileHeight = 4;
+		static constexpr int kTilesX = kWidth / kTileWidth;
+		static constexpr int kTilesY = kHeight / kTileHeight;
+
+		/** @brief Fewer occluder triangles than this are rasterized on the calling thread. */
+		static constexpr size_t kParallelTriangles = 2048;
+
+		/** @brief Instances are tested in batches this large, one batch per worker at a time. */
+		static constexpr size_t kTestBatch = 2048;
+
+		OcclusionCuller() = default;
+
+		OcclusionCuller(const OcclusionCuller&) = delete;
+		OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+		/**
+		 * @brief The mesh every instance draws: @p vertexCount triangle-list positions, @p stride
+		 *        floats apart, counter-clockwise when seen from outside. Occluders rasterize it and
+		 *        occludees are tested by its bounding box.
+		 */
+		void SetMesh(const float* vertices, int vertexCount, int stride);
+
+		/** @brief Instances flagged LoadedScene::kOccluder in @p renderFlags become occluders. */
+		void SetOccluders(const std::vector<uint8_t>& renderFlags);
+
+		/**
+		 * @brief Culls the first @p count instances of @p worldMatrices (16 floats each) for
+		 *        @p viewProjection. @p visible receives the ascending indices of the survivors.
+		 */
+		void Cull(const float* worldMatrices, size_t count, const QMatrix4x4& viewProjection, std::vector<uint32_t>& visible);
+
+		OcclusionCullingStats Stats() const { return m_stats; }
+
+	private:
+		// Four pixel rows of coverage bits, bit i for column i, and two depths in [0, 1].
+		struct alignas(16) Tile
+		{
+			uint32_t mask[kTileHeight];
+			float zMax0;        // farthest depth among the covered pixels
+			float zMax1;        // bound for every pixel of the tile
+		};
+
+		struct ScreenTriangle
+		{
+			float edgeSlope[3];     // crossing x = slope * y + offset, in pixels
+			float edgeOffset[3];
+			int8_t edgeSide[3];     // -1 bounds the span on the left, 1 on the right, 0 horizontal
+			float yMin;
+			float yMax;
+			float zPlane[3];        // depth = x * [0] + y * [1] + [2]
+			float zMax;
+			int16_t tiles[4];       // x0, y0, x1, y1, inclusive
+			bool valid;
+		};
+
+		void SetupOccluder(size_t occluder, const float* worldMatrix, const QMatrix4x4& viewProjection);
+		void RasterizeTileRow(int tileY);
+		uint8_t TestInstance(const float* worldMatrix, const QMatrix4x4& viewProjection) const;
+
+		std::vector<float> m_positions;                 // 3 floats per mesh vertex
+		float m_boundsMin[3] = { -1.0f, -1.0f, -1.0f };
+		float m_boundsMax[3] = { 1.0f, 1.0f, 1.0f };
+
+		std::vector<uint32_t> m_occluders;
+		std::vector<uint8_t> m_isOccluder;              // per instance
+		std::vector<ScreenTriangle> m_triangles;        // mesh triangles per occluder
+		std::vector<uint8_t> m_results;                 // per instance: 0 visible, 1 outside the frustum, 2 occluded
+		Tile m_tiles[kTilesY][kTilesX] = {};
+
+		OcclusionCullingStats m_stats;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,544 @@
+#include "RenderGraph.h"
+#include "../Core/EditorLog.h"
+#include "../Core/MemoryTracker.h"
+#include "../Core/Profiler.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <algorithm>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr int kMaxColorAttachments = 8;
+
+		struct FormatInfo
+		{
+			GLenum internalFormat;
+			GLenum format;
+			GLenum type;
+			uint32_t bytesPerPixel;
+			bool depth;
+			bool stencil;
+		};
+
+		FormatInfo Info(RenderFormat format)
+		{
+			switch (format)
+			{
+			case RenderFormat::RGBA8: return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4, false, false };
+			case RenderFormat::RGBA16F: return { GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8, false, false };
+			case RenderFormat::R32F: return { GL_R32F, GL_RED, GL_FLOAT, 4, false, false };
+			case RenderFormat::Depth24: return { GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, 4, true, false };
+			case RenderFormat::Depth24Stencil8: return { GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, 4, true, true };
+			case RenderFormat::Depth32F: return { GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT, 4, true, false };
+			}
+			return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4, false, false };
+		}
+
+		uint64_t Bytes(const RenderTargetDesc& resolved)
+		{
+			return static_cast<uint64_t>(resolved.width) * static_cast<uint64_t>(resolved.height) * Info(resolved.format).bytesPerPixel;
+		}
+	}
+
+	void RenderPassBuilder::Read(RenderResource resource)
+	{
+		m_graph.m_passes[m_pass].reads.push_back(resource);
+	}
+
+	void RenderPassBuilder::WriteColor(RenderResource resource)
+	{
+		m_graph.m_passes[m_pass].colorWrites.push_back(resource);
+	}
+
+	void RenderPassBuilder::WriteDepth(RenderResource resource)
+	{
+		m_graph.m_passes[m_pass].depthWrite = resource;
+	}
+
+	void RenderPassBuilder::Write(RenderResource resource)
+	{
+		m_graph.m_passes[m_pass].persistentWrites.push_back(resource);
+	}
+
+	void RenderPassBuilder::SideEffect()
+	{
+		m_graph.m_passes[m_pass].sideEffect = true;
+	}
+
+	// GL objects can only go with the context current, which the owner arranges through Clear().
+	RenderGraph::~RenderGraph() = default;
+
+	void RenderGraph::Initialize()
+	{
+		initializeOpenGLFunctions();
+		m_initialized = true;
+		m_compiled = false;
+		m_failed = false;
+	}
+
+	void RenderGraph::Clear()
+	{
+		if (!m_initialized) return;
+
+		DeleteFramebuffers();
+		for (const Physical& physical : m_physical) DeletePhysical(physical);
+		m_physical.clear();
+		m_timers.clear();
+		m_timedPasses.clear();
+		m_compiled = false;
+	}
+
+	void RenderGraph::Reset()
+	{
+		if (m_initialized) DeleteFramebuffers();
+		m_passes.clear();
+		m_resources.clear();
+		m_timers.clear();
+		m_timedPasses.clear();
+		m_compiled = false;
+		m_failed = false;
+	}
+
+	RenderResource RenderGraph::CreateTarget(const char* name, const RenderTargetDesc& desc)
+	{
+		Resource resource;
+		resource.name = name;
+		resource.desc = desc;
+		m_resources.push_back(resource);
+		m_compiled = false;
+		return static_cast<RenderResource>(m_resources.size() - 1);
+	}
+
+	RenderResource RenderGraph::ImportBackbuffer(const char* name)
+	{
+		Resource resource;
+		resource.name = name;
+		resource.imported = true;
+		m_resources.push_back(resource);
+		m_compiled = false;
+		return static_cast<RenderResource>(m_resources.size() - 1);
+	}
+
+	RenderResource RenderGraph::ImportTexture(const char* name)
+	{
+		Resource resource;
+		resource.name = name;
+		resource.imported = true;
+		resource.persistent = true;
+		m_resources.push_back(resource);
+		m_compiled = false;
+		return static_cast<RenderResource>(m_resources.size() - 1);
+	}
+
+	void RenderGraph::AddPass(const char* name, const SetupFunction& setup, ExecuteFunction execute)
+	{
+		Pass pass;
+		pass.name = name;
+		pass.zoneName = Profiler::Intern(QByteArray("Pass ") + name);
+		pass.execute = std::move(execute);
+		m_passes.push_back(std::move(pass));
+		m_compiled = false;
+		m_failed = false;
+
+		RenderPassBuilder builder(*this, static_cast<uint32_t>(m_passes.size() - 1));
+		if (setup) setup(builder);
+	}
+
+	bool RenderGraph::Compile(int width, int height)
+	{
+		ORCA_PROFILE_ZONE("RenderGraph::Compile");
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+
+		m_width = width;
+		m_height = height;
+		m_compiled = false;
+		m_failed = true;
+		if (!m_initialized || !Validate()) return false;
+
+		Cull();
+		AssignPhysical();
+		if (!BuildFramebuffers()) return false;
+		CreateTimers();
+
+		m_compiled = true;
+		m_failed = false;
+		return true;
+	}
+
+	bool RenderGraph::Validate() const
+	{
+		const size_t count = m_resources.size();
+		for (const Pass& pass : m_passes)
+		{
+			auto fail = [&pass](const char* problem, const char* resource)
+			{
+				ORCA_LOG_ERROR("Renderer", "Render pass {}: {} {}", pass.name, problem, resource ? resource : "");
+				return false;
+			};
+
+			for (RenderResource resource : pass.reads)
+			{
+				if (resource >= count) return fail("reads an unknown resource", nullptr);
+				const Resource& read = m_resources[resource];
+				if ((read.imported && !read.persistent) || read.desc.renderbuffer) return fail("can't sample", read.name);
+			}
+			for (RenderResource resource : pass.persistentWrites)
+			{
+				if (resource >= count) return fail("writes an unknown resource", nullptr);
+				if (!m_resources[resource].persistent) return fail("can only Write() an imported texture, not", m_resources[resource].name);
+			}
+
+			if (pass.colorWrites.size() > kMaxColorAttachments) return fail("has too many color attachments", nullptr);
+
+			int imported = 0;
+			int transient = 0;
+			for (RenderResource resource : pass.colorWrites)
+			{
+				if (resource >= count) return fail("writes an unknown resource", nullptr);
+				if (m_resources[resource].persistent) return fail("can't attach an imported texture:", m_resources[resource].name);
+				if (m_resources[resource].imported) { ++imported; continue; }
+				if (Info(m_resources[resource].desc.format).depth) return fail("uses a depth format as color:", m_resources[resource].name);
+				++transient;
+			}
+			if (pass.depthWrite != kNoRenderResource)
+			{
+				if (pass.depthWrite >= count) return fail("writes an unknown resource", nullptr);
+				const Resource& depth = m_resources[pass.depthWrite];
+				if (depth.persistent) return fail("can't attach an imported texture:", depth.name);
+				if (depth.imported) ++imported;
+				else if (!Info(depth.desc.format).depth) return fail("uses a color format as depth:", depth.name);
+				else ++transient;
+			}
+
+			// The backbuffer is its own framebuffer; GL can't mix its attachments with ours.
+			if (imported > 0 && transient > 0) return fail("mixes the backbuffer with graph targets", nullptr);
+		}
+		return true;
+	}
+
+	void RenderGraph::Cull()
+	{
+		// Walk back from the outputs. A pass survives if it has side effects or writes something a
+		// later survivor (or the backbuffer) needs; everything it touches is then needed as well,
+		// since attachments keep their contents and earlier writers contribute to them. Imported
+		// textures are only needed if something reads them.
+		std::vector<uint8_t> needed(m_resources.size(), 0);
+		for (size_t i = 0; i < m_resources.size(); ++i) needed[i] = m_resources[i].imported && !m_resources[i].persistent ? 1 : 0;
+
+		for (size_t p = m_passes.size(); p-- > 0;)
+		{
+			Pass& pass = m_passes[p];
+			bool alive = pass.sideEffect;
+			for (RenderResource resource : pass.colorWrites) alive = alive || needed[resource];
+			if (pass.depthWrite != kNoRenderResource) alive = alive || needed[pass.depthWrite];
+			for (RenderResource resource : pass.persistentWrites) alive = alive || needed[resource];
+
+			pass.culled = !alive;
+			if (!alive) continue;
+
+			for (RenderResource resource : pass.reads) needed[resource] = 1;
+			for (RenderResource resource : pass.colorWrites) needed[resource] = 1;
+			if (pass.depthWrite != kNoRenderResource) needed[pass.depthWrite] = 1;
+			for (RenderResource resource : pass.persistentWrites) needed[resource] = 1;
+		}
+	}
+
+	void RenderGraph::AssignPhysical()
+	{
+		for (Resource& resource : m_resources)
+		{
+			resource.physical = -1;
+			resource.firstPass = -1;
+			resource.lastPass = -1;
+		}
+
+		auto touch = [this](RenderResource index, int pass)
+		{
+			Resource& resource = m_resources[index];
+			if (resource.firstPass < 0) resource.firstPass = pass;
+			resource.lastPass = pass;
+		};
+		for (size_t p = 0; p < m_passes.size(); ++p)
+		{
+			const Pass& pass = m_passes[p];
+			if (pass.culled) continue;
+			for (RenderResource resource : pass.reads) touch(resource, static_cast<int>(p));
+			for (RenderResource resource : pass.colorWrites) touch(resource, static_cast<int>(p));
+			if (pass.depthWrite != kNoRenderResource) touch(pass.depthWrite, static_cast<int>(p));
+			for (RenderResource resource : pass.persistentWrites) touch(resource, static_cast<int>(p));
+		}
+
+		std::vector<RenderResource> order;
+		for (size_t i = 0; i < m_resources.size(); ++i)
+		{
+			if (!m_resources[i].imported && m_resources[i].firstPass >= 0) order.push_back(static_cast<RenderResource>(i));
+		}
+		std::stable_sort(order.begin(), order.end(), [this](RenderResource a, RenderResource b) { return m_resources[a].firstPass < m_resources[b].firstPass; });
+
+		// The previous compile's objects are the pool, so recompiling at the same size allocates nothing.
+		std::vector<Physical> pool = std::move(m_physical);
+		m_physical.clear();
+
+		for (RenderResource index : order)
+		{
+			Resource& resource = m_resources[index];
+			const RenderTargetDesc desc = Resolved(resource.desc);
+
+			// An object that is free again by the time this resource is first written.
+			int chosen = -1;
+			for (size_t i = 0; i < m_physical.size() && chosen < 0; ++i)
+			{
+				if (m_physical[i].desc == desc && m_physical[i].busyUntil < resource.firstPass) chosen = static_cast<int>(i);
+			}
+
+			if (chosen < 0)
+			{
+				auto reusable = std::find_if(pool.begin(), pool.end(), [&desc](const Physical& physical) { return physical.desc == desc; });
+				if (reusable != pool.end())
+				{
+					m_physical.push_back(*reusable);
+					pool.erase(reusable);
+				}
+				else
+				{
+					Physical physical;
+					physical.desc = desc;
+					physical.id = CreatePhysical(desc);
+					physical.bytes = Bytes(desc);
+					m_physical.push_back(physical);
+				}
+				chosen = static_cast<int>(m_physical.size() - 1);
+			}
+
+			m_physical[chosen].busyUntil = resource.lastPass;
+			resource.physical = chosen;
+		}
+
+		for (const Physical& physical : pool) DeletePhysical(physical);
+	}
+
+	GLuint RenderGraph::CreatePhysical(const RenderTargetDesc& desc)
+	{
+		const FormatInfo info = Info(desc.format);
+		GLuint id = 0;
+
+		if (desc.renderbuffer)
+		{
+			glGenRenderbuffers(1, &id);
+			glBindRenderbuffer(GL_RENDERBUFFER, id);
+			glRenderbufferStorage(GL_RENDERBUFFER, info.internalFormat, desc.width, desc.height);
+			glBindRenderbuffer(GL_RENDERBUFFER, 0);
+			return id;
+		}
+
+		const GLint filter = info.depth ? GL_NEAREST : GL_LINEAR;
+		glGenTextures(1, &id);
+		glBindTexture(GL_TEXTURE_2D, id);
+		glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(info.internalFormat), desc.width, desc.height, 0, info.format, info.type, nullptr);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return id;
+	}
+
+	void RenderGraph::DeletePhysical(const Physical& physical)
+	{
+		if (physical.desc.renderbuffer) glDeleteRenderbuffers(1, &physical.id);
+		else glDeleteTextures(1, &physical.id);
+	}
+
+	bool RenderGraph::BuildFramebuffers()
+	{
+		DeleteFramebuffers();
+
+		bool ok = true;
+		for (Pass& pass : m_passes)
+		{
+			pass.width = std::max(m_width, 1);
+			pass.height = std::max(m_height, 1);
+			if (pass.culled) continue;
+
+			// Passes without attachments, or that draw to the backbuffer, run with the backbuffer bound.
+			const RenderResource first = !pass.colorWrites.empty() ? pass.colorWrites.front() : pass.depthWrite;
+			if (first == kNoRenderResource || m_resources[first].imported) continue;
+
+			const Physical& size = m_physical[m_resources[first].physical];
+			pass.width = size.desc.width;
+			pass.height = size.desc.height;
+
+			auto attach = [this](GLenum attachment, RenderResource resource)
+			{
+				const Physical& physical = m_physical[m_resources[resource].physical];
+				if (physical.desc.renderbuffer) glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, physical.id);
+				else glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, physical.id, 0);
+			};
+
+			glGenFramebuffers(1, &pass.framebuffer);
+			glBindFramebuffer(GL_FRAMEBUFFER, pass.framebuffer);
+
+			GLenum drawBuffers[kMaxColorAttachments];
+			GLsizei colorCount = 0;
+			for (RenderResource resource : pass.colorWrites)
+			{
+				drawBuffers[colorCount] = GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(colorCount);
+				attach(drawBuffers[colorCount], resource);
+				++colorCount;
+			}
+			if (pass.depthWrite != kNoRenderResource)
+			{
+				attach(Info(m_resources[pass.depthWrite].desc.format).stencil ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT, pass.depthWrite);
+			}
+
+			const GLenum none = GL_NONE;
+			glDrawBuffers(colorCount > 0 ? colorCount : 1, colorCount > 0 ? drawBuffers : &none);
+			if (colorCount == 0) glReadBuffer(GL_NONE);
+
+			const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+			if (status != GL_FRAMEBUFFER_COMPLETE)
+			{
+				ORCA_LOG_ERROR("Renderer", "Render pass {}: framebuffer incomplete (0x{})", pass.name, QString::number(status, 16));
+				ok = false;
+			}
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		return ok;
+	}
+
+	void RenderGraph::DeleteFramebuffers()
+	{
+		for (Pass& pass : m_passes)
+		{
+			if (pass.framebuffer) glDeleteFramebuffers(1, &pass.framebuffer);
+			pass.framebuffer = 0;
+		}
+	}
+
+	void RenderGraph::CreateTimers()
+	{
+		m_timers.clear();
+		m_timedPasses.clear();
+		std::fill(std::begin(m_timerPending), std::end(m_timerPending), false);
+
+		for (size_t p = 0; p < m_passes.size(); ++p)
+		{
+			m_passes[p].gpuMs = -1.0;
+			if (!m_passes[p].culled) m_timedPasses.push_back(static_cast<int>(p));
+		}
+
+		// Timer queries are optional (GL 3.3 has them, GLES/software contexts may not).
+		m_timersReady = !m_timedPasses.empty();
+		const size_t count = (m_timedPasses.size() + 1) * kTimerFrames;
+		for (size_t i = 0; i < count && m_timersReady; ++i)
+		{
+			auto query = std::make_unique<QOpenGLTimerQuery>();
+			m_timersReady = query->create();
+			m_timers.push_back(std::move(query));
+		}
+		if (!m_timersReady) m_timers.clear();
+	}
+
+	void RenderGraph::CollectTimers(int slot)
+	{
+		if (!m_timersReady || !m_timerPending[slot]) return;
+
+		const size_t perFrame = m_timedPasses.size() + 1;
+		const size_t base = static_cast<size_t>(slot) * perFrame;
+		if (!m_timers[base + perFrame - 1]->isResultAvailable()) return;
+
+		GLuint64 previous = m_timers[base]->waitForResult();
+		for (size_t i = 0; i < m_timedPasses.size(); ++i)
+		{
+			const GLuint64 timestamp = m_timers[base + i + 1]->waitForResult();
+			m_passes[m_timedPasses[i]].gpuMs = (timestamp - previous) / 1e6;
+			previous = timestamp;
+		}
+		m_timerPending[slot] = false;
+	}
+
+	void RenderGraph::Execute(GLuint backbuffer)
+	{
+		if (!m_compiled) return;
+
+		const int slot = static_cast<int>(m_frame++ % kTimerFrames);
+		CollectTimers(slot);
+		const bool timing = m_timersReady && !m_timerPending[slot];
+		const size_t base = static_cast<size_t>(slot) * (m_timedPasses.size() + 1);
+
+		QElapsedTimer timer;
+		size_t timed = 0;
+		for (Pass& pass : m_passes)
+		{
+			if (pass.culled) continue;
+			if (timing) m_timers[base + timed]->recordTimestamp();
+			++timed;
+
+			ORCA_PROFILE_ZONE(pass.zoneName);
+			timer.start();
+			glBindFramebuffer(GL_FRAMEBUFFER, pass.framebuffer ? pass.framebuffer : backbuffer);
+			glViewport(0, 0, pass.width, pass.height);
+			if (pass.execute) pass.execute();
+			pass.cpuMs = timer.nsecsElapsed() / 1e6;
+		}
+
+		if (timing)
+		{
+			m_timers[base + timed]->recordTimestamp();
+			m_timerPending[slot] = true;
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, backbuffer);
+		glViewport(0, 0, std::max(m_width, 1), std::max(m_height, 1));
+	}
+
+	GLuint RenderGraph::Texture(RenderResource resource) const
+	{
+		if (resource >= m_resources.size() || m_resources[resource].physical < 0) return 0;
+
+		const Physical& physical = m_physical[m_resources[resource].physical];
+		return physical.desc.renderbuffer ? 0 : physical.id;
+	}
+
+	RenderGraphReport RenderGraph::Report() const
+	{
+		RenderGraphReport report;
+		for (const Pass& pass : m_passes)
+		{
+			RenderPassReport entry;
+			entry.name = pass.name;
+			entry.culled = pass.culled;
+			entry.cpuMs = pass.cpuMs;
+			entry.gpuMs = pass.gpuMs;
+			report.passes.push_back(entry);
+		}
+
+		for (const Resource& resource : m_resources)
+		{
+			RenderResourceReport entry;
+			entry.name = resource.name;
+			entry.imported = resource.imported;
+			entry.physical = resource.physical;
+			entry.firstPass = resource.firstPass;
+			entry.lastPass = resource.lastPass;
+			if (resource.physical >= 0)
+			{
+				entry.bytes = m_physical[resource.physical].bytes;
+				report.transientBytes += entry.bytes;
+			}
+			report.resources.push_back(entry);
+		}
+
+		for (const Physical& physical : m_physical) report.allocatedBytes += physical.bytes;
+		return report;
+	}
+
+	RenderTargetDesc RenderGraph::Resolved(const RenderTargetDesc& desc) const
+	{
+		RenderTargetDesc resolved = desc;
+		if (resolved.width <= 0) resolved.width = std::max(m_width, 1);
+		if (resolved.height <= 0) resolved.height = std::max(m_height, 1);
+		return resolved;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,237 @@
+#pragma once
+
+#ifndef RENDER_GRAPH_H
+#define RENDER_GRAPH_H
+
+#include <QtGui/QOpenGLExtraFunctions>
+#include <QtOpenGL/QOpenGLTimerQuery>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Orca
+{
+	enum class RenderFormat : uint8_t
+	{
+		RGBA8,
+		RGBA16F,
+		R32F,
+		Depth24,
+		Depth24Stencil8,
+		Depth32F
+	};
+
+	struct RenderTargetDesc
+	{
+		RenderFormat format = RenderFormat::RGBA8;
+		int width = 0;               // 0: the width the graph was compiled for
+		int height = 0;              // 0: the height the graph was compiled for
+		bool renderbuffer = false;   // attachment only, can't be read by a later pass
+
+		bool operator==(const RenderTargetDesc& other) const
+		{
+			return format == other.format && width == other.width && height == other.height && renderbuffer == other.renderbuffer;
+		}
+	};
+
+	using RenderResource = uint32_t;
+	constexpr RenderResource kNoRenderResource = 0xFFFFFFFFu;
+
+	struct RenderPassReport
+	{
+		const char* name = nullptr;
+		bool culled = false;
+		double cpuMs = 0.0;
+		double gpuMs = -1.0;          // -1 until a timer result has come back
+	};
+
+	struct RenderResourceReport
+	{
+		const char* name = nullptr;
+		bool imported = false;
+		int physical = -1;            // GL object shared by resources with the same number
+		uint64_t bytes = 0;
+		int firstPass = -1;           // -1 when no surviving pass uses it
+		int lastPass = -1;
+	};
+
+	struct RenderGraphReport
+	{
+		std::vector<RenderPassReport> passes;
+		std::vector<RenderResourceReport> resources;
+		uint64_t transientBytes = 0;  // what the transient resources would take without aliasing
+		uint64_t allocatedBytes = 0;  // what they take
+	};
+
+	class RenderGraph;
+
+	/**
+	 * @brief Declares what one pass touches; handed to the setup function in RenderGraph::AddPass().
+	 */
+	class RenderPassBuilder
+	{
+	public:
+		/** @brief The pass samples the resource; fetch it with RenderGraph::Texture() when executing. */
+		void Read(RenderResource resource);
+
+		/** @brief Next color attachment. Previous contents are kept, so earlier writers stay alive. */
+		void WriteColor(RenderResource resource);
+
+		void WriteDepth(RenderResource resource);
+
+		/**
+		 * @brief The pass draws into an imported texture through framebuffers of the texture's owner.
+		 *        Kept only while a later surviving pass reads the texture.
+		 */
+		void Write(RenderResource resource);
+
+		/** @brief Keeps the pass even when nothing reads what it writes (uploads, queries, readbacks). */
+		void SideEffect();
+
+	private:
+		friend class RenderGraph;
+		RenderPassBuilder(RenderGraph& graph, uint32_t pass) : m_graph(graph), m_pass(pass) {}
+
+		RenderGraph& m_graph;
+		uint32_t m_pass;
+	};
+
+	/**
+	 * @brief Declarative frame structure for one GL context.
+	 *
+	 * Passes declare the targets they read and write; Compile() drops passes whose results
+	 * nobody uses, works out how long each transient target lives and lets targets with
+	 * disjoint lifetimes and the same description share one GL texture or renderbuffer.
+	 * GL 3.3 can't place different formats in the same memory, so only matching targets are
+	 * aliased. Execute() binds each pass's framebuffer and runs it, timing every pass on the
+	 * CPU and, when timer queries exist, on the GPU (read back a few frames late).
+	 *
+	 * The graph is declared once and recompiled only when it or the frame size changes; a
+	 * compiled graph executes without touching the heap. All GL calls need the owning context
+	 * current, and the owner must call Clear() before the context goes away.
+	 */
+	class RenderGraph : protected QOpenGLExtraFunctions
+	{
+	public:
+		using SetupFunction = std::function<void(RenderPassBuilder& pass)>;
+		using ExecuteFunction = std::function<void()>;
+
+		static constexpr int kTimerFrames = 3;
+
+		RenderGraph() = default;
+		~RenderGraph();
+
+		RenderGraph(const RenderGraph&) = delete;
+		RenderGraph& operator=(const RenderGraph&) = delete;
+
+		void Initialize();
+
+		/** @brief Deletes every GL object; declarations are kept. */
+		void Clear();
+
+		/** @brief Drops the declared passes and resources. GL objects are kept for the next Compile() to reuse. */
+		void Reset();
+
+		/** @brief A target owned by the graph, alive from the first pass that uses it to the last. */
+		RenderResource CreateTarget(const char* name, const RenderTargetDesc& desc);
+
+		/** @brief The framebuffer given to Execute(). Always an output, so passes writing it are never culled. */
+		RenderResource ImportBackbuffer(const char* name);
+
+		/**
+		 * @brief A texture that outlives the frame, allocated and bound by its owner. Passes declare
+		 *        it with Write() and Read() so the graph orders and culls them; it is never an attachment.
+		 */
+		RenderResource ImportTexture(const char* name);
+
+		/** @brief @p setup runs immediately; @p execute runs every frame with the pass's framebuffer bound. */
+		void AddPass(const char* name, const SetupFunction& setup, ExecuteFunction execute);
+
+		/** @brief True after a change or resize; a graph that failed to compile isn't retried until one. */
+		bool NeedsCompile(int width, int height) const { return (!m_compiled && !m_failed) || width != m_width || height != m_height; }
+
+		/** @brief Culls passes, assigns GL objects and builds framebuffers. Errors are logged. */
+		bool Compile(int width, int height);
+
+		/** @brief Runs the surviving passes in declaration order. */
+		void Execute(GLuint backbuffer);
+
+		/** @brief GL texture behind a target, for passes that Read() it. */
+		GLuint Texture(RenderResource resource) const;
+
+		RenderGraphReport Report() const;
+
+	private:
+		friend class RenderPassBuilder;
+
+		struct Resource
+		{
+			const char* name = nullptr;
+			RenderTargetDesc desc;
+			bool imported = false;
+			bool persistent = false;           // ImportTexture(): sampled, written through the owner's framebuffers
+			int physical = -1;
+			int firstPass = -1;
+			int lastPass = -1;
+		};
+
+		struct Pass
+		{
+			const char* name = nullptr;
+			const char* zoneName = nullptr;    // "Pass <name>" in the profiler
+			ExecuteFunction execute;
+			std::vector<RenderResource> reads;
+			std::vector<RenderResource> colorWrites;
+			RenderResource depthWrite = kNoRenderResource;
+			std::vector<RenderResource> persistentWrites;
+			bool sideEffect = false;
+
+			bool culled = false;
+			bool backbuffer = false;
+			GLuint framebuffer = 0;
+			int width = 0;
+			int height = 0;
+			double cpuMs = 0.0;
+			double gpuMs = -1.0;
+		};
+
+		struct Physical
+		{
+			RenderTargetDesc desc;             // with the size resolved
+			GLuint id = 0;
+			uint64_t bytes = 0;
+			int busyUntil = -1;                // last pass of the resource using it, while compiling
+		};
+
+		bool Validate() const;
+		void Cull();
+		void AssignPhysical();
+		GLuint CreatePhysical(const RenderTargetDesc& desc);
+		void DeletePhysical(const Physical& physical);
+		bool BuildFramebuffers();
+		void DeleteFramebuffers();
+		void CreateTimers();
+		void CollectTimers(int slot);
+		RenderTargetDesc Resolved(const RenderTargetDesc& desc) const;
+
+		bool m_initialized = false;
+		bool m_compiled = false;
+		bool m_failed = false;
+		int m_width = 0;
+		int m_height = 0;
+
+		std::vector<Resource> m_resources;
+		std::vector<Pass> m_passes;
+		std::vector<Physical> m_physical;
+
+		// kTimerFrames rows of one timestamp per surviving pass plus one for the end.
+		std::vector<std::unique_ptr<QOpenGLTimerQuery>> m_timers;
+		std::vector<int> m_timedPasses;
+		bool m_timerPending[kTimerFrames] = {};
+		bool m_timersReady = false;
+		uint64_t m_frame = 0;
+	};
+}
+
+#endif
\ No newline at end of file
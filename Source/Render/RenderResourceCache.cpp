@@ -0,0 +1,165 @@
+#include "RenderResourceCache.h"
+#include "../Core/EditorStats.h"
+#include "../Core/MemoryTracker.h"
+#include <algorithm>
+
+static const float cubeVertices[] = 
+{
+	-1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
+	 1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
+	 1.0f,  1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
+	-1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
+	 1.0f,  1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
+	-1.0f,  1.0f,  1.0f, 1.0f, 0.0f, 0.0f,
+
+	 1.0f, -1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+	-1.0f, -1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+	-1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+	 1.0f, -1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+	-1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+	 1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+
+	  1.0f, -1.0f,  1.0f, 0.0f, 0.0f, 1.0f,
+	  1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 1.0f,
+	  1.0f,  1.0f, -1.0f, 0.0f, 0.0f, 1.0f,
+	  1.0f, -1.0f,  1.0f, 0.0f, 0.0f, 1.0f,
+	  1.0f,  1.0f, -1.0f, 0.0f, 0.0f, 1.0f,
+	  1.0f,  1.0f,  1.0f, 0.0f, 0.0f, 1.0f,
+
+	  -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 0.0f,
+	  -1.0f, -1.0f,  1.0f, 1.0f, 1.0f, 0.0f,
+	  -1.0f,  1.0f,  1.0f, 1.0f, 1.0f, 0.0f,
+	  -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 0.0f,
+	  -1.0f,  1.0f,  1.0f, 1.0f, 1.0f, 0.0f,
+	  -1.0f,  1.0f, -1.0f, 1.0f, 1.0f, 0.0f,
+
+	  -1.0f,  1.0f,  1.0f, 0.0f, 1.0f, 1.0f,
+	   1.0f,  1.0f,  1.0f, 0.0f, 1.0f, 1.0f,
+	   1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 1.0f,
+	  -1.0f,  1.0f,  1.0f, 0.0f, 1.0f, 1.0f,
+	   1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 1.0f,
+	  -1.0f,  1.0f, -1.0f, 0.0f, 1.0f, 1.0f,
+
+	  -1.0f, -1.0f, -1.0f, 1.0f, 0.0f, 1.0f,
+	   1.0f, -1.0f, -1.0f, 1.0f, 0.0f, 1.0f,
+	   1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 1.0f,
+	  -1.0f, -1.0f, -1.0f, 1.0f, 0.0f, 1.0f,
+	   1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 1.0f,
+	  -1.0f, -1.0f,  1.0f, 1.0f, 0.0f, 1.0f
+};
+
+namespace Orca
+{
+	RenderResourceCache& RenderResourceCache::Get()
+	{
+		static RenderResourceCache s_cache;
+		return s_cache;
+	}
+
+	void RenderResourceCache::Acquire()
+	{
+		if (m_users++ > 0) return;
+
+		// Resolved for the share group, not the context that happens to be current.
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+		initializeOpenGLFunctions();
+
+		glGenBuffers(1, &m_meshBuffer);
+		glBindBuffer(GL_ARRAY_BUFFER, m_meshBuffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), cubeVertices, GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		// One identity instance until a scene is uploaded, which draws the lone preview cube.
+		static const float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+		m_instanceMatrices.assign(identity, identity + 16);
+		m_instanceCount = 1;
+		m_instanceCapacity = 1;
+		m_sceneLoaded = false;
+
+		glGenBuffers(1, &m_instanceBuffer);
+		glBindBuffer(GL_TEXTURE_BUFFER, m_instanceBuffer);
+		glBufferData(GL_TEXTURE_BUFFER, sizeof(identity), identity, GL_DYNAMIC_DRAW);
+		glGenTextures(1, &m_instanceTexture);
+		glBindTexture(GL_TEXTURE_BUFFER, m_instanceTexture);
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_instanceBuffer);
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+		++m_instanceVersion;
+		++m_staticVersion;
+
+		m_textures.Initialize();
+
+		static bool s_reporterRegistered = false;
+		if (!s_reporterRegistered)
+		{
+			s_reporterRegistered = true;
+			EditorStats::Get().RegisterMemoryReporter("Renderer", []() -> uint64_t { return sizeof(cubeVertices); });
+		}
+	}
+
+	void RenderResourceCache::Release()
+	{
+		if (m_users == 0 || --m_users > 0) return;
+
+		m_shaders.Clear();
+		++m_shaderGeneration;
+		m_textures.Clear();
+		glDeleteTextures(1, &m_instanceTexture);
+		glDeleteBuffers(1, &m_instanceBuffer);
+		glDeleteBuffers(1, &m_meshBuffer);
+		m_instanceTexture = 0;
+		m_instanceBuffer = 0;
+		m_meshBuffer = 0;
+		m_instanceCapacity = 0;
+		m_instanceMatrices.clear();
+		m_instanceMatrices.shrink_to_fit();
+		m_instanceCount = 0;
+		m_sceneLoaded = false;
+	}
+
+	int RenderResourceCache::ReloadShaders(const QStringList& changedPaths)
+	{
+		if (m_users == 0) return 0;
+
+		const int reloaded = m_shaders.ReloadChanged(changedPaths);
+		if (reloaded > 0) ++m_shaderGeneration;
+		return reloaded;
+	}
+
+	const float* RenderResourceCache::MeshVertices()
+	{
+		return cubeVertices;
+	}
+
+	size_t RenderResourceCache::UploadInstances(const std::vector<float>& matrices, size_t first, size_t maxCount, bool dynamicOnly)
+	{
+		const size_t total = matrices.size() / 16;
+		if (m_users == 0 || first >= total) return 0;
+
+		const size_t count = std::min(maxCount, total - first);
+		MemoryTagScope memoryTag(MemoryTag::Renderer);
+		glBindBuffer(GL_TEXTURE_BUFFER, m_instanceBuffer);
+		if (first == 0)
+		{
+			m_instanceMatrices.resize(total * 16);
+			m_instanceCount = 0;
+			m_sceneLoaded = true;
+
+			// Play mode re-uploads every step at the same size, which reuses the storage.
+			if (total != m_instanceCapacity)
+			{
+				glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(total * 16 * sizeof(float)), nullptr, GL_DYNAMIC_DRAW);
+				m_instanceCapacity = total;
+			}
+		}
+		std::copy(matrices.begin() + first * 16, matrices.begin() + (first + count) * 16, m_instanceMatrices.begin() + first * 16);
+		glBufferSubData(GL_TEXTURE_BUFFER, static_cast<GLintptr>(first * 16 * sizeof(float)), static_cast<GLsizeiptr>(count * 16 * sizeof(float)),
+			matrices.data() + first * 16);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+		m_instanceCount = first + count;
+
+		++m_instanceVersion;
+		if (!dynamicOnly) ++m_staticVersion;
+		return count;
+	}
+}
\ No newline at end of file
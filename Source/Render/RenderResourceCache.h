@@ -0,0 +1,107 @@
+#pragma once
+
+#ifndef RENDER_RESOURCE_CACHE_H
+#define RENDER_RESOURCE_CACHE_H
+
+#include "ShaderLibrary.h"
+#include "TextureStreamer.h"
+#include <QtCore/QStringList>
+#include <QtGui/QOpenGLExtraFunctions>
+#include <cstdint>
+#include <vector>
+
+namespace Orca
+{
+	/**
+	 * @brief The GPU resources every scene viewport draws with: shader programs, the mesh, the
+	 *        scene's instance matrices and streamed textures, uploaded once however many views there are.
+	 *
+	 * Viewport contexts all share one group (Qt::AA_ShareOpenGLContexts), so a program, buffer or
+	 * texture made in one of them works in the others. Vertex arrays and framebuffers can't be
+	 * shared and stay with each viewport, as does anything that depends on its camera.
+	 *
+	 * The first Acquire() creates the resources and the last Release() deletes them. Those and
+	 * every other GL call need a context of the group current.
+	 */
+	class RenderResourceCache : protected QOpenGLExtraFunctions
+	{
+	public:
+		static constexpr int kMeshVertexCount = 36;
+		static constexpr int kMeshStride = 6;           // floats per vertex: position, color
+
+		static RenderResourceCache& Get();
+
+		RenderResourceCache(const RenderResourceCache&) = delete;
+		RenderResourceCache& operator=(const RenderResourceCache&) = delete;
+
+		void Acquire();
+		void Release();
+
+		ShaderLibrary& Shaders() { return m_shaders; }
+
+		/** @brief Changes whenever programs are rebuilt, so viewports know to look theirs up again. */
+		uint64_t ShaderGeneration() const { return m_shaderGeneration; }
+
+		/** @brief Recompiles the programs touched by a batch of project-relative changed paths. */
+		int ReloadShaders(const QStringList& changedPaths);
+
+		TextureStreamer& Textures() { return m_textures; }
+
+		/** @brief The mesh every instance draws: kMeshVertexCount vertices of kMeshStride floats. */
+		GLuint MeshBuffer() const { return m_meshBuffer; }
+		static const float* MeshVertices();
+
+		/**
+		 * @brief Uploads up to maxCount world matrices (16 floats each, column-major) starting at
+		 *        instance `first`; first == 0 starts a new scene of matrices.size() / 16 instances.
+		 *        @p dynamicOnly promises that only LoadedScene::kDynamic entities moved, as in a
+		 *        play mode frame, so StaticVersion() stays the same.
+		 * @return Number of instances uploaded.
+		 */
+		size_t UploadInstances(const std::vector<float>& matrices, size_t first, size_t maxCount, bool dynamicOnly);
+
+		/** @brief Buffer texture of the instance matrices: four RGBA32F texels, one per column, per instance. */
+		GLuint InstanceTexture() const { return m_instanceTexture; }
+
+		/** @brief CPU copy of the uploaded matrices, for culling and cameras. */
+		const float* InstanceMatrices() const { return m_instanceMatrices.data(); }
+		size_t InstanceCount() const { return m_instanceCount; }
+
+		/** @brief False until a scene is uploaded; until then the one instance is the preview cube. */
+		bool SceneLoaded() const { return m_sceneLoaded; }
+
+		/** @brief Changes with every upload. */
+		uint64_t InstanceVersion() const { return m_instanceVersion; }
+
+		/** @brief Changes with every upload that may move a static entity. */
+		uint64_t StaticVersion() const { return m_staticVersion; }
+
+		/**
+		 * @brief The play session step the instances were last uploaded from, so viewports following
+		 *        the session upload each step once between them; ~0 when none was.
+		 */
+		uint64_t PlayStep() const { return m_playStep; }
+		void SetPlayStep(uint64_t step) { m_playStep = step; }
+
+	private:
+		RenderResourceCache() = default;
+
+		int m_users = 0;
+		ShaderLibrary m_shaders;
+		uint64_t m_shaderGeneration = 1;
+		TextureStreamer m_textures;
+
+		GLuint m_meshBuffer = 0;
+		GLuint m_instanceBuffer = 0;
+		GLuint m_instanceTexture = 0;
+		size_t m_instanceCapacity = 0;                  // instances m_instanceBuffer has room for
+		std::vector<float> m_instanceMatrices;
+		size_t m_instanceCount = 0;
+		bool m_sceneLoaded = false;
+		uint64_t m_instanceVersion = 1;
+		uint64_t m_staticVersion = 1;
+		uint64_t m_playStep = ~uint64_t(0);
+	};
+}
+
+#endif
\ No newline at end of file
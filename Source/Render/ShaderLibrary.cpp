@@ -0,0 +1,106 @@
+#include "ShaderLibrary.h"
+#include "../Core/EditorLog.h"
+#include <QtCore/QFile>
+
+namespace Orca
+{
+	QString ShaderLibrary::OverridePath(const QString& name, const char* extension) const
+	{
+		return QString("%1/%2.%3").arg(kOverrideDirectory, name, extension);
+	}
+
+	QByteArray ShaderLibrary::Source(const QString& name, const char* extension, const QByteArray& builtin) const
+	{
+		if (m_projectRoot.isEmpty()) return builtin;
+
+		QFile file(m_projectRoot + "/" + OverridePath(name, extension));
+		if (!file.open(QIODevice::ReadOnly)) return builtin;
+		return file.readAll();
+	}
+
+	std::unique_ptr<QOpenGLShaderProgram> ShaderLibrary::Build(const Entry& entry, bool allowOverrides) const
+	{
+		auto program = std::make_unique<QOpenGLShaderProgram>();
+		const QByteArray vertex = allowOverrides ? Source(entry.name, "vert", entry.builtinVertex) : entry.builtinVertex;
+		const QByteArray fragment = allowOverrides ? Source(entry.name, "frag", entry.builtinFragment) : entry.builtinFragment;
+
+		if (!program->addShaderFromSourceCode(QOpenGLShader::Vertex, vertex)
+			|| !program->addShaderFromSourceCode(QOpenGLShader::Fragment, fragment)
+			|| !program->link())
+		{
+			ORCA_LOG_WARNING("Renderer", "Shader '{}' failed to build: {}", entry.name, program->log().trimmed());
+			return nullptr;
+		}
+		return program;
+	}
+
+	QOpenGLShaderProgram* ShaderLibrary::Load(const QString& name, const char* vertexSource, const char* fragmentSource)
+	{
+		Entry entry;
+		entry.name = name;
+		entry.builtinVertex = vertexSource;
+		entry.builtinFragment = fragmentSource;
+
+		entry.program = Build(entry, true);
+		if (!entry.program) entry.program = Build(entry, false);
+		if (!entry.program) return nullptr;
+
+		QOpenGLShaderProgram* program = entry.program.get();
+		m_entries.push_back(std::move(entry));
+		return program;
+	}
+
+	QOpenGLShaderProgram* ShaderLibrary::Program(const QString& name) const
+	{
+		for (const Entry& entry : m_entries)
+		{
+			if (entry.name == name) return entry.program.get();
+		}
+		return nullptr;
+	}
+
+	bool ShaderLibrary::Affects(const Entry& entry, const QString& changedPath) const
+	{
+		if (changedPath == ".") return true;
+
+		for (const char* extension : { "vert", "frag" })
+		{
+			const QString path = OverridePath(entry.name, extension);
+			if (path == changedPath || path.startsWith(changedPath + "/")) return true;
+		}
+		return false;
+	}
+
+	int ShaderLibrary::ReloadChanged(const QStringList& changedPaths)
+	{
+		if (m_projectRoot.isEmpty()) return 0;
+
+		int replaced = 0;
+		for (Entry& entry : m_entries)
+		{
+			bool affected = false;
+			for (const QString& path : changedPaths)
+			{
+				if (Affects(entry, path))
+				{
+					affected = true;
+					break;
+				}
+			}
+			if (!affected) continue;
+
+			// A deleted override falls back to the built-in source through Source().
+			std::unique_ptr<QOpenGLShaderProgram> program = Build(entry, true);
+			if (!program)
+			{
+				ORCA_LOG_WARNING("Renderer", "Keeping the previous version of shader '{}'", entry.name);
+				continue;
+			}
+
+			entry.program = std::move(program);
+			++replaced;
+			ORCA_LOG_INFO("Renderer", "Reloaded shader '{}'", entry.name);
+		}
+		return replaced;
+	}
+}
\ No newline at end of file
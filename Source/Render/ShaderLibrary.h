@@ -0,0 +1,64 @@
+#pragma once
+
+#ifndef SHADER_LIBRARY_H
+#define SHADER_LIBRARY_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtOpenGL/QOpenGLShaderProgram>
+#include <memory>
+#include <vector>
+
+namespace Orca
+{
+	/**
+	 * @brief Named shader programs for one GL context, hot-reloadable from the project.
+	 *
+	 * Every program has built-in sources. If the project has Assets/Shaders/<name>.vert or
+	 * <name>.frag, that file is used instead, and editing it recompiles the program in place.
+	 * A program that fails to compile keeps running the last good version.
+	 *
+	 * All calls need the owning context current. Overrides must keep the built-in attribute
+	 * locations and uniform names.
+	 */
+	class ShaderLibrary
+	{
+	public:
+		static constexpr const char* kOverrideDirectory = "Assets/Shaders";
+
+		void SetProjectRoot(const QString& projectRoot) { m_projectRoot = projectRoot; }
+
+		/** @brief Compiles and registers a program. Returns null if neither the override nor the built-in compiles. */
+		QOpenGLShaderProgram* Load(const QString& name, const char* vertexSource, const char* fragmentSource);
+		QOpenGLShaderProgram* Program(const QString& name) const;
+
+		/**
+		 * @brief Recompiles every program whose override files are affected by the changed
+		 *        project-relative paths (a directory covers its contents, "." everything).
+		 * @return Number of programs that were replaced.
+		 */
+		int ReloadChanged(const QStringList& changedPaths);
+
+		void Clear() { m_entries.clear(); }
+
+	private:
+		struct Entry
+		{
+			QString name;
+			QByteArray builtinVertex;
+			QByteArray builtinFragment;
+			std::unique_ptr<QOpenGLShaderProgram> program;
+		};
+
+		QString OverridePath(const QString& name, const char* extension) const;
+		QByteArray Source(const QString& name, const char* extension, const QByteArray& builtin) const;
+		bool Affects(const Entry& entry, const QString& changedPath) const;
+		std::unique_ptr<QOpenGLShaderProgram> Build(const Entry& entry, bool allowOverrides) const;
+
+		QString m_projectRoot;
+		std::vector<Entry> m_entries;
+	};
+}
+
+#endif
\ No newline at end of file
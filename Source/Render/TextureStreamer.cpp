@@ -0,0 +1,268 @@
+#include "TextureStreamer.h"
+#include "../Core/EditorLog.h"
+#include "../Core/Profiler.h"
+#include <QtGui/QOpenGLContext>
+#include <algorithm>
+
+namespace Orca
+{
+	namespace
+	{
+		// EXT_texture_compression_s3tc and EXT_texture_sRGB; not in every GL header.
+		constexpr GLenum kCompressedRgbDxt1 = 0x83F0;
+		constexpr GLenum kCompressedRgbaDxt5 = 0x83F3;
+		constexpr GLenum kCompressedSrgbDxt1 = 0x8C4C;
+		constexpr GLenum kCompressedSrgbAlphaDxt5 = 0x8C4F;
+
+		uint32_t LevelFor(const TextureArtifactView& view, uint32_t wantedSize)
+		{
+			if (wantedSize == 0) return 0;
+
+			const uint32_t largest = std::max(view.Header().width, view.Header().height);
+			uint32_t level = 0;
+			while (level + 1 < view.MipCount() && (largest >> (level + 1)) >= wantedSize) ++level;
+			return level;
+		}
+	}
+
+	void TextureStreamer::Initialize()
+	{
+		initializeOpenGLFunctions();
+
+		QOpenGLContext* context = QOpenGLContext::currentContext();
+		m_s3tc = context->hasExtension("GL_EXT_texture_compression_s3tc");
+		m_s3tcSrgb = m_s3tc && context->hasExtension("GL_EXT_texture_sRGB");
+		m_initialized = true;
+
+		if (!m_s3tc)
+		{
+			ORCA_LOG_WARNING("Renderer", "S3TC is not supported; compressed textures are expanded to RGBA8 on upload");
+		}
+	}
+
+	void TextureStreamer::Clear()
+	{
+		for (const auto& texture : m_textures)
+		{
+			if (texture->id) glDeleteTextures(1, &texture->id);
+		}
+		m_textures.clear();
+		m_byPath.clear();
+		m_residentBytes = 0;
+	}
+
+	bool TextureStreamer::OpenArtifact(Texture& texture)
+	{
+		QString error;
+		std::string viewError;
+		if (!texture.file.Open(texture.path, &error))
+		{
+			ORCA_LOG_WARNING("Renderer", "Could not open texture {}: {}", texture.path, error);
+			return false;
+		}
+		if (!texture.view.Open(texture.file.Data(), texture.file.Size(), &viewError))
+		{
+			ORCA_LOG_WARNING("Renderer", "Could not read texture {}: {}", texture.path, QString::fromStdString(viewError));
+			texture.file.Close();
+			return false;
+		}
+
+		texture.finestResident = texture.view.MipCount();
+		return true;
+	}
+
+	GLuint TextureStreamer::Request(const QString& artifactPath, uint32_t wantedSize)
+	{
+		Texture* texture = m_byPath.value(artifactPath, nullptr);
+		if (!texture)
+		{
+			m_textures.push_back(std::make_unique<Texture>());
+			texture = m_textures.back().get();
+			texture->path = artifactPath;
+			texture->failed = !OpenArtifact(*texture);
+			m_byPath.insert(artifactPath, texture);
+
+			// Sized here, for the finest level, so uploads never grow it.
+			if (!texture->failed && texture->view.Format() != TextureFormat::RGBA8 && !Native(*texture))
+			{
+				m_decodeScratch.resize(std::max<size_t>(m_decodeScratch.size(), LevelBytes(*texture, 0)));
+			}
+		}
+		if (texture->failed) return 0;
+
+		const uint32_t level = LevelFor(texture->view, wantedSize);
+		texture->wantedLevel = texture->lastUsedFrame == m_frame ? std::min(texture->wantedLevel, level) : level;
+		texture->lastUsedFrame = m_frame;
+		return texture->id;
+	}
+
+	bool TextureStreamer::Native(const Texture& texture) const
+	{
+		return texture.view.Format() != TextureFormat::RGBA8 && m_s3tc && (!texture.view.Header().srgb || m_s3tcSrgb);
+	}
+
+	uint64_t TextureStreamer::LevelBytes(const Texture& texture, uint32_t level) const
+	{
+		const TextureMipEntry& mip = texture.view.Mip(level);
+		return Native(texture) ? mip.size : static_cast<uint64_t>(mip.width) * mip.height * 4;
+	}
+
+	void TextureStreamer::UploadLevel(Texture& texture, uint32_t level)
+	{
+		const TextureMipEntry& mip = texture.view.Mip(level);
+		const TextureFormat format = texture.view.Format();
+		const bool srgb = texture.view.Header().srgb != 0;
+		const auto* data = reinterpret_cast<const uint8_t*>(texture.view.MipData(level));
+
+		if (!texture.id)
+		{
+			glGenTextures(1, &texture.id);
+			glBindTexture(GL_TEXTURE_2D, texture.id);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(texture.view.MipCount() - 1));
+		}
+		else
+		{
+			glBindTexture(GL_TEXTURE_2D, texture.id);
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		const bool compressed = format != TextureFormat::RGBA8;
+		if (Native(texture))
+		{
+			const GLenum internalFormat = format == TextureFormat::BC1
+				? (srgb ? kCompressedSrgbDxt1 : kCompressedRgbDxt1)
+				: (srgb ? kCompressedSrgbAlphaDxt5 : kCompressedRgbaDxt5);
+			glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), internalFormat, static_cast<GLsizei>(mip.width),
+				static_cast<GLsizei>(mip.height), 0, static_cast<GLsizei>(mip.size), data);
+		}
+		else
+		{
+			if (compressed)
+			{
+				DecodeBlocks(format, data, mip.width, mip.height, m_decodeScratch.data());
+				data = m_decodeScratch.data();
+			}
+			glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8, static_cast<GLsizei>(mip.width),
+				static_cast<GLsizei>(mip.height), 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+		}
+
+		// Levels arrive coarsest first, so [level, last] is always complete.
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(level));
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		const uint64_t bytes = LevelBytes(texture, level);
+		texture.finestResident = level;
+		texture.residentBytes += bytes;
+		m_residentBytes += bytes;
+	}
+
+	void TextureStreamer::DropFinestLevel(Texture& texture)
+	{
+		const uint32_t level = texture.finestResident;
+		const uint64_t bytes = std::min(texture.residentBytes, LevelBytes(texture, level));
+
+		texture.finestResident = level + 1;
+		texture.residentBytes -= bytes;
+		m_residentBytes -= bytes;
+
+		if (texture.finestResident == texture.view.MipCount())
+		{
+			glDeleteTextures(1, &texture.id);
+			texture.id = 0;
+			texture.residentBytes = 0;
+			return;
+		}
+
+		// GL 3.3 has no way to release a single level, so it is redefined as empty once it is
+		// outside the base level; drivers free the storage for it.
+		glBindTexture(GL_TEXTURE_2D, texture.id);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(texture.finestResident));
+		glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA8, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	bool TextureStreamer::MakeRoom(uint64_t bytes, const Texture* keep, FrameArena& arena)
+	{
+		if (m_residentBytes + bytes <= m_budgetBytes) return true;
+
+		// Least recently used first; textures used this frame are never evicted.
+		ArenaVector<Texture*> candidates{ ArenaAllocator<Texture*>(arena) };
+		candidates.reserve(m_textures.size());
+		for (const auto& texture : m_textures)
+		{
+			if (texture.get() != keep && texture->id && texture->lastUsedFrame < m_frame) candidates.push_back(texture.get());
+		}
+		std::sort(candidates.begin(), candidates.end(), [](const Texture* a, const Texture* b) { return a->lastUsedFrame < b->lastUsedFrame; });
+
+		for (Texture* texture : candidates)
+		{
+			while (texture->id && m_residentBytes + bytes > m_budgetBytes) DropFinestLevel(*texture);
+			if (m_residentBytes + bytes <= m_budgetBytes) return true;
+		}
+		return false;
+	}
+
+	void TextureStreamer::Update(FrameArena& arena)
+	{
+		if (!m_initialized) return;
+
+		ORCA_PROFILE_ZONE("TextureStreamer::Update");
+
+		ArenaVector<Texture*> pending{ ArenaAllocator<Texture*>(arena) };
+		for (const auto& texture : m_textures)
+		{
+			if (!texture->failed && texture->lastUsedFrame == m_frame && texture->finestResident > texture->wantedLevel)
+			{
+				pending.push_back(texture.get());
+			}
+		}
+
+		// Cheapest next level first: every texture gets its coarse levels before any gets a fine one.
+		// Counted as they will sit in VRAM, so expanded levels reserve their RGBA8 size.
+		auto nextBytes = [this](const Texture* texture) { return LevelBytes(*texture, texture->finestResident - 1); };
+
+		uint64_t uploaded = 0;
+		while (!pending.empty())
+		{
+			auto next = std::min_element(pending.begin(), pending.end(), [&](const Texture* a, const Texture* b) { return nextBytes(a) < nextBytes(b); });
+			Texture* texture = *next;
+			const uint64_t bytes = nextBytes(texture);
+
+			if (uploaded > 0 && uploaded + bytes > m_uploadBytesPerFrame) break;
+			if (!MakeRoom(bytes, texture, arena))
+			{
+				pending.erase(next);
+				continue;
+			}
+
+			UploadLevel(*texture, texture->finestResident - 1);
+			uploaded += bytes;
+			if (texture->finestResident <= texture->wantedLevel) pending.erase(next);
+		}
+
+		// A lowered budget is enforced on textures this frame did not use.
+		if (m_residentBytes > m_budgetBytes) MakeRoom(0, nullptr, arena);
+
+		m_lastUploadedBytes = uploaded;
+		++m_frame;
+	}
+
+	TextureStreamerStats TextureStreamer::Stats() const
+	{
+		TextureStreamerStats stats;
+		stats.textures = static_cast<int>(m_textures.size());
+		stats.residentBytes = m_residentBytes;
+		stats.budgetBytes = m_budgetBytes;
+		stats.uploadedBytes = m_lastUploadedBytes;
+		for (const auto& texture : m_textures)
+		{
+			if (texture->id) ++stats.resident;
+			if (texture->id && texture->finestResident <= texture->wantedLevel) ++stats.complete;
+		}
+		return stats;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include "../Asset/TextureArtifact.h"
+#include "../Core/FrameArena.h"
+#include "../Document/SceneFile.h"
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtGui/QOpenGLExtraFunctions>
+#include <memory>
+#include <vector>
+
+namespace Orca
+{
+	struct TextureStreamerStats
+	{
+		int textures = 0;
+		int resident = 0;             // textures with at least one level on the GPU
+		int complete = 0;             // textures with every wanted level on the GPU
+		uint64_t residentBytes = 0;
+		uint64_t budgetBytes = 0;
+		uint64_t uploadedBytes = 0;   // during the last Update()
+	};
+
+	/**
+	 * @brief Streams texture artifacts to the GPU a mip level at a time, under a VRAM budget.
+	 *
+	 * Request() says which textures a frame uses and how large they appear; Update() then
+	 * uploads straight from the mapped artifacts, coarsest level first, so everything becomes
+	 * visible blurry before anything becomes sharp. When the budget is full, the finest levels
+	 * of textures that were not requested recently are dropped, least recently used first.
+	 *
+	 * All calls need the owning context current, and the owner must call Clear() before the
+	 * context goes away.
+	 */
+	class TextureStreamer : protected QOpenGLExtraFunctions
+	{
+	public:
+		static constexpr uint64_t kDefaultBudgetBytes = 512ull << 20;
+		static constexpr uint64_t kDefaultUploadBytesPerFrame = 8ull << 20;
+
+		TextureStreamer() = default;
+
+		TextureStreamer(const TextureStreamer&) = delete;
+		TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+		void Initialize();
+
+		/** @brief Deletes every GL texture and closes the artifacts. */
+		void Clear();
+
+		void SetBudget(uint64_t bytes) { m_budgetBytes = bytes; }
+		uint64_t Budget() const { return m_budgetBytes; }
+		void SetUploadBudget(uint64_t bytesPerFrame) { m_uploadBytesPerFrame = bytesPerFrame; }
+
+		/**
+		 * @brief Marks a texture as used this frame.
+		 * @param artifactPath Texture artifact, as given by AssetDatabase::ArtifactPath().
+		 * @param wantedSize Largest on-screen dimension in pixels; 0 streams the full resolution.
+		 * @return The GL texture, or 0 until its first level has been uploaded.
+		 */
+		GLuint Request(const QString& artifactPath, uint32_t wantedSize = 0);
+
+		/** @brief Uploads and evicts levels for the requests made since the last call. Scratch lists come from @p arena. */
+		void Update(FrameArena& arena);
+
+		TextureStreamerStats Stats() const;
+
+	private:
+		struct Texture
+		{
+			QString path;
+			MappedFile file;
+			TextureArtifactView view;
+			bool failed = false;
+
+			GLuint id = 0;
+			uint32_t finestResident = 0;    // == mip count when nothing is resident
+			uint32_t wantedLevel = 0;
+			uint64_t residentBytes = 0;
+			uint64_t lastUsedFrame = 0;
+		};
+
+		bool OpenArtifact(Texture& texture);
+
+		/** @brief True if the texture uploads compressed; otherwise its levels are expanded to RGBA8. */
+		bool Native(const Texture& texture) const;
+
+		/** @brief VRAM a level takes once uploaded. */
+		uint64_t LevelBytes(const Texture& texture, uint32_t level) const;
+
+		void UploadLevel(Texture& texture, uint32_t level);
+		void DropFinestLevel(Texture& texture);
+		bool MakeRoom(uint64_t bytes, const Texture* keep, FrameArena& arena);
+
+		bool m_initialized = false;
+		bool m_s3tc = false;
+		bool m_s3tcSrgb = false;
+
+		std::vector<std::unique_ptr<Texture>> m_textures;
+		QHash<QString, Texture*> m_byPath;
+
+		uint64_t m_frame = 1;
+		uint64_t m_budgetBytes = kDefaultBudgetBytes;
+		uint64_t m_uploadBytesPerFrame = kDefaultUploadBytesPerFrame;
+		uint64_t m_residentBytes = 0;
+		uint64_t m_lastUploadedBytes = 0;
+		std::vector<uint8_t> m_decodeScratch;           // the finest expanded level of any requested texture
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,699 @@
+// orca_bench - headless benchmark suite for the editor's hot paths.
+//
+// Runs on the offscreen Qt platform (set here unless QT_QPA_PLATFORM already
+// names one), so CI machines need no display. Every benchmark reports the best
+// of --iterations runs in milliseconds. --json writes the results out and
+// --baseline compares them with an earlier file, failing when a benchmark got
+// slower than --threshold percent. Some benchmarks also check an invariant,
+// such as steady-state viewport frames not allocating or render graph targets
+// sharing memory, and fail the run if it doesn't hold.
+
+#include "../Asset/TextureArtifact.h"
+#include "../Core/EditorLog.h"
+#include "../Core/MemoryTracker.h"
+#include "../Core/PlaySession.h"
+#include "../Core/ProjectLoader.h"
+#include "../Document/EditableScene.h"
+#include "../Document/SceneBenchmarks.h"
+#include "../Document/SceneFile.h"
+#include "../Panel/ConsoleLogModel.h"
+#include "../Panel/HierarchyPanel.h"
+#include "../Panel/InspectorBenchmark.h"
+#include "../Panel/SceneViewport.h"
+#include "../Render/RenderGraph.h"
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSysInfo>
+#include <QtCore/QTemporaryDir>
+#include <QtGui/QOffscreenSurface>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QSurfaceFormat>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QTreeWidget>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr int kExitRegression = 3;
+	constexpr int kExitCheckFailed = 4;
+
+	// Differences below this are timer noise, whatever the percentage says.
+	constexpr double kNoiseFloorMs = 0.05;
+
+	struct Options
+	{
+		std::string json;
+		std::string baseline;
+		std::string filter;
+		uint32_t objects = 20000;
+		int iterations = 5;
+		int frames = 120;
+		double thresholdPercent = 10.0;
+	};
+
+	struct BenchResult
+	{
+		std::string name;
+		double ms = 0.0;
+		std::string detail;    // throughput and sizes, for people; not compared
+		std::string skipped;   // why it didn't run, empty if it did
+		std::string failed;    // the invariant it checks that didn't hold, empty if none did
+	};
+
+	void PrintUsage()
+	{
+		std::cerr <<
+			"Usage: orca_bench [options]\n"
+			"  --objects <n>        entities in the synthetic scene (default 20000)\n"
+			"  --iterations <n>     runs per benchmark, best one kept (default 5)\n"
+			"  --frames <n>         frames timed by render.offscreen (default 120)\n"
+			"  --filter <text>      only benchmarks whose name contains <text>\n"
+			"  --json <file>        write results as JSON\n"
+			"  --baseline <file>    compare with an earlier --json file\n"
+			"  --threshold <pct>    slowdown that counts as a regression (default 10)\n"
+			"Exit status is 3 when --baseline finds a regression, 4 when a check fails.\n";
+	}
+
+	bool ParseArguments(int argc, char* argv[], Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			auto next = [&](std::string& out) -> bool
+			{
+				if (i + 1 >= argc) return false;
+				out = argv[++i];
+				return true;
+			};
+			auto nextNumber = [&](auto& out) -> bool
+			{
+				std::string text;
+				if (!next(text)) return false;
+				try { out = static_cast<std::decay_t<decltype(out)>>(std::stod(text)); }
+				catch (const std::exception&) { return false; }
+				return out > 0;
+			};
+
+			if (arg == "--json") { if (!next(options.json)) return false; }
+			else if (arg == "--baseline") { if (!next(options.baseline)) return false; }
+			else if (arg == "--filter") { if (!next(options.filter)) return false; }
+			else if (arg == "--objects") { if (!nextNumber(options.objects)) return false; }
+			else if (arg == "--iterations") { if (!nextNumber(options.iterations)) return false; }
+			else if (arg == "--frames") { if (!nextNumber(options.frames)) return false; }
+			else if (arg == "--threshold") { if (!nextNumber(options.thresholdPercent)) return false; }
+			else return false;
+		}
+		return true;
+	}
+
+	double MillisecondsSince(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/** Best of @p iterations; @p setup runs untimed before each one. */
+	template <typename Setup, typename Function>
+	double BestOf(int iterations, Setup&& setup, Function&& function)
+	{
+		double best = 1e300;
+		for (int i = 0; i < iterations; ++i)
+		{
+			setup();
+			auto start = std::chrono::steady_clock::now();
+			function();
+			best = std::min(best, MillisecondsSince(start));
+		}
+		return best;
+	}
+
+	template <typename Function>
+	double BestOf(int iterations, Function&& function)
+	{
+		return BestOf(iterations, [] {}, std::forward<Function>(function));
+	}
+
+	std::string Format(const char* format, double a, double b = 0.0)
+	{
+		char buffer[128];
+		std::snprintf(buffer, sizeof(buffer), format, a, b);
+		return buffer;
+	}
+
+	// Keeps the optimizer from dropping loops whose results nothing else reads.
+	volatile double g_sink = 0.0;
+
+	/** Holds the scene every benchmark after scene.parse works on. */
+	struct Fixture
+	{
+		QTemporaryDir directory;
+		QString scenePath;
+		std::shared_ptr<const Orca::SceneDocument> document;
+		std::shared_ptr<const Orca::LoadedScene> scene;
+	};
+
+	/** Writes, loads and instantiates a synthetic scene; @p error says which step failed. */
+	bool MakeSyntheticScene(const QString& path, uint32_t objects, bool dynamic, std::shared_ptr<const Orca::SceneDocument>& document,
+		std::shared_ptr<const Orca::LoadedScene>& scene, std::string& error)
+	{
+		QString message;
+		if (!Orca::WriteSyntheticScene(path, objects, &message, dynamic))
+		{
+			error = "Couldn't write the synthetic scene: " + message.toStdString();
+			return false;
+		}
+
+		auto loaded = std::make_shared<Orca::SceneDocument>();
+		if (!Orca::LoadSceneFile(path, *loaded, &message))
+		{
+			error = "Couldn't load the synthetic scene: " + message.toStdString();
+			return false;
+		}
+		document = loaded;
+
+		std::atomic<bool> cancel{ false };
+		scene = Orca::ProjectLoader::Instantiate(document, cancel, nullptr);
+		if (!scene) error = "Couldn't instantiate the synthetic scene";
+		return scene != nullptr;
+	}
+
+	bool PrepareFixture(const Options& options, Fixture& fixture)
+	{
+		if (!fixture.directory.isValid())
+		{
+			std::cerr << "Couldn't create a temporary directory\n";
+			return false;
+		}
+
+		fixture.scenePath = fixture.directory.filePath("Bench.orca");
+		std::string error;
+		if (!MakeSyntheticScene(fixture.scenePath, options.objects, false, fixture.document, fixture.scene, error))
+		{
+			std::cerr << error << "\n";
+			return false;
+		}
+		return true;
+	}
+
+	/** An uncompressed, mipmapped @p size x @p size texture artifact at @p path. */
+	bool WriteBenchTexture(const QString& path, uint32_t size, uint8_t tint)
+	{
+		std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 4);
+		for (size_t i = 0; i < pixels.size(); i += 4)
+		{
+			const size_t pixel = i / 4;
+			pixels[i] = static_cast<uint8_t>(pixel % size);
+			pixels[i + 1] = static_cast<uint8_t>(pixel / size);
+			pixels[i + 2] = tint;
+			pixels[i + 3] = 255;
+		}
+
+		QFile file(path);
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+
+		Orca::TextureBuildOptions build;
+		build.compress = false;
+		build.srgb = false;
+		return Orca::WriteTextureArtifact(pixels.data(), size, size, build, [&file](const char* data, size_t bytes)
+		{
+			return file.write(data, static_cast<qint64>(bytes)) == static_cast<qint64>(bytes);
+		});
+	}
+
+	BenchResult BenchSceneParse(const Options& options, const Fixture& fixture)
+	{
+		Orca::SceneParseBenchmarkResult parse = Orca::BenchmarkSceneParse(fixture.scenePath, options.iterations);
+
+		BenchResult result{ "scene.parse" };
+		if (!parse.orcaOk)
+		{
+			result.skipped = parse.orcaError.toStdString();
+			return result;
+		}
+		result.ms = parse.orcaMs;
+		result.detail = Format("%.1f MB/s", Orca::SceneParseBenchmarkResult::MegabytesPerSecond(parse.fileBytes, parse.orcaMs));
+		return result;
+	}
+
+	BenchResult BenchEntityIteration(const Options& options, const Fixture& fixture)
+	{
+		Orca::EditableScene editable(fixture.document);
+		editable.SetTransform(0, editable.Transform(0));   // one edited chunk, like a real session
+		Orca::SceneSnapshot snapshot = editable.Snapshot();
+		const std::vector<Orca::ComponentRecord>& components = fixture.document->Components();
+
+		BenchResult result{ "entity.iterate" };
+		result.ms = BestOf(options.iterations, [&]
+		{
+			double sum = 0.0;
+			for (size_t chunk = 0; chunk < snapshot.ChunkCount(); ++chunk)
+			{
+				const Orca::EntityRecord* records = snapshot.Records(chunk);
+				const Orca::TransformData* transforms = snapshot.Transforms(chunk);
+				for (uint32_t i = 0, count = snapshot.ChunkSize(chunk); i < count; ++i)
+				{
+					sum += transforms[i].position[0] + transforms[i].position[1] + transforms[i].position[2];
+					sum += snapshot.String(records[i].nameId).size();
+					for (uint32_t c = 0; c < records[i].componentCount; ++c) sum += components[records[i].firstComponent + c].propertyCount;
+				}
+			}
+			g_sink = sum;
+		});
+		result.detail = Format("%.1f M entities/s", result.ms > 0.0 ? snapshot.EntityCount() / (result.ms * 1000.0) : 0.0);
+		return result;
+	}
+
+	BenchResult BenchTransformEdit(const Options& options, const Fixture& fixture)
+	{
+		// Every entity moved once, through the copy-on-write chunks, then snapshotted for readers.
+		std::unique_ptr<Orca::EditableScene> editable;
+		BenchResult result{ "transform.edit" };
+		result.ms = BestOf(options.iterations,
+			[&] { editable = std::make_unique<Orca::EditableScene>(fixture.document); },
+			[&]
+			{
+				for (uint32_t entity = 0, count = static_cast<uint32_t>(editable->EntityCount()); entity < count; ++entity)
+				{
+					Orca::TransformData transform = editable->Transform(entity);
+					transform.position[1] += 1.0f;
+					editable->SetTransform(entity, transform);
+				}
+				g_sink = static_cast<double>(editable->Snapshot().revision);
+			});
+		return result;
+	}
+
+	BenchResult BenchTransformWorld(const Options& options, const Fixture& fixture)
+	{
+		std::atomic<bool> cancel{ false };
+		BenchResult result{ "transform.world" };
+		result.ms = BestOf(options.iterations, [&]
+		{
+			std::shared_ptr<Orca::LoadedScene> scene = Orca::ProjectLoader::Instantiate(fixture.document, cancel, nullptr);
+			g_sink = scene ? scene->boundsRadius : 0.0;
+		});
+		return result;
+	}
+
+	BenchResult BenchHierarchyPopulate(const Options& options, const Fixture& fixture)
+	{
+		// Parented to a hidden tree, as the dock is before the user looks at it.
+		QTreeWidget tree;
+		tree.setHeaderHidden(true);
+		std::vector<QTreeWidgetItem*> items;
+		QTreeWidgetItem* root = nullptr;
+
+		BenchResult result{ "hierarchy.populate" };
+		result.ms = BestOf(options.iterations,
+			[&]
+			{
+				tree.clear();
+				items.assign(fixture.document->EntityCount(), nullptr);
+				root = new QTreeWidgetItem(&tree, QStringList() << "Bench");
+				root->setExpanded(true);
+			},
+			[&] { Orca::Editor::AppendHierarchyItems(*fixture.scene, 0, fixture.scene->hierarchyOrder.size(), root, items); });
+		return result;
+	}
+
+	BenchResult BenchInspectorRebuild(const Options& options)
+	{
+		constexpr int kRows = 300;
+		Orca::InspectorBenchmarkResult inspector = Orca::BenchmarkInspectorRows(kRows, options.iterations);
+
+		BenchResult result{ "inspector.rebuild" };
+		result.ms = inspector.themeBuildMs;
+		result.detail = std::to_string(inspector.rows) + " rows, " + std::to_string(inspector.widgets) + " widgets";
+		return result;
+	}
+
+	BenchResult BenchConsoleAppend(const Options& options)
+	{
+		// Log calls into the store, then the rows handed to the console model in search-sized batches.
+		constexpr int kLines = 100000;
+		constexpr int kBatch = 256;
+
+		Orca::Editor::ConsoleLogModel model;
+		model.SetGeneration(1);
+		QVector<quint64> batch;
+		batch.reserve(kBatch);
+
+		BenchResult result{ "console.append" };
+		result.ms = BestOf(options.iterations,
+			[&] { model.onMatchesFound(1, {}, true); },
+			[&]
+			{
+				const uint64_t first = Orca::LogStore::Get().Appended();
+				for (int i = 0; i < kLines; ++i)
+				{
+					ORCA_LOG_INFO("Bench", "Line {} of {}", i, kLines);
+				}
+				for (uint64_t sequence = first, end = first + kLines; sequence < end;)
+				{
+					batch.clear();
+					for (; sequence < end && batch.size() < kBatch; ++sequence) batch.push_back(sequence);
+					model.onMatchesFound(1, batch, false);
+				}
+			});
+		result.detail = Format("%.2f M lines/s", result.ms > 0.0 ? kLines / (result.ms * 1000.0) : 0.0);
+		return result;
+	}
+
+	BenchResult BenchRenderGraph(const Options& options)
+	{
+		constexpr int kSize = 512;
+		constexpr int kChain = 4;
+
+		BenchResult result{ "render.graph" };
+		QSurfaceFormat format;
+		format.setVersion(3, 3);
+		format.setProfile(QSurfaceFormat::CoreProfile);
+		QOffscreenSurface surface;
+		surface.setFormat(format);
+		surface.create();
+		QOpenGLContext context;
+		context.setFormat(format);
+		if (!context.create() || !context.makeCurrent(&surface) || context.format().version() < qMakePair(3, 3))
+		{
+			result.skipped = "no OpenGL 3.3 context on this platform";
+			return result;
+		}
+
+		// A chain of same-sized color targets, each dead once the next pass has read it, so two
+		// textures serve all of them. The pass writing "Unused" has no reader and is culled.
+		Orca::RenderGraph graph;
+		graph.Initialize();
+		const Orca::RenderResource backbuffer = graph.ImportBackbuffer("Backbuffer");
+		const char* names[kChain] = { "Chain 0", "Chain 1", "Chain 2", "Chain 3" };
+		Orca::RenderResource chain[kChain];
+		for (int i = 0; i < kChain; ++i) chain[i] = graph.CreateTarget(names[i], Orca::RenderTargetDesc());
+		const Orca::RenderResource unused = graph.CreateTarget("Unused", Orca::RenderTargetDesc());
+
+		for (int i = 0; i < kChain; ++i)
+		{
+			graph.AddPass(names[i], [&chain, i](Orca::RenderPassBuilder& pass)
+			{
+				if (i > 0) pass.Read(chain[i - 1]);
+				pass.WriteColor(chain[i]);
+			}, nullptr);
+		}
+		graph.AddPass("Unused", [unused](Orca::RenderPassBuilder& pass) { pass.WriteColor(unused); }, nullptr);
+		graph.AddPass("Present", [&chain, backbuffer](Orca::RenderPassBuilder& pass)
+		{
+			pass.Read(chain[kChain - 1]);
+			pass.WriteColor(backbuffer);
+		}, nullptr);
+
+		// Recompiling at one size reuses the previous compile's objects; alternating sizes doesn't.
+		bool compiled = true;
+		int frame = 0;
+		result.ms = BestOf(options.iterations, [&] { compiled = graph.Compile(kSize + (frame++ & 1), kSize) && compiled; });
+		compiled = graph.Compile(kSize, kSize) && compiled;
+		graph.Execute(context.defaultFramebufferObject());
+
+		const Orca::RenderGraphReport report = graph.Report();
+		const uint64_t targetBytes = static_cast<uint64_t>(kSize) * kSize * 4;
+		auto physical = [&report](Orca::RenderResource resource) { return report.resources[resource].physical; };
+		auto check = [&result](bool ok, const char* problem) { if (!ok && result.failed.empty()) result.failed = problem; };
+
+		check(compiled, "the graph didn't compile");
+		check(report.passes[kChain].culled, "the pass writing a target nobody reads wasn't culled");
+		check(physical(unused) < 0, "a culled pass's target was allocated");
+		check(physical(chain[0]) >= 0 && physical(chain[1]) >= 0 && physical(chain[0]) != physical(chain[1]), "overlapping targets share a texture");
+		check(physical(chain[0]) == physical(chain[2]) && physical(chain[1]) == physical(chain[3]), "disjoint targets weren't aliased");
+		check(graph.Texture(chain[0]) != 0 && graph.Texture(chain[0]) == graph.Texture(chain[2]), "aliased targets have different textures");
+		check(report.transientBytes == kChain * targetBytes, "transient bytes don't add up");
+		check(report.allocatedBytes == 2 * targetBytes, "aliasing didn't halve the allocated bytes");
+
+		result.detail = Format("%.1f MB allocated for %.1f MB of targets", report.allocatedBytes / 1048576.0, report.transientBytes / 1048576.0);
+		graph.Clear();
+		context.doneCurrent();
+		return result;
+	}
+
+	/**
+	 * Steady-state frames mustn't allocate, even with everything going on that can happen per
+	 * frame: the camera pans, so culling, light binning and shadow pages redo their work, a play
+	 * session moves the rigidbodies, and two textures that don't both fit the budget keep
+	 * evicting each other. Counts operator new charged to the renderer on any thread, ticks
+	 * included; see SceneViewport::LastFrameHeapAllocations.
+	 * @return What went wrong, or empty.
+	 */
+	std::string CheckFrameAllocations(const Options& options, const Fixture& fixture, Orca::SceneViewport& viewport, std::string& detail)
+	{
+		// Each texture is 1.3 MB with its mips and the budget only fits one.
+		constexpr uint32_t kTextureSize = 512;
+		constexpr int kFramesPerTexture = 4;
+		constexpr uint64_t kTextureBudget = 2ull << 20;
+		constexpr uint64_t kUploadBudget = 256ull << 10;
+
+		// The session steps at its own pace, so frames continue until it has stepped this often.
+		constexpr int kPlaySteps = 10;
+		constexpr qint64 kPlayTimeoutMs = 5000;
+
+		std::shared_ptr<const Orca::SceneDocument> document;
+		std::shared_ptr<const Orca::LoadedScene> scene;
+		std::string error;
+		if (!MakeSyntheticScene(fixture.directory.filePath("Dynamic.orca"), options.objects, true, document, scene, error)) return error;
+
+		const QString textures[2] = { fixture.directory.filePath("Bench0.texture"), fixture.directory.filePath("Bench1.texture") };
+		if (!WriteBenchTexture(textures[0], kTextureSize, 0) || !WriteBenchTexture(textures[1], kTextureSize, 255)) return "couldn't write the test textures";
+
+		viewport.SetScene(scene);
+		viewport.UploadInstances(scene->worldMatrices, 0, scene->worldMatrices.size() / 16);
+		viewport.FrameBounds(QVector3D(scene->boundsCenter[0], scene->boundsCenter[1], scene->boundsCenter[2]), scene->boundsRadius);
+
+		Orca::TextureStreamer& streamer = viewport.Textures();
+		streamer.SetBudget(kTextureBudget);
+		streamer.SetUploadBudget(kUploadBudget);
+		int textureFrame = 0;
+		const std::function<void()> requestTextures = [&] { streamer.Request(textures[textureFrame++ / kFramesPerTexture % 2]); };
+
+		const Orca::RenderResourceCache& cache = Orca::RenderResourceCache::Get();
+		Orca::EditableScene editable(document);
+		Orca::PlaySession play(editable.Snapshot(), scene);
+		viewport.SetPlaySession(&play);
+
+		// A full turn of the pan, so the measured frames only revisit views already seen, and
+		// until the first play step has been uploaded.
+		QElapsedTimer clock;
+		clock.start();
+		viewport.RenderBenchmarkFrames(Orca::SceneViewport::kBenchmarkPanFrames, true, requestTextures);
+		while (cache.PlayStep() == ~uint64_t(0) && clock.elapsed() < kPlayTimeoutMs) viewport.RenderBenchmarkFrames(1, true, requestTextures);
+
+		uint64_t allocations = 0;
+		uint64_t streamedBytes = 0;
+		uint64_t step = cache.PlayStep();
+		int playSteps = 0;
+		int frames = 0;
+		clock.restart();
+		for (; frames < options.frames || (playSteps < kPlaySteps && clock.elapsed() < kPlayTimeoutMs); ++frames)
+		{
+			viewport.RenderBenchmarkFrames(1, true, requestTextures);
+			allocations += viewport.LastFrameHeapAllocations();
+			streamedBytes += streamer.Stats().uploadedBytes;
+			if (cache.PlayStep() != step)
+			{
+				step = cache.PlayStep();
+				++playSteps;
+			}
+		}
+
+		viewport.SetPlaySession(nullptr);
+		streamer.SetBudget(Orca::TextureStreamer::kDefaultBudgetBytes);
+		streamer.SetUploadBudget(Orca::TextureStreamer::kDefaultUploadBytesPerFrame);
+
+		detail = std::to_string(frames) + " checked frames, " + std::to_string(playSteps) + " play steps, " +
+			std::to_string(viewport.Lighting().Stats().pointLights) + " point lights, " + Format("%.1f MB streamed", streamedBytes / 1048576.0);
+
+		// Otherwise the check would pass without having looked at what it is there for.
+		if (viewport.Lighting().Stats().pointLights == 0) return "the scene has no point lights to bin";
+		if (playSteps == 0) return "no play step reached the viewport";
+		if (streamedBytes == 0) return "no texture levels were streamed";
+		if (allocations > 0) return Format("%.0f heap allocations in %.0f steady-state frames", static_cast<double>(allocations), frames);
+		return std::string();
+	}
+
+	BenchResult BenchOffscreenRender(const Options& options, const Fixture& fixture)
+	{
+		constexpr int kWarmupFrames = 10;
+
+		BenchResult result{ "render.offscreen" };
+		Orca::SceneViewport viewport;
+		viewport.setAttribute(Qt::WA_DontShowOnScreen);
+		viewport.resize(1280, 720);
+		viewport.show();
+		QApplication::processEvents();
+
+		if (viewport.RenderBenchmarkFrames(kWarmupFrames).empty())
+		{
+			result.skipped = "no OpenGL 3.3 context on this platform";
+			return result;
+		}
+
+		const std::vector<float>& matrices = fixture.scene->worldMatrices;
+		viewport.UploadInstances(matrices, 0, matrices.size() / 16);
+		viewport.FrameBounds(QVector3D(fixture.scene->boundsCenter[0], fixture.scene->boundsCenter[1], fixture.scene->boundsCenter[2]), fixture.scene->boundsRadius);
+		viewport.RenderBenchmarkFrames(kWarmupFrames);
+
+		// Median frame: single frames are at the mercy of the driver, the best one flatters.
+		std::vector<double> times = viewport.RenderBenchmarkFrames(options.frames);
+		std::sort(times.begin(), times.end());
+		result.ms = times[times.size() / 2];
+		result.detail = Format("%.0f instances, p95 %.2f ms", static_cast<double>(matrices.size() / 16), times[std::min(times.size() - 1, times.size() * 95 / 100)]);
+
+		// After the timing, which keeps a still camera over the plain scene so results stay comparable.
+		if (ORCA_MEMORY_TRACKING)
+		{
+			std::string checked;
+			result.failed = CheckFrameAllocations(options, fixture, viewport, checked);
+			result.detail += "; " + checked;
+		}
+		return result;
+	}
+
+	QJsonDocument ToJson(const Options& options, const std::vector<BenchResult>& results)
+	{
+		QJsonArray entries;
+		for (const BenchResult& result : results)
+		{
+			QJsonObject entry{ { "name", QString::fromStdString(result.name) } };
+			if (!result.skipped.empty()) entry["skipped"] = QString::fromStdString(result.skipped);
+			else entry["ms"] = result.ms;
+			if (!result.detail.empty()) entry["detail"] = QString::fromStdString(result.detail);
+			if (!result.failed.empty()) entry["failed"] = QString::fromStdString(result.failed);
+			entries.append(entry);
+		}
+
+		QJsonObject root;
+		root["tool"] = "orca_bench";
+		root["version"] = 1;
+		root["platform"] = QSysInfo::prettyProductName();
+		root["cpu"] = QSysInfo::currentCpuArchitecture();
+		root["objects"] = static_cast<qint64>(options.objects);
+		root["iterations"] = options.iterations;
+		root["results"] = entries;
+		return QJsonDocument(root);
+	}
+
+	bool LoadBaseline(const std::string& path, std::map<std::string, double>& out)
+	{
+		QFile file(QString::fromStdString(path));
+		if (!file.open(QIODevice::ReadOnly)) return false;
+
+		QJsonParseError error;
+		QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+		if (error.error != QJsonParseError::NoError || !document.isObject()) return false;
+
+		for (const QJsonValue& value : document.object().value("results").toArray())
+		{
+			QJsonObject entry = value.toObject();
+			if (entry.contains("ms")) out[entry.value("name").toString().toStdString()] = entry.value("ms").toDouble();
+		}
+		return true;
+	}
+
+	/** Prints the comparison and returns how many benchmarks regressed. */
+	int Compare(const std::vector<BenchResult>& results, const std::map<std::string, double>& baseline, double thresholdPercent)
+	{
+		int regressions = 0;
+		std::printf("\nAgainst baseline (threshold %.1f%%):\n", thresholdPercent);
+		for (const BenchResult& result : results)
+		{
+			auto it = baseline.find(result.name);
+			if (!result.skipped.empty() || it == baseline.end())
+			{
+				std::printf("  %-20s %s\n", result.name.c_str(), result.skipped.empty() ? "new" : "skipped");
+				continue;
+			}
+
+			const double before = it->second;
+			const double change = before > 0.0 ? (result.ms - before) / before * 100.0 : 0.0;
+			const bool regressed = change > thresholdPercent && result.ms - before > kNoiseFloorMs;
+			if (regressed) ++regressions;
+			std::printf("  %-20s %9.3f -> %9.3f ms  %+6.1f%%%s\n", result.name.c_str(), before, result.ms, change, regressed ? "  REGRESSION" : "");
+		}
+		return regressions;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!ParseArguments(argc, argv, options))
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+	QApplication app(argc, argv);
+
+	// Benchmarks log heavily on purpose; nothing should be dropped or written to disk.
+	Orca::EditorLog::SetRateLimit(0);
+
+	Fixture fixture;
+	if (!PrepareFixture(options, fixture)) return 1;
+
+	using Benchmark = std::function<BenchResult()>;
+	const std::vector<std::pair<std::string, Benchmark>> benchmarks = {
+		{ "scene.parse", [&] { return BenchSceneParse(options, fixture); } },
+		{ "entity.iterate", [&] { return BenchEntityIteration(options, fixture); } },
+		{ "transform.edit", [&] { return BenchTransformEdit(options, fixture); } },
+		{ "transform.world", [&] { return BenchTransformWorld(options, fixture); } },
+		{ "hierarchy.populate", [&] { return BenchHierarchyPopulate(options, fixture); } },
+		{ "inspector.rebuild", [&] { return BenchInspectorRebuild(options); } },
+		{ "console.append", [&] { return BenchConsoleAppend(options); } },
+		{ "render.graph", [&] { return BenchRenderGraph(options); } },
+		{ "render.offscreen", [&] { return BenchOffscreenRender(options, fixture); } },
+	};
+
+	std::printf("orca_bench: %u entities, best of %d\n", options.objects, options.iterations);
+	std::vector<BenchResult> results;
+	for (const auto& [name, run] : benchmarks)
+	{
+		if (!options.filter.empty() && name.find(options.filter) == std::string::npos) continue;
+
+		BenchResult result = run();
+		if (result.skipped.empty()) std::printf("  %-20s %9.3f ms  %s\n", result.name.c_str(), result.ms, result.detail.c_str());
+		else std::printf("  %-20s   skipped  %s\n", result.name.c_str(), result.skipped.c_str());
+		if (!result.failed.empty()) std::printf("  %-20s    FAILED  %s\n", result.name.c_str(), result.failed.c_str());
+		results.push_back(std::move(result));
+	}
+
+	if (!options.json.empty())
+	{
+		QFile file(QString::fromStdString(options.json));
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(ToJson(options, results).toJson()) < 0)
+		{
+			std::cerr << "Couldn't write " << options.json << "\n";
+			return 1;
+		}
+	}
+
+	if (!options.baseline.empty())
+	{
+		std::map<std::string, double> baseline;
+		if (!LoadBaseline(options.baseline, baseline))
+		{
+			std::cerr << "Couldn't read baseline " << options.baseline << "\n";
+			return 1;
+		}
+		if (Compare(results, baseline, options.thresholdPercent) > 0) return kExitRegression;
+	}
+
+	const bool failed = std::any_of(results.begin(), results.end(), [](const BenchResult& result) { return !result.failed.empty(); });
+	return failed ? kExitCheckFailed : 0;
+}
\ No newline at end of file
@@ -0,0 +1,177 @@
+// orca_logdecode - renders Orca binary logs (.oblog) as text.
+//
+// Standalone on purpose: depends only on Core/BinaryLog.cpp and the standard
+// library, so it builds anywhere a bug report ends up.
+
+#include "../Core/BinaryLog.h"
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Options
+	{
+		std::vector<std::string> files;
+		std::string grep;
+		std::string regex;
+		std::string category;
+		Orca::LogSeverity minimumSeverity = Orca::LogSeverity::Trace;
+		bool stats = false;
+		bool ignoreCase = false;
+	};
+
+	void PrintUsage()
+	{
+		std::cerr <<
+			"Usage: orca_logdecode [options] <file.oblog>...\n"
+			"  --grep <text>        only events whose message contains <text>\n"
+			"  --regex <pattern>    only events whose message matches <pattern> (ECMAScript)\n"
+			"  -i                   case-insensitive --grep/--regex\n"
+			"  --level <severity>   minimum severity: trace, debug, info, warn, error, fatal\n"
+			"  --category <name>    only events from <name>\n"
+			"  --stats              print per-format counts instead of events\n";
+	}
+
+	bool ParseArguments(int argc, char* argv[], Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			auto next = [&](std::string& out) -> bool
+			{
+				if (i + 1 >= argc) return false;
+				out = argv[++i];
+				return true;
+			};
+
+			if (arg == "--grep") { if (!next(options.grep)) return false; }
+			else if (arg == "--regex") { if (!next(options.regex)) return false; }
+			else if (arg == "--category") { if (!next(options.category)) return false; }
+			else if (arg == "--level")
+			{
+				std::string level;
+				if (!next(level) || !Orca::ParseLogSeverity(level, options.minimumSeverity)) return false;
+			}
+			else if (arg == "--stats") options.stats = true;
+			else if (arg == "-i") options.ignoreCase = true;
+			else if (arg == "-h" || arg == "--help") return false;
+			else options.files.push_back(arg);
+		}
+		return !options.files.empty();
+	}
+
+	std::string Lowered(std::string text)
+	{
+		for (char& c : text) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		return text;
+	}
+
+	std::string FormatTimestamp(int64_t unixNs)
+	{
+		std::time_t seconds = static_cast<std::time_t>(unixNs / 1000000000);
+		int millis = static_cast<int>((unixNs / 1000000) % 1000);
+
+		std::tm local{};
+#ifdef _WIN32
+		localtime_s(&local, &seconds);
+#else
+		localtime_r(&seconds, &local);
+#endif
+		char buffer[32];
+		std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+
+		char out[40];
+		std::snprintf(out, sizeof(out), "%s.%03d", buffer, millis);
+		return out;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!ParseArguments(argc, argv, options))
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	std::regex pattern;
+	if (!options.regex.empty())
+	{
+		try
+		{
+			auto flags = std::regex::ECMAScript | std::regex::optimize;
+			if (options.ignoreCase) flags |= std::regex::icase;
+			pattern = std::regex(options.regex, flags);
+		}
+		catch (const std::regex_error& e)
+		{
+			std::cerr << "Invalid --regex: " << e.what() << "\n";
+			return 2;
+		}
+	}
+
+	std::string grep = options.ignoreCase ? Lowered(options.grep) : options.grep;
+
+	struct FormatStats { std::string category; std::string format; uint64_t count = 0; };
+	std::map<std::pair<std::string, uint32_t>, FormatStats> stats;
+
+	int exitCode = 0;
+	for (const std::string& file : options.files)
+	{
+		Orca::BinaryLogReader reader;
+		if (!reader.Open(file))
+		{
+			std::cerr << reader.Error() << "\n";
+			exitCode = 1;
+			continue;
+		}
+
+		bool complete = reader.ForEach([&](const Orca::BinaryLogEvent& event)
+		{
+			if (event.severity < options.minimumSeverity) return true;
+			if (!options.category.empty() && event.category != options.category) return true;
+			if (!grep.empty())
+			{
+				const std::string haystack = options.ignoreCase ? Lowered(event.message) : event.message;
+				if (haystack.find(grep) == std::string::npos) return true;
+			}
+			if (!options.regex.empty() && !std::regex_search(event.message, pattern)) return true;
+
+			if (options.stats)
+			{
+				FormatStats& entry = stats[{ file, event.formatId }];
+				if (entry.count++ == 0)
+				{
+					entry.category = std::string(event.category);
+					entry.format = std::string(event.format);
+				}
+				return true;
+			}
+
+			std::cout << FormatTimestamp(event.unixNs) << " [" << Orca::LogSeverityName(event.severity) << "] <"
+				<< event.category << "> (t" << event.thread << ") " << event.message << "\n";
+			return true;
+		});
+
+		if (!complete)
+		{
+			std::cerr << file << ": " << reader.Error() << "\n";
+		}
+	}
+
+	if (options.stats)
+	{
+		for (const auto& [key, entry] : stats)
+		{
+			std::cout << entry.count << "\t<" << entry.category << ">\t" << entry.format << "\n";
+		}
+	}
+
+	return exitCode;
+}
\ No newline at end of file
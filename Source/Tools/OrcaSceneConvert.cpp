@@ -0,0 +1,193 @@
+// orca_sceneconvert - converts scenes between .orca text and .orcab binary.
+//
+// Standalone like orca_logdecode: depends only on Source/Document and the
+// standard library. The direction is picked from the output extension.
+
+#include "../Document/OrcaBinaryScene.h"
+#include "../Document/OrcaSceneParser.h"
+#include "../Document/OrcaSceneWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Options
+	{
+		std::string input;
+		std::string output;
+		bool bench = false;
+	};
+
+	void PrintUsage()
+	{
+		std::cerr <<
+			"Usage: orca_sceneconvert <input> <output>\n"
+			"       orca_sceneconvert --bench <scene.orca>\n"
+			"  Converts .orca <-> .orcab; the output extension picks the format.\n"
+			"  --bench   converts in memory and compares load times of both formats\n";
+	}
+
+	bool ParseArguments(int argc, char* argv[], Options& options)
+	{
+		std::vector<std::string> files;
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			if (arg == "--bench") options.bench = true;
+			else if (arg == "-h" || arg == "--help") return false;
+			else files.push_back(arg);
+		}
+
+		if (options.bench && files.size() == 1)
+		{
+			options.input = files[0];
+			return true;
+		}
+		if (!options.bench && files.size() == 2)
+		{
+			options.input = files[0];
+			options.output = files[1];
+			return true;
+		}
+		return false;
+	}
+
+	bool EndsWith(const std::string& text, const char* suffix)
+	{
+		size_t length = std::char_traits<char>::length(suffix);
+		return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+	}
+
+	bool ReadFile(const std::string& path, std::vector<char>& out)
+	{
+		std::FILE* file = std::fopen(path.c_str(), "rb");
+		if (!file) return false;
+
+		std::fseek(file, 0, SEEK_END);
+		long size = std::ftell(file);
+		std::fseek(file, 0, SEEK_SET);
+
+		out.resize(size > 0 ? static_cast<size_t>(size) : 0);
+		bool ok = size >= 0 && std::fread(out.data(), 1, out.size(), file) == out.size();
+		std::fclose(file);
+		return ok;
+	}
+
+	bool Load(const std::vector<char>& data, Orca::SceneDocument& document, std::string& error)
+	{
+		if (Orca::IsOrcaBinaryScene(data.data(), data.size()))
+		{
+			return Orca::ReadOrcaBinaryScene(data.data(), data.size(), document, &error);
+		}
+		return Orca::ParseOrcaScene(data.data(), data.size(), document, &error);
+	}
+
+	double MillisecondsSince(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/** Best of three, from memory, so disk speed doesn't blur the comparison. */
+	template <typename Function>
+	double BestOf(Function&& function)
+	{
+		double best = 1e300;
+		for (int i = 0; i < 3; ++i)
+		{
+			auto start = std::chrono::steady_clock::now();
+			function();
+			best = std::min(best, MillisecondsSince(start));
+		}
+		return best;
+	}
+
+	int Bench(const std::string& path)
+	{
+		std::vector<char> text;
+		if (!ReadFile(path, text))
+		{
+			std::cerr << "Couldn't read " << path << "\n";
+			return 1;
+		}
+
+		Orca::SceneDocument document;
+		std::string error;
+		if (!Orca::ParseOrcaScene(text.data(), text.size(), document, &error))
+		{
+			std::cerr << path << ":" << error << "\n";
+			return 1;
+		}
+
+		std::vector<char> binary;
+		Orca::WriteOrcaBinaryScene(document, [&binary](const char* data, size_t size)
+		{
+			binary.insert(binary.end(), data, data + size);
+			return true;
+		});
+
+		// Vectors are heap-allocated, which is aligned enough for the view.
+		double textMs = BestOf([&] { Orca::ParseOrcaScene(text.data(), text.size(), document); });
+		double copyMs = BestOf([&] { Orca::ReadOrcaBinaryScene(binary.data(), binary.size(), document); });
+		double viewMs = BestOf([&] { Orca::OrcaBinarySceneView view; view.Open(binary.data(), binary.size()); });
+
+		std::printf("%zu entities, %zu components\n", document.EntityCount(), document.ComponentCount());
+		std::printf("  .orca  text    %10.1f MB  %9.1f ms\n", text.size() / 1e6, textMs);
+		std::printf("  .orcab copy    %10.1f MB  %9.1f ms  (%.1fx)\n", binary.size() / 1e6, copyMs, textMs / copyMs);
+		std::printf("  .orcab view    %10.1f MB  %9.1f ms  (%.1fx, validation only)\n", binary.size() / 1e6, viewMs, textMs / viewMs);
+		return 0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!ParseArguments(argc, argv, options))
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	if (options.bench)
+	{
+		return Bench(options.input);
+	}
+
+	std::vector<char> data;
+	if (!ReadFile(options.input, data))
+	{
+		std::cerr << "Couldn't read " << options.input << "\n";
+		return 1;
+	}
+
+	Orca::SceneDocument document;
+	std::string error;
+	if (!Load(data, document, error))
+	{
+		std::cerr << options.input << ":" << error << "\n";
+		return 1;
+	}
+
+	std::FILE* file = std::fopen(options.output.c_str(), "wb");
+	if (!file)
+	{
+		std::cerr << "Couldn't create " << options.output << "\n";
+		return 1;
+	}
+
+	auto sink = [file](const char* bytes, size_t size) { return std::fwrite(bytes, 1, size, file) == size; };
+	bool written = EndsWith(options.output, ".orcab") ? Orca::WriteOrcaBinaryScene(document, sink) : Orca::WriteOrcaScene(document, sink);
+	written = (std::fclose(file) == 0) && written;
+
+	if (!written)
+	{
+		std::cerr << "Failed writing " << options.output << "\n";
+		return 1;
+	}
+
+	std::cout << "Wrote " << document.EntityCount() << " entities to " << options.output << "\n";
+	return 0;
+}
\ No newline at end of file